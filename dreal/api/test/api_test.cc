@@ -113,6 +113,30 @@ TEST_F(ApiTest, CheckSatisfiabilityUnsat) {
   }
 }
 
+// Tests that the deterministic parallel mode finds the same δ-box every
+// time, even though there are many.
+TEST_F(ApiTest, CheckSatisfiabilityDeterministicParallel) {
+  const Formula f{-5 <= x_ && x_ <= 5 && -5 <= y_ && y_ <= 5 &&
+                  x_ * x_ + y_ * y_ == 1 && sin(x_) + cos(y_) > 0.5};
+  Config config;
+  config.mutable_precision() = 0.001;
+  config.mutable_number_of_jobs() = 4;
+  config.mutable_use_deterministic_icp() = true;
+
+  const optional<Box> first{CheckSatisfiability(f, config)};
+  ASSERT_TRUE(first);
+  EXPECT_TRUE(CheckSolution(x_ * x_ + y_ * y_ == 1, *first));
+  for (int i = 0; i < 10; ++i) {
+    const optional<Box> result{CheckSatisfiability(f, config)};
+    ASSERT_TRUE(result);
+    EXPECT_EQ(*result, *first);
+  }
+
+  // UNSAT.
+  const Formula g{-10 <= x_ && x_ <= 10 && 2 * x_ * x_ + 6 * x_ + 5 < 0};
+  EXPECT_FALSE(CheckSatisfiability(g, config));
+}
+
 TEST_F(ApiTest, Minimize1) {
   // minimize 2x² + 6x + 5 s.t. -10 ≤ x ≤ 10
   const Expression objective{2 * x_ * x_ + 6 * x_ + 5};
@@ -1,9 +1,12 @@
 #include "dreal/contractor/contractor_ibex_fwdbwd.h"
 
 #include <sstream>
+#include <stdexcept>
 #include <utility>
+#include <vector>
 
 #include "dreal/util/assert.h"
+#include "dreal/util/exception.h"
 #include "dreal/util/logging.h"
 #include "dreal/util/math.h"
 #include "dreal/util/stat.h"
@@ -13,6 +16,7 @@ using std::cout;
 using std::make_unique;
 using std::ostream;
 using std::ostringstream;
+using std::vector;
 
 namespace dreal {
 
@@ -32,6 +36,9 @@ class ContractorIbexFwdbwdStat : public Stat {
       print(cout, "{:<45} @ {:<20} = {:>15}\n",
             "Total # of ibex-fwdbwd Pruning (zero-effect)", "Pruning level",
             num_zero_effect_pruning_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of ibex-fwdbwd Pruning (enclosure)", "Pruning level",
+            num_enclosure_pruning_);
       if (num_pruning_) {
         print(cout, "{:<45} @ {:<20} = {:>15f} sec\n",
               "Total time spent in Pruning", "Pruning level",
@@ -42,9 +49,30 @@ class ContractorIbexFwdbwdStat : public Stat {
 
   int num_zero_effect_pruning_{0};
   int num_pruning_{0};
+  int num_enclosure_pruning_{0};
 
   Timer timer_pruning_;
 };
+
+// Returns the closure of the set of values of `e₁ - e₂` which satisfy
+// @p f, which is either `e₁ rop e₂` or its negation.
+Box::Interval FeasibleValues(const Formula& f) {
+  const bool negated{is_negation(f)};
+  switch ((negated ? get_operand(f) : f).get_kind()) {
+    case FormulaKind::Eq:
+      return negated ? Box::Interval::ALL_REALS : Box::Interval{0.0};
+    case FormulaKind::Neq:
+      return negated ? Box::Interval{0.0} : Box::Interval::ALL_REALS;
+    case FormulaKind::Gt:
+    case FormulaKind::Geq:
+      return negated ? Box::Interval::NEG_REALS : Box::Interval::POS_REALS;
+    case FormulaKind::Lt:
+    case FormulaKind::Leq:
+      return negated ? Box::Interval::POS_REALS : Box::Interval::NEG_REALS;
+    default:
+      DREAL_UNREACHABLE();
+  }
+}
 }  // namespace
 
 //---------------------------------------
@@ -68,6 +96,30 @@ ContractorIbexFwdbwd::ContractorIbexFwdbwd(Formula f, const Box& box,
     }
   } else {
     is_dummy_ = true;
+    return;
+  }
+  // Build enclosure.
+  const Formula& atom{is_negation(f_) ? get_operand(f_) : f_};
+  if (config.enclosure_mode() == EnclosureMode::Natural ||
+      !is_relational(atom)) {
+    return;
+  }
+  feasible_values_ = FeasibleValues(f_);
+  if (feasible_values_ == Box::Interval::ALL_REALS) {
+    return;
+  }
+  const Variables& variables{f_.GetFreeVariables()};
+  vector<Variable> enclosure_variables{variables.begin(), variables.end()};
+  try {
+    enclosure_ = make_unique<const IntervalEnclosure>(
+        get_lhs_expression(atom) - get_rhs_expression(atom),
+        enclosure_variables, config.enclosure_mode());
+  } catch (const std::runtime_error&) {
+    // It includes an if-then-else or an uninterpreted function.
+    return;
+  }
+  for (const Variable& var : enclosure_variables) {
+    enclosure_indices_.push_back(box.index(var));
   }
 }
 
@@ -81,8 +133,22 @@ void ContractorIbexFwdbwd::Prune(ContractorStatus* cs) const {
   DREAL_LOG_TRACE("F = {}", f_);
   const Box::IntervalVector old_iv{iv};
   stat.timer_pruning_.resume();
-  const bool is_inner{num_ctr_->f.backward(num_ctr_->right_hand_side(),
-                                           iv)};  // true if unchanged.
+  bool is_inner{num_ctr_->f.backward(num_ctr_->right_hand_side(),
+                                     iv)};  // true if unchanged.
+  if (enclosure_ && !iv.is_empty()) {
+    thread_local vector<Box::Interval> inputs;
+    inputs.resize(enclosure_indices_.size());
+    for (size_t i = 0; i < enclosure_indices_.size(); ++i) {
+      inputs[i] = iv[enclosure_indices_[i]];
+    }
+    if (((*enclosure_)(inputs.data()) & feasible_values_).is_empty()) {
+      iv.set_empty();
+      is_inner = false;
+      if (stat.enabled()) {
+        stat.num_enclosure_pruning_++;
+      }
+    }
+  }
   stat.timer_pruning_.pause();
   if (stat.enabled()) {
     stat.num_pruning_++;
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <ostream>
+#include <vector>
 
 #include "./ibex.h"
 
@@ -9,10 +10,16 @@
 #include "dreal/contractor/contractor_status.h"
 #include "dreal/symbolic/symbolic.h"
 #include "dreal/util/box.h"
+#include "dreal/util/interval_enclosure.h"
 
 namespace dreal {
 
 /// Contractor class wrapping IBEX's forward/backward contractor.
+///
+/// If `config.enclosure_mode()` is not the natural extension, it also
+/// encloses `e₁ - e₂` of the relational formula `e₁ rop e₂` over the
+/// pruned box by the given mode, and empties the box if the enclosure
+/// shows that the formula has no solution in the box.
 class ContractorIbexFwdbwd : public ContractorCell {
  public:
   /// Deleted default constructor.
@@ -48,6 +55,15 @@ class ContractorIbexFwdbwd : public ContractorCell {
   IbexConverter ibex_converter_;
   std::unique_ptr<const ibex::ExprCtr> expr_ctr_;
   std::unique_ptr<ibex::NumConstraint> num_ctr_;
+
+  // The enclosure of `e₁ - e₂` of f_. It is nullptr if it is not used.
+  std::unique_ptr<const IntervalEnclosure> enclosure_;
+
+  // The positions of the variables of enclosure_ in the box.
+  std::vector<int> enclosure_indices_;
+
+  // The closure of the set of values of `e₁ - e₂` which satisfy f_.
+  Box::Interval feasible_values_;
 };
 
 }  // namespace dreal
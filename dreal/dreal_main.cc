@@ -129,11 +129,79 @@ void MainProgram::AddOptions() {
            "Use local optimization algorithm for exist-forall problems.\n",
            "--local-optimization");
 
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Allocate symbolic expressions and formulas in an arena.\n",
+           "--symbolic-arena");
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Cache the results of the theory solver to skip redundant\n"
+           "theory checks.\n",
+           "--theory-cache");
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Resume the search of the last theory check when the theory\n"
+           "literals are only added.\n",
+           "--incremental-theory");
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Check the Boolean models in the theory on --jobs workers\n"
+           "while the SAT solver keeps enumerating them.\n",
+           "--pipelined-theory");
+
   opt_.add("1" /* Default */, false /* Required? */,
            1 /* Number of args expected. */,
            0 /* Delimiter if expecting multiple args. */, "Number of jobs.\n",
            "--jobs", "-j");
 
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Make the result of parallel ICP (--jobs) independent of the\n"
+           "timing of the threads.\n",
+           "--deterministic");
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Order the constraints in ICP by their refutation rate per\n"
+           "measured evaluation time. The result depends on the timing.\n",
+           "--cost-based-order");
+
+  opt_.add("0" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Screen this many boxes at once by batched interval evaluation\n"
+           "before pruning them in ICP (0 = disabled).\n",
+           "--icp-batch-size");
+
+  auto* const enclosure_mode_option_validator = new ez::ezOptionValidator(
+      "t", "in", "natural,mean-value,affine,taylor,adaptive", false);
+  opt_.add("natural" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Method to enclose the ranges of expressions over boxes.\n"
+           "Any one of these (default = natural):\n"
+           "natural, mean-value, affine, taylor, adaptive\n",
+           "--enclosure-mode", enclosure_mode_option_validator);
+
+  auto* const brancher_option_validator = new ez::ezOptionValidator(
+      "t", "in", "largest-first,smear,round-robin,max-impact,hybrid", false);
+  opt_.add("largest-first" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Heuristic to choose a branching dimension in ICP.\n"
+           "Any one of these (default = largest-first):\n"
+           "largest-first, smear, round-robin, max-impact, hybrid\n",
+           "--brancher", brancher_option_validator);
+
   const string kDefaultNloptFtolRel{
       fmt::format("{}", Config::kDefaultNloptFtolRel)};
   opt_.add(kDefaultNloptFtolRel.c_str() /* Default */, false /* Required? */,
@@ -202,10 +270,49 @@ void MainProgram::AddOptions() {
            "  3 = random initial phase\n",
            "--sat-default-phase");
 
+  auto* const sat_backend_option_validator =
+      new ez::ezOptionValidator("t", "in", "picosat,assumption", false);
+  opt_.add("picosat" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Backend of the SAT solver.\n"
+           "  picosat    = picosat_push/pop (default)\n"
+           "  assumption = activation literals, which keep the learned\n"
+           "               clauses across push/pop\n",
+           "--sat-backend", sat_backend_option_validator);
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Only encode the directions of the Tseitin definitions which\n"
+           "are required by the polarities (Plaisted-Greenbaum).\n",
+           "--polarity-aware-cnf");
+
   opt_.add("0" /* Default */, false /* Required? */,
            1 /* Number of args expected. */,
            0 /* Delimiter if expecting multiple args. */,
            "Set a seed for the random number generator.", "--random-seed");
+
+  opt_.add("0" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Consult the theory solver on partial assignments every this\n"
+           "many SAT decisions (0 = disabled).\n",
+           "--theory-propagation-interval");
+
+  opt_.add("0" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Time budget (in seconds) to minimize each explanation of a\n"
+           "theory conflict (0 = disabled).\n",
+           "--explanation-minimization-budget");
+
+  opt_.add("0" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Keep up to this many theory lemmas across push/pop and learn\n"
+           "them again after a pop (0 = disabled).\n",
+           "--theory-lemma-store-size");
 }
 
 bool MainProgram::ValidateOptions() {
@@ -309,6 +416,58 @@ void MainProgram::ExtractOptions() {
                     config_.number_of_jobs());
   }
 
+  // --icp-batch-size
+  if (opt_.isSet("--icp-batch-size")) {
+    int icp_batch_size{};
+    opt_.get("--icp-batch-size")->getInt(icp_batch_size);
+    if (icp_batch_size < 0) {
+      throw DREAL_RUNTIME_ERROR(
+          "--icp-batch-size should be non-negative. We have {}.",
+          icp_batch_size);
+    }
+    config_.mutable_icp_batch_size().set_from_command_line(icp_batch_size);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --icp-batch-size = {}",
+                    config_.icp_batch_size());
+  }
+
+  // --enclosure-mode
+  if (opt_.isSet("--enclosure-mode")) {
+    string enclosure_mode;
+    opt_.get("--enclosure-mode")->getString(enclosure_mode);
+    EnclosureMode mode{EnclosureMode::Natural};
+    if (enclosure_mode == "mean-value") {
+      mode = EnclosureMode::MeanValue;
+    } else if (enclosure_mode == "affine") {
+      mode = EnclosureMode::Affine;
+    } else if (enclosure_mode == "taylor") {
+      mode = EnclosureMode::Taylor;
+    } else if (enclosure_mode == "adaptive") {
+      mode = EnclosureMode::Adaptive;
+    }
+    config_.mutable_enclosure_mode().set_from_command_line(mode);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --enclosure-mode = {}",
+                    config_.enclosure_mode());
+  }
+
+  // --brancher
+  if (opt_.isSet("--brancher")) {
+    string brancher;
+    opt_.get("--brancher")->getString(brancher);
+    BranchingHeuristic heuristic{BranchingHeuristic::LargestFirst};
+    if (brancher == "smear") {
+      heuristic = BranchingHeuristic::SmearSumRelative;
+    } else if (brancher == "round-robin") {
+      heuristic = BranchingHeuristic::RoundRobin;
+    } else if (brancher == "max-impact") {
+      heuristic = BranchingHeuristic::MaxImpact;
+    } else if (brancher == "hybrid") {
+      heuristic = BranchingHeuristic::Hybrid;
+    }
+    config_.mutable_branching_heuristic().set_from_command_line(heuristic);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --brancher = {}",
+                    config_.branching_heuristic());
+  }
+
   // --forall-polytope
   if (opt_.isSet("--forall-polytope")) {
     config_.mutable_use_polytope_in_forall().set_from_command_line(true);
@@ -330,6 +489,50 @@ void MainProgram::ExtractOptions() {
                     config_.use_local_optimization());
   }
 
+  // --symbolic-arena
+  if (opt_.isSet("--symbolic-arena")) {
+    config_.mutable_use_symbolic_arena().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --symbolic-arena = {}",
+                    config_.use_symbolic_arena());
+  }
+
+  // --deterministic
+  if (opt_.isSet("--deterministic")) {
+    config_.mutable_use_deterministic_icp().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --deterministic = {}",
+                    config_.use_deterministic_icp());
+  }
+
+  // --cost-based-order
+  if (opt_.isSet("--cost-based-order")) {
+    config_.mutable_use_cost_based_evaluation_order().set_from_command_line(
+        true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --cost-based-order = {}",
+                    config_.use_cost_based_evaluation_order());
+  }
+
+  // --theory-cache
+  if (opt_.isSet("--theory-cache")) {
+    config_.mutable_use_theory_result_cache().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --theory-cache = {}",
+                    config_.use_theory_result_cache());
+  }
+
+  // --incremental-theory
+  if (opt_.isSet("--incremental-theory")) {
+    config_.mutable_use_incremental_theory_solver().set_from_command_line(
+        true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --incremental-theory = {}",
+                    config_.use_incremental_theory_solver());
+  }
+
+  // --pipelined-theory
+  if (opt_.isSet("--pipelined-theory")) {
+    config_.mutable_use_pipelined_theory_solver().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --pipelined-theory = {}",
+                    config_.use_pipelined_theory_solver());
+  }
+
   // --nlopt-ftol-rel
   if (opt_.isSet("--nlopt-ftol-rel")) {
     double nlopt_ftol_rel{0.0};
@@ -376,6 +579,75 @@ void MainProgram::ExtractOptions() {
                     config_.sat_default_phase());
   }
 
+  // --sat-backend
+  if (opt_.isSet("--sat-backend")) {
+    string sat_backend;
+    opt_.get("--sat-backend")->getString(sat_backend);
+    config_.mutable_sat_backend().set_from_command_line(
+        sat_backend == "assumption" ? Config::SatBackendType::Assumption
+                                    : Config::SatBackendType::Picosat);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --sat-backend = {}",
+                    config_.sat_backend());
+  }
+
+  // --polarity-aware-cnf
+  if (opt_.isSet("--polarity-aware-cnf")) {
+    config_.mutable_use_polarity_aware_cnf().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --polarity-aware-cnf = {}",
+                    config_.use_polarity_aware_cnf());
+  }
+
+  // --theory-propagation-interval
+  if (opt_.isSet("--theory-propagation-interval")) {
+    int theory_propagation_interval{};
+    opt_.get("--theory-propagation-interval")
+        ->getInt(theory_propagation_interval);
+    if (theory_propagation_interval < 0) {
+      throw DREAL_RUNTIME_ERROR(
+          "--theory-propagation-interval should be non-negative. We have {}.",
+          theory_propagation_interval);
+    }
+    config_.mutable_theory_propagation_interval().set_from_command_line(
+        theory_propagation_interval);
+    DREAL_LOG_DEBUG(
+        "MainProgram::ExtractOptions() --theory-propagation-interval = {}",
+        config_.theory_propagation_interval());
+  }
+
+  // --explanation-minimization-budget
+  if (opt_.isSet("--explanation-minimization-budget")) {
+    double explanation_minimization_budget{};
+    opt_.get("--explanation-minimization-budget")
+        ->getDouble(explanation_minimization_budget);
+    if (explanation_minimization_budget < 0) {
+      throw DREAL_RUNTIME_ERROR(
+          "--explanation-minimization-budget should be non-negative. We have "
+          "{}.",
+          explanation_minimization_budget);
+    }
+    config_.mutable_explanation_minimization_budget().set_from_command_line(
+        explanation_minimization_budget);
+    DREAL_LOG_DEBUG(
+        "MainProgram::ExtractOptions() --explanation-minimization-budget = {}",
+        config_.explanation_minimization_budget());
+  }
+
+  // --theory-lemma-store-size
+  if (opt_.isSet("--theory-lemma-store-size")) {
+    int theory_lemma_store_size{};
+    opt_.get("--theory-lemma-store-size")->getInt(theory_lemma_store_size);
+    if (theory_lemma_store_size < 0) {
+      throw DREAL_RUNTIME_ERROR(
+          "--theory-lemma-store-size should be non-negative. We have {}.",
+          theory_lemma_store_size);
+    }
+    config_.mutable_theory_lemma_store_size().set_from_command_line(
+        theory_lemma_store_size);
+    DREAL_LOG_DEBUG(
+        "MainProgram::ExtractOptions() --theory-lemma-store-size = {}",
+        config_.theory_lemma_store_size());
+  }
+
   // --random-seed
   if (opt_.isSet("--random-seed")) {
     // NOLINTNEXTLINE(runtime/int)
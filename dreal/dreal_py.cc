@@ -6,6 +6,7 @@
 #include "fmt/format.h"
 #include "fmt/ostream.h"
 #include "pybind11/functional.h"
+#include "pybind11/numpy.h"
 #include "pybind11/operators.h"
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
@@ -16,10 +17,12 @@
 #include "dreal/smt2/logic.h"
 #include "dreal/solver/config.h"
 #include "dreal/solver/context.h"
+#include "dreal/symbolic/batch_evaluator.h"
 #include "dreal/symbolic/prefix_printer.h"
 #include "dreal/symbolic/symbolic.h"
 #include "dreal/util/box.h"
 #include "dreal/util/if_then_else_eliminator.h"
+#include "dreal/util/interval_enclosure.h"
 #include "dreal/util/interrupt.h"
 #include "dreal/util/logging.h"
 #include "dreal/util/optional.h"
@@ -70,6 +73,24 @@ struct IbexBitSetIterator {
   py::object ref_;  // keep a reference
 };
 
+// A column-major (num_points × num_variables) matrix of points. Numpy
+// arrays of doubles in Fortran order (e.g. the transpose of a C-order
+// (num_variables × num_points) array) are passed without a copy.
+using PointMatrix =
+    py::array_t<double, py::array::f_style | py::array::forcecast>;
+
+// Checks that @p points has @p num_variables columns and returns the
+// number of points.
+int GetNumPoints(const PointMatrix& points, const size_t num_variables) {
+  if (points.ndim() != 2 ||
+      static_cast<size_t>(points.shape(1)) != num_variables) {
+    throw std::runtime_error{fmt::format(
+        "Expected a matrix of points with {} columns (one per variable).",
+        num_variables)};
+  }
+  return static_cast<int>(points.shape(0));
+}
+
 }  // namespace
 
 PYBIND11_MODULE(_dreal_py, m) {
@@ -666,6 +687,58 @@ PYBIND11_MODULE(_dreal_py, m) {
   py::implicitly_convertible<double, Expression>();
   py::implicitly_convertible<Variable, Expression>();
 
+  py::class_<ExpressionBatchEvaluator>(m, "ExpressionBatchEvaluator")
+      .def(py::init<const Expression&, vector<Variable>>())
+      .def(py::init<const Expression&>())
+      .def("variables", &ExpressionBatchEvaluator::variables)
+      .def("Evaluate",
+           [](const ExpressionBatchEvaluator& self, const PointMatrix& points) {
+             const int num_points{
+                 GetNumPoints(points, self.variables().size())};
+             py::array_t<double> results(num_points);
+             double* const out{results.mutable_data()};
+             {
+               py::gil_scoped_release release;
+               self.Evaluate(points.data(), num_points, out);
+             }
+             return results;
+           });
+
+  py::class_<FormulaBatchEvaluator>(m, "FormulaBatchEvaluator")
+      .def(py::init<const Formula&, vector<Variable>>())
+      .def(py::init<const Formula&>())
+      .def("variables", &FormulaBatchEvaluator::variables)
+      .def("Evaluate",
+           [](const FormulaBatchEvaluator& self, const PointMatrix& points) {
+             const int num_points{
+                 GetNumPoints(points, self.variables().size())};
+             py::array_t<bool> results(num_points);
+             bool* const out{results.mutable_data()};
+             {
+               py::gil_scoped_release release;
+               self.Evaluate(points.data(), num_points, out);
+             }
+             return results;
+           });
+
+  py::enum_<EnclosureMode>(m, "EnclosureMode")
+      .value("Natural", EnclosureMode::Natural)
+      .value("MeanValue", EnclosureMode::MeanValue)
+      .value("Affine", EnclosureMode::Affine)
+      .value("Taylor", EnclosureMode::Taylor)
+      .value("Adaptive", EnclosureMode::Adaptive);
+
+  py::enum_<BranchingHeuristic>(m, "BranchingHeuristic")
+      .value("LargestFirst", BranchingHeuristic::LargestFirst)
+      .value("SmearSumRelative", BranchingHeuristic::SmearSumRelative)
+      .value("RoundRobin", BranchingHeuristic::RoundRobin)
+      .value("MaxImpact", BranchingHeuristic::MaxImpact)
+      .value("Hybrid", BranchingHeuristic::Hybrid);
+
+  py::enum_<Config::SatBackendType>(m, "SatBackendType")
+      .value("Picosat", Config::SatBackendType::Picosat)
+      .value("Assumption", Config::SatBackendType::Assumption);
+
   py::class_<Config>(m, "Config")
       .def(py::init<>())
       .def_property("precision", &Config::precision,
@@ -691,6 +764,29 @@ PYBIND11_MODULE(_dreal_py, m) {
                       self.mutable_use_local_optimization() =
                           use_local_optimization;
                     })
+      .def_property("use_symbolic_arena", &Config::use_symbolic_arena,
+                    [](Config& self, const bool use_symbolic_arena) {
+                      self.mutable_use_symbolic_arena() = use_symbolic_arena;
+                    })
+      .def_property("use_theory_result_cache",
+                    &Config::use_theory_result_cache,
+                    [](Config& self, const bool use_theory_result_cache) {
+                      self.mutable_use_theory_result_cache() =
+                          use_theory_result_cache;
+                    })
+      .def_property(
+          "use_incremental_theory_solver",
+          &Config::use_incremental_theory_solver,
+          [](Config& self, const bool use_incremental_theory_solver) {
+            self.mutable_use_incremental_theory_solver() =
+                use_incremental_theory_solver;
+          })
+      .def_property(
+          "use_pipelined_theory_solver", &Config::use_pipelined_theory_solver,
+          [](Config& self, const bool use_pipelined_theory_solver) {
+            self.mutable_use_pipelined_theory_solver() =
+                use_pipelined_theory_solver;
+          })
       .def_property("nlopt_ftol_rel", &Config::nlopt_ftol_rel,
                     [](Config& self, const bool nlopt_ftol_rel) {
                       self.mutable_nlopt_ftol_rel() = nlopt_ftol_rel;
@@ -707,14 +803,66 @@ PYBIND11_MODULE(_dreal_py, m) {
                     [](Config& self, const bool nlopt_maxtime) {
                       self.mutable_nlopt_maxtime() = nlopt_maxtime;
                     })
+      .def_property("use_deterministic_icp", &Config::use_deterministic_icp,
+                    [](Config& self, const bool use_deterministic_icp) {
+                      self.mutable_use_deterministic_icp() =
+                          use_deterministic_icp;
+                    })
+      .def_property("use_cost_based_evaluation_order",
+                    &Config::use_cost_based_evaluation_order,
+                    [](Config& self,
+                       const bool use_cost_based_evaluation_order) {
+                      self.mutable_use_cost_based_evaluation_order() =
+                          use_cost_based_evaluation_order;
+                    })
       .def_property("number_of_jobs", &Config::number_of_jobs,
                     [](Config& self, const int number_of_jobs) {
                       self.mutable_number_of_jobs() = number_of_jobs;
                     })
+      .def_property("theory_propagation_interval",
+                    &Config::theory_propagation_interval,
+                    [](Config& self, const int theory_propagation_interval) {
+                      self.mutable_theory_propagation_interval() =
+                          theory_propagation_interval;
+                    })
+      .def_property(
+          "explanation_minimization_budget",
+          &Config::explanation_minimization_budget,
+          [](Config& self, const double explanation_minimization_budget) {
+            self.mutable_explanation_minimization_budget() =
+                explanation_minimization_budget;
+          })
+      .def_property("theory_lemma_store_size",
+                    &Config::theory_lemma_store_size,
+                    [](Config& self, const int theory_lemma_store_size) {
+                      self.mutable_theory_lemma_store_size() =
+                          theory_lemma_store_size;
+                    })
+      .def_property("icp_batch_size", &Config::icp_batch_size,
+                    [](Config& self, const int icp_batch_size) {
+                      self.mutable_icp_batch_size() = icp_batch_size;
+                    })
+      .def_property("enclosure_mode", &Config::enclosure_mode,
+                    [](Config& self, const EnclosureMode enclosure_mode) {
+                      self.mutable_enclosure_mode() = enclosure_mode;
+                    })
       .def_property("brancher", &Config::brancher,
                     [](Config& self, const Config::Brancher& brancher) {
                       self.mutable_brancher() = brancher;
                     })
+      .def_property("branching_heuristic", &Config::branching_heuristic,
+                    [](Config& self, const BranchingHeuristic heuristic) {
+                      self.mutable_branching_heuristic() = heuristic;
+                    })
+      .def_property("sat_backend", &Config::sat_backend,
+                    [](Config& self, const Config::SatBackendType sat_backend) {
+                      self.mutable_sat_backend() = sat_backend;
+                    })
+      .def_property("use_polarity_aware_cnf", &Config::use_polarity_aware_cnf,
+                    [](Config& self, const bool use_polarity_aware_cnf) {
+                      self.mutable_use_polarity_aware_cnf() =
+                          use_polarity_aware_cnf;
+                    })
       .def("__str__",
            [](const Config& self) { return fmt::format("{}", self); });
 
@@ -732,6 +880,11 @@ PYBIND11_MODULE(_dreal_py, m) {
              SignalHandlerGuard guard{SIGINT, &sigint_handler, &g_interrupted};
              return self.CheckSat();
            })
+      .def("CheckSatAssuming",
+           [](Context& self, const std::vector<Formula>& assumptions) {
+             SignalHandlerGuard guard{SIGINT, &sigint_handler, &g_interrupted};
+             return self.CheckSatAssuming(assumptions);
+           })
       .def("DeclareVariable",
            [](Context& self, const Variable& v) {
              return self.DeclareVariable(v);
@@ -763,7 +916,9 @@ PYBIND11_MODULE(_dreal_py, m) {
                     })
       .def_property_readonly_static(
           "version", [](py::object /* self */) { return Context::version(); })
-      .def_property_readonly("box", &Context::box);
+      .def_property_readonly("box", &Context::box)
+      .def_property_readonly("unsat_assumptions",
+                             &Context::get_unsat_assumptions);
 
   m.def("CheckSatisfiability",
         [](const Formula& f, double delta) {
@@ -29,21 +29,19 @@ double NloptOptimizerEvaluate(const unsigned n, const double* x, double* grad,
   DREAL_ASSERT(n == static_cast<size_t>(box.size()));
   DREAL_ASSERT(n > 0);
   // Set up an environment.
-  Environment& env{expression.mutable_environment()};
+  IndexedEnvironment& env{expression.mutable_environment()};
+  const vector<int>& box_slots{expression.box_slots()};
   for (size_t i = 0; i < n; ++i) {
-    const Variable& var{box.variable(i)};
     if (std::isnan(x[i])) {
       throw DREAL_RUNTIME_ERROR(
           "NloptOptimizer: x[{}] = nan is detected during evaluation", i);
     }
-    env[var] = x[i];
+    if (box_slots[i] != -1) {
+      env[box_slots[i]] = x[i];
+    }
   }
-  // Set up gradients.
   if (grad) {
-    for (int i = 0; i < box.size(); ++i) {
-      const Variable& var{box.variable(i)};
-      grad[i] = expression.Differentiate(var).Evaluate(env);
-    }
+    return expression.EvaluateWithGradient(env, grad);
   }
   // Return evaluation.
   return expression.Evaluate(env);
@@ -54,8 +52,22 @@ double NloptOptimizerEvaluate(const unsigned n, const double* x, double* grad,
 // CachedExpression
 // ----------------
 CachedExpression::CachedExpression(Expression e, const Box& box)
-    : expression_{std::move(e)}, box_{&box} {
+    : expression_{std::move(e)},
+      environment_{expression_.GetVariables()},
+      box_{&box} {
   DREAL_ASSERT(box_);
+  box_slots_.reserve(box.size());
+  for (const Variable& var : box.variables()) {
+    box_slots_.push_back(environment_.slot(var));
+  }
+  if (IsDifferentiable(expression_)) {
+    // Both of AutoDiff and IndexedEnvironment order the variables by
+    // their IDs. Therefore, the slots of environment_ can be passed to
+    // autodiff_ as its inputs.
+    autodiff_ = std::make_shared<const AutoDiff>(expression_);
+    DREAL_ASSERT(autodiff_->variables() == environment_.variables());
+    autodiff_grad_.resize(autodiff_->num_inputs());
+  }
 }
 
 const Box& CachedExpression::box() const {
@@ -63,13 +75,15 @@ const Box& CachedExpression::box() const {
   return *box_;
 }
 
-Environment& CachedExpression::mutable_environment() { return environment_; }
+IndexedEnvironment& CachedExpression::mutable_environment() {
+  return environment_;
+}
 
-const Environment& CachedExpression::environment() const {
+const IndexedEnvironment& CachedExpression::environment() const {
   return environment_;
 }
 
-double CachedExpression::Evaluate(const Environment& env) const {
+double CachedExpression::Evaluate(const IndexedEnvironment& env) const {
   return expression_.Evaluate(env);
 }
 
@@ -83,6 +97,23 @@ const Expression& CachedExpression::Differentiate(const Variable& x) {
   }
 }
 
+double CachedExpression::EvaluateWithGradient(const IndexedEnvironment& env,
+                                              double* const grad) {
+  DREAL_ASSERT(box_);
+  if (!autodiff_) {
+    for (int i = 0; i < box_->size(); ++i) {
+      grad[i] = Differentiate(box_->variable(i)).Evaluate(env);
+    }
+    return Evaluate(env);
+  }
+  DREAL_ASSERT(env.size() == autodiff_->num_inputs());
+  const double value{autodiff_->Gradient(env.data(), autodiff_grad_.data())};
+  for (size_t i = 0; i < box_slots_.size(); ++i) {
+    grad[i] = box_slots_[i] != -1 ? autodiff_grad_[box_slots_[i]] : 0.0;
+  }
+  return value;
+}
+
 ostream& operator<<(ostream& os, const CachedExpression& expression) {
   return os << expression.expression_;
 }
@@ -207,9 +238,9 @@ nlopt::result NloptOptimizer::Optimize(vector<double>* const x,
                                        double* const opt_f,
                                        const Environment& env) {
   // Update objective_ and constraints_ with env.
-  objective_.mutable_environment() = env;
+  objective_.mutable_environment().Update(env);
   for (auto& constraint_ptr : constraints_) {
-    constraint_ptr->mutable_environment() = env;
+    constraint_ptr->mutable_environment().Update(env);
   }
   return Optimize(x, opt_f);
 }
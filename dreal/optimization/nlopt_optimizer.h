@@ -11,6 +11,7 @@
 #pragma GCC diagnostic pop
 
 #include "dreal/solver/config.h"
+#include "dreal/symbolic/autodiff.h"
 #include "dreal/symbolic/symbolic.h"
 #include "dreal/util/box.h"
 #include "dreal/util/nnfizer.h"
@@ -23,17 +24,43 @@ class CachedExpression {
   CachedExpression() = default;
   CachedExpression(Expression e, const Box& box);
   const Box& box() const;
-  Environment& mutable_environment();
-  const Environment& environment() const;
-  double Evaluate(const Environment& env) const;
+
+  /// Returns the environment over the variables in the expression. The
+  /// values of the variables which are not in box() should be set
+  /// before an evaluation.
+  IndexedEnvironment& mutable_environment();
+  const IndexedEnvironment& environment() const;
+
+  /// Returns the slots of the variables in box(). `box_slots()[i]` is
+  /// the slot of `box().variable(i)` in environment(), or -1 if the
+  /// variable does not appear in the expression.
+  const std::vector<int>& box_slots() const { return box_slots_; }
+
+  double Evaluate(const IndexedEnvironment& env) const;
   const Expression& Differentiate(const Variable& x);
 
+  /// Evaluates the expression under @p env and stores its gradient with
+  /// respect to the variables in box() in @p grad. Returns the value.
+  ///
+  /// It uses reverse-mode automatic differentiation when the
+  /// expression is differentiable. Otherwise, it falls back to
+  /// symbolic differentiation.
+  double EvaluateWithGradient(const IndexedEnvironment& env, double* grad);
+
  private:
   Expression expression_;
-  Environment environment_;
+  IndexedEnvironment environment_;
   const Box* box_{nullptr};
+  std::vector<int> box_slots_;
   std::unordered_map<Variable, Expression, hash_value<Variable>> gradient_;
 
+  // AutoDiff over the variables in expression_. It is nullptr if
+  // expression_ is not differentiable. Its inputs are the slots of
+  // environment_.
+  std::shared_ptr<const AutoDiff> autodiff_;
+  // Scratch buffer for EvaluateWithGradient.
+  std::vector<double> autodiff_grad_;
+
   friend std::ostream& operator<<(std::ostream& os,
                                   const CachedExpression& expression);
 };
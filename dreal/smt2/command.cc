@@ -2,6 +2,7 @@
 
 #include <ostream>
 #include <string>
+#include <vector>
 
 #include "dreal/smt2/command_cell.h"
 #include "dreal/smt2/logic.h"
@@ -10,6 +11,7 @@ namespace dreal {
 using std::make_shared;
 using std::ostream;
 using std::string;
+using std::vector;
 
 ostream& operator<<(ostream& os, const Command& c) {
   return c.ptr_->Display(os);
@@ -21,6 +23,10 @@ Command assert_command(const Formula& f) {
 
 Command check_sat_command() { return Command{make_shared<CheckSatCommand>()}; }
 
+Command check_sat_assuming_command(const vector<Formula>& assumptions) {
+  return Command{make_shared<CheckSatAssumingCommand>(assumptions)};
+}
+
 Command exit_command() { return Command{make_shared<ExitCommand>()}; }
 
 Command set_info_command(const string& key, const string& val) {
@@ -4,6 +4,7 @@
 #include <ostream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "dreal/smt2/logic.h"
 #include "dreal/symbolic/symbolic.h"
@@ -27,6 +28,7 @@ std::ostream& operator<<(std::ostream& os, const Command& c);
 
 Command assert_command(const Formula& f);
 Command check_sat_command();
+Command check_sat_assuming_command(const std::vector<Formula>& assumptions);
 Command exit_command();
 Command pop_command(int level);
 Command push_command(int level);
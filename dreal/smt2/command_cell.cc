@@ -16,6 +16,17 @@ std::ostream& CheckSatCommand::Display(std::ostream& os) const {
   return os << "(check-sat)";
 }
 
+// -----------------------
+// CheckSatAssumingCommand
+// -----------------------
+std::ostream& CheckSatAssumingCommand::Display(std::ostream& os) const {
+  os << "(check-sat-assuming (";
+  for (size_t i = 0; i < assumptions_.size(); ++i) {
+    os << (i == 0 ? "" : " ") << assumptions_[i];
+  }
+  return os << "))";
+}
+
 // -------------
 // EchoCommand
 // -------------
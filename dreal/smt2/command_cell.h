@@ -3,6 +3,7 @@
 #include <ostream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "dreal/smt2/command.h"
 #include "dreal/symbolic/symbolic.h"
@@ -52,6 +53,18 @@ class CheckSatCommand : public CommandCell {
   std::ostream& Display(std::ostream& os) const override;
 };
 
+/// "check-sat-assuming" command.
+class CheckSatAssumingCommand : public CommandCell {
+ public:
+  explicit CheckSatAssumingCommand(std::vector<Formula> assumptions)
+      : assumptions_{std::move(assumptions)} {}
+  const std::vector<Formula>& get_assumptions() const { return assumptions_; }
+  std::ostream& Display(std::ostream& os) const override;
+
+ private:
+  const std::vector<Formula> assumptions_;
+};
+
 /// "echo" command.
 class EchoCommand : public CommandCell {
  public:
@@ -206,7 +219,6 @@ class SetOptionCommand : public CommandCell {
 };
 
 // TODO(soonho): Add support the following cases:
-// class CheckSatAssumingCommand : public CommandCell {};
 // class DeclareConstCommand : public CommandCell {};
 // class DeclareFunCommand : public CommandCell {};
 // class DeclareSortCommand : public CommandCell {};
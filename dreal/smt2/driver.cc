@@ -94,15 +94,16 @@ void Smt2Driver::error(const location& l, const string& m) {
 
 void Smt2Driver::error(const string& m) { cerr << m << "\n"; }
 
-void Smt2Driver::CheckSat() {
-  const optional<Box> model{context_.CheckSat()};
+namespace {
+// Prints the result of a check-sat command.
+void PrintCheckSatResult(const Context& context, const optional<Box>& model) {
   if (model) {
-    if (context_.config().smtlib2_compliant()) {
+    if (context.config().smtlib2_compliant()) {
       cout << "delta-sat\n";
     } else {
-      cout << "delta-sat with delta = " << context_.config().precision()
+      cout << "delta-sat with delta = " << context.config().precision()
            << "\n";
-      if (context_.config().produce_models()) {
+      if (context.config().produce_models()) {
         cout << *model << "\n";
       }
     }
@@ -111,6 +112,30 @@ void Smt2Driver::CheckSat() {
   }
   cout.flush();
 }
+}  // namespace
+
+void Smt2Driver::CheckSat() {
+  PrintCheckSatResult(context_, context_.CheckSat());
+}
+
+void Smt2Driver::CheckSatAssuming(const vector<Term>& assumptions) {
+  vector<Formula> formulas;
+  formulas.reserve(assumptions.size());
+  for (const Term& term : assumptions) {
+    formulas.push_back(term.formula());
+  }
+  PrintCheckSatResult(context_, context_.CheckSatAssuming(formulas));
+}
+
+void Smt2Driver::GetUnsatAssumptions() const {
+  const vector<Formula>& assumptions{context_.get_unsat_assumptions()};
+  fmt::print("(");
+  for (size_t i = 0; i < assumptions.size(); ++i) {
+    fmt::print("{}{}", i == 0 ? "" : " ", ToPrefix(assumptions[i]));
+  }
+  fmt::print(")\n");
+  cout.flush();
+}
 
 namespace {
 ostream& PrintModel(ostream& os, const Box& box) {
@@ -75,6 +75,14 @@ class Smt2Driver {
   /// Calls context_.CheckSat() and print proper output messages to cout.
   void CheckSat();
 
+  /// Handles `(check-sat-assuming (t1 ... tn))`. Calls
+  /// context_.CheckSatAssuming() and print proper output messages to cout.
+  void CheckSatAssuming(const std::vector<Term>& assumptions);
+
+  /// Handles `(get-unsat-assumptions)`. Prints the assumptions used to
+  /// show UNSAT in the latest check-sat-assuming.
+  void GetUnsatAssumptions() const;
+
   /// Register a variable with name @p name and sort @p s in the scope. Note
   /// that it does not declare the variable in the context.
   Variable RegisterVariable(const std::string& name, Sort sort);
@@ -130,10 +130,12 @@ command_list:   command
 command:
                 command_assert
         |       command_check_sat
+        |       command_check_sat_assuming
         |       command_declare_fun
         |       command_define_fun
         |       command_exit
         |       command_get_model
+        |       command_get_unsat_assumptions
         |       command_get_value
         |       command_maximize
         |       command_minimize
@@ -154,6 +156,14 @@ command_check_sat:
                     driver.CheckSat();
                 }
                 ;
+command_check_sat_assuming:
+                '('TK_CHECK_SAT_ASSUMING '(' ')' ')' {
+                    driver.CheckSatAssuming({});
+                }
+        |       '('TK_CHECK_SAT_ASSUMING '(' term_list ')' ')' {
+                    driver.CheckSatAssuming($4);
+                }
+                ;
 command_declare_fun:
                 '(' TK_DECLARE_FUN SYMBOL '(' ')' sort ')' {
                     driver.DeclareVariable($3, $6);
@@ -200,6 +210,12 @@ command_get_model:
                 }
                 ;
 
+command_get_unsat_assumptions:
+                '('TK_GET_UNSAT_ASSUMPTIONS ')' {
+                    driver.GetUnsatAssumptions();
+                }
+                ;
+
 command_get_value:
                 '(' TK_GET_VALUE '(' term_list ')' ')' {
                     driver.GetValue($4);
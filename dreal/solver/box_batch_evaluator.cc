@@ -0,0 +1,307 @@
+#include "dreal/solver/box_batch_evaluator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "dreal/solver/relational_formula_evaluator.h"
+#include "dreal/util/assert.h"
+#include "dreal/util/logging.h"
+
+namespace dreal {
+
+using std::make_unique;
+using std::min;
+using std::numeric_limits;
+using std::size_t;
+using std::vector;
+
+namespace {
+// The number of boxes which are evaluated at a time.
+constexpr int kBlockSize{64};
+
+constexpr double kEpsilon{numeric_limits<double>::epsilon()};
+constexpr double kDenormMin{numeric_limits<double>::denorm_min()};
+
+// Returns a lower bound of the exact value of an operation whose result
+// is @p x when rounded to nearest. |x| * ε is at least one ulp of x and
+// the smallest denormal covers the results around zero.
+inline double RoundDown(const double x) {
+  return x - (std::abs(x) * kEpsilon + kDenormMin);
+}
+
+// Returns an upper bound of the exact value of an operation whose result
+// is @p x when rounded to nearest. See RoundDown.
+inline double RoundUp(const double x) {
+  return x + (std::abs(x) * kEpsilon + kDenormMin);
+}
+
+// Returns min(a, b), or NaN if a or b is NaN. Unlike std::min, it
+// does not drop a NaN in the second argument.
+inline double NanMin(const double a, const double b) {
+  return (a < b || a != a) ? a : b;
+}
+
+// Returns max(a, b), or NaN if a or b is NaN.
+inline double NanMax(const double a, const double b) {
+  return (a > b || a != a) ? a : b;
+}
+
+// Converts the bounds in the structure-of-arrays layout to an
+// interval. An empty interval is represented by NaN bounds.
+inline Box::Interval ToInterval(const double lb, const double ub) {
+  if (std::isnan(lb) || std::isnan(ub)) {
+    return Box::Interval::EMPTY_SET;
+  }
+  return Box::Interval{lb, ub};
+}
+
+// Stores @p iv at @p lb and @p ub. See ToInterval.
+inline void FromInterval(const Box::Interval& iv, double* const lb,
+                         double* const ub) {
+  if (iv.is_empty()) {
+    *lb = *ub = numeric_limits<double>::quiet_NaN();
+  } else {
+    *lb = iv.lb();
+    *ub = iv.ub();
+  }
+}
+
+// Returns true if @p f is a relational formula or its negation.
+bool IsRelationalLiteral(const Formula& f) {
+  return is_relational(f) || (is_negation(f) && is_relational(get_operand(f)));
+}
+}  // namespace
+
+BoxBatchEvaluator::BoxBatchEvaluator(
+    const vector<FormulaEvaluator>& formula_evaluators) {
+  vector<Expression> expressions;
+  Variables variables;
+  for (size_t i = 0; i < formula_evaluators.size(); ++i) {
+    const Formula& f{formula_evaluators[i].formula()};
+    if (!IsRelationalLiteral(f)) {
+      continue;
+    }
+    formulas_.push_back({static_cast<int>(i), GetRelationalOperator(f)});
+    expressions.push_back(ExtractExpression(f));
+    variables += expressions.back().GetVariables();
+  }
+  if (formulas_.empty()) {
+    return;
+  }
+  const vector<Variable> tape_variables(variables.begin(), variables.end());
+  try {
+    tape_ = make_unique<const ExpressionTape>(expressions, tape_variables);
+  } catch (const std::runtime_error&) {
+    // Some expressions include if-then-else or uninterpreted functions,
+    // which a tape does not support. Drop the corresponding formulas.
+    vector<RelationalFormula> formulas;
+    vector<Expression> supported;
+    for (size_t i = 0; i < formulas_.size(); ++i) {
+      try {
+        ExpressionTape{expressions[i], tape_variables};
+      } catch (const std::runtime_error&) {
+        DREAL_LOG_DEBUG("BoxBatchEvaluator: Skip {}", expressions[i]);
+        continue;
+      }
+      formulas.push_back(formulas_[i]);
+      supported.push_back(expressions[i]);
+    }
+    formulas_ = std::move(formulas);
+    if (!formulas_.empty()) {
+      tape_ = make_unique<const ExpressionTape>(supported, tape_variables);
+    }
+  }
+}
+
+void BoxBatchEvaluator::Evaluate(
+    const vector<const Box*>& boxes,
+    vector<Box::Interval>* const evaluations) const {
+  const int num_boxes{static_cast<int>(boxes.size())};
+  evaluations->resize(formulas_.size() * boxes.size());
+  if (!tape_) {
+    return;
+  }
+  thread_local vector<double> lb;
+  thread_local vector<double> ub;
+  lb.resize(static_cast<size_t>(tape_->size()) * kBlockSize);
+  ub.resize(lb.size());
+  const vector<int>& outputs{tape_->outputs()};
+  for (int begin = 0; begin < num_boxes; begin += kBlockSize) {
+    const int m{min(kBlockSize, num_boxes - begin)};
+    EvaluateBlock(boxes, begin, m, lb.data(), ub.data());
+    for (size_t i = 0; i < formulas_.size(); ++i) {
+      const int offset{outputs[i] * kBlockSize};
+      for (int k = 0; k < m; ++k) {
+        (*evaluations)[i * num_boxes + begin + k] =
+            ToInterval(lb[offset + k], ub[offset + k]);
+      }
+    }
+  }
+}
+
+void BoxBatchEvaluator::FindUnsat(const vector<const Box*>& boxes,
+                                  vector<int>* const unsat) const {
+  unsat->assign(boxes.size(), -1);
+  vector<Box::Interval> evaluations;
+  Evaluate(boxes, &evaluations);
+  for (size_t i = 0; i < formulas_.size(); ++i) {
+    for (size_t k = 0; k < boxes.size(); ++k) {
+      int& result{(*unsat)[k]};
+      if (result == -1 &&
+          EvaluateRelationalOperator(formulas_[i].op,
+                                     evaluations[i * boxes.size() + k]) ==
+              FormulaEvaluationResult::Type::UNSAT) {
+        result = formulas_[i].index;
+      }
+    }
+  }
+}
+
+void BoxBatchEvaluator::EvaluateBlock(const vector<const Box*>& boxes,
+                                      const int begin, const int size,
+                                      double* const lb,
+                                      double* const ub) const {
+  using Op = ExpressionTape::Op;
+  const Box& first{*boxes[begin]};
+  const vector<Variable>& variables{tape_->variables()};
+  const vector<ExpressionTape::Instruction>& instructions{
+      tape_->instructions()};
+  for (size_t i = 0; i < instructions.size(); ++i) {
+    const ExpressionTape::Instruction& inst{instructions[i]};
+    double* const lo{lb + i * kBlockSize};
+    double* const hi{ub + i * kBlockSize};
+    // Bounds of the operands (unused for nullary instructions).
+    const bool has_arg1{inst.arg1 >= 0 && inst.op != Op::Var};
+    const bool has_arg2{inst.arg2 >= 0};
+    const double* const lo1{has_arg1 ? lb + inst.arg1 * kBlockSize : nullptr};
+    const double* const hi1{has_arg1 ? ub + inst.arg1 * kBlockSize : nullptr};
+    const double* const lo2{has_arg2 ? lb + inst.arg2 * kBlockSize : nullptr};
+    const double* const hi2{has_arg2 ? ub + inst.arg2 * kBlockSize : nullptr};
+    bool check_nan{true};
+    switch (inst.op) {
+      case Op::Constant:
+        std::fill(lo, lo + size, inst.c);
+        std::fill(hi, hi + size, inst.c);
+        check_nan = false;
+        break;
+      case Op::RealConstant:
+        std::fill(lo, lo + size, inst.lb);
+        std::fill(hi, hi + size, inst.ub);
+        check_nan = false;
+        break;
+      case Op::Var: {
+        // Boxes which are copies of each other share their variables, so
+        // the position of the variable is looked up once.
+        const Variable& var{variables[inst.arg1]};
+        const int index{first.index(var)};
+        for (int k = 0; k < size; ++k) {
+          const Box& box{*boxes[begin + k]};
+          const Box::Interval& iv{
+              &box.variables() == &first.variables() ? box[index] : box[var]};
+          lo[k] = iv.lb();
+          hi[k] = iv.ub();
+        }
+        check_nan = false;
+        break;
+      }
+      case Op::Add:
+        for (int k = 0; k < size; ++k) {
+          lo[k] = RoundDown(lo1[k] + lo2[k]);
+          hi[k] = RoundUp(hi1[k] + hi2[k]);
+        }
+        break;
+      case Op::AddConstant:
+        for (int k = 0; k < size; ++k) {
+          lo[k] = RoundDown(lo1[k] + inst.c);
+          hi[k] = RoundUp(hi1[k] + inst.c);
+        }
+        break;
+      case Op::Mul:
+        for (int k = 0; k < size; ++k) {
+          const double p1{lo1[k] * lo2[k]};
+          const double p2{lo1[k] * hi2[k]};
+          const double p3{hi1[k] * lo2[k]};
+          const double p4{hi1[k] * hi2[k]};
+          lo[k] = RoundDown(NanMin(NanMin(p1, p2), NanMin(p3, p4)));
+          hi[k] = RoundUp(NanMax(NanMax(p1, p2), NanMax(p3, p4)));
+        }
+        break;
+      case Op::Scale:
+        if (inst.c >= 0.0) {
+          for (int k = 0; k < size; ++k) {
+            lo[k] = RoundDown(lo1[k] * inst.c);
+            hi[k] = RoundUp(hi1[k] * inst.c);
+          }
+        } else {
+          for (int k = 0; k < size; ++k) {
+            lo[k] = RoundDown(hi1[k] * inst.c);
+            hi[k] = RoundUp(lo1[k] * inst.c);
+          }
+        }
+        break;
+      case Op::PowConstant:
+        if (inst.c == 2.0) {
+          for (int k = 0; k < size; ++k) {
+            const double l2{lo1[k] * lo1[k]};
+            const double u2{hi1[k] * hi1[k]};
+            const double l{lo1[k] > 0.0 ? l2 : (hi1[k] < 0.0 ? u2 : 0.0)};
+            lo[k] = std::max(RoundDown(l), 0.0);
+            hi[k] = RoundUp(NanMax(l2, u2));
+          }
+          break;
+        }
+        for (int k = 0; k < size; ++k) {
+          FromInterval(EvaluateLane(i, k, lb, ub), &lo[k], &hi[k]);
+        }
+        check_nan = false;
+        break;
+      default:
+        for (int k = 0; k < size; ++k) {
+          FromInterval(EvaluateLane(i, k, lb, ub), &lo[k], &hi[k]);
+        }
+        check_nan = false;
+    }
+    if (check_nan) {
+      // The fast path produces NaN for empty operands and for
+      // indeterminate forms such as `∞ - ∞` or `0 × ∞`. Recompute them.
+      for (int k = 0; k < size; ++k) {
+        if (std::isnan(lo[k]) || std::isnan(hi[k])) {
+          FromInterval(EvaluateLane(i, k, lb, ub), &lo[k], &hi[k]);
+        }
+      }
+    }
+  }
+}
+
+Box::Interval BoxBatchEvaluator::EvaluateLane(const int i, const int k,
+                                              const double* const lb,
+                                              const double* const ub) const {
+  using Op = ExpressionTape::Op;
+  ExpressionTape::Instruction inst{tape_->instructions()[i]};
+  DREAL_ASSERT(inst.op != Op::Var);
+  // Copy the operands of the k-th box and rebind them to 0 and 1.
+  Box::Interval operands[2];
+  if (inst.arg1 >= 0) {
+    operands[0] = ToInterval(lb[inst.arg1 * kBlockSize + k],
+                             ub[inst.arg1 * kBlockSize + k]);
+    inst.arg1 = 0;
+  }
+  if (inst.arg2 >= 0) {
+    operands[1] = ToInterval(lb[inst.arg2 * kBlockSize + k],
+                             ub[inst.arg2 * kBlockSize + k]);
+    inst.arg2 = 1;
+  }
+  if (inst.op == Op::Pow && operands[1].is_degenerated() &&
+      !operands[1].is_empty()) {
+    // As in ExpressionEvaluator, use the tighter versions of pow if the
+    // exponent is a point.
+    return internal::PowConstant(operands[0], operands[1].lb());
+  }
+  return ExpressionTape::Evaluate<Box::Interval>(inst, operands, nullptr);
+}
+
+}  // namespace dreal
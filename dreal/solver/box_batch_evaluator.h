@@ -0,0 +1,91 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "./ibex.h"
+
+#include "dreal/solver/formula_evaluator.h"
+#include "dreal/symbolic/expression_tape.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+
+namespace dreal {
+
+/// Evaluates relational formulas over many boxes at once using
+/// interval arithmetic.
+///
+/// The expressions `e₁ - e₂` of the formulas `e₁ rop e₂` are compiled
+/// into one ExpressionTape. The boxes are evaluated in blocks which
+/// are stored in structure-of-arrays layout: for each instruction of
+/// the tape, the lower bounds over the boxes in a block are contiguous
+/// and so are the upper bounds.
+///
+/// Additions, multiplications, scalings, and squares are applied to
+/// all the boxes in a block by branch-free loops which the compiler
+/// vectorizes. They are computed in the current rounding mode
+/// (round-to-nearest) and then rounded outward by at least one ulp, so
+/// the results enclose the exact ranges. The other operations, and the
+/// lanes where the fast path produces NaN (e.g. `0 × ∞`), are
+/// evaluated by ibex one box at a time.
+///
+/// Quantified formulas are skipped. The results are sound but can be
+/// slightly wider than the ones of RelationalFormulaEvaluator.
+class BoxBatchEvaluator {
+ public:
+  /// Constructs an evaluator for the relational formulas in
+  /// @p formula_evaluators.
+  explicit BoxBatchEvaluator(
+      const std::vector<FormulaEvaluator>& formula_evaluators);
+
+  /// Returns the number of formulas which this evaluator handles.
+  int size() const { return static_cast<int>(formulas_.size()); }
+
+  /// Returns the position of the @p i-th handled formula in the vector
+  /// of formula evaluators given at construction.
+  int formula_index(int i) const { return formulas_[i].index; }
+
+  /// Evaluates the handled formulas over @p boxes. The interval
+  /// evaluation of `e₁ - e₂` of the i-th formula over `boxes[k]` is
+  /// stored in `(*evaluations)[i * boxes.size() + k]`.
+  ///
+  /// @pre The boxes are not empty and include the variables of the
+  ///      formulas.
+  void Evaluate(const std::vector<const Box*>& boxes,
+                std::vector<Box::Interval>* evaluations) const;
+
+  /// Finds the boxes in @p boxes which have no solution. `(*unsat)[k]`
+  /// is set to the position (in the vector of formula evaluators given
+  /// at construction) of a formula which is UNSAT over `boxes[k]`, or
+  /// to -1 if there is no such formula.
+  ///
+  /// @pre The boxes are not empty and include the variables of the
+  ///      formulas.
+  void FindUnsat(const std::vector<const Box*>& boxes,
+                 std::vector<int>* unsat) const;
+
+ private:
+  struct RelationalFormula {
+    // Position in the vector of formula evaluators.
+    int index;
+    RelationalOperator op;
+  };
+
+  // Evaluates the tape over `boxes[begin, begin + size)` and stores
+  // the bounds in `lb` and `ub` in structure-of-arrays layout.
+  void EvaluateBlock(const std::vector<const Box*>& boxes, int begin,
+                     int size, double* lb, double* ub) const;
+
+  // Evaluates the @p i-th instruction of the tape on a single box by
+  // ibex, where `lb` and `ub` hold the bounds of the block.
+  Box::Interval EvaluateLane(int i, int k, const double* lb,
+                             const double* ub) const;
+
+  std::vector<RelationalFormula> formulas_;
+
+  // The tape whose i-th output is `e₁ - e₂` of formulas_[i]. It is
+  // nullptr if no formula is handled.
+  std::unique_ptr<const ExpressionTape> tape_;
+};
+
+}  // namespace dreal
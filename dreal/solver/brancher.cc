@@ -1,12 +1,291 @@
 #include "dreal/solver/brancher.h"
 
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
 #include "dreal/util/assert.h"
+#include "dreal/util/exception.h"
 #include "dreal/util/logging.h"
 
 namespace dreal {
 
 using std::make_pair;
+using std::make_shared;
+using std::make_unique;
+using std::ostream;
 using std::pair;
+using std::shared_ptr;
+using std::unique_ptr;
+using std::vector;
+
+namespace {
+// Partitions @p box into @p left and @p right by bisecting the
+// @p branching_dim-th dimension. Returns @p branching_dim.
+int BranchOn(const Box& box, const int branching_dim, Box* const left,
+             Box* const right) {
+  pair<Box, Box> bisected_boxes{box.bisect(branching_dim)};
+  *left = std::move(bisected_boxes.first);
+  *right = std::move(bisected_boxes.second);
+  DREAL_LOG_DEBUG(
+      "Branch {}\n"
+      "on {}\n"
+      "Box1=\n{}\n"
+      "Box2=\n{}",
+      box, box.variable(branching_dim), *left, *right);
+  return branching_dim;
+}
+
+// Finds the bisectable dimension in @p active_set with the largest
+// positive score, breaking ties by diameters. Returns -1 if there is no
+// such dimension.
+int FindMaxScore(const Box& box, const DynamicBitset& active_set,
+                 const vector<double>& scores) {
+  double max_score{0.0};
+  double max_diam{0.0};
+  int max_score_idx{-1};
+  DynamicBitset::size_type idx = active_set.find_first();
+  while (idx != DynamicBitset::npos) {
+    const Box::Interval& iv_i{box[idx]};
+    const double score_i{scores[idx]};
+    if (iv_i.is_bisectable() &&
+        (score_i > max_score ||
+         (score_i == max_score && score_i > 0.0 && iv_i.diam() > max_diam))) {
+      max_score = score_i;
+      max_diam = iv_i.diam();
+      max_score_idx = idx;
+    }
+    idx = active_set.find_next(idx);
+  }
+  return max_score_idx;
+}
+
+// Returns true if @p f is in form of `v relop c` or `c relop v`. Such a
+// formula only bounds a variable, so it does not tell which dimension
+// is worth branching.
+bool IsBound(const Formula& f) {
+  const Expression& lhs{get_lhs_expression(f)};
+  const Expression& rhs{get_rhs_expression(f)};
+  return (is_variable(lhs) && (is_constant(rhs) || is_real_constant(rhs))) ||
+         (is_variable(rhs) && (is_constant(lhs) || is_real_constant(lhs)));
+}
+
+// Computes the sum of the relative smears of the dimensions of a box.
+//
+// The smear of a variable xᵢ in a constraint f(x) relop 0 over a box B
+// is |∂f/∂xᵢ(B)| · diam(Bᵢ), which estimates how much xᵢ contributes to
+// the width of f(B). The relative smears of a constraint are its smears
+// divided by their sum. Summing them over the constraints gives a score
+// which is not dominated by a constraint of a large magnitude.
+class Smears {
+ public:
+  explicit Smears(vector<shared_ptr<const AutoDiff>> gradients)
+      : gradients_{std::move(gradients)} {}
+
+  // Computes the scores of the dimensions of @p box. Returns false if
+  // no constraint has a finite and positive smear over @p box.
+  bool Compute(const Box& box, vector<double>* const scores) {
+    scores->assign(box.size(), 0.0);
+    bool found{false};
+    for (const shared_ptr<const AutoDiff>& gradient : gradients_) {
+      const AutoDiff& autodiff{*gradient};
+      const vector<Variable>& variables{autodiff.variables()};
+      const size_t n{variables.size()};
+      dims_.resize(n);
+      inputs_.resize(n);
+      gradient_.resize(n);
+      smears_.resize(n);
+      for (size_t k = 0; k < n; ++k) {
+        dims_[k] = box.index(variables[k]);
+        inputs_[k] = box[dims_[k]];
+      }
+      autodiff.Gradient(inputs_.data(), gradient_.data());
+      double total{0.0};
+      for (size_t k = 0; k < n; ++k) {
+        smears_[k] = gradient_[k].mag() * inputs_[k].diam();
+        total += smears_[k];
+      }
+      if (!(total > 0.0) || !std::isfinite(total)) {
+        continue;
+      }
+      for (size_t k = 0; k < n; ++k) {
+        (*scores)[dims_[k]] += smears_[k] / total;
+      }
+      found = true;
+    }
+    return found;
+  }
+
+ private:
+  // They are shared by the branchers of the same constraints.
+  const vector<shared_ptr<const AutoDiff>> gradients_;
+
+  // Scratch spaces.
+  vector<int> dims_;
+  vector<Box::Interval> inputs_;
+  vector<Box::Interval> gradient_;
+  vector<double> smears_;
+};
+
+// Keeps the impact of branching on each dimension, that is, the
+// average relative reduction of the widths by the pruning which
+// follows a branching on the dimension. It is an exponential moving
+// average. A dimension which is never branched has the impact 1.0, so
+// that it is tried.
+class Impacts {
+ public:
+  double operator[](const int i) const {
+    return static_cast<size_t>(i) < impacts_.size() ? impacts_[i] : 1.0;
+  }
+
+  void Update(const int branching_dim, const Box& before, const Box& after) {
+    if (branching_dim < 0) {
+      return;
+    }
+    if (impacts_.size() < static_cast<size_t>(before.size())) {
+      impacts_.resize(before.size(), 1.0);
+    }
+    double reduction{1.0};
+    if (!after.empty()) {
+      double sum{0.0};
+      int n{0};
+      for (int i = 0; i < before.size(); ++i) {
+        const double diam_before{before[i].diam()};
+        if (diam_before > 0.0 && std::isfinite(diam_before)) {
+          sum += 1.0 - after[i].diam() / diam_before;
+          ++n;
+        }
+      }
+      reduction = n > 0 ? sum / n : 0.0;
+    }
+    double& impact{impacts_[branching_dim]};
+    impact = (1.0 - kAlpha) * impact + kAlpha * reduction;
+  }
+
+ private:
+  // The weight of a new observation.
+  static constexpr double kAlpha{0.2};
+
+  vector<double> impacts_;
+};
+
+constexpr double Impacts::kAlpha;
+
+// Returns true if a dimension in @p active_set is unbounded. Such a
+// dimension is branched first, as the scores are not meaningful.
+bool HasUnboundedDimension(const Box& box, const DynamicBitset& active_set) {
+  DynamicBitset::size_type idx = active_set.find_first();
+  while (idx != DynamicBitset::npos) {
+    if (!std::isfinite(box[idx].diam())) {
+      return true;
+    }
+    idx = active_set.find_next(idx);
+  }
+  return false;
+}
+
+// Brancher based on a function such as BranchLargestFirst.
+class FunctionBrancher : public StatefulBrancher {
+ public:
+  explicit FunctionBrancher(
+      std::function<int(const Box&, const DynamicBitset&, Box*, Box*)>
+          brancher)
+      : brancher_{std::move(brancher)} {}
+
+  int operator()(const Box& box, const DynamicBitset& active_set,
+                 Box* const left, Box* const right) override {
+    return brancher_(box, active_set, left, right);
+  }
+
+ private:
+  const std::function<int(const Box&, const DynamicBitset&, Box*, Box*)>
+      brancher_;
+};
+
+// Branches on the active dimensions in turn.
+class RoundRobinBrancher : public StatefulBrancher {
+ public:
+  int operator()(const Box& box, const DynamicBitset& active_set,
+                 Box* const left, Box* const right) override {
+    DREAL_ASSERT(!active_set.none());
+    const int n{box.size()};
+    for (int k = 1; k <= n; ++k) {
+      const int i{(last_ + k) % n};
+      if (active_set[i] && box[i].is_bisectable()) {
+        last_ = i;
+        return BranchOn(box, i, left, right);
+      }
+    }
+    return -1;
+  }
+
+ private:
+  // The last branching dimension.
+  int last_{-1};
+};
+
+// Branches on the dimension with the largest score, which is computed
+// from the smears and/or the impacts. It falls back to
+// BranchLargestFirst if no dimension has a positive score.
+class ScoreBrancher : public StatefulBrancher {
+ public:
+  ScoreBrancher(vector<shared_ptr<const AutoDiff>> gradients,
+                const bool use_smears, const bool use_impacts)
+      : use_smears_{use_smears}, use_impacts_{use_impacts} {
+    if (use_smears_) {
+      smears_ = make_unique<Smears>(std::move(gradients));
+    }
+  }
+
+  int operator()(const Box& box, const DynamicBitset& active_set,
+                 Box* const left, Box* const right) override {
+    DREAL_ASSERT(!active_set.none());
+    if (HasUnboundedDimension(box, active_set)) {
+      return BranchLargestFirst(box, active_set, left, right);
+    }
+    const bool has_smears{use_smears_ && smears_->Compute(box, &scores_)};
+    if (use_impacts_) {
+      if (!has_smears) {
+        // Weight the impacts by the relative diameters so that a
+        // dimension is not branched once it is narrow.
+        const double max_diam{FindMaxDiam(box, active_set).first};
+        scores_.assign(box.size(), 0.0);
+        if (max_diam > 0.0) {
+          for (int i = 0; i < box.size(); ++i) {
+            scores_[i] = impacts_[i] * box[i].diam() / max_diam;
+          }
+        }
+      } else {
+        // The smears already take the diameters into account.
+        for (int i = 0; i < box.size(); ++i) {
+          scores_[i] *= 1.0 + impacts_[i];
+        }
+      }
+    } else if (!has_smears) {
+      return BranchLargestFirst(box, active_set, left, right);
+    }
+    const int branching_dim{FindMaxScore(box, active_set, scores_)};
+    if (branching_dim < 0) {
+      return BranchLargestFirst(box, active_set, left, right);
+    }
+    return BranchOn(box, branching_dim, left, right);
+  }
+
+  bool uses_pruning() const override { return use_impacts_; }
+
+  void Pruned(const int branching_dim, const Box& before,
+              const Box& after) override {
+    impacts_.Update(branching_dim, before, after);
+  }
+
+ private:
+  const bool use_smears_;
+  const bool use_impacts_;
+  unique_ptr<Smears> smears_;
+  Impacts impacts_;
+  vector<double> scores_;
+};
+}  // namespace
 
 pair<double, int> FindMaxDiam(const Box& box, const DynamicBitset& active_set) {
   DREAL_ASSERT(!active_set.none());
@@ -32,17 +311,130 @@ int BranchLargestFirst(const Box& box, const DynamicBitset& active_set,
   const pair<double, int> max_diam_and_idx{FindMaxDiam(box, active_set)};
   const int branching_dim{max_diam_and_idx.second};
   if (branching_dim >= 0) {
-    pair<Box, Box> bisected_boxes{box.bisect(branching_dim)};
-    *left = std::move(bisected_boxes.first);
-    *right = std::move(bisected_boxes.second);
-    DREAL_LOG_DEBUG(
-        "Branch {}\n"
-        "on {}\n"
-        "Box1=\n{}\n"
-        "Box2=\n{}",
-        box, box.variable(branching_dim), *left, *right);
-    return branching_dim;
+    return BranchOn(box, branching_dim, left, right);
   }
   return -1;
 }
+
+vector<Box> MultisectLargestFirst(const Box& box,
+                                  const DynamicBitset& active_set,
+                                  const int n) {
+  DREAL_ASSERT(!active_set.none());
+  // Splitting a dimension into too many pieces concentrates the splits
+  // on a few dimensions.
+  constexpr int kMaxMultisection{8};
+  vector<Box> boxes{box};
+  while (static_cast<int>(boxes.size()) < n) {
+    // All the boxes have the same widths except for the rounding of the
+    // integer dimensions.
+    const int dim{FindMaxDiam(boxes.front(), active_set).second};
+    if (dim < 0) {
+      break;
+    }
+    const int num_boxes{static_cast<int>(boxes.size())};
+    const int k{std::max(
+        2, std::min(kMaxMultisection, (n + num_boxes - 1) / num_boxes))};
+    vector<Box> next;
+    next.reserve(num_boxes * k);
+    for (const Box& b : boxes) {
+      if (b[dim].is_bisectable()) {
+        for (Box& piece : b.multisect(dim, k)) {
+          next.push_back(std::move(piece));
+        }
+      } else {
+        next.push_back(b);
+      }
+    }
+    boxes = std::move(next);
+  }
+  DREAL_LOG_DEBUG("MultisectLargestFirst: Split the box into {} boxes.",
+                  boxes.size());
+  return boxes;
+}
+
+ostream& operator<<(ostream& os, const BranchingHeuristic heuristic) {
+  switch (heuristic) {
+    case BranchingHeuristic::LargestFirst:
+      return os << "Largest-First";
+    case BranchingHeuristic::SmearSumRelative:
+      return os << "Smear-Sum-Relative";
+    case BranchingHeuristic::RoundRobin:
+      return os << "Round-Robin";
+    case BranchingHeuristic::MaxImpact:
+      return os << "Max-Impact";
+    case BranchingHeuristic::Hybrid:
+      return os << "Hybrid";
+  }
+  DREAL_UNREACHABLE();
+}
+
+void StatefulBrancher::Pruned(const int, const Box&, const Box&) {}
+
+bool UsesSmears(const BranchingHeuristic heuristic) {
+  return heuristic == BranchingHeuristic::SmearSumRelative ||
+         heuristic == BranchingHeuristic::Hybrid;
+}
+
+shared_ptr<const AutoDiff> MakeSmearGradient(const Formula& formula) {
+  const Formula& atom{is_negation(formula) ? get_operand(formula) : formula};
+  if (!is_relational(atom) || IsBound(atom)) {
+    return nullptr;
+  }
+  const Expression e{get_lhs_expression(atom) - get_rhs_expression(atom)};
+  const Variables& variables{e.GetVariables()};
+  if (variables.empty()) {
+    return nullptr;
+  }
+  try {
+    return make_shared<const AutoDiff>(
+        e, vector<Variable>(variables.begin(), variables.end()));
+  } catch (const std::runtime_error&) {
+    // The expression is not differentiable (e.g. it includes abs).
+    DREAL_LOG_DEBUG("MakeSmearGradient: Skip {}", atom);
+    return nullptr;
+  }
+}
+
+unique_ptr<StatefulBrancher> MakeStatefulBrancher(
+    const BranchingHeuristic heuristic,
+    std::function<int(const Box&, const DynamicBitset&, Box*, Box*)> brancher,
+    const vector<Formula>& formulas) {
+  vector<shared_ptr<const AutoDiff>> gradients;
+  if (UsesSmears(heuristic)) {
+    for (const Formula& f : formulas) {
+      shared_ptr<const AutoDiff> gradient{MakeSmearGradient(f)};
+      if (gradient) {
+        gradients.push_back(std::move(gradient));
+      }
+    }
+  }
+  return MakeStatefulBrancher(heuristic, std::move(brancher),
+                              std::move(gradients));
+}
+
+unique_ptr<StatefulBrancher> MakeStatefulBrancher(
+    const BranchingHeuristic heuristic,
+    std::function<int(const Box&, const DynamicBitset&, Box*, Box*)> brancher,
+    vector<shared_ptr<const AutoDiff>> gradients) {
+  switch (heuristic) {
+    case BranchingHeuristic::LargestFirst:
+      return make_unique<FunctionBrancher>(std::move(brancher));
+    case BranchingHeuristic::SmearSumRelative:
+      return make_unique<ScoreBrancher>(std::move(gradients),
+                                        true /* use_smears */,
+                                        false /* use_impacts */);
+    case BranchingHeuristic::RoundRobin:
+      return make_unique<RoundRobinBrancher>();
+    case BranchingHeuristic::MaxImpact:
+      return make_unique<ScoreBrancher>(std::move(gradients),
+                                        false /* use_smears */,
+                                        true /* use_impacts */);
+    case BranchingHeuristic::Hybrid:
+      return make_unique<ScoreBrancher>(std::move(gradients),
+                                        true /* use_smears */,
+                                        true /* use_impacts */);
+  }
+  DREAL_UNREACHABLE();
+}
+
 }  // namespace dreal
@@ -1,7 +1,13 @@
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <ostream>
 #include <utility>
+#include <vector>
 
+#include "dreal/symbolic/autodiff.h"
+#include "dreal/symbolic/symbolic.h"
 #include "dreal/util/box.h"
 #include "dreal/util/dynamic_bitset.h"
 
@@ -29,4 +35,81 @@ std::pair<double, int> FindMaxDiam(const Box& box,
 int BranchLargestFirst(const Box& box, const DynamicBitset& active_set,
                        Box* left, Box* right);
 
+/// Splits @p box into at least @p n boxes by k-way multisections. It
+/// repeatedly splits all the boxes along the widest dimension in @p
+/// active_set, into at most eight pieces at a time. It returns fewer
+/// than @p n boxes if no dimension in @p active_set is bisectable.
+std::vector<Box> MultisectLargestFirst(const Box& box,
+                                       const DynamicBitset& active_set,
+                                       int n);
+
+/// Heuristics to choose a branching dimension in ICP.
+enum class BranchingHeuristic {
+  LargestFirst = 0,      ///< The widest dimension (default).
+  SmearSumRelative = 1,  ///< The largest sum of relative smears.
+  RoundRobin = 2,        ///< The dimensions in turn.
+  MaxImpact = 3,         ///< The largest impact of pruning after branching.
+  Hybrid = 4,            ///< Smears weighted by impacts.
+};
+
+std::ostream& operator<<(std::ostream& os, BranchingHeuristic heuristic);
+
+/// Brancher which keeps a state across the branchings of an ICP run,
+/// e.g. the history of pruning. It is not thread-safe. Each ICP worker
+/// uses its own instance.
+class StatefulBrancher {
+ public:
+  StatefulBrancher() = default;
+  StatefulBrancher(const StatefulBrancher&) = delete;
+  StatefulBrancher(StatefulBrancher&&) = delete;
+  StatefulBrancher& operator=(const StatefulBrancher&) = delete;
+  StatefulBrancher& operator=(StatefulBrancher&&) = delete;
+  virtual ~StatefulBrancher() = default;
+
+  /// Partitions @p box into @p left and @p right by branching on one of
+  /// the dimensions in @p active_set. See BranchLargestFirst.
+  ///
+  /// @returns the branching dimension if found, otherwise returns -1.
+  virtual int operator()(const Box& box, const DynamicBitset& active_set,
+                         Box* left, Box* right) = 0;
+
+  /// Returns true if this brancher uses the pruning history. If it
+  /// returns false, ICP does not need to call Pruned().
+  virtual bool uses_pruning() const { return false; }
+
+  /// Notifies that a contractor pruned @p before into @p after, where
+  /// @p before was obtained by branching on @p branching_dim (-1 if
+  /// unknown).
+  virtual void Pruned(int branching_dim, const Box& before, const Box& after);
+};
+
+/// Makes a brancher for @p heuristic.
+///
+/// @param heuristic The branching heuristic.
+/// @param brancher The brancher used for BranchingHeuristic::LargestFirst.
+///                 It can be a user-provided one (see Config::brancher()).
+/// @param formulas The constraints of the problem. The smears of the
+///                 relational ones are used by SmearSumRelative and
+///                 Hybrid.
+std::unique_ptr<StatefulBrancher> MakeStatefulBrancher(
+    BranchingHeuristic heuristic,
+    std::function<int(const Box&, const DynamicBitset&, Box*, Box*)> brancher,
+    const std::vector<Formula>& formulas);
+
+/// Makes a brancher for @p heuristic as above. The smears are computed
+/// from @p gradients, which are made by MakeSmearGradient.
+std::unique_ptr<StatefulBrancher> MakeStatefulBrancher(
+    BranchingHeuristic heuristic,
+    std::function<int(const Box&, const DynamicBitset&, Box*, Box*)> brancher,
+    std::vector<std::shared_ptr<const AutoDiff>> gradients);
+
+/// Returns true if @p heuristic uses the smears of the constraints.
+bool UsesSmears(BranchingHeuristic heuristic);
+
+/// Returns the AutoDiff of the constraint @p formula from which its
+/// smears are computed. Returns nullptr if it has none, e.g. if it is a
+/// bound or it is not differentiable. The result is immutable, so it
+/// can be shared by the branchers of different ICP runs and workers.
+std::shared_ptr<const AutoDiff> MakeSmearGradient(const Formula& formula);
+
 }  // namespace dreal
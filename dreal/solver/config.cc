@@ -47,9 +47,57 @@ OptionValue<bool>& Config::mutable_use_local_optimization() {
   return use_local_optimization_;
 }
 
+bool Config::use_symbolic_arena() const { return use_symbolic_arena_.get(); }
+OptionValue<bool>& Config::mutable_use_symbolic_arena() {
+  return use_symbolic_arena_;
+}
+
+bool Config::use_theory_result_cache() const {
+  return use_theory_result_cache_.get();
+}
+OptionValue<bool>& Config::mutable_use_theory_result_cache() {
+  return use_theory_result_cache_;
+}
+
+bool Config::use_incremental_theory_solver() const {
+  return use_incremental_theory_solver_.get();
+}
+OptionValue<bool>& Config::mutable_use_incremental_theory_solver() {
+  return use_incremental_theory_solver_;
+}
+
+bool Config::use_pipelined_theory_solver() const {
+  return use_pipelined_theory_solver_.get();
+}
+OptionValue<bool>& Config::mutable_use_pipelined_theory_solver() {
+  return use_pipelined_theory_solver_;
+}
+
 int Config::number_of_jobs() const { return number_of_jobs_.get(); }
 OptionValue<int>& Config::mutable_number_of_jobs() { return number_of_jobs_; }
 
+bool Config::use_deterministic_icp() const {
+  return use_deterministic_icp_.get();
+}
+OptionValue<bool>& Config::mutable_use_deterministic_icp() {
+  return use_deterministic_icp_;
+}
+
+bool Config::use_cost_based_evaluation_order() const {
+  return use_cost_based_evaluation_order_.get();
+}
+OptionValue<bool>& Config::mutable_use_cost_based_evaluation_order() {
+  return use_cost_based_evaluation_order_;
+}
+
+int Config::icp_batch_size() const { return icp_batch_size_.get(); }
+OptionValue<int>& Config::mutable_icp_batch_size() { return icp_batch_size_; }
+
+EnclosureMode Config::enclosure_mode() const { return enclosure_mode_.get(); }
+OptionValue<EnclosureMode>& Config::mutable_enclosure_mode() {
+  return enclosure_mode_;
+}
+
 bool Config::stack_left_box_first() const {
   return stack_left_box_first_.get();
 }
@@ -67,6 +115,14 @@ const Config::Brancher& Config::brancher() const { return brancher_.get(); }
 
 OptionValue<Config::Brancher>& Config::mutable_brancher() { return brancher_; }
 
+BranchingHeuristic Config::branching_heuristic() const {
+  return branching_heuristic_.get();
+}
+
+OptionValue<BranchingHeuristic>& Config::mutable_branching_heuristic() {
+  return branching_heuristic_;
+}
+
 double Config::nlopt_ftol_rel() const { return nlopt_ftol_rel_.get(); }
 
 OptionValue<double>& Config::mutable_nlopt_ftol_rel() {
@@ -95,6 +151,42 @@ OptionValue<Config::SatDefaultPhase>& Config::mutable_sat_default_phase() {
   return sat_default_phase_;
 }
 
+Config::SatBackendType Config::sat_backend() const {
+  return sat_backend_.get();
+}
+
+OptionValue<Config::SatBackendType>& Config::mutable_sat_backend() {
+  return sat_backend_;
+}
+
+bool Config::use_polarity_aware_cnf() const {
+  return use_polarity_aware_cnf_.get();
+}
+OptionValue<bool>& Config::mutable_use_polarity_aware_cnf() {
+  return use_polarity_aware_cnf_;
+}
+
+int Config::theory_propagation_interval() const {
+  return theory_propagation_interval_.get();
+}
+OptionValue<int>& Config::mutable_theory_propagation_interval() {
+  return theory_propagation_interval_;
+}
+
+double Config::explanation_minimization_budget() const {
+  return explanation_minimization_budget_.get();
+}
+OptionValue<double>& Config::mutable_explanation_minimization_budget() {
+  return explanation_minimization_budget_;
+}
+
+int Config::theory_lemma_store_size() const {
+  return theory_lemma_store_size_.get();
+}
+OptionValue<int>& Config::mutable_theory_lemma_store_size() {
+  return theory_lemma_store_size_;
+}
+
 uint32_t Config::random_seed() const { return random_seed_.get(); }
 
 OptionValue<uint32_t>& Config::mutable_random_seed() { return random_seed_; }
@@ -114,6 +206,17 @@ std::ostream& operator<<(std::ostream& os,
   DREAL_UNREACHABLE();
 }
 
+std::ostream& operator<<(std::ostream& os,
+                         const Config::SatBackendType& sat_backend) {
+  switch (sat_backend) {
+    case Config::SatBackendType::Picosat:
+      return os << "PicoSAT";
+    case Config::SatBackendType::Assumption:
+      return os << "Assumption";
+  }
+  DREAL_UNREACHABLE();
+}
+
 ostream& operator<<(ostream& os, const Config& config) {
   return os << fmt::format(
              "Config("
@@ -123,20 +226,45 @@ ostream& operator<<(ostream& os, const Config& config) {
              "use_polytope_in_forall = {}, "
              "use_worklist_fixpoint = {}, "
              "use_local_optimization = {}, "
+             "use_symbolic_arena = {}, "
+             "use_theory_result_cache = {}, "
+             "use_incremental_theory_solver = {}, "
+             "use_pipelined_theory_solver = {}, "
              "number_of_jobs = {}, "
+             "use_deterministic_icp = {}, "
+             "use_cost_based_evaluation_order = {}, "
+             "icp_batch_size = {}, "
+             "enclosure_mode = {}, "
+             "branching_heuristic = {}, "
              "nlopt_ftol_rel = {}, "
              "nlopt_ftol_abs = {}, "
              "nlopt_maxeval = {}, "
              "nlopt_maxtime = {}, "
              "sat_default_phase = {}, "
+             "sat_backend = {}, "
+             "use_polarity_aware_cnf = {}, "
+             "theory_propagation_interval = {}, "
+             "explanation_minimization_budget = {}, "
+             "theory_lemma_store_size = {}, "
              "random_seed = {}"
              ")",
              config.precision(), config.produce_models(), config.use_polytope(),
              config.use_polytope_in_forall(), config.use_worklist_fixpoint(),
-             config.use_local_optimization(), config.number_of_jobs(),
+             config.use_local_optimization(), config.use_symbolic_arena(),
+             config.use_theory_result_cache(),
+             config.use_incremental_theory_solver(),
+             config.use_pipelined_theory_solver(),
+             config.number_of_jobs(), config.use_deterministic_icp(),
+             config.use_cost_based_evaluation_order(),
+             config.icp_batch_size(),
+             config.enclosure_mode(), config.branching_heuristic(),
              config.nlopt_ftol_rel(), config.nlopt_ftol_abs(),
              config.nlopt_maxeval(), config.nlopt_maxtime(),
-             config.sat_default_phase(), config.random_seed());
+             config.sat_default_phase(), config.sat_backend(),
+             config.use_polarity_aware_cnf(),
+             config.theory_propagation_interval(),
+             config.explanation_minimization_budget(),
+             config.theory_lemma_store_size(), config.random_seed());
 }
 
 }  // namespace dreal
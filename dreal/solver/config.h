@@ -5,6 +5,7 @@
 #include "dreal/solver/brancher.h"
 #include "dreal/util/box.h"
 #include "dreal/util/dynamic_bitset.h"
+#include "dreal/util/interval_enclosure.h"
 #include "dreal/util/option_value.h"
 
 namespace dreal {
@@ -58,12 +59,75 @@ class Config {
   /// Returns a mutable OptionValue for 'use_local_optimization'.
   OptionValue<bool>& mutable_use_local_optimization();
 
+  /// Returns whether a Context allocates symbolic cells in its own
+  /// SymbolicArena, which is released when the Context is destroyed.
+  bool use_symbolic_arena() const;
+
+  /// Returns a mutable OptionValue for 'use_symbolic_arena'.
+  OptionValue<bool>& mutable_use_symbolic_arena();
+
+  /// Returns whether a Context caches the results of its theory solver
+  /// to skip the theory checks whose results are known. See
+  /// TheoryResultCache.
+  bool use_theory_result_cache() const;
+
+  /// Returns a mutable OptionValue for 'use_theory_result_cache'.
+  OptionValue<bool>& mutable_use_theory_result_cache();
+
+  /// Returns whether the theory solver resumes the search of its last
+  /// delta-SAT call instead of starting from the root box. See
+  /// TheorySolver::CheckSat.
+  bool use_incremental_theory_solver() const;
+
+  /// Returns a mutable OptionValue for 'use_incremental_theory_solver'.
+  OptionValue<bool>& mutable_use_incremental_theory_solver();
+
+  /// Returns whether the SAT solver keeps enumerating the Boolean models
+  /// while `number_of_jobs()` workers check them in the theory
+  /// concurrently. See TheoryPipeline.
+  bool use_pipelined_theory_solver() const;
+
+  /// Returns a mutable OptionValue for 'use_pipelined_theory_solver'.
+  OptionValue<bool>& mutable_use_pipelined_theory_solver();
+
   /// Returns the number of parallel jobs.
   int number_of_jobs() const;
 
   /// Returns a mutable OptionValue for 'number_of_jobs'.
   OptionValue<int>& mutable_number_of_jobs();
 
+  /// Returns whether ICP reports the same result regardless of the
+  /// timing of the threads with multiple jobs. See IcpParallel.
+  bool use_deterministic_icp() const;
+
+  /// Returns a mutable OptionValue for 'use_deterministic_icp'.
+  OptionValue<bool>& mutable_use_deterministic_icp();
+
+  /// Returns whether ICP weighs the refutation rate of each constraint
+  /// by its measured evaluation time when it orders the constraints. The
+  /// time is measured by the clock, so the order and the explanations of
+  /// UNSAT boxes depend on the timing. See IncrementalBoxEvaluator.
+  bool use_cost_based_evaluation_order() const;
+
+  /// Returns a mutable OptionValue for 'use_cost_based_evaluation_order'.
+  OptionValue<bool>& mutable_use_cost_based_evaluation_order();
+
+  /// Returns the number of boxes in the ICP stack which are screened
+  /// at once by batched interval evaluation before they are pruned.
+  /// Boxes found infeasible are discarded. 0 disables the screening.
+  int icp_batch_size() const;
+
+  /// Returns a mutable OptionValue for 'icp_batch_size'.
+  OptionValue<int>& mutable_icp_batch_size();
+
+  /// Returns the method to enclose the ranges of expressions over
+  /// boxes, which is used by the formula evaluators and the
+  /// forward/backward contractors. See IntervalEnclosure.
+  EnclosureMode enclosure_mode() const;
+
+  /// Returns a mutable OptionValue for 'enclosure_mode'.
+  OptionValue<EnclosureMode>& mutable_enclosure_mode();
+
   /// Returns whether the ICP algorithm stacks the left box first
   /// after branching.
   bool stack_left_box_first() const;
@@ -71,12 +135,19 @@ class Config {
   /// Returns a mutable OptionValue for 'stack_left_box_first'.
   OptionValue<bool>& mutable_stack_left_box_first();
 
-  /// Returns the brancher.
+  /// Returns the brancher. It is used when the branching heuristic is
+  /// BranchingHeuristic::LargestFirst.
   const Brancher& brancher() const;
 
   /// Returns a mutable OptionValue for `brancher`.
   OptionValue<Brancher>& mutable_brancher();
 
+  /// Returns the heuristic to choose a branching dimension in ICP.
+  BranchingHeuristic branching_heuristic() const;
+
+  /// Returns a mutable OptionValue for 'branching_heuristic'.
+  OptionValue<BranchingHeuristic>& mutable_branching_heuristic();
+
   /// @name NLopt Options
   ///
   /// Specifies stopping criteria of NLopt. See
@@ -122,6 +193,51 @@ class Config {
   /// Returns a mutable OptionValue for `sat_default_phase`.
   OptionValue<SatDefaultPhase>& mutable_sat_default_phase();
 
+  /// The SAT solver backends. See MakeSatBackend.
+  enum class SatBackendType {
+    Picosat = 0,  // Default option
+    Assumption = 1
+  };
+
+  /// Returns the backend of the SAT solver.
+  SatBackendType sat_backend() const;
+
+  /// Returns a mutable OptionValue for `sat_backend`.
+  OptionValue<SatBackendType>& mutable_sat_backend();
+
+  /// Returns whether the Tseitin transformation only encodes the
+  /// directions of the definitions required by the polarities of the
+  /// subformulas (Plaisted-Greenbaum transformation). See TseitinCnfizer.
+  bool use_polarity_aware_cnf() const;
+
+  /// Returns a mutable OptionValue for 'use_polarity_aware_cnf'.
+  OptionValue<bool>& mutable_use_polarity_aware_cnf();
+
+  /// Returns the number of decisions of the SAT solver between the
+  /// consultations of the theory solver on partial assignments. The
+  /// theory solver runs only cheap checks, FilterAssertion and one pass
+  /// of the contractors, on them. 0 disables it.
+  int theory_propagation_interval() const;
+
+  /// Returns a mutable OptionValue for `theory_propagation_interval`.
+  OptionValue<int>& mutable_theory_propagation_interval();
+
+  /// Returns the time budget, in seconds, to minimize each explanation
+  /// of a theory conflict before it is learned by the SAT solver. 0
+  /// disables the minimization. See TheorySolver.
+  double explanation_minimization_budget() const;
+
+  /// Returns a mutable OptionValue for `explanation_minimization_budget`.
+  OptionValue<double>& mutable_explanation_minimization_budget();
+
+  /// Returns the maximum number of the theory lemmas which are kept
+  /// across Push/Pop and added to the SAT solver again after the scope
+  /// which learned them is popped. 0 disables it. See TheoryLemmaStore.
+  int theory_lemma_store_size() const;
+
+  /// Returns a mutable OptionValue for `theory_lemma_store_size`.
+  OptionValue<int>& mutable_theory_lemma_store_size();
+
   /// Returns the random seed.
   uint32_t random_seed() const;
 
@@ -151,7 +267,15 @@ class Config {
   OptionValue<bool> use_polytope_in_forall_{false};
   OptionValue<bool> use_worklist_fixpoint_{false};
   OptionValue<bool> use_local_optimization_{false};
+  OptionValue<bool> use_symbolic_arena_{false};
+  OptionValue<bool> use_theory_result_cache_{false};
+  OptionValue<bool> use_incremental_theory_solver_{false};
+  OptionValue<bool> use_pipelined_theory_solver_{false};
   OptionValue<int> number_of_jobs_{1};
+  OptionValue<bool> use_deterministic_icp_{false};
+  OptionValue<bool> use_cost_based_evaluation_order_{false};
+  OptionValue<int> icp_batch_size_{0};
+  OptionValue<EnclosureMode> enclosure_mode_{EnclosureMode::Natural};
   OptionValue<bool> stack_left_box_first_{false};
   OptionValue<bool> smtlib2_compliant_{false};
 
@@ -199,15 +323,37 @@ class Config {
   OptionValue<SatDefaultPhase> sat_default_phase_{
       SatDefaultPhase::JeroslowWang};
 
+  // Backend of the SAT solver. The default uses picosat_push/pop.
+  OptionValue<SatBackendType> sat_backend_{SatBackendType::Picosat};
+
+  // If true, use the Plaisted-Greenbaum transformation in TseitinCnfizer.
+  OptionValue<bool> use_polarity_aware_cnf_{false};
+
+  // The number of SAT decisions between theory propagations.
+  OptionValue<int> theory_propagation_interval_{0};
+
+  // Time budget (in seconds) to minimize an explanation.
+  OptionValue<double> explanation_minimization_budget_{0.0};
+
+  // The maximum number of the lemmas in TheoryLemmaStore.
+  OptionValue<int> theory_lemma_store_size_{0};
+
   // Seed for Random Number Generator.
   OptionValue<uint32_t> random_seed_{0};
 
   // Brancher to use. By default it uses `BranchLargestFirst`.
   OptionValue<Brancher> brancher_{BranchLargestFirst};
+
+  // Branching heuristic. The default uses `brancher_`.
+  OptionValue<BranchingHeuristic> branching_heuristic_{
+      BranchingHeuristic::LargestFirst};
 };
 std::ostream& operator<<(std::ostream& os,
                          const Config::SatDefaultPhase& sat_default_phase);
 
+std::ostream& operator<<(std::ostream& os,
+                         const Config::SatBackendType& sat_backend);
+
 std::ostream& operator<<(std::ostream& os, const Config& config);
 
 }  // namespace dreal
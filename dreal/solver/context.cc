@@ -26,6 +26,10 @@ void Context::Assert(const Formula& f) { impl_->Assert(f); }
 
 optional<Box> Context::CheckSat() { return impl_->CheckSat(); }
 
+optional<Box> Context::CheckSatAssuming(const vector<Formula>& assumptions) {
+  return impl_->CheckSatAssuming(assumptions);
+}
+
 void Context::DeclareVariable(const Variable& v, const bool is_model_variable) {
   impl_->DeclareVariable(v, is_model_variable);
 }
@@ -104,6 +108,10 @@ const Box& Context::box() const { return impl_->box(); }
 
 const Box& Context::get_model() const { return impl_->get_model(); }
 
+const vector<Formula>& Context::get_unsat_assumptions() const {
+  return impl_->get_unsat_assumptions();
+}
+
 const ScopedVector<Formula>& Context::assertions() const {
   return impl_->assertions();
 }
@@ -49,6 +49,14 @@ class Context {
   /// Checks the satisfiability of the asserted formulas.
   optional<Box> CheckSat();
 
+  /// Checks the satisfiability of the asserted formulas together with
+  /// @p assumptions. Unlike Push/Assert/Pop, the assumptions are not
+  /// asserted. So the SAT solver and the theory solver keep their states
+  /// (learned clauses and caches) over the calls. If it is UNSAT,
+  /// get_unsat_assumptions() returns a subset of @p assumptions which is
+  /// UNSAT with the asserted formulas.
+  optional<Box> CheckSatAssuming(const std::vector<Formula>& assumptions);
+
   /// Declare a variable @p v. By default @p v is considered as a
   /// model variable. If @p is_model_variable is false, it is declared as
   /// a non-model variable and will not appear in the model.
@@ -125,6 +133,10 @@ class Context {
   /// response to an invocation of the check-sat.
   const Box& get_model() const;
 
+  /// Returns the subset of the assumptions which are used to show UNSAT
+  /// in the last call of CheckSatAssuming.
+  const std::vector<Formula>& get_unsat_assumptions() const;
+
  private:
   // This header is exposed to external users as a part of API. We use
   // PIMPL idiom to hide internals and to reduce number of '#includes' in this
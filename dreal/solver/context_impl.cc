@@ -17,11 +17,13 @@
 #include "dreal/util/if_then_else_eliminator.h"
 #include "dreal/util/interrupt.h"
 #include "dreal/util/logging.h"
+#include "dreal/util/math.h"
 
 namespace dreal {
 
 using std::find_if;
 using std::isfinite;
+using std::make_unique;
 using std::ostringstream;
 using std::pair;
 using std::set;
@@ -69,18 +71,73 @@ bool ParseBooleanOption(const string& key, const string& val) {
   throw DREAL_RUNTIME_ERROR("Unknown value {} is provided for option {}", val,
                             key);
 }
+
+EnclosureMode ParseEnclosureModeOption(const string& key, const string& val) {
+  if (val == "natural") {
+    return EnclosureMode::Natural;
+  }
+  if (val == "mean-value") {
+    return EnclosureMode::MeanValue;
+  }
+  if (val == "affine") {
+    return EnclosureMode::Affine;
+  }
+  if (val == "taylor") {
+    return EnclosureMode::Taylor;
+  }
+  if (val == "adaptive") {
+    return EnclosureMode::Adaptive;
+  }
+  throw DREAL_RUNTIME_ERROR("Unknown value {} is provided for option {}", val,
+                            key);
+}
+
+BranchingHeuristic ParseBranchingHeuristicOption(const string& key,
+                                                 const string& val) {
+  if (val == "largest-first") {
+    return BranchingHeuristic::LargestFirst;
+  }
+  if (val == "smear") {
+    return BranchingHeuristic::SmearSumRelative;
+  }
+  if (val == "round-robin") {
+    return BranchingHeuristic::RoundRobin;
+  }
+  if (val == "max-impact") {
+    return BranchingHeuristic::MaxImpact;
+  }
+  if (val == "hybrid") {
+    return BranchingHeuristic::Hybrid;
+  }
+  throw DREAL_RUNTIME_ERROR("Unknown value {} is provided for option {}", val,
+                            key);
+}
+
+Config::SatBackendType ParseSatBackendOption(const string& key,
+                                             const string& val) {
+  if (val == "picosat") {
+    return Config::SatBackendType::Picosat;
+  }
+  if (val == "assumption") {
+    return Config::SatBackendType::Assumption;
+  }
+  throw DREAL_RUNTIME_ERROR("Unknown value {} is provided for option {}", val,
+                            key);
+}
 }  // namespace
 
 Context::Impl::Impl() : Impl{Config{}} {}
 
 Context::Impl::Impl(Config config)
     : config_{std::move(config)},
-      sat_solver_{config_},
-      theory_solver_{config_} {
+      sat_solver_{make_unique<SatSolver>(config_)},
+      theory_solver_{config_},
+      theory_lemma_store_{config_} {
   boxes_.push_back(Box{});
 }
 
 void Context::Impl::Assert(const Formula& f) {
+  const SymbolicArena::Scope arena_scope{arena()};
   if (is_true(f)) {
     return;
   }
@@ -100,7 +157,7 @@ void Context::Impl::Assert(const Formula& f) {
       AddToBox(ite_var);
     }
     stack_.push_back(no_ite);
-    sat_solver_.AddFormula(no_ite);
+    sat_solver_->AddFormula(no_ite);
     return;
   } else {
     DREAL_LOG_DEBUG("ContextImpl::Assert: {} is not added.", f);
@@ -128,38 +185,56 @@ optional<Box> Context::Impl::CheckSatCore(const ScopedVector<Formula>& stack,
     DREAL_LOG_DEBUG("ContextImpl::CheckSatCore() - Found Model\n{}", box);
     return box;
   }
+  const int learned_clause_level{LearnedClauseLevel()};
+  if (config_.theory_lemma_store_size() > 0 &&
+      sat_solver == sat_solver_.get()) {
+    // The lemmas learned before the last Pop() which still hold.
+    theory_lemma_store_.Reinstate(
+        boxes_.last(), [sat_solver, learned_clause_level](
+                           const set<Formula>& lemma) {
+          return sat_solver->HasLiveAtoms(lemma)
+                     ? sat_solver->AddLearnedClause(lemma,
+                                                    learned_clause_level)
+                     : -1;
+        });
+  }
+  if (config_.use_pipelined_theory_solver()) {
+    return CheckSatPipelined(std::move(box), sat_solver, learned_clause_level);
+  }
   while (true) {
-    // Note that 'DREAL_CHECK_INTERRUPT' is only defined in setup.py,
-    // when we build dReal python package.
-#ifdef DREAL_CHECK_INTERRUPT
-    if (g_interrupted) {
-      DREAL_LOG_DEBUG("KeyboardInterrupt(SIGINT) Detected.");
-      throw std::runtime_error("KeyboardInterrupt(SIGINT) Detected.");
-    }
-#endif
-
-    const auto optional_model = sat_solver->CheckSat();
+    CheckInterrupt();
+    const auto optional_model = CheckSatBoolean(box, sat_solver);
     if (optional_model) {
-      const vector<pair<Variable, bool>>& boolean_model{optional_model->first};
-      for (const pair<Variable, bool>& p : boolean_model) {
-        box[p.first] = p.second ? 1.0 : 0.0;  // true -> 1.0 and false -> 0.0
-      }
-      const vector<pair<Variable, bool>>& theory_model{optional_model->second};
-      if (!theory_model.empty()) {
+      const vector<Formula> assertions{
+          ApplyBooleanModel(*optional_model, *sat_solver, &box)};
+      if (!assertions.empty()) {
         // SAT from SATSolver.
         DREAL_LOG_DEBUG("ContextImpl::CheckSatCore() - Sat Check = SAT");
-
-        vector<Formula> assertions;
-        assertions.reserve(theory_model.size());
-        for (const pair<Variable, bool>& p : theory_model) {
-          assertions.push_back(p.second ? sat_solver->theory_literal(p.first)
-                                        : !sat_solver->theory_literal(p.first));
+        if (config_.use_theory_result_cache()) {
+          // Skip the theory solver if the result is known.
+          optional<set<Formula>> core{
+              theory_result_cache_.FindUnsatCore(box, assertions)};
+          if (core) {
+            DREAL_LOG_DEBUG(
+                "ContextImpl::CheckSatCore() - Theory Cache = UNSAT");
+            LearnLemma(*core, learned_clause_level, sat_solver);
+            continue;
+          }
+          optional<Box> model{theory_result_cache_.FindModel(box, assertions)};
+          if (model) {
+            DREAL_LOG_DEBUG(
+                "ContextImpl::CheckSatCore() - Theory Cache = delta-SAT");
+            return model;
+          }
         }
         if (theory_solver_.CheckSat(box, assertions)) {
           // SAT from TheorySolver.
           DREAL_LOG_DEBUG(
               "ContextImpl::CheckSatCore() - Theroy Check = delta-SAT");
           Box model{theory_solver_.GetModel()};
+          if (config_.use_theory_result_cache()) {
+            theory_result_cache_.AddModel(box, assertions, model);
+          }
           return model;
         } else {
           // UNSAT from TheorySolver.
@@ -169,7 +244,10 @@ optional<Box> Context::Impl::CheckSatCore(const ScopedVector<Formula>& stack,
               "ContextImpl::CheckSatCore() - size of explanation = {} - stack "
               "size = {}",
               explanation.size(), stack.get_vector().size());
-          sat_solver->AddLearnedClause(explanation);
+          if (config_.use_theory_result_cache()) {
+            theory_result_cache_.AddUnsatCore(box, explanation);
+          }
+          LearnLemma(explanation, learned_clause_level, sat_solver);
         }
       } else {
         return box;
@@ -182,8 +260,216 @@ optional<Box> Context::Impl::CheckSatCore(const ScopedVector<Formula>& stack,
   }
 }
 
+optional<Box> Context::Impl::CheckSatPipelined(
+    Box box, SatSolver* const sat_solver, const int learned_clause_level) {
+  DREAL_LOG_DEBUG("ContextImpl::CheckSatPipelined()");
+  TheoryPipeline pipeline{config_};
+  // A model is blocked while it is checked, so that the SAT solver finds
+  // another one. The blocking clauses are not lemmas, and they are
+  // retracted when this call returns.
+  sat_solver->Push();
+  const int blocking_clause_level{sat_solver->level()};
+  optional<Box> result;
+  bool sat_exhausted{false};
+  try {
+    while (!result) {
+      CheckInterrupt();
+      if (!sat_exhausted && !pipeline.is_full()) {
+        const auto optional_model = CheckSatBoolean(box, sat_solver);
+        if (!optional_model) {
+          // The remaining models, if any, are in the pipeline.
+          DREAL_LOG_DEBUG("ContextImpl::CheckSatPipelined() - Sat Check = "
+                          "UNSAT");
+          sat_exhausted = true;
+          continue;
+        }
+        vector<Formula> assertions{
+            ApplyBooleanModel(*optional_model, *sat_solver, &box)};
+        if (assertions.empty()) {
+          result = box;
+          break;
+        }
+        if (config_.use_theory_result_cache()) {
+          optional<set<Formula>> core{
+              theory_result_cache_.FindUnsatCore(box, assertions)};
+          if (core) {
+            LearnLemma(*core, learned_clause_level, sat_solver);
+            continue;
+          }
+          result = theory_result_cache_.FindModel(box, assertions);
+          if (result) {
+            break;
+          }
+        }
+        sat_solver->AddLearnedClause(
+            set<Formula>(assertions.begin(), assertions.end()),
+            blocking_clause_level);
+        pipeline.Submit(box, std::move(assertions));
+        continue;
+      }
+      if (pipeline.num_running() == 0) {
+        // UNSAT. Every model is refuted.
+        break;
+      }
+      TheoryPipeline::Result theory_result{pipeline.Take()};
+      if (theory_result.model) {
+        DREAL_LOG_DEBUG(
+            "ContextImpl::CheckSatPipelined() - Theory Check = delta-SAT");
+        if (config_.use_theory_result_cache()) {
+          theory_result_cache_.AddModel(theory_result.box,
+                                        theory_result.assertions,
+                                        *theory_result.model);
+        }
+        result = std::move(theory_result.model);
+      } else {
+        DREAL_LOG_DEBUG(
+            "ContextImpl::CheckSatPipelined() - Theory Check = UNSAT");
+        if (config_.use_theory_result_cache()) {
+          theory_result_cache_.AddUnsatCore(theory_result.box,
+                                            theory_result.explanation);
+        }
+        LearnLemma(theory_result.explanation, learned_clause_level,
+                   sat_solver);
+      }
+    }
+  } catch (...) {
+    sat_solver->Pop();
+    throw;
+  }
+  sat_solver->Pop();
+  return result;
+}
+
+optional<SatSolver::Model> Context::Impl::CheckSatBoolean(
+    const Box& box, SatSolver* const sat_solver) {
+  if (config_.theory_propagation_interval() > 0) {
+    return sat_solver->CheckSat(
+        config_.theory_propagation_interval(),
+        [this, &box](const vector<Formula>& assigned,
+                     const vector<Formula>& unassigned) {
+          return theory_solver_.Propagate(box, assigned, unassigned);
+        });
+  }
+  return sat_solver->CheckSat();
+}
+
+vector<Formula> Context::Impl::ApplyBooleanModel(const SatSolver::Model& model,
+                                                 const SatSolver& sat_solver,
+                                                 Box* const box) {
+  const vector<pair<Variable, bool>>& boolean_model{model.first};
+  for (const pair<Variable, bool>& p : boolean_model) {
+    (*box)[p.first] = p.second ? 1.0 : 0.0;  // true -> 1.0 and false -> 0.0
+  }
+  const vector<pair<Variable, bool>>& theory_model{model.second};
+  vector<Formula> assertions;
+  assertions.reserve(theory_model.size());
+  for (const pair<Variable, bool>& p : theory_model) {
+    assertions.push_back(p.second ? sat_solver.theory_literal(p.first)
+                                  : !sat_solver.theory_literal(p.first));
+  }
+  return assertions;
+}
+
+void Context::Impl::CheckInterrupt() {
+  // Note that 'DREAL_CHECK_INTERRUPT' is only defined in setup.py,
+  // when we build dReal python package.
+#ifdef DREAL_CHECK_INTERRUPT
+  if (g_interrupted) {
+    DREAL_LOG_DEBUG("KeyboardInterrupt(SIGINT) Detected.");
+    throw std::runtime_error("KeyboardInterrupt(SIGINT) Detected.");
+  }
+#endif
+}
+
+void Context::Impl::LearnLemma(const set<Formula>& lemma, const int level,
+                               SatSolver* const sat_solver) {
+  const int added_level{sat_solver->AddLearnedClause(lemma, level)};
+  if (config_.theory_lemma_store_size() > 0 &&
+      sat_solver == sat_solver_.get()) {
+    theory_lemma_store_.Add(boxes_.last(), lemma, added_level);
+  }
+}
+
 optional<Box> Context::Impl::CheckSat() {
-  auto result = CheckSatCore(stack_, box(), &sat_solver_);
+  const SymbolicArena::Scope arena_scope{arena()};
+  return UpdateModel(CheckSatCore(stack_, box(), sat_solver_.get()));
+}
+
+optional<Box> Context::Impl::CheckSatAssuming(
+    const vector<Formula>& assumptions) {
+  const SymbolicArena::Scope arena_scope{arena()};
+  DREAL_LOG_DEBUG("ContextImpl::CheckSatAssuming(#assumptions = {})",
+                  assumptions.size());
+  unsat_assumptions_.clear();
+  // CheckSatCore looks at the stack to detect the trivial cases.
+  ScopedVector<Formula> stack{stack_};
+  // The literals passed to the SAT solver and their assumptions.
+  vector<pair<Formula, Formula>> literals;
+  for (const Formula& f : assumptions) {
+    if (is_true(f)) {
+      continue;
+    }
+    if (is_false(f)) {
+      unsat_assumptions_.push_back(f);
+      return UpdateModel({});
+    }
+    stack.push_back(f);
+    literals.emplace_back(Formula{AssumptionLiteral(f)}, f);
+  }
+  vector<Formula> sat_assumptions;
+  for (const auto& p : literals) {
+    sat_assumptions.push_back(p.first);
+  }
+  sat_solver_->SetAssumptions(sat_assumptions);
+  optional<Box> result;
+  // True if the failed assumptions of the SAT solver are not known.
+  bool all_failed{false};
+  try {
+    result = CheckSatCore(stack, box(), sat_solver_.get());
+    // The last UNSAT of the SAT solver in CheckSatPipelined may depend on
+    // the blocking clauses, which are retracted now. Check it again with
+    // the learned clauses only.
+    if (!result && config_.use_pipelined_theory_solver()) {
+      all_failed = static_cast<bool>(sat_solver_->CheckSat());
+    }
+  } catch (...) {
+    sat_solver_->SetAssumptions({});
+    throw;
+  }
+  if (!result) {
+    const vector<Formula>& failed{sat_solver_->failed_assumptions()};
+    for (const auto& p : literals) {
+      if (all_failed ||
+          std::any_of(failed.begin(), failed.end(), [&p](const Formula& l) {
+            return l.EqualTo(p.first);
+          })) {
+        unsat_assumptions_.push_back(p.second);
+      }
+    }
+  }
+  sat_solver_->SetAssumptions({});
+  return UpdateModel(std::move(result));
+}
+
+Variable Context::Impl::AssumptionLiteral(const Formula& f) {
+  const auto it = assumption_literals_.find(f);
+  if (it != assumption_literals_.end()) {
+    return it->second;
+  }
+  const Variable b{"assumption", Variable::Type::BOOLEAN};
+  // Note that b is not a model variable.
+  AddToBox(b);
+  IfThenElseEliminator ite_eliminator;
+  const Formula no_ite{ite_eliminator.Process(imply(b, f))};
+  for (const Variable& ite_var : ite_eliminator.variables()) {
+    AddToBox(ite_var);
+  }
+  sat_solver_->AddFormula(no_ite);
+  assumption_literals_.insert(f, b);
+  return b;
+}
+
+optional<Box> Context::Impl::UpdateModel(optional<Box> result) {
   if (result) {
     // In case of delta-sat, do post-processing.
     Tighten(&(*result), config_.precision());
@@ -226,6 +512,7 @@ void Context::Impl::SetDomain(const Variable& v, const Expression& lb,
 }
 
 void Context::Impl::Minimize(const vector<Expression>& functions) {
+  const SymbolicArena::Scope arena_scope{arena()};
   // Given objective functions f₁(x), ... fₙ(x) and the current
   // constraints ϕᵢ which involves x. this method encodes them into a
   // universally quantified formula ψ:
@@ -304,18 +591,30 @@ void Context::Impl::Minimize(const vector<Expression>& functions) {
   return Assert(psi);
 }
 
+int Context::Impl::LearnedClauseLevel() const {
+  // boxes_[i] is the box of the scope at level i.
+  int level{static_cast<int>(boxes_.size()) - 1};
+  while (level > 0 && boxes_[level - 1] == boxes_.last()) {
+    --level;
+  }
+  return level;
+}
+
 void Context::Impl::Pop() {
   DREAL_LOG_DEBUG("ContextImpl::Pop()");
   stack_.pop();
+  assumption_literals_.pop();
   boxes_.pop();
-  sat_solver_.Pop();
+  sat_solver_->Pop();
+  theory_lemma_store_.Pop(sat_solver_->level());
 }
 
 void Context::Impl::Push() {
   DREAL_LOG_DEBUG("ContextImpl::Push()");
-  sat_solver_.Push();
+  sat_solver_->Push();
   boxes_.push();
   boxes_.push_back(boxes_.last());
+  assumption_literals_.push();
   stack_.push();
 }
 
@@ -351,6 +650,48 @@ void Context::Impl::SetOption(const string& key, const double val) {
     }
     return config_.mutable_precision().set_from_file(val);
   }
+  if (key == ":explanation-minimization-budget" ||
+      key == ":explanation_minimization_budget") {
+    if (val < 0.0) {
+      throw DREAL_RUNTIME_ERROR(
+          "Explanation minimization budget has to be non-negative "
+          "(input = {}).",
+          val);
+    }
+    return config_.mutable_explanation_minimization_budget().set_from_file(
+        val);
+  }
+  if (key == ":theory-propagation-interval" ||
+      key == ":theory_propagation_interval") {
+    if (val < 0.0 || !is_integer(val)) {
+      throw DREAL_RUNTIME_ERROR(
+          "Theory propagation interval has to be a non-negative integer "
+          "(input = {}).",
+          val);
+    }
+    return config_.mutable_theory_propagation_interval().set_from_file(
+        static_cast<int>(val));
+  }
+  if (key == ":theory-lemma-store-size" ||
+      key == ":theory_lemma_store_size") {
+    if (val < 0.0 || !is_integer(val)) {
+      throw DREAL_RUNTIME_ERROR(
+          "Theory lemma store size has to be a non-negative integer "
+          "(input = {}).",
+          val);
+    }
+    return config_.mutable_theory_lemma_store_size().set_from_file(
+        static_cast<int>(val));
+  }
+  if (key == ":icp-batch-size" || key == ":icp_batch_size") {
+    if (val < 0.0 || !is_integer(val)) {
+      throw DREAL_RUNTIME_ERROR(
+          "ICP batch size has to be a non-negative integer (input = {}).",
+          val);
+    }
+    return config_.mutable_icp_batch_size().set_from_file(
+        static_cast<int>(val));
+  }
 }
 
 optional<string> Context::Impl::GetOption(const string& key) const {
@@ -389,10 +730,65 @@ void Context::Impl::SetOption(const string& key, const string& val) {
     return config_.mutable_produce_models().set_from_file(
         ParseBooleanOption(key, val));
   }
+  if (key == ":symbolic-arena" || key == ":symbolic_arena") {
+    return config_.mutable_use_symbolic_arena().set_from_file(
+        ParseBooleanOption(key, val));
+  }
+  if (key == ":deterministic") {
+    return config_.mutable_use_deterministic_icp().set_from_file(
+        ParseBooleanOption(key, val));
+  }
+  if (key == ":cost-based-order" || key == ":cost_based_order") {
+    return config_.mutable_use_cost_based_evaluation_order().set_from_file(
+        ParseBooleanOption(key, val));
+  }
+  if (key == ":theory-cache" || key == ":theory_cache") {
+    return config_.mutable_use_theory_result_cache().set_from_file(
+        ParseBooleanOption(key, val));
+  }
+  if (key == ":incremental-theory" || key == ":incremental_theory") {
+    return config_.mutable_use_incremental_theory_solver().set_from_file(
+        ParseBooleanOption(key, val));
+  }
+  if (key == ":pipelined-theory" || key == ":pipelined_theory") {
+    return config_.mutable_use_pipelined_theory_solver().set_from_file(
+        ParseBooleanOption(key, val));
+  }
   if (key == ":smtlib2-compliant" || key == ":smtlib2_compliant") {
     return config_.mutable_smtlib2_compliant().set_from_file(
         ParseBooleanOption(key, val));
   }
+  if (key == ":enclosure-mode" || key == ":enclosure_mode") {
+    return config_.mutable_enclosure_mode().set_from_file(
+        ParseEnclosureModeOption(key, val));
+  }
+  if (key == ":brancher") {
+    return config_.mutable_branching_heuristic().set_from_file(
+        ParseBranchingHeuristicOption(key, val));
+  }
+  if (key == ":sat-backend" || key == ":sat_backend") {
+    const Config::SatBackendType sat_backend{ParseSatBackendOption(key, val)};
+    CheckSatSolverIsUnused(key);
+    config_.mutable_sat_backend().set_from_file(sat_backend);
+    sat_solver_ = make_unique<SatSolver>(config_);
+    return;
+  }
+  if (key == ":polarity-aware-cnf" || key == ":polarity_aware_cnf") {
+    const bool use_polarity_aware_cnf{ParseBooleanOption(key, val)};
+    CheckSatSolverIsUnused(key);
+    config_.mutable_use_polarity_aware_cnf().set_from_file(
+        use_polarity_aware_cnf);
+    sat_solver_ = make_unique<SatSolver>(config_);
+    return;
+  }
+}
+
+void Context::Impl::CheckSatSolverIsUnused(const string& key) const {
+  if (!sat_solver_->empty()) {
+    throw DREAL_RUNTIME_ERROR(
+        "Option {} needs to be set before the first assertion and push.",
+        key);
+  }
 }
 
 Box Context::Impl::ExtractModel(const Box& box) const {
@@ -409,6 +805,13 @@ Box Context::Impl::ExtractModel(const Box& box) const {
   return new_box;
 }
 
+SymbolicArena* Context::Impl::arena() {
+  if (!arena_ && config_.use_symbolic_arena()) {
+    arena_ = make_unique<SymbolicArena>();
+  }
+  return arena_.get();
+}
+
 bool Context::Impl::is_model_variable(const Variable& v) const {
   return (model_variables_.find(v.get_id()) != model_variables_.end());
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -7,8 +9,12 @@
 
 #include "dreal/solver/context.h"
 #include "dreal/solver/sat_solver.h"
+#include "dreal/solver/theory_lemma_store.h"
+#include "dreal/solver/theory_pipeline.h"
+#include "dreal/solver/theory_result_cache.h"
 #include "dreal/solver/theory_solver.h"
 #include "dreal/util/optional.h"
+#include "dreal/util/scoped_unordered_map.h"
 #include "dreal/util/scoped_vector.h"
 
 namespace dreal {
@@ -26,6 +32,7 @@ class Context::Impl {
 
   void Assert(const Formula& f);
   optional<Box> CheckSat();
+  optional<Box> CheckSatAssuming(const std::vector<Formula>& assumptions);
   void DeclareVariable(const Variable& v, bool is_model_variable);
   void SetDomain(const Variable& v, const Expression& lb, const Expression& ub);
   void Minimize(const std::vector<Expression>& functions);
@@ -43,6 +50,9 @@ class Context::Impl {
   const ScopedVector<Formula>& assertions() const;
   Box& box() { return boxes_.last(); }
   const Box& get_model() { return model_; }
+  const std::vector<Formula>& get_unsat_assumptions() const {
+    return unsat_assumptions_;
+  }
 
  private:
   // Add the variable @p v to the current box. This is used to
@@ -52,10 +62,62 @@ class Context::Impl {
   // should not call it directly.
   void AddToBox(const Variable& v);
 
+  // Post-processes @p result of CheckSatCore and stores it in model_.
+  optional<Box> UpdateModel(optional<Box> result);
+
+  // Returns a Boolean variable b which is asserted to imply @p f. The
+  // assumption f is passed to the SAT solver as b.
+  Variable AssumptionLiteral(const Formula& f);
+
   // Returns the current box in the stack.
   optional<Box> CheckSatCore(const ScopedVector<Formula>& stack, Box box,
                              SatSolver* sat_solver);
 
+  // Checks the Boolean models from @p sat_solver on the workers of a
+  // TheoryPipeline while @p sat_solver keeps searching for other models.
+  // The first delta-SAT model found wins, and the explanations of the
+  // UNSAT ones are learned at @p learned_clause_level. It is used if
+  // `config().use_pipelined_theory_solver()` is true.
+  //
+  // @note It waits for the running theory checks before it returns.
+  optional<Box> CheckSatPipelined(Box box, SatSolver* sat_solver,
+                                  int learned_clause_level);
+
+  // Finds a Boolean model of @p sat_solver. If
+  // `config().theory_propagation_interval()` is positive, it consults
+  // the theory solver over @p box during the search.
+  optional<SatSolver::Model> CheckSatBoolean(const Box& box,
+                                             SatSolver* sat_solver);
+
+  // Assigns the Boolean variables in @p box by @p model, and returns
+  // the theory literals in @p model.
+  static std::vector<Formula> ApplyBooleanModel(const SatSolver::Model& model,
+                                                const SatSolver& sat_solver,
+                                                Box* box);
+
+  // Throws if the user interrupted the process.
+  static void CheckInterrupt();
+
+  // Learns @p lemma, which is found over the current box, at @p level of
+  // @p sat_solver. It is also kept in theory_lemma_store_ if
+  // `config().theory_lemma_store_size()` is positive.
+  void LearnLemma(const std::set<Formula>& lemma, int level,
+                  SatSolver* sat_solver);
+
+  // Returns the level of the outermost scope whose box is the same as
+  // the current one. The theory lemmas learned over the current box hold
+  // in that scope, so they are learned there and survive Pop().
+  int LearnedClauseLevel() const;
+
+  // Returns the arena for symbolic cells built in this context, or nullptr
+  // if `config().use_symbolic_arena()` is false. The arena is created on
+  // the first call.
+  SymbolicArena* arena();
+
+  // Throws if sat_solver_ is already in use, so that an option @p key
+  // which it reads at its construction cannot take effect anymore.
+  void CheckSatSolverIsUnused(const std::string& key) const;
+
   // Marks variable @p v as a model variable
   void mark_model_variable(const Variable& v);
 
@@ -68,6 +130,11 @@ class Context::Impl {
   // those non-model variables.
   Box ExtractModel(const Box& box) const;
 
+  // It is declared first so that it outlives the other members which hold
+  // symbolic cells. Then, its chunks are released in bulk when this context
+  // is destroyed.
+  std::unique_ptr<SymbolicArena> arena_;
+
   Config config_;
   optional<Logic> logic_{};
   std::unordered_map<std::string, std::string> info_;
@@ -77,13 +144,25 @@ class Context::Impl {
   ScopedVector<Box> boxes_;
   // Stack of asserted formulas.
   ScopedVector<Formula> stack_;
-  SatSolver sat_solver_;
+  // Maps an assumption of CheckSatAssuming to its Boolean variable.
+  ScopedUnorderedMap<Formula, Variable> assumption_literals_;
+  // It is rebuilt if an option which it reads is set before its use.
+  std::unique_ptr<SatSolver> sat_solver_;
   std::unordered_set<Variable::Id> model_variables_;
   TheorySolver theory_solver_;
+  // Results of theory_solver_. It is used if
+  // `config().use_theory_result_cache()` is true.
+  TheoryResultCache theory_result_cache_;
+  // The lemmas learned in sat_solver_, which are learned again after
+  // Pop(). It is used if `config().theory_lemma_store_size()` is positive.
+  TheoryLemmaStore theory_lemma_store_;
 
   // Stores the result of the latest checksat.
   // Note that if the checksat result was UNSAT, this box holds an empty box.
   Box model_;
+
+  // The assumptions used to show UNSAT in the latest CheckSatAssuming.
+  std::vector<Formula> unsat_assumptions_;
 };
 
 }  // namespace dreal
@@ -2,7 +2,9 @@
 
 #include <algorithm>  // to suppress cpplint for the use of 'min'
 #include <numeric>
+#include <stdexcept>
 #include <utility>
+#include <vector>
 
 #include "dreal/util/assert.h"
 #include "dreal/util/exception.h"
@@ -12,14 +14,102 @@
 namespace dreal {
 
 using std::accumulate;
+using std::make_unique;
 using std::pair;
-
-ExpressionEvaluator::ExpressionEvaluator(Expression e) : e_{std::move(e)} {}
+using std::vector;
+
+namespace {
+// Scratch buffer for the values of the instructions of a tape. It is
+// reused by all the evaluators in a thread.
+thread_local vector<Box::Interval> tape_values;
+
+// Scratch buffer for the inputs of an enclosure.
+thread_local vector<Box::Interval> enclosure_inputs;
+}  // namespace
+
+ExpressionEvaluator::ExpressionEvaluator(Expression e, const EnclosureMode mode)
+    : e_{std::move(e)} {
+  try {
+    tape_ = make_unique<const ExpressionTape>(e_);
+  } catch (const std::runtime_error&) {
+    // Unsupported expression. See VisitIfThenElse and
+    // VisitUninterpretedFunction.
+    return;
+  }
+  box_index_ = vector<std::atomic<int>>(tape_->variables().size());
+  for (std::atomic<int>& index : box_index_) {
+    index.store(-1, std::memory_order_relaxed);
+  }
+  if (mode != EnclosureMode::Natural) {
+    enclosure_ =
+        make_unique<const IntervalEnclosure>(e_, tape_->variables(), mode);
+  }
+}
 
 Box::Interval ExpressionEvaluator::operator()(const Box& box) const {
+  if (enclosure_) {
+    return EvaluateEnclosure(box);
+  }
+  if (tape_) {
+    return EvaluateTape(box);
+  }
   return Visit(e_, box);
 }
 
+int ExpressionEvaluator::BoxIndex(const int i, const Box& box) const {
+  const Variable& var{tape_->variables()[i]};
+  int index{box_index_[i].load(std::memory_order_relaxed)};
+  if (index < 0 || index >= box.size() ||
+      !box.variables()[index].equal_to(var)) {
+    index = box.index(var);
+    box_index_[i].store(index, std::memory_order_relaxed);
+  }
+  return index;
+}
+
+Box::Interval ExpressionEvaluator::EvaluateTape(const Box& box) const {
+  using Op = ExpressionTape::Op;
+  const vector<ExpressionTape::Instruction>& instructions{
+      tape_->instructions()};
+  if (tape_values.size() < instructions.size()) {
+    tape_values.resize(instructions.size());
+  }
+  Box::Interval* const v{tape_values.data()};
+  for (size_t i = 0; i < instructions.size(); ++i) {
+    const ExpressionTape::Instruction& inst{instructions[i]};
+    switch (inst.op) {
+      case Op::Var:
+        v[i] = box[BoxIndex(inst.arg1, box)];
+        break;
+      case Op::Pow: {
+        // As in VisitPow, use the tighter versions of pow if the
+        // exponent is a point.
+        const Box::Interval& exponent{v[inst.arg2]};
+        if (exponent.is_degenerated() && !exponent.is_empty()) {
+          v[i] = internal::PowConstant(v[inst.arg1], exponent.lb());
+        } else {
+          v[i] = pow(v[inst.arg1], exponent);
+        }
+        break;
+      }
+      default:
+        v[i] = ExpressionTape::Evaluate<Box::Interval>(inst, v, nullptr);
+    }
+  }
+  return v[tape_->outputs()[0]];
+}
+
+Box::Interval ExpressionEvaluator::EvaluateEnclosure(const Box& box) const {
+  const int n{static_cast<int>(box_index_.size())};
+  if (enclosure_inputs.size() < box_index_.size()) {
+    enclosure_inputs.resize(box_index_.size());
+  }
+  for (int i = 0; i < n; ++i) {
+    enclosure_inputs[i] = box[BoxIndex(i, box)];
+  }
+  return (*enclosure_)(enclosure_inputs.data());
+}
+
 Box::Interval ExpressionEvaluator::Visit(const Expression& e,
                                          const Box& box) const {
   return VisitExpression<Box::Interval>(this, e, box);
@@ -51,7 +141,7 @@ Box::Interval ExpressionEvaluator::VisitAddition(const Expression& e,
   return accumulate(expr_to_coeff_map.begin(), expr_to_coeff_map.end(),
                     ibex::Interval{c},
                     [this, &box](const Box::Interval& init,
-                                 const pair<const Expression, double>& p) {
+                                 const pair<Expression, double>& p) {
                       return init + Visit(p.first, box) * p.second;
                     });
 }
@@ -64,7 +154,7 @@ Box::Interval ExpressionEvaluator::VisitMultiplication(const Expression& e,
   return accumulate(base_to_exponent_map.begin(), base_to_exponent_map.end(),
                     ibex::Interval{c},
                     [this, &box](const Box::Interval& init,
-                                 const pair<const Expression, Expression>& p) {
+                                 const pair<Expression, Expression>& p) {
                       return init * VisitPow(p.first, p.second, box);
                     });
 }
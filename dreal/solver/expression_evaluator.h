@@ -1,17 +1,49 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <ostream>
+#include <vector>
 
 #include "./ibex.h"
 
+#include "dreal/symbolic/expression_tape.h"
 #include "dreal/symbolic/symbolic.h"
 #include "dreal/util/box.h"
+#include "dreal/util/interval_enclosure.h"
 
 namespace dreal {
 
+/// Evaluates an expression over a box using interval arithmetic.
+///
+/// The expression is compiled into an ExpressionTape at construction
+/// so that an evaluation is a loop over the instructions of the tape,
+/// where common sub-expressions are evaluated once. The positions of
+/// the variables in a box are cached, so the variables are not looked
+/// up by hashing as long as the boxes share the same layout (as in
+/// ICP).
+///
+/// By default, it computes the natural interval extension. Another
+/// enclosure mode can be given at construction, which is tighter for
+/// expressions with repeated variables. See IntervalEnclosure.
 class ExpressionEvaluator {
  public:
-  explicit ExpressionEvaluator(Expression e);
+  explicit ExpressionEvaluator(Expression e,
+                               EnclosureMode mode = EnclosureMode::Natural);
+
+  /// Deleted copy-constructor.
+  ExpressionEvaluator(const ExpressionEvaluator&) = delete;
+
+  /// Default move-constructor.
+  ExpressionEvaluator(ExpressionEvaluator&&) = default;
+
+  /// Deleted copy-assignment operator.
+  ExpressionEvaluator& operator=(const ExpressionEvaluator&) = delete;
+
+  /// Deleted move-assignment operator.
+  ExpressionEvaluator& operator=(ExpressionEvaluator&&) = delete;
+
+  ~ExpressionEvaluator() = default;
 
   /// Evaluates the expression with @p box.
   Box::Interval operator()(const Box& box) const;
@@ -19,6 +51,15 @@ class ExpressionEvaluator {
   const Variables& variables() const { return e_.GetVariables(); }
 
  private:
+  // Evaluates tape_ with @p box.
+  Box::Interval EvaluateTape(const Box& box) const;
+
+  // Evaluates enclosure_ with @p box.
+  Box::Interval EvaluateEnclosure(const Box& box) const;
+
+  // Returns the index of the @p i-th variable of tape_ in @p box.
+  int BoxIndex(int i, const Box& box) const;
+
   Box::Interval Visit(const Expression& e, const Box& box) const;
   static Box::Interval VisitVariable(const Expression& e, const Box& box);
   static Box::Interval VisitConstant(const Expression& e, const Box& box);
@@ -60,6 +101,21 @@ class ExpressionEvaluator {
       std::ostream& os, const ExpressionEvaluator& expression_evaluator);
 
   const Expression e_;
+
+  // The tape of e_ over its variables. It is nullptr if e_ includes an
+  // if-then-else or an uninterpreted function, which are handled (and
+  // rejected) by the visitor.
+  std::unique_ptr<const ExpressionTape> tape_;
+
+  // The enclosure of e_ over the variables of tape_. It is nullptr in
+  // the natural mode or if tape_ is nullptr.
+  std::unique_ptr<const IntervalEnclosure> enclosure_;
+
+  // box_index_[i] is the index of the i-th variable of tape_ in the
+  // last evaluated box, or -1. It is a hint which is validated before
+  // use. The evaluator can be shared by ICP worker threads, hence the
+  // atomics.
+  mutable std::vector<std::atomic<int>> box_index_;
 };
 
 std::ostream& operator<<(std::ostream& os,
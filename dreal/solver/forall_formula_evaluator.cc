@@ -50,9 +50,15 @@ vector<RelationalFormulaEvaluator> BuildFormulaEvaluators(const Formula& f) {
 }  // namespace
 
 Context& ForallFormulaEvaluator::GetContext() const {
+  // With a single context, this evaluator is used by a sequential ICP.
+  // It can run in any thread (e.g. a worker of a TheoryPipeline), whose
+  // thread ID is not necessarily 0.
+  if (contexts_.size() == 1) {
+    return contexts_.front();
+  }
   thread_local const int kThreadId{ThreadPool::get_thread_id()};
   DREAL_ASSERT(0 <= kThreadId &&
-               kThreadId <= static_cast<int>(contexts_.size()));
+               kThreadId < static_cast<int>(contexts_.size()));
   return contexts_[kThreadId];
 }
 
@@ -1,6 +1,8 @@
 #include "dreal/solver/formula_evaluator.h"
 
 #include <cassert>
+#include <chrono>
+#include <cstdint>
 #include <utility>
 
 #include "dreal/solver/expression_evaluator.h"
@@ -12,10 +14,16 @@
 
 namespace dreal {
 
+using std::int64_t;
 using std::make_shared;
 using std::ostream;
 using std::shared_ptr;
 
+namespace {
+// One of every kSamplePeriod evaluations is timed.
+constexpr int64_t kSamplePeriod{16};
+}  // namespace
+
 FormulaEvaluationResult::FormulaEvaluationResult(
     Type type, const Box::Interval& evaluation)
     : type_{type}, evaluation_{evaluation} {}
@@ -50,7 +58,25 @@ FormulaEvaluator::FormulaEvaluator(std::shared_ptr<FormulaEvaluatorCell> ptr)
 }
 
 FormulaEvaluationResult FormulaEvaluator::operator()(const Box& box) const {
-  return (*ptr_)(box);
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+  using std::chrono::steady_clock;
+  FormulaEvaluatorCell::Stat& stat{ptr_->stat()};
+  const int64_t n{stat.num_evaluations.fetch_add(1, std::memory_order_relaxed)};
+  const bool timed{n % kSamplePeriod == 0};
+  const steady_clock::time_point start{timed ? steady_clock::now()
+                                             : steady_clock::time_point{}};
+  FormulaEvaluationResult result{(*ptr_)(box)};
+  if (timed) {
+    stat.total_nanoseconds.fetch_add(
+        duration_cast<nanoseconds>(steady_clock::now() - start).count(),
+        std::memory_order_relaxed);
+    stat.num_samples.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (result.type() == FormulaEvaluationResult::Type::UNSAT) {
+    stat.num_refutations.fetch_add(1, std::memory_order_relaxed);
+  }
+  return result;
 }
 
 const Variables& FormulaEvaluator::variables() const {
@@ -65,12 +91,39 @@ bool FormulaEvaluator::is_simple_relational() const {
 
 bool FormulaEvaluator::is_neq() const { return ptr_->is_neq(); }
 
+bool FormulaEvaluator::is_forall() const {
+  return dreal::is_forall(ptr_->formula());
+}
+
+double FormulaEvaluator::refutation_rate() const {
+  const FormulaEvaluatorCell::Stat& stat{ptr_->stat()};
+  const int64_t n{stat.num_evaluations.load(std::memory_order_relaxed)};
+  if (n == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(
+             stat.num_refutations.load(std::memory_order_relaxed)) /
+         static_cast<double>(n);
+}
+
+double FormulaEvaluator::average_cost() const {
+  const FormulaEvaluatorCell::Stat& stat{ptr_->stat()};
+  const int64_t n{stat.num_samples.load(std::memory_order_relaxed)};
+  if (n == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(
+             stat.total_nanoseconds.load(std::memory_order_relaxed)) /
+         static_cast<double>(n);
+}
+
 ostream& operator<<(ostream& os, const FormulaEvaluator& evaluator) {
   return evaluator.ptr_->Display(os);
 }
 
-FormulaEvaluator make_relational_formula_evaluator(const Formula& f) {
-  return FormulaEvaluator{make_shared<RelationalFormulaEvaluator>(f)};
+FormulaEvaluator make_relational_formula_evaluator(const Formula& f,
+                                                   const EnclosureMode mode) {
+  return FormulaEvaluator{make_shared<RelationalFormulaEvaluator>(f, mode)};
 }
 
 FormulaEvaluator make_forall_formula_evaluator(const Formula& f,
@@ -6,6 +6,7 @@
 
 #include "dreal/symbolic/symbolic.h"
 #include "dreal/util/box.h"
+#include "dreal/util/interval_enclosure.h"
 #include "dreal/util/logging.h"
 
 namespace dreal {
@@ -81,6 +82,20 @@ class FormulaEvaluator {
   /// in form of `e1 != e2` or `!(e1 == e2)`.
   bool is_neq() const;
 
+  /// Returns true if the based formula is a universally quantified
+  /// formula. Its evaluation runs an inner ICP, which is much more
+  /// expensive than the evaluation of a relational formula.
+  bool is_forall() const;
+
+  /// Returns the fraction of the evaluations which returned UNSAT. The
+  /// copies of this evaluator share the statistics.
+  double refutation_rate() const;
+
+  /// Returns the average time of an evaluation in nanoseconds, which is
+  /// measured on a sample of the evaluations. Returns 0.0 if no
+  /// evaluation is measured yet.
+  double average_cost() const;
+
  private:
   // Constructs an FormulaEvaluator from `ptr`.
   explicit FormulaEvaluator(std::shared_ptr<FormulaEvaluatorCell> ptr);
@@ -90,7 +105,8 @@ class FormulaEvaluator {
   friend std::ostream& operator<<(std::ostream& os,
                                   const FormulaEvaluator& evaluator);
 
-  friend FormulaEvaluator make_relational_formula_evaluator(const Formula& f);
+  friend FormulaEvaluator make_relational_formula_evaluator(
+      const Formula& f, EnclosureMode mode);
 
   friend FormulaEvaluator make_forall_formula_evaluator(const Formula& f,
                                                         double epsilon,
@@ -99,7 +115,9 @@ class FormulaEvaluator {
 };
 
 /// Creates FormulaEvaluator for a relational formula @p f using @p variables.
-FormulaEvaluator make_relational_formula_evaluator(const Formula& f);
+/// The expressions in @p f are enclosed by @p mode.
+FormulaEvaluator make_relational_formula_evaluator(
+    const Formula& f, EnclosureMode mode = EnclosureMode::Natural);
 
 /// Creates FormulaEvaluator for a universally quantified formula @p f
 /// using @p variables, @p epsilon, @p delta, and @p number_of_jobs.
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <ostream>
 #include <vector>
@@ -12,6 +14,16 @@ namespace dreal {
 /// Base type for evaluator cell types.
 class FormulaEvaluatorCell {
  public:
+  /// Statistics of the evaluations. They are shared by the copies of a
+  /// FormulaEvaluator, which can be used by multiple threads.
+  struct Stat {
+    std::atomic<std::int64_t> num_evaluations{0};
+    std::atomic<std::int64_t> num_refutations{0};
+    // The evaluations whose time is measured, and their total time.
+    std::atomic<std::int64_t> num_samples{0};
+    std::atomic<std::int64_t> total_nanoseconds{0};
+  };
+
   explicit FormulaEvaluatorCell(Formula f);
 
   /// Deleted copy-constructor.
@@ -46,10 +58,15 @@ class FormulaEvaluatorCell {
 
   virtual std::ostream& Display(std::ostream& os) const = 0;
 
+  /// Returns the statistics of the evaluations.
+  Stat& stat() const { return *stat_; }
+
  private:
   const Formula f_;
   const bool is_simple_relational_{false};
   const bool is_neq_{false};
+  // It is held by a pointer so that the cell is still movable.
+  std::unique_ptr<Stat> stat_{std::make_unique<Stat>()};
 };
 
 }  // namespace dreal
@@ -1,63 +1,228 @@
 #include "dreal/solver/icp.h"
 
+#include <algorithm>
+#include <memory>
+#include <numeric>
 #include <ostream>
 #include <tuple>
 #include <utility>
 
+#include "dreal/util/assert.h"
+#include "dreal/util/exception.h"
 #include "dreal/util/logging.h"
 
+using std::make_shared;
+using std::shared_ptr;
+using std::unique_ptr;
 using std::vector;
 
 namespace dreal {
 
+namespace {
+// IncrementalBoxEvaluator updates the order of evaluation every
+// kReorderPeriod calls.
+constexpr int kReorderPeriod{1024};
+
+// Handles the @p result of @p formula_evaluator over @p box. Returns
+// false if it is UNSAT. Otherwise, adds the dimensions to branch on to
+// @p branching_candidates. See EvaluateBox.
+bool HandleResult(const FormulaEvaluator& formula_evaluator,
+                  const FormulaEvaluationResult& result, const Box& box,
+                  const double precision,
+                  DynamicBitset* const branching_candidates,
+                  ContractorStatus* const cs) {
+  switch (result.type()) {
+    case FormulaEvaluationResult::Type::UNSAT:
+      DREAL_LOG_DEBUG(
+          "Icp::EvaluateBox() Found that the box\n"
+          "{0}\n"
+          "has no solution for {1} (evaluation = {2}).",
+          box, formula_evaluator, result.evaluation());
+      cs->mutable_box().set_empty();
+      cs->AddUsedConstraint(formula_evaluator.formula());
+      return false;
+    case FormulaEvaluationResult::Type::VALID:
+      DREAL_LOG_DEBUG(
+          "Icp::EvaluateBox() Found that all points in the box\n"
+          "{0}\n"
+          "satisfies the constraint {1} (evaluation = {2}).",
+          box, formula_evaluator, result.evaluation());
+      return true;
+    case FormulaEvaluationResult::Type::UNKNOWN: {
+      const Box::Interval& evaluation{result.evaluation()};
+      const double diam = evaluation.diam();
+      if (diam > precision) {
+        DREAL_LOG_DEBUG(
+            "Icp::EvaluateBox() Found an interval >= precision({2}):\n"
+            "{0} -> {1}",
+            formula_evaluator, evaluation, precision);
+        if (formula_evaluator.is_simple_relational() ||
+            formula_evaluator.is_neq()) {
+          // Note: when the base formula is simple relational or not-equal, we
+          // do not need to branch on the base variable.
+        } else {
+          for (const Variable& v : formula_evaluator.variables()) {
+            branching_candidates->set(box.index(v));
+          }
+        }
+      }
+      return true;
+    }
+  }
+  DREAL_UNREACHABLE();
+}
+}  // namespace
+
 Icp::Icp(const Config& config) : config_{config} {}
 
+vector<shared_ptr<const AutoDiff>> Icp::SmearGradients(
+    const vector<FormulaEvaluator>& formula_evaluators) {
+  vector<shared_ptr<const AutoDiff>> gradients;
+  if (!UsesSmears(config().branching_heuristic())) {
+    return gradients;
+  }
+  for (const FormulaEvaluator& formula_evaluator : formula_evaluators) {
+    if (formula_evaluator.is_forall()) {
+      continue;
+    }
+    const Formula& f{formula_evaluator.formula()};
+    auto it = smear_gradients_.find(f);
+    if (it == smear_gradients_.end()) {
+      it = smear_gradients_.emplace_hint(it, f, MakeSmearGradient(f));
+    }
+    if (it->second) {
+      gradients.push_back(it->second);
+    }
+  }
+  return gradients;
+}
+
 optional<DynamicBitset> EvaluateBox(
     const vector<FormulaEvaluator>& formula_evaluators, const Box& box,
     const double precision, ContractorStatus* const cs) {
   DynamicBitset branching_candidates(box.size());  // Return value.
   for (const FormulaEvaluator& formula_evaluator : formula_evaluators) {
-    const FormulaEvaluationResult result{formula_evaluator(box)};
-    switch (result.type()) {
-      case FormulaEvaluationResult::Type::UNSAT:
-        DREAL_LOG_DEBUG(
-            "Icp::EvaluateBox() Found that the box\n"
-            "{0}\n"
-            "has no solution for {1} (evaluation = {2}).",
-            box, formula_evaluator, result.evaluation());
-        cs->mutable_box().set_empty();
-        cs->AddUsedConstraint(formula_evaluator.formula());
-        return nullopt;
-      case FormulaEvaluationResult::Type::VALID:
-        DREAL_LOG_DEBUG(
-            "Icp::EvaluateBox() Found that all points in the box\n"
-            "{0}\n"
-            "satisfies the constraint {1} (evaluation = {2}).",
-            box, formula_evaluator, result.evaluation());
-        continue;
-      case FormulaEvaluationResult::Type::UNKNOWN: {
-        const Box::Interval& evaluation{result.evaluation()};
-        const double diam = evaluation.diam();
-        if (diam > precision) {
-          DREAL_LOG_DEBUG(
-              "Icp::EvaluateBox() Found an interval >= precision({2}):\n"
-              "{0} -> {1}",
-              formula_evaluator, evaluation, precision);
-          if (formula_evaluator.is_simple_relational() ||
-              formula_evaluator.is_neq()) {
-            // Note: when the base formula is simple relational or not-equal, we
-            // do not need to branch on the base variable.
-          } else {
-            for (const Variable& v : formula_evaluator.variables()) {
-              branching_candidates.set(box.index(v));
-            }
-          }
+    if (!HandleResult(formula_evaluator, formula_evaluator(box), box,
+                      precision, &branching_candidates, cs)) {
+      return nullopt;
+    }
+  }
+  return branching_candidates;
+}
+
+unique_ptr<StatefulBrancher> MakeBrancher(
+    const Config& config,
+    const vector<shared_ptr<const AutoDiff>>& gradients) {
+  return MakeStatefulBrancher(config.branching_heuristic(), config.brancher(),
+                              gradients);
+}
+
+IncrementalBoxEvaluator::Order MakeEvaluationOrder(const Config& config) {
+  if (config.use_deterministic_icp()) {
+    return IncrementalBoxEvaluator::Order::Fixed;
+  }
+  if (config.use_cost_based_evaluation_order()) {
+    return IncrementalBoxEvaluator::Order::RefutationRatePerCost;
+  }
+  return IncrementalBoxEvaluator::Order::RefutationRate;
+}
+
+IncrementalBoxEvaluator::IncrementalBoxEvaluator(
+    vector<FormulaEvaluator> formula_evaluators, const Box& box,
+    const Order order)
+    : formula_evaluators_{std::move(formula_evaluators)},
+      order_kind_{order},
+      dim_to_evaluators_(box.size()) {
+  for (size_t i = 0; i < formula_evaluators_.size(); ++i) {
+    for (const Variable& v : formula_evaluators_[i].variables()) {
+      dim_to_evaluators_[box.index(v)].push_back(static_cast<int>(i));
+    }
+  }
+  // The evaluators are shared across the calls of ICP. Their statistics
+  // from the previous calls give the initial order.
+  order_ = make_shared<const vector<int>>(ComputeOrder());
+}
+
+optional<DynamicBitset> IncrementalBoxEvaluator::operator()(
+    const Box& box, const double precision, const Snapshot* const parent,
+    Results* const results, ContractorStatus* const cs) const {
+  DREAL_ASSERT(box.size() == static_cast<int>(dim_to_evaluators_.size()));
+  if (order_kind_ != Order::Fixed &&
+      (num_calls_.fetch_add(1, std::memory_order_relaxed) + 1) %
+              kReorderPeriod ==
+          0) {
+    std::atomic_store(&order_, make_shared<const vector<int>>(ComputeOrder()));
+  }
+  const shared_ptr<const vector<int>> order{std::atomic_load(&order_)};
+
+  // dirty[i] is true if the i-th formula evaluator needs to be evaluated.
+  vector<bool> dirty(formula_evaluators_.size(), true);
+  if (parent && &parent->box.variables() == &box.variables()) {
+    DREAL_ASSERT(parent->results.size() == formula_evaluators_.size());
+    dirty.assign(dirty.size(), false);
+    for (int i = 0; i < box.size(); ++i) {
+      if (box[i] != parent->box[i]) {
+        for (const int j : dim_to_evaluators_[i]) {
+          dirty[j] = true;
         }
-        break;
       }
     }
+    *results = parent->results;
+  } else {
+    results->assign(formula_evaluators_.size(), nullopt);
+  }
+
+  DynamicBitset branching_candidates(box.size());  // Return value.
+  for (const int i : *order) {
+    const FormulaEvaluator& formula_evaluator{formula_evaluators_[i]};
+    optional<FormulaEvaluationResult>& result{(*results)[i]};
+    if (dirty[i] || !result) {
+      if (formula_evaluator.is_forall() && branching_candidates.any()) {
+        // The box is branched anyway. Postpone this evaluator until the
+        // others are satisfied.
+        result = nullopt;
+        continue;
+      }
+      result = formula_evaluator(box);
+    }
+    if (!HandleResult(formula_evaluator, *result, box, precision,
+                      &branching_candidates, cs)) {
+      return nullopt;
+    }
   }
   return branching_candidates;
 }
 
+vector<int> IncrementalBoxEvaluator::ComputeOrder() const {
+  // The expected number of refutations per evaluation, or per
+  // nanosecond for Order::RefutationRatePerCost. The cost of an
+  // evaluator which is not measured yet is assumed to be 1ns. The
+  // scores are all zero for the fixed order.
+  vector<double> scores(formula_evaluators_.size(), 0.0);
+  for (size_t i = 0; i < formula_evaluators_.size(); ++i) {
+    switch (order_kind_) {
+      case Order::Fixed:
+        break;
+      case Order::RefutationRate:
+        scores[i] = formula_evaluators_[i].refutation_rate();
+        break;
+      case Order::RefutationRatePerCost:
+        scores[i] = formula_evaluators_[i].refutation_rate() /
+                    std::max(formula_evaluators_[i].average_cost(), 1.0);
+        break;
+    }
+  }
+  vector<int> order(formula_evaluators_.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](const int a, const int b) {
+    const bool forall_a{formula_evaluators_[a].is_forall()};
+    const bool forall_b{formula_evaluators_[b].is_forall()};
+    if (forall_a != forall_b) {
+      return forall_b;
+    }
+    return scores[a] > scores[b];
+  });
+  return order;
+}
+
 }  // namespace dreal
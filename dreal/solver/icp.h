@@ -1,9 +1,13 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "dreal/contractor/contractor.h"
 #include "dreal/contractor/contractor_status.h"
+#include "dreal/solver/brancher.h"
 #include "dreal/solver/config.h"
 #include "dreal/solver/formula_evaluator.h"
 #include "dreal/util/box.h"
@@ -36,11 +40,32 @@ class Icp {
                         const std::vector<FormulaEvaluator>& formula_evaluators,
                         ContractorStatus* cs) = 0;
 
+  /// Returns the boxes which the last call of CheckSat left unexplored
+  /// when it found a delta-SAT box, the next one to explore at the back.
+  /// With the found box, they include all the solutions in the input
+  /// box. Returns nullopt if they are not kept.
+  ///
+  /// @note They are kept only if Config::use_incremental_theory_solver()
+  /// is set.
+  virtual optional<std::vector<Box>> TakeFrontier() { return nullopt; }
+
  protected:
   const Config& config() const { return config_; }
 
+  /// Returns the gradients for the smears of the branchers (see
+  /// MakeSmearGradient) of the formulas of @p formula_evaluators which
+  /// are not universally quantified. They are built once per formula
+  /// and kept across the calls of CheckSat. It returns none if
+  /// `config().branching_heuristic()` does not use the smears.
+  std::vector<std::shared_ptr<const AutoDiff>> SmearGradients(
+      const std::vector<FormulaEvaluator>& formula_evaluators);
+
  private:
   const Config& config_;
+
+  // Formula ↦ its gradient, or nullptr if it has none.
+  std::unordered_map<Formula, std::shared_ptr<const AutoDiff>>
+      smear_gradients_;
 };
 
 /// Evaluates each formula with @p box using interval
@@ -78,4 +103,96 @@ optional<DynamicBitset> EvaluateBox(
     const std::vector<FormulaEvaluator>& formula_evaluators, const Box& box,
     double precision, ContractorStatus* cs);
 
+/// Makes a brancher for an ICP run. It follows
+/// `config.branching_heuristic()` and uses `config.brancher()` for
+/// BranchingHeuristic::LargestFirst. The smears are computed from @p
+/// gradients (see Icp::SmearGradients).
+std::unique_ptr<StatefulBrancher> MakeBrancher(
+    const Config& config,
+    const std::vector<std::shared_ptr<const AutoDiff>>& gradients);
+
+/// Incremental version of EvaluateBox.
+///
+/// In ICP, a box is obtained from its parent box by branching on a
+/// dimension and then pruning it. A FormulaEvaluator only reads the
+/// intervals of its variables. Therefore, its result over a box is the
+/// same as the one over the parent box if none of those intervals has
+/// changed. This class keeps the results over a box and re-evaluates
+/// only the formula evaluators which read a changed dimension.
+///
+/// The evaluators are not evaluated in the given order. Instead, the
+/// ones which refute boxes often go first so that an UNSAT box is
+/// detected early. The order is learned from the statistics of the
+/// evaluators (see FormulaEvaluator::refutation_rate()) and updated
+/// periodically. The evaluators of universally quantified formulas go
+/// last, and they are skipped if the other evaluators already require
+/// the box to be branched. They are evaluated once the other evaluators
+/// are satisfied.
+///
+/// By default, the order only depends on the refutation counts, so that
+/// a sequential run is reproducible. Order::RefutationRatePerCost also
+/// weighs them by the measured costs (see
+/// FormulaEvaluator::average_cost()), which makes the order and the
+/// explanations of UNSAT boxes depend on timings. Order::Fixed evaluates
+/// them in the given order, except that the universally quantified ones
+/// go last.
+class IncrementalBoxEvaluator {
+ public:
+  /// The order of evaluation.
+  enum class Order {
+    Fixed,                  ///< The given order.
+    RefutationRate,         ///< By refutations per evaluation (default).
+    RefutationRatePerCost,  ///< By refutations per nanosecond.
+  };
+
+  /// The results of the formula evaluators. The i-th entry is None if
+  /// the i-th evaluator is not evaluated.
+  using Results = std::vector<optional<FormulaEvaluationResult>>;
+
+  /// The results of the formula evaluators over a box.
+  struct Snapshot {
+    Box box;
+    Results results;
+  };
+
+  /// Constructs an incremental evaluator of @p formula_evaluators over
+  /// the boxes which have the same variables as @p box, using @p order
+  /// of evaluation.
+  IncrementalBoxEvaluator(std::vector<FormulaEvaluator> formula_evaluators,
+                          const Box& box, Order order = Order::RefutationRate);
+
+  /// Evaluates the formulas with @p box as EvaluateBox does. If @p parent
+  /// is not nullptr, it reuses the results over `parent->box`, a box
+  /// which includes @p box. The two boxes need to share their variables
+  /// (i.e. one is a copy of the other) for the reuse.
+  ///
+  /// On return, @p results holds the results over @p box, which can be
+  /// used to make a snapshot for the boxes derived from @p box. They
+  /// are incomplete if it returns None.
+  optional<DynamicBitset> operator()(
+      const Box& box, double precision, const Snapshot* parent,
+      Results* results, ContractorStatus* cs) const;
+
+ private:
+  // Returns the order of evaluation based on the statistics of the
+  // evaluators.
+  std::vector<int> ComputeOrder() const;
+
+  const std::vector<FormulaEvaluator> formula_evaluators_;
+  const Order order_kind_;
+
+  // The current order of evaluation. It is replaced every
+  // kReorderPeriod calls, possibly by another ICP worker thread.
+  mutable std::shared_ptr<const std::vector<int>> order_;
+  mutable std::atomic<int> num_calls_{0};
+
+  // dim_to_evaluators_[i] is the indices of the formula evaluators which
+  // read the i-th dimension.
+  std::vector<std::vector<int>> dim_to_evaluators_;
+};
+
+/// Returns the order of evaluation which @p config asks for. It is
+/// fixed if `config.use_deterministic_icp()` holds.
+IncrementalBoxEvaluator::Order MakeEvaluationOrder(const Config& config);
+
 }  // namespace dreal
@@ -1,6 +1,9 @@
 #include "dreal/solver/icp_parallel.h"
 
+#include <algorithm>
 #include <atomic>
+#include <functional>
+#include <memory>
 #include <tuple>
 #include <utility>
 
@@ -12,43 +15,48 @@
 #include "dreal/util/logging.h"
 
 using std::atomic;
-using std::pair;
+using std::make_shared;
+using std::shared_ptr;
+using std::unique_ptr;
 using std::vector;
 
 namespace dreal {
 
 namespace {
 
-bool ParallelBranch(const DynamicBitset& bitset,
-                    const bool stack_left_box_first, Box* const box,
-                    Stack<Box>* const global_stack,
-                    atomic<int>* const number_of_boxes) {
-  const pair<double, int> max_diam_and_idx{FindMaxDiam(*box, bitset)};
-  const int branching_point{max_diam_and_idx.second};
+// IcpParallel::CheckSat seeds the global stack with at least
+// (number of jobs * kSeedBoxesPerJob) boxes so that every worker has
+// something to work on from the start.
+constexpr int kSeedBoxesPerJob{4};
+
+// In the deterministic mode, the subtrees are not shared by the
+// workers. More subtrees balance the load among the workers.
+constexpr int kDeterministicSeedBoxesPerJob{16};
+
+// Branches @p box by @p brancher. One of the two boxes is pushed to
+// @p global_stack and the other is stored in @p box. Returns the
+// branching dimension, or -1 if it fails to find one.
+int ParallelBranch(const DynamicBitset& bitset,
+                   const bool stack_left_box_first,
+                   StatefulBrancher* const brancher, Box* const box,
+                   Stack<Box>* const global_stack,
+                   atomic<int>* const number_of_boxes) {
+  Box left;
+  Box right;
+  const int branching_point{(*brancher)(*box, bitset, &left, &right)};
   if (branching_point >= 0) {
-    const auto boxes = box->bisect(branching_point);
-    const Box* box1_ptr{nullptr};
-    const Box* box2_ptr{nullptr};
-    if (stack_left_box_first) {
-      box1_ptr = &boxes.first;
-      box2_ptr = &boxes.second;
-    } else {
-      box2_ptr = &boxes.first;
-      box1_ptr = &boxes.second;
-    }
-    const Box& box1{*box1_ptr};
-    const Box& box2{*box2_ptr};
+    Box& box1{stack_left_box_first ? left : right};
+    Box& box2{stack_left_box_first ? right : left};
     number_of_boxes->fetch_add(1, std::memory_order_relaxed);
     global_stack->push(box1);
-    *box = box2;
-    return true;
+    *box = std::move(box2);
   }
-  // Fail to find a branching point.
-  return false;
+  return branching_point;
 }
 
 void Worker(const Contractor& contractor, const Config& config,
-            const vector<FormulaEvaluator>& formula_evaluators, const int id,
+            const IncrementalBoxEvaluator& box_evaluator,
+            StatefulBrancher* const brancher, const int id,
             const bool main_thread, Stack<Box>* const global_stack,
             ContractorStatus* const cs, atomic<int>* const found_delta_sat,
             atomic<int>* const number_of_boxes) {
@@ -72,6 +80,19 @@ void Worker(const Contractor& contractor, const Config& config,
   // indicates that we can work with the box inside of the ContractorStatus.
   bool need_to_pop{true};
 
+  // The evaluation of the parent of the current box. A worker keeps one
+  // of the two boxes from a branching, which is evaluated
+  // incrementally. A box popped from the global stack is evaluated from
+  // scratch.
+  shared_ptr<const IncrementalBoxEvaluator::Snapshot> parent_evaluation;
+  IncrementalBoxEvaluator::Results results;
+
+  // The dimension of the branching which produced the current box, or -1
+  // if it is popped from the global stack. The box before pruning is
+  // kept if the brancher uses the pruning history.
+  int branching_dim{-1};
+  Box box_before_pruning;
+
   while ((*found_delta_sat == -1) &&
          (number_of_boxes->load(std::memory_order_acquire) > 0)) {
     // Note that 'DREAL_CHECK_INTERRUPT' is only defined in setup.py,
@@ -88,12 +109,20 @@ void Worker(const Contractor& contractor, const Config& config,
       if (!global_stack->pop(current_box)) {
         continue;
       }
+      parent_evaluation.reset();
+      branching_dim = -1;
     }
     need_to_pop = true;
 
     // 2. Prune the current box.
     prune_timer_guard.resume();
+    if (brancher->uses_pruning()) {
+      box_before_pruning = current_box;
+    }
     contractor.Prune(cs);
+    if (brancher->uses_pruning()) {
+      brancher->Pruned(branching_dim, box_before_pruning, current_box);
+    }
     prune_timer_guard.pause();
     if (stat.enabled()) {
       stat.num_prune_++;
@@ -109,7 +138,8 @@ void Worker(const Contractor& contractor, const Config& config,
     // under evaluation and it's small enough.
     eval_timer_guard.resume();
     const optional<DynamicBitset> evaluation_result{
-        EvaluateBox(formula_evaluators, current_box, config.precision(), cs)};
+        box_evaluator(current_box, config.precision(), parent_evaluation.get(),
+                      &results, cs)};
     if (!evaluation_result) {
       // 3.2.1. We detect that the current box is not a feasible solution.
       number_of_boxes->fetch_sub(1, std::memory_order_acq_rel);
@@ -130,8 +160,12 @@ void Worker(const Contractor& contractor, const Config& config,
 
     // 3.2.3. This box is bigger than delta. Need branching.
     branch_timer_guard.resume();
-    if (!ParallelBranch(*evaluation_result, stack_left_box_first, &current_box,
-                        global_stack, number_of_boxes)) {
+    parent_evaluation = make_shared<const IncrementalBoxEvaluator::Snapshot>(
+        IncrementalBoxEvaluator::Snapshot{current_box, std::move(results)});
+    branching_dim = ParallelBranch(*evaluation_result, stack_left_box_first,
+                                   brancher, &current_box, global_stack,
+                                   number_of_boxes);
+    if (branching_dim < 0) {
       DREAL_LOG_DEBUG(
           "IcpParallel::Worker() Found that the current box is not "
           "satisfying "
@@ -150,6 +184,125 @@ void Worker(const Contractor& contractor, const Config& config,
     stat.num_branch_++;
   }
 }
+
+// Searches the subtree rooted at `cs->box()`, which is the @p
+// index-th subtree, in the depth-first order. It gives up the search
+// once @p winner becomes less than @p index. Returns true if it finds a
+// delta-box, which is stored in @p cs.
+//
+// The search only depends on the root box. In particular, it uses a
+// new brancher so that the pruning history of the other subtrees does
+// not affect the branchings. Its smears are computed from @p gradients.
+bool SearchSubtree(const Contractor& contractor, const Config& config,
+                   const vector<shared_ptr<const AutoDiff>>& gradients,
+                   const IncrementalBoxEvaluator& box_evaluator,
+                   const int index, const atomic<int>& winner,
+                   IcpStat* const stat, ContractorStatus* const cs) {
+  const unique_ptr<StatefulBrancher> brancher{
+      MakeBrancher(config, gradients)};
+  bool stack_left_box_first{config.stack_left_box_first()};
+  Box& current_box{cs->mutable_box()};
+  vector<Box> stack;
+  bool need_to_pop{false};
+  shared_ptr<const IncrementalBoxEvaluator::Snapshot> parent_evaluation;
+  IncrementalBoxEvaluator::Results results;
+  int branching_dim{-1};
+  Box box_before_pruning;
+
+  while (!need_to_pop || !stack.empty()) {
+#ifdef DREAL_CHECK_INTERRUPT
+    if (g_interrupted) {
+      DREAL_LOG_DEBUG("KeyboardInterrupt(SIGINT) Detected.");
+      throw std::runtime_error("KeyboardInterrupt(SIGINT) Detected.");
+    }
+#endif
+    if (winner.load(std::memory_order_relaxed) < index) {
+      return false;
+    }
+    if (need_to_pop) {
+      current_box = std::move(stack.back());
+      stack.pop_back();
+      parent_evaluation.reset();
+      branching_dim = -1;
+    }
+    need_to_pop = true;
+
+    if (brancher->uses_pruning()) {
+      box_before_pruning = current_box;
+    }
+    contractor.Prune(cs);
+    if (brancher->uses_pruning()) {
+      brancher->Pruned(branching_dim, box_before_pruning, current_box);
+    }
+    if (stat->enabled()) {
+      stat->num_prune_++;
+    }
+    if (current_box.empty()) {
+      continue;
+    }
+
+    const optional<DynamicBitset> evaluation_result{
+        box_evaluator(current_box, config.precision(), parent_evaluation.get(),
+                      &results, cs)};
+    if (!evaluation_result) {
+      continue;
+    }
+    if (evaluation_result->none()) {
+      return true;
+    }
+
+    parent_evaluation = make_shared<const IncrementalBoxEvaluator::Snapshot>(
+        IncrementalBoxEvaluator::Snapshot{current_box, std::move(results)});
+    Box left;
+    Box right;
+    branching_dim = (*brancher)(current_box, *evaluation_result, &left, &right);
+    if (branching_dim < 0) {
+      // Not satisfying the delta-condition but not bisectable.
+      return true;
+    }
+    // Keep one of the two boxes and stack the other, as Worker does.
+    stack.push_back(std::move(stack_left_box_first ? left : right));
+    current_box = std::move(stack_left_box_first ? right : left);
+    need_to_pop = false;
+    stack_left_box_first = !stack_left_box_first;
+    stat->num_branch_++;
+  }
+  return false;
+}
+
+// Worker of the deterministic mode. It takes the subtrees rooted at @p
+// seeds in order and searches them. (*statuses)[i] is the contractor
+// status of the i-th subtree. @p winner is the least index of the
+// subtrees where a delta-box is found, or the number of seeds if there
+// is none yet. The subtrees after the winner are skipped.
+void DeterministicWorker(const Contractor& contractor, const Config& config,
+                         const vector<shared_ptr<const AutoDiff>>& gradients,
+                         const IncrementalBoxEvaluator& box_evaluator,
+                         const int id, const vector<Box>& seeds,
+                         atomic<int>* const next_seed,
+                         atomic<int>* const winner,
+                         vector<ContractorStatus>* const statuses) {
+  thread_local IcpStat stat{DREAL_LOG_INFO_ENABLED, id};
+  while (true) {
+    const int index{next_seed->fetch_add(1)};
+    if (index >= static_cast<int>(seeds.size()) || index > winner->load()) {
+      return;
+    }
+    ContractorStatus& cs{(*statuses)[index]};
+    cs.mutable_box() = seeds[index];
+    if (SearchSubtree(contractor, config, gradients, box_evaluator, index,
+                      *winner, &stat, &cs)) {
+      DREAL_LOG_DEBUG(
+          "IcpParallel::DeterministicWorker() Found a delta-box in the "
+          "{}-th subtree:\n{}",
+          index, cs.box());
+      int current{winner->load()};
+      while (index < current &&
+             !winner->compare_exchange_weak(current, index)) {
+      }
+    }
+  }
+}
 }  // namespace
 
 IcpParallel::IcpParallel(const Config& config)
@@ -184,24 +337,58 @@ bool IcpParallel::CheckSat(const Contractor& contractor,
   // more work to do.
   atomic<int> number_of_boxes{0};
 
-  global_stack.push(cs->box());
-  ++number_of_boxes;
+  const IncrementalBoxEvaluator box_evaluator{
+      formula_evaluators, cs->box(), MakeEvaluationOrder(config())};
+
+  // Warm-up: Evaluate the root box and split it along the dimensions to
+  // branch on, instead of letting a single worker branch on it while the
+  // others wait for boxes.
+  IncrementalBoxEvaluator::Results root_results;
+  const optional<DynamicBitset> root_evaluation{box_evaluator(
+      cs->box(), config().precision(), nullptr, &root_results, cs)};
+  if (!root_evaluation) {
+    return false;
+  }
+  if (root_evaluation->none()) {
+    return true;
+  }
+  // The branchers of the workers share the gradients for the smears.
+  const vector<shared_ptr<const AutoDiff>> gradients{
+      SmearGradients(formula_evaluators)};
+  if (config().use_deterministic_icp()) {
+    return CheckSatDeterministic(contractor, gradients, box_evaluator,
+                                 *root_evaluation, cs);
+  }
+  const vector<Box> seeds{MultisectLargestFirst(
+      cs->box(), *root_evaluation, number_of_jobs * kSeedBoxesPerJob)};
+  // Push them in reverse order so that the first one is popped first.
+  for (auto it = seeds.rbegin(); it != seeds.rend(); ++it) {
+    global_stack.push(*it);
+  }
+  number_of_boxes = static_cast<int>(seeds.size());
 
   for (int i = 0; i < number_of_jobs; ++i) {
     status_vector_.push_back(*cs);
   }
 
+  // Each worker has its own brancher as they are stateful.
+  vector<unique_ptr<StatefulBrancher>> branchers;
+  for (int i = 0; i < number_of_jobs; ++i) {
+    branchers.push_back(MakeBrancher(config(), gradients));
+  }
+
   for (int i = 0; i < number_of_jobs - 1; ++i) {
     results_.push_back(
-        pool_.enqueue(Worker, contractor, config(), formula_evaluators, i,
-                      false /* not main thread */, &global_stack,
-                      &status_vector_[i], &found_delta_sat, &number_of_boxes));
+        pool_.enqueue(Worker, contractor, config(), std::cref(box_evaluator),
+                      branchers[i].get(), i, false /* not main thread */,
+                      &global_stack, &status_vector_[i], &found_delta_sat,
+                      &number_of_boxes));
   }
 
   const int last_index{number_of_jobs - 1};
-  Worker(contractor, config(), formula_evaluators, last_index,
-         true /* main thread */, &global_stack, &status_vector_[last_index],
-         &found_delta_sat, &number_of_boxes);
+  Worker(contractor, config(), box_evaluator, branchers[last_index].get(),
+         last_index, true /* main thread */, &global_stack,
+         &status_vector_[last_index], &found_delta_sat, &number_of_boxes);
 
   // barrier.
   for (auto&& result : results_) {
@@ -222,4 +409,53 @@ bool IcpParallel::CheckSat(const Contractor& contractor,
     return false;
   }
 }
+
+bool IcpParallel::CheckSatDeterministic(
+    const Contractor& contractor,
+    const vector<shared_ptr<const AutoDiff>>& gradients,
+    const IncrementalBoxEvaluator& box_evaluator,
+    const DynamicBitset& root_branching_candidates,
+    ContractorStatus* const cs) {
+  const int number_of_jobs = config().number_of_jobs();
+  // The seeds are in a canonical order which only depends on the root
+  // box.
+  const vector<Box> seeds{
+      MultisectLargestFirst(cs->box(), root_branching_candidates,
+                            number_of_jobs * kDeterministicSeedBoxesPerJob)};
+  for (size_t i = 0; i < seeds.size(); ++i) {
+    status_vector_.push_back(*cs);
+  }
+  atomic<int> next_seed{0};
+  atomic<int> winner{static_cast<int>(seeds.size())};
+
+  for (int i = 0; i < number_of_jobs - 1; ++i) {
+    results_.push_back(pool_.enqueue(DeterministicWorker, contractor, config(),
+                                     std::cref(gradients),
+                                     std::cref(box_evaluator), i,
+                                     std::cref(seeds), &next_seed, &winner,
+                                     &status_vector_));
+  }
+  DeterministicWorker(contractor, config(), gradients, box_evaluator,
+                      number_of_jobs - 1, seeds, &next_seed, &winner,
+                      &status_vector_);
+
+  // barrier.
+  for (auto&& result : results_) {
+    result.get();
+  }
+
+  // The subtrees before the winner are searched completely. The ones
+  // after the winner are not, and depend on the timing. They are
+  // excluded.
+  const int last{std::min(winner.load(), static_cast<int>(seeds.size()) - 1)};
+  for (int i = 0; i <= last; ++i) {
+    cs->InplaceJoin(status_vector_[i]);
+  }
+  if (winner < static_cast<int>(seeds.size())) {
+    cs->mutable_box() = status_vector_[winner].box();
+    return true;
+  }
+  cs->mutable_box().set_empty();
+  return false;
+}
 }  // namespace dreal
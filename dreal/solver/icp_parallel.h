@@ -1,6 +1,7 @@
 #pragma once
 
 #include <future>
+#include <memory>
 #include <vector>
 
 #include "ThreadPool/ThreadPool.h"
@@ -24,6 +25,17 @@ class IcpParallel : public Icp {
                 ContractorStatus* cs) override;
 
  private:
+  // Searches the subtrees rooted at the boxes split from `cs->box()` in
+  // parallel. Among the subtrees where a delta-box is found, the first
+  // one in the canonical order wins. Therefore, the result does not
+  // depend on the timing of the workers. The branchers compute the
+  // smears from @p gradients.
+  bool CheckSatDeterministic(
+      const Contractor& contractor,
+      const std::vector<std::shared_ptr<const AutoDiff>>& gradients,
+      const IncrementalBoxEvaluator& box_evaluator,
+      const DynamicBitset& root_branching_candidates, ContractorStatus* cs);
+
   ThreadPool pool_;
 
   std::vector<std::future<void>> results_;
@@ -1,19 +1,68 @@
 #include "dreal/solver/icp_seq.h"
 
+#include <algorithm>
+#include <memory>
 #include <tuple>
 #include <utility>
 
+#include "dreal/solver/box_batch_evaluator.h"
 #include "dreal/solver/brancher.h"
 #include "dreal/solver/icp_stat.h"
 #include "dreal/util/interrupt.h"
 #include "dreal/util/logging.h"
 
-using std::pair;
+using std::get;
+using std::make_shared;
+using std::shared_ptr;
 using std::tie;
+using std::tuple;
+using std::unique_ptr;
 using std::vector;
 
 namespace dreal {
 
+namespace {
+// An entry of the stack: a box, the dimension of the branching which
+// produced it, and the evaluation of its parent box.
+using StackEntry =
+    tuple<Box, int, shared_ptr<const IncrementalBoxEvaluator::Snapshot>>;
+
+// Evaluates the boxes in `stack[begin:]` by @p batch_evaluator and
+// removes the infeasible ones. Returns the number of removed boxes.
+int ScreenStack(const BoxBatchEvaluator& batch_evaluator,
+                const vector<FormulaEvaluator>& formula_evaluators,
+                const size_t begin, vector<StackEntry>* const stack,
+                ContractorStatus* const cs) {
+  vector<const Box*> boxes;
+  boxes.reserve(stack->size() - begin);
+  for (size_t i = begin; i < stack->size(); ++i) {
+    boxes.push_back(&get<0>((*stack)[i]));
+  }
+  vector<int> unsat;
+  batch_evaluator.FindUnsat(boxes, &unsat);
+  // Keep the order of the remaining boxes.
+  size_t last{begin};
+  for (size_t i = begin; i < stack->size(); ++i) {
+    const int formula_index{unsat[i - begin]};
+    if (formula_index == -1) {
+      if (last != i) {
+        (*stack)[last] = std::move((*stack)[i]);
+      }
+      ++last;
+    } else {
+      DREAL_LOG_DEBUG(
+          "IcpSeq::CheckSat() Detect that the box\n{}\nis not feasible by "
+          "batch evaluation of {}.",
+          get<0>((*stack)[i]), formula_evaluators[formula_index]);
+      cs->AddUsedConstraint(formula_evaluators[formula_index].formula());
+    }
+  }
+  const int num_removed{static_cast<int>(stack->size() - last)};
+  stack->resize(last);
+  return num_removed;
+}
+}  // namespace
+
 IcpSeq::IcpSeq(const Config& config) : Icp{config} {}
 
 bool IcpSeq::CheckSat(const Contractor& contractor,
@@ -21,14 +70,15 @@ bool IcpSeq::CheckSat(const Contractor& contractor,
                       ContractorStatus* const cs) {
   // Use the stacking policy set by the configuration.
   stack_left_box_first_ = config().stack_left_box_first();
-  static IcpStat stat{DREAL_LOG_INFO_ENABLED};
+  frontier_.reset();
+  thread_local IcpStat stat{DREAL_LOG_INFO_ENABLED};
   DREAL_LOG_DEBUG("IcpSeq::CheckSat()");
-  // Stack of Box x BranchingPoint.
-  vector<pair<Box, int>> stack;
+  // Stack of Box x BranchingPoint x Evaluation of the parent box.
+  vector<StackEntry> stack;
   stack.emplace_back(
       cs->box(),
       // -1 indicates that the very first box does not come from a branching.
-      -1);
+      -1, nullptr);
 
   // `current_box` always points to the box in the contractor status
   // as a mutable reference.
@@ -36,6 +86,20 @@ bool IcpSeq::CheckSat(const Contractor& contractor,
   // `current_branching_point` always points to the branching_point in
   // the contractor status as a mutable reference.
   int& current_branching_point{cs->mutable_branching_point()};
+  // The evaluation of the parent of the current box.
+  shared_ptr<const IncrementalBoxEvaluator::Snapshot> parent_evaluation;
+
+  // The formula evaluators are evaluated incrementally along each
+  // lineage of boxes. See IncrementalBoxEvaluator.
+  const IncrementalBoxEvaluator box_evaluator{
+      formula_evaluators, cs->box(), MakeEvaluationOrder(config())};
+  IncrementalBoxEvaluator::Results results;
+
+  const unique_ptr<StatefulBrancher> brancher{
+      MakeBrancher(config(), SmearGradients(formula_evaluators))};
+  // The box before pruning, kept if the brancher uses the pruning
+  // history.
+  Box box_before_pruning;
 
   TimerGuard prune_timer_guard(&stat.timer_prune_, stat.enabled(),
                                false /* start_timer */);
@@ -44,6 +108,28 @@ bool IcpSeq::CheckSat(const Contractor& contractor,
   TimerGuard branch_timer_guard(&stat.timer_branch_, stat.enabled(),
                                 false /* start_timer */);
 
+  // When enabled, the boxes pushed to the stack are screened in chunks
+  // by batched interval evaluation before they are popped and pruned.
+  // The boxes in stack[0, num_screened) are already screened.
+  const size_t batch_size{static_cast<size_t>(config().icp_batch_size())};
+  optional<BoxBatchEvaluator> batch_evaluator;
+  if (batch_size > 0) {
+    batch_evaluator.emplace(formula_evaluators);
+  }
+  size_t num_screened{0};
+
+  // Keeps the boxes in the stack when it finds a delta-SAT box, so that
+  // the incremental theory solver can resume the search.
+  const auto keep_frontier = [this, &stack]() {
+    if (config().use_incremental_theory_solver()) {
+      frontier_.emplace();
+      frontier_->reserve(stack.size());
+      for (StackEntry& entry : stack) {
+        frontier_->push_back(std::move(get<0>(entry)));
+      }
+    }
+  };
+
   while (!stack.empty()) {
     DREAL_LOG_DEBUG("IcpSeq::CheckSat() Loop Head");
 
@@ -56,14 +142,36 @@ bool IcpSeq::CheckSat(const Contractor& contractor,
     }
 #endif
 
-    // 1. Pop the current box from the stack
-    tie(current_box, current_branching_point) = stack.back();
+    // 1. Pop the current box from the stack. If there are enough
+    // unscreened boxes, screen them first.
+    if (batch_evaluator && stack.size() - num_screened >= batch_size) {
+      eval_timer_guard.resume();
+      stat.num_batch_discard_ += ScreenStack(
+          *batch_evaluator, formula_evaluators, num_screened, &stack, cs);
+      eval_timer_guard.pause();
+      num_screened = stack.size();
+      if (stack.empty()) {
+        // The remaining boxes are all infeasible.
+        current_box.set_empty();
+        break;
+      }
+    }
+    tie(current_box, current_branching_point, parent_evaluation) =
+        std::move(stack.back());
     stack.pop_back();
+    num_screened = std::min(num_screened, stack.size());
 
     // 2. Prune the current box.
     DREAL_LOG_TRACE("IcpSeq::CheckSat() Current Box:\n{}", current_box);
     prune_timer_guard.resume();
+    if (brancher->uses_pruning()) {
+      box_before_pruning = current_box;
+    }
     contractor.Prune(cs);
+    if (brancher->uses_pruning()) {
+      brancher->Pruned(current_branching_point, box_before_pruning,
+                       current_box);
+    }
     prune_timer_guard.pause();
     stat.num_prune_++;
     DREAL_LOG_TRACE("IcpSeq::CheckSat() After pruning, the current box =\n{}",
@@ -78,7 +186,8 @@ bool IcpSeq::CheckSat(const Contractor& contractor,
     // under evaluation and it's small enough.
     eval_timer_guard.resume();
     const optional<DynamicBitset> evaluation_result{
-        EvaluateBox(formula_evaluators, current_box, config().precision(), cs)};
+        box_evaluator(current_box, config().precision(),
+                      parent_evaluation.get(), &results, cs)};
     if (!evaluation_result) {
       // 3.2.1. We detect that the current box is not a feasible solution.
       DREAL_LOG_DEBUG(
@@ -91,6 +200,7 @@ bool IcpSeq::CheckSat(const Contractor& contractor,
     if (evaluation_result->none()) {
       // 3.2.2. delta-SAT : We find a box which is smaller enough.
       DREAL_LOG_DEBUG("IcpSeq::CheckSat() Found a delta-box:\n{}", current_box);
+      keep_frontier();
       return true;
     }
     eval_timer_guard.pause();
@@ -99,21 +209,27 @@ bool IcpSeq::CheckSat(const Contractor& contractor,
     branch_timer_guard.resume();
     Box box_left;
     Box box_right;
-    const int branching_dim = config().brancher()(
-        current_box, *evaluation_result, &box_left, &box_right);
+    const int branching_dim = (*brancher)(current_box, *evaluation_result,
+                                          &box_left, &box_right);
     if (branching_dim >= 0) {
+      // The two boxes share the evaluation of the current box.
+      const shared_ptr<const IncrementalBoxEvaluator::Snapshot> evaluation{
+          make_shared<const IncrementalBoxEvaluator::Snapshot>(
+              IncrementalBoxEvaluator::Snapshot{current_box,
+                                                std::move(results)})};
       if (stack_left_box_first_) {
-        stack.emplace_back(box_left, branching_dim);
-        stack.emplace_back(box_right, branching_dim);
+        stack.emplace_back(box_left, branching_dim, evaluation);
+        stack.emplace_back(box_right, branching_dim, evaluation);
       } else {
-        stack.emplace_back(box_right, branching_dim);
-        stack.emplace_back(box_left, branching_dim);
+        stack.emplace_back(box_right, branching_dim, evaluation);
+        stack.emplace_back(box_left, branching_dim, evaluation);
       }
     } else {
       DREAL_LOG_DEBUG(
           "IcpSeq::CheckSat() Found that the current box is not satisfying "
           "delta-condition but it's not bisectable.:\n{}",
           current_box);
+      keep_frontier();
       return true;
     }
     branch_timer_guard.pause();
@@ -126,4 +242,10 @@ bool IcpSeq::CheckSat(const Contractor& contractor,
   DREAL_LOG_DEBUG("IcpSeq::CheckSat() No solution");
   return false;
 }
+
+optional<vector<Box>> IcpSeq::TakeFrontier() {
+  optional<vector<Box>> frontier{std::move(frontier_)};
+  frontier_.reset();
+  return frontier;
+}
 }  // namespace dreal
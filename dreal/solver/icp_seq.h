@@ -7,6 +7,8 @@
 #include "dreal/solver/config.h"
 #include "dreal/solver/formula_evaluator.h"
 #include "dreal/solver/icp.h"
+#include "dreal/util/box.h"
+#include "dreal/util/optional.h"
 
 namespace dreal {
 
@@ -20,11 +22,16 @@ class IcpSeq : public Icp {
                 const std::vector<FormulaEvaluator>& formula_evaluators,
                 ContractorStatus* cs) override;
 
+  optional<std::vector<Box>> TakeFrontier() override;
+
  private:
   // If `stack_left_box_first_` is true, we add the left box from the
   // branching operation to the `stack`. Otherwise, we add the right
   // box first.
   bool stack_left_box_first_{false};
+
+  // The unexplored boxes of the last call of CheckSat. See TakeFrontier.
+  optional<std::vector<Box>> frontier_;
 };
 
 }  // namespace dreal
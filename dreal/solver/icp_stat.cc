@@ -16,6 +16,11 @@ IcpStat::~IcpStat() {
           "ICP level", thread_id_, num_branch_);
     print(cout, "{:<45} @ {:<16} T{:<2} = {:>15}\n", "Total # of Pruning",
           "ICP level", thread_id_, num_prune_);
+    if (num_batch_discard_ > 0) {
+      print(cout, "{:<45} @ {:<16} T{:<2} = {:>15}\n",
+            "Total # of Boxes Discarded by Batch Eval", "ICP level",
+            thread_id_, num_batch_discard_);
+    }
     if (num_branch_ > 0) {
       print(cout, "{:<45} @ {:<16} T{:<2} = {:>15f} sec\n",
             "Total time spent in Branching", "ICP level", thread_id_,
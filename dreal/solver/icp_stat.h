@@ -24,6 +24,7 @@ class IcpStat : public Stat {
 
   std::atomic<int> num_branch_{0};
   std::atomic<int> num_prune_{0};
+  std::atomic<int> num_batch_discard_{0};
 
   Timer timer_branch_;
   Timer timer_prune_;
@@ -9,8 +9,6 @@ namespace dreal {
 
 using std::ostream;
 
-namespace {
-
 RelationalOperator GetRelationalOperator(const Formula& f) {
   DREAL_ASSERT(is_relational(f) || is_negation(f));
   switch (f.get_kind()) {
@@ -51,7 +49,6 @@ RelationalOperator GetRelationalOperator(const Formula& f) {
   DREAL_UNREACHABLE();
 }
 
-// Decomposes a formula `f = e₁ rop e₂` into `(rop, e₁ - e₂)`.
 Expression ExtractExpression(const Formula& f) {
   if (is_relational(f)) {
     return get_lhs_expression(f) - get_rhs_expression(f);
@@ -60,126 +57,114 @@ Expression ExtractExpression(const Formula& f) {
     return ExtractExpression(get_operand(f));
   }
 }
-}  // namespace
-
-RelationalFormulaEvaluator::RelationalFormulaEvaluator(Formula f)
-    : FormulaEvaluatorCell{std::move(f)},
-      op_{GetRelationalOperator(formula())},
-      expression_evaluator_{ExtractExpression(formula())} {}
-
-RelationalFormulaEvaluator::~RelationalFormulaEvaluator() {
-  DREAL_LOG_DEBUG("RelationalFormulaEvaluator::~RelationalFormulaEvaluator()");
-}
 
-FormulaEvaluationResult RelationalFormulaEvaluator::operator()(
-    const Box& box) const {
-  const Box::Interval evaluation{expression_evaluator_(box)};
-  switch (op_) {
+FormulaEvaluationResult::Type EvaluateRelationalOperator(
+    const RelationalOperator op, const Box::Interval& evaluation) {
+  switch (op) {
     case RelationalOperator::EQ: {
       // e₁ - e₂ = 0
       // VALID if e₁ - e₂ == [0, 0].
       if (evaluation.lb() == 0.0 && evaluation.ub() == 0.0) {
-        return FormulaEvaluationResult{FormulaEvaluationResult::Type::VALID,
-                                       evaluation};
+        return FormulaEvaluationResult::Type::VALID;
       }
       // UNSAT if 0 ∉ e₁ - e₂
       if (!evaluation.contains(0.0)) {
-        return FormulaEvaluationResult{FormulaEvaluationResult::Type::UNSAT,
-                                       evaluation};
+        return FormulaEvaluationResult::Type::UNSAT;
       }
       // Otherwise, it's UNKNOWN. It should be the case that 0.0 ∈ e₁ - e₂.
-      return FormulaEvaluationResult{FormulaEvaluationResult::Type::UNKNOWN,
-                                     evaluation};
+      return FormulaEvaluationResult::Type::UNKNOWN;
     }
 
     case RelationalOperator::NEQ: {
       // e₁ - e₂ ≠ 0
       // VALID if 0.0 ∉ e₁ - e₂
       if (evaluation.ub() < 0.0 || evaluation.lb() > 0.0) {
-        return FormulaEvaluationResult{FormulaEvaluationResult::Type::VALID,
-                                       evaluation};
+        return FormulaEvaluationResult::Type::VALID;
       }
       // UNSAT if e₁ - e₂ = 0.0
       if (evaluation.ub() == 0.0 && evaluation.lb() == 0.0) {
-        return FormulaEvaluationResult{FormulaEvaluationResult::Type::UNSAT,
-                                       evaluation};
+        return FormulaEvaluationResult::Type::UNSAT;
       }
       // Otherwise, it's UNKNOWN. It should be the case that 0.0 ∈ e₁ - e₂.
-      return FormulaEvaluationResult{FormulaEvaluationResult::Type::UNKNOWN,
-                                     evaluation};
+      return FormulaEvaluationResult::Type::UNKNOWN;
     }
 
     case RelationalOperator::GT: {
       // e₁ - e₂ > 0
       // VALID if e₁ - e₂ > 0.
       if (evaluation.lb() > 0.0) {
-        return FormulaEvaluationResult{FormulaEvaluationResult::Type::VALID,
-                                       evaluation};
+        return FormulaEvaluationResult::Type::VALID;
       }
       // UNSAT if e₁ - e₂ ≤ 0.
       if (evaluation.ub() <= 0.0) {
-        return FormulaEvaluationResult{FormulaEvaluationResult::Type::UNSAT,
-                                       evaluation};
+        return FormulaEvaluationResult::Type::UNSAT;
       }
       // Otherwise, it's UNKNOWN.
-      return FormulaEvaluationResult{FormulaEvaluationResult::Type::UNKNOWN,
-                                     evaluation};
+      return FormulaEvaluationResult::Type::UNKNOWN;
     }
 
     case RelationalOperator::GEQ: {
       // e₁ - e₂ ≥ 0
       // VALID if e₁ - e₂ ≥ 0.
       if (evaluation.lb() >= 0.0) {
-        return FormulaEvaluationResult{FormulaEvaluationResult::Type::VALID,
-                                       evaluation};
+        return FormulaEvaluationResult::Type::VALID;
       }
       // UNSAT if e₁ - e₂ < 0.
       if (evaluation.ub() < 0.0) {
-        return FormulaEvaluationResult{FormulaEvaluationResult::Type::UNSAT,
-                                       evaluation};
+        return FormulaEvaluationResult::Type::UNSAT;
       }
       // Otherwise, it's UNKNOWN.
-      return FormulaEvaluationResult{FormulaEvaluationResult::Type::UNKNOWN,
-                                     evaluation};
+      return FormulaEvaluationResult::Type::UNKNOWN;
     }
 
     case RelationalOperator::LT: {
       // e₁ - e₂ < 0
       // VALID if e₁ - e₂ < 0.
       if (evaluation.ub() < 0.0) {
-        return FormulaEvaluationResult{FormulaEvaluationResult::Type::VALID,
-                                       evaluation};
+        return FormulaEvaluationResult::Type::VALID;
       }
       // UNSAT if e₁ - e₂ ≥ 0.
       if (evaluation.lb() >= 0.0) {
-        return FormulaEvaluationResult{FormulaEvaluationResult::Type::UNSAT,
-                                       evaluation};
+        return FormulaEvaluationResult::Type::UNSAT;
       }
       // Otherwise, it's UNKNOWN.
-      return FormulaEvaluationResult{FormulaEvaluationResult::Type::UNKNOWN,
-                                     evaluation};
+      return FormulaEvaluationResult::Type::UNKNOWN;
     }
 
     case RelationalOperator::LEQ: {
       // e₁ - e₂ ≤ 0
       // VALID if e₁ - e₂ ≤ 0.
       if (evaluation.ub() <= 0.0) {
-        return FormulaEvaluationResult{FormulaEvaluationResult::Type::VALID,
-                                       evaluation};
+        return FormulaEvaluationResult::Type::VALID;
       }
       // UNSAT if e₁ - e₂ > 0.
       if (evaluation.lb() > 0.0) {
-        return FormulaEvaluationResult{FormulaEvaluationResult::Type::UNSAT,
-                                       evaluation};
+        return FormulaEvaluationResult::Type::UNSAT;
       }
       // Otherwise, it's UNKNOWN.
-      return FormulaEvaluationResult{FormulaEvaluationResult::Type::UNKNOWN,
-                                     evaluation};
+      return FormulaEvaluationResult::Type::UNKNOWN;
     }
   }
   DREAL_UNREACHABLE();
 }
 
+RelationalFormulaEvaluator::RelationalFormulaEvaluator(Formula f,
+                                                       const EnclosureMode mode)
+    : FormulaEvaluatorCell{std::move(f)},
+      op_{GetRelationalOperator(formula())},
+      expression_evaluator_{ExtractExpression(formula()), mode} {}
+
+RelationalFormulaEvaluator::~RelationalFormulaEvaluator() {
+  DREAL_LOG_DEBUG("RelationalFormulaEvaluator::~RelationalFormulaEvaluator()");
+}
+
+FormulaEvaluationResult RelationalFormulaEvaluator::operator()(
+    const Box& box) const {
+  const Box::Interval evaluation{expression_evaluator_(box)};
+  return FormulaEvaluationResult{EvaluateRelationalOperator(op_, evaluation),
+                                 evaluation};
+}
+
 ostream& RelationalFormulaEvaluator::Display(ostream& os) const {
   return os << "RelationalFormulaEvaluator(" << expression_evaluator_ << " "
             << op_ << " 0.0)";
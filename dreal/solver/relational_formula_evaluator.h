@@ -9,13 +9,17 @@
 #include "dreal/solver/formula_evaluator_cell.h"
 #include "dreal/symbolic/symbolic.h"
 #include "dreal/util/box.h"
+#include "dreal/util/interval_enclosure.h"
 
 namespace dreal {
 
 /// Evaluator for relational formulas.
 class RelationalFormulaEvaluator : public FormulaEvaluatorCell {
  public:
-  explicit RelationalFormulaEvaluator(Formula f);
+  /// Constructs an evaluator of @p f which encloses `e₁ - e₂` by
+  /// @p mode.
+  explicit RelationalFormulaEvaluator(
+      Formula f, EnclosureMode mode = EnclosureMode::Natural);
 
   /// Deleted copy-constructor.
   RelationalFormulaEvaluator(const RelationalFormulaEvaluator&) = delete;
@@ -42,6 +46,21 @@ class RelationalFormulaEvaluator : public FormulaEvaluatorCell {
 
  private:
   const RelationalOperator op_{};
-  const ExpressionEvaluator expression_evaluator_;
+  // It is not const so that this class is movable (ExpressionEvaluator
+  // is move-only).
+  ExpressionEvaluator expression_evaluator_;
 };
+
+/// Returns the relational operator of @p f, which is either `e₁ rop
+/// e₂` or its negation. For a negation, it returns the negated
+/// operator.
+RelationalOperator GetRelationalOperator(const Formula& f);
+
+/// Decomposes a formula `f = e₁ rop e₂` (or its negation) into `e₁ - e₂`.
+Expression ExtractExpression(const Formula& f);
+
+/// Classifies @p evaluation, the interval evaluation of `e₁ - e₂` over
+/// a box, with respect to a relational formula `e₁ op e₂`.
+FormulaEvaluationResult::Type EvaluateRelationalOperator(
+    RelationalOperator op, const Box::Interval& evaluation);
 }  // namespace dreal
@@ -0,0 +1,179 @@
+#include "dreal/solver/sat_backend.h"
+
+#include "./picosat.h"
+
+#include "dreal/util/assert.h"
+#include "dreal/util/exception.h"
+#include "dreal/util/logging.h"
+
+using std::make_unique;
+using std::unique_ptr;
+using std::vector;
+
+namespace dreal {
+
+namespace {
+// Common part of the backends on PicoSAT.
+class PicosatBackendBase : public SatBackend {
+ public:
+  explicit PicosatBackendBase(const Config& config) : sat_{picosat_init()} {
+    // Enable partial checks via picosat_deref_partial. See the call-site in
+    // PicosatBackend::Value().
+    picosat_save_original_clauses(sat_);
+    if (config.random_seed() != 0) {
+      picosat_set_seed(sat_, config.random_seed());
+      DREAL_LOG_DEBUG("SatBackend::Set Random Seed {}", config.random_seed());
+    }
+    picosat_set_global_default_phase(
+        sat_, static_cast<int>(config.sat_default_phase()));
+    DREAL_LOG_DEBUG("SatBackend::Set Default Phase {}",
+                    config.sat_default_phase());
+  }
+
+  ~PicosatBackendBase() override { picosat_reset(sat_); }
+
+  int NewVariable() override { return picosat_inc_max_var(sat_); }
+
+  int num_variables() const override { return picosat_variables(sat_); }
+
+  int num_clauses() const override {
+    return picosat_added_original_clauses(sat_);
+  }
+
+  int TopLevelValue(const int var) const override {
+    return picosat_deref_toplevel(sat_, var);
+  }
+
+  void Assume(const int literal) override { picosat_assume(sat_, literal); }
+
+  bool Failed(const int literal) const override {
+    return picosat_failed_assumption(sat_, literal) != 0;
+  }
+
+ protected:
+  // Adds @p clause and @p extra_literal, if it is non-zero.
+  void DoAddClause(const vector<int>& clause, const int extra_literal) {
+    for (const int literal : clause) {
+      picosat_add(sat_, literal);
+    }
+    if (extra_literal != 0) {
+      picosat_add(sat_, extra_literal);
+    }
+    picosat_add(sat_, 0);
+  }
+
+  // Calls picosat_sat and converts its result.
+  Result DoSolve(const int decision_limit) {
+    switch (picosat_sat(sat_, decision_limit > 0 ? decision_limit : -1)) {
+      case PICOSAT_SATISFIABLE:
+        return Result::Sat;
+      case PICOSAT_UNSATISFIABLE:
+        return Result::Unsat;
+      default:
+        return Result::Unknown;
+    }
+  }
+
+  PicoSAT* const sat_{};
+};
+
+// Scopes by picosat_push and picosat_pop.
+class PicosatBackend : public PicosatBackendBase {
+ public:
+  explicit PicosatBackend(const Config& config) : PicosatBackendBase{config} {}
+
+  int AddClause(const vector<int>& clause, int) override {
+    DoAddClause(clause, 0);
+    return level_;
+  }
+
+  int level() const override { return level_; }
+
+  void Push() override {
+    picosat_push(sat_);
+    ++level_;
+  }
+
+  void Pop() override {
+    DREAL_ASSERT(level_ > 0);
+    picosat_pop(sat_);
+    --level_;
+    has_picosat_pop_used_ = true;
+  }
+
+  Result Solve(const int decision_limit) override {
+    return DoSolve(decision_limit);
+  }
+
+  int Value(const int var) const override {
+    return has_picosat_pop_used_ ? picosat_deref(sat_, var)
+                                 : picosat_deref_partial(sat_, var);
+  }
+
+ private:
+  int level_{0};
+
+  /// @note We found an issue when picosat_deref_partial is used with
+  /// picosat_pop. When this variable is true, we use `picosat_deref`
+  /// instead.
+  ///
+  /// TODO(soonho): Remove this hack when it's not needed.
+  bool has_picosat_pop_used_{false};
+};
+
+// Scopes by activation variables, which are assumed during the search.
+class AssumptionBackend : public PicosatBackendBase {
+ public:
+  explicit AssumptionBackend(const Config& config)
+      : PicosatBackendBase{config} {}
+
+  int AddClause(const vector<int>& clause, const int level) override {
+    DREAL_ASSERT(0 <= level && level <= this->level());
+    DoAddClause(clause, level == 0 ? 0 : -activations_[level - 1]);
+    return level;
+  }
+
+  int level() const override { return static_cast<int>(activations_.size()); }
+
+  void Push() override { activations_.push_back(NewVariable()); }
+
+  void Pop() override {
+    DREAL_ASSERT(!activations_.empty());
+    // Disable the clauses of the scope for good.
+    DoAddClause({-activations_.back()}, 0);
+    activations_.pop_back();
+  }
+
+  Result Solve(const int decision_limit) override {
+    // The assumptions are valid only for the next call of picosat_sat.
+    for (const int activation : activations_) {
+      picosat_assume(sat_, activation);
+    }
+    return DoSolve(decision_limit);
+  }
+
+  // The clauses of a popped scope are satisfied by ¬aᵢ, and the ones of
+  // an open scope are not since aᵢ is assumed. So the partial model from
+  // the original clauses is still a model of the open scopes.
+  int Value(const int var) const override {
+    return picosat_deref_partial(sat_, var);
+  }
+
+ private:
+  // activations_[i] is the activation variable of the scope at level
+  // i + 1.
+  vector<int> activations_;
+};
+}  // namespace
+
+unique_ptr<SatBackend> MakeSatBackend(const Config& config) {
+  switch (config.sat_backend()) {
+    case Config::SatBackendType::Picosat:
+      return make_unique<PicosatBackend>(config);
+    case Config::SatBackendType::Assumption:
+      return make_unique<AssumptionBackend>(config);
+  }
+  DREAL_UNREACHABLE();
+}
+
+}  // namespace dreal
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "dreal/solver/config.h"
+
+namespace dreal {
+
+/// Interface of the SAT solvers which SatSolver runs on. It works on the
+/// DIMACS-style literals: a variable is a positive integer v, and v and
+/// -v are its positive and negative literals.
+///
+/// A backend has a stack of scopes. The outermost scope is at level 0.
+/// The clauses added to a scope are retracted when the scope is popped.
+class SatBackend {
+ public:
+  /// The result of Solve().
+  enum class Result { Sat, Unsat, Unknown };
+
+  SatBackend() = default;
+  SatBackend(const SatBackend&) = delete;
+  SatBackend(SatBackend&&) = delete;
+  SatBackend& operator=(const SatBackend&) = delete;
+  SatBackend& operator=(SatBackend&&) = delete;
+  virtual ~SatBackend() = default;
+
+  /// Returns a new variable.
+  virtual int NewVariable() = 0;
+
+  /// Returns the largest variable.
+  virtual int num_variables() const = 0;
+
+  /// Returns the number of the added clauses.
+  virtual int num_clauses() const = 0;
+
+  /// Adds @p clause, a disjunction of literals, to the scope at @p level.
+  /// It is retracted when the scope is popped. Returns the level of the
+  /// scope where it is actually added.
+  ///
+  /// @pre 0 ≤ @p level ≤ level().
+  virtual int AddClause(const std::vector<int>& clause, int level) = 0;
+
+  /// Returns the level of the current scope.
+  virtual int level() const = 0;
+
+  /// Opens a new scope.
+  virtual void Push() = 0;
+
+  /// Closes the current scope.
+  ///
+  /// @pre level() > 0.
+  virtual void Pop() = 0;
+
+  /// Assumes @p literal in the next call of Solve(). The assumptions are
+  /// dropped after the call.
+  virtual void Assume(int literal) = 0;
+
+  /// Searches a model of the clauses. If @p decision_limit is positive,
+  /// it returns Result::Unknown after that many decisions.
+  virtual Result Solve(int decision_limit) = 0;
+
+  /// Returns true if @p literal is one of the assumptions used to show
+  /// Result::Unsat by the last call of Solve().
+  virtual bool Failed(int literal) const = 0;
+
+  /// Returns the value of @p var in the model found by the last call of
+  /// Solve(): 1 (true), -1 (false), or 0 (not needed by the model).
+  virtual int Value(int var) const = 0;
+
+  /// Returns the value of @p var fixed at the top level of the search, or
+  /// 0 if it is not fixed. It is valid during a search interrupted by
+  /// the decision limit.
+  virtual int TopLevelValue(int var) const = 0;
+};
+
+/// Makes a SAT backend of the type `config.sat_backend()`.
+///
+///  - Config::SatBackendType::Picosat uses picosat_push and
+///    picosat_pop. PicoSAT only adds a clause to the current scope, so
+///    it ignores the level given to SatBackend::AddClause. The clauses
+///    learned in a scope are dropped when the scope is popped.
+///
+///  - Config::SatBackendType::Assumption keeps an activation variable aᵢ
+///    for each scope i > 0. A clause C added to the scope i is added as
+///    (C ∨ ¬aᵢ), and the search assumes the aᵢs of the open scopes.
+///    Popping the scope i adds the unit clause ¬aᵢ. The other clauses,
+///    including the ones learned by PicoSAT, are kept.
+std::unique_ptr<SatBackend> MakeSatBackend(const Config& config);
+
+}  // namespace dreal
@@ -1,5 +1,7 @@
 #include "dreal/solver/sat_solver.h"
 
+#include <cstdlib>
+#include <limits>
 #include <ostream>
 #include <utility>
 
@@ -12,21 +14,14 @@
 namespace dreal {
 
 using std::cout;
+using std::numeric_limits;
 using std::set;
 using std::vector;
 
-SatSolver::SatSolver(const Config& config) : sat_{picosat_init()} {
-  // Enable partial checks via picosat_deref_partial. See the call-site in
-  // SatSolver::CheckSat().
-  picosat_save_original_clauses(sat_);
-  if (config.random_seed() != 0) {
-    picosat_set_seed(sat_, config.random_seed());
-    DREAL_LOG_DEBUG("SatSolver::Set Random Seed {}", config.random_seed());
-  }
-  picosat_set_global_default_phase(
-      sat_, static_cast<int>(config.sat_default_phase()));
-  DREAL_LOG_DEBUG("SatSolver::Set Default Phase {}",
-                  config.sat_default_phase());
+SatSolver::SatSolver(const Config& config)
+    : backend_{MakeSatBackend(config)},
+      cnfizer_{config.use_polarity_aware_cnf()} {
+  DREAL_LOG_DEBUG("SatSolver::Set Backend {}", config.sat_backend());
 }
 
 SatSolver::SatSolver(const Config& config, const vector<Formula>& clauses)
@@ -34,7 +29,7 @@ SatSolver::SatSolver(const Config& config, const vector<Formula>& clauses)
   AddClauses(clauses);
 }
 
-SatSolver::~SatSolver() { picosat_reset(sat_); }
+SatSolver::~SatSolver() = default;
 
 void SatSolver::AddFormula(const Formula& f) {
   DREAL_LOG_DEBUG("SatSolver::AddFormula({})", f);
@@ -47,6 +42,7 @@ void SatSolver::AddFormula(const Formula& f) {
     clause = predicate_abstractor_.Convert(clause);
   }
   AddClauses(clauses);
+  AddImplications();
 }
 
 void SatSolver::AddFormulas(const vector<Formula>& formulas) {
@@ -56,10 +52,50 @@ void SatSolver::AddFormulas(const vector<Formula>& formulas) {
 }
 
 void SatSolver::AddLearnedClause(const set<Formula>& formulas) {
+  AddLearnedClause(formulas, level());
+}
+
+int SatSolver::AddLearnedClause(const set<Formula>& formulas,
+                                const int level) {
+  vector<int> clause;
+  clause.reserve(formulas.size());
   for (const Formula& f : formulas) {
-    AddLiteral(!predicate_abstractor_.Convert(f));
+    AddLiteral(!predicate_abstractor_.Convert(f), &clause);
+  }
+  return backend_->AddClause(clause, level);
+}
+
+bool SatSolver::HasLiveAtoms(const set<Formula>& formulas) {
+  for (const Formula& f : formulas) {
+    Formula atom{predicate_abstractor_.Convert(f)};
+    if (is_negation(atom)) {
+      atom = get_operand(atom);
+    }
+    if (!is_variable(atom)) {
+      return false;
+    }
+    const auto it = to_sat_var_.find(get_variable(atom).get_id());
+    if (it == to_sat_var_.end() || !is_live(it->second)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void SatSolver::AddImplications() {
+  for (const Formula& f : predicate_abstractor_.TakeImplications()) {
+    DREAL_LOG_DEBUG("SatSolver::AddImplications({})", f);
+    vector<int> clause;
+    for (const Formula& l : get_operands(f)) {
+      for (const Variable& var : l.GetFreeVariables()) {
+        MakeSatVar(var);
+      }
+      AddLiteral(l, &clause);
+    }
+    // They hold regardless of the box, so they go to the outermost scope
+    // as the learned clauses do. They do not make the variables live.
+    backend_->AddClause(clause, 0);
   }
-  picosat_add(sat_, 0);
 }
 
 void SatSolver::AddClauses(const vector<Formula>& formulas) {
@@ -94,93 +130,198 @@ class SatSolverStat : public Stat {
       print(cout, "{:<45} @ {:<20} = {:>15f} sec\n",
             "Total time spent in SAT checks", "SAT level",
             timer_check_sat_.seconds());
+      if (num_theory_propagation_) {
+        print(cout, "{:<45} @ {:<20} = {:>15}\n",
+              "Total # of Theory Propagations", "SAT level",
+              num_theory_propagation_);
+      }
     }
   }
 
   int num_check_sat_{0};
+  int num_theory_propagation_{0};
   Timer timer_check_sat_;
 };
 }  // namespace
 
 optional<SatSolver::Model> SatSolver::CheckSat() {
+  return CheckSat(-1, nullptr);
+}
+
+optional<SatSolver::Model> SatSolver::CheckSat(
+    const int decision_interval, const TheoryPropagator& propagator) {
   static SatSolverStat stat{DREAL_LOG_INFO_ENABLED};
   DREAL_LOG_DEBUG("SatSolver::CheckSat(#vars = {}, #clauses = {})",
-                  picosat_variables(sat_),
-                  picosat_added_original_clauses(sat_));
+                  backend_->num_variables(), backend_->num_clauses());
   stat.num_check_sat_++;
   // Call SAT solver.
   TimerGuard check_sat_timer_guard(&stat.timer_check_sat_,
                                    DREAL_LOG_INFO_ENABLED);
-  const int ret{picosat_sat(sat_, -1)};
-  check_sat_timer_guard.pause();
-
-  Model model;
-  if (ret == PICOSAT_SATISFIABLE) {
-    // SAT Case.
-    const auto& var_to_formula_map = predicate_abstractor_.var_to_formula_map();
-    for (int i = 1; i <= picosat_variables(sat_); ++i) {
-      const int model_i{has_picosat_pop_used_ ? picosat_deref(sat_, i)
-                                              : picosat_deref_partial(sat_, i)};
-      if (model_i == 0) {
-        continue;
-      }
-      const auto it_var = to_sym_var_.find(i);
-      if (it_var == to_sym_var_.end()) {
-        // There is no symbolic::Variable corresponding to this
-        // picosat variable (int). This could be because of
-        // picosat_push/pop.
-        continue;
-      }
-      const Variable& var{it_var->second};
-      const auto it = var_to_formula_map.find(var);
-      if (it != var_to_formula_map.end()) {
-        DREAL_LOG_TRACE("SatSolver::CheckSat: Add theory literal {}{} to Model",
-                        model_i ? "" : "¬", var);
-        auto& theory_model = model.second;
-        theory_model.emplace_back(var, model_i == 1);
-      } else if (tseitin_variables_.count(var.get_id()) == 0) {
-        DREAL_LOG_TRACE(
-            "SatSolver::CheckSat: Add Boolean literal {}{} to Model ",
-            model_i ? "" : "¬", var);
-        auto& boolean_model = model.first;
-        boolean_model.emplace_back(var, model_i == 1);
+  SatBackend::Result ret{};
+  if (decision_interval > 0 && propagator) {
+    int num_assigned{0};
+    int decision_limit{decision_interval};
+    while ((ret = Solve(decision_limit)) == SatBackend::Result::Unknown) {
+      if (PropagateTopLevel(propagator, &num_assigned)) {
+        stat.num_theory_propagation_++;
       } else {
-        DREAL_LOG_TRACE(
-            "SatSolver::CheckSat: Skip {}{} which is a temporary variable.",
-            model_i ? "" : "¬", var);
+        // Each slice restarts the search. Without a new top-level
+        // assignment, the next slice would hit the same limit again, so
+        // the limit is doubled to make progress. It is dropped once it
+        // overflows.
+        decision_limit = decision_limit <= numeric_limits<int>::max() / 2
+                             ? 2 * decision_limit
+                             : -1;
       }
     }
-    DREAL_LOG_DEBUG("SatSolver::CheckSat() Found a model.");
-    return model;
-  } else if (ret == PICOSAT_UNSATISFIABLE) {
-    DREAL_LOG_DEBUG("SatSolver::CheckSat() No solution.");
-    // UNSAT Case.
-    return {};
   } else {
-    DREAL_ASSERT(ret == PICOSAT_UNKNOWN);
-    DREAL_LOG_CRITICAL("PICOSAT returns PICOSAT_UNKNOWN.");
-    throw DREAL_RUNTIME_ERROR("PICOSAT returns PICOSAT_UNKNOWN.");
+    ret = Solve(-1);
+  }
+  check_sat_timer_guard.pause();
+
+  switch (ret) {
+    case SatBackend::Result::Sat:
+      // SAT Case.
+      DREAL_LOG_DEBUG("SatSolver::CheckSat() Found a model.");
+      return GetModel();
+    case SatBackend::Result::Unsat:
+      DREAL_LOG_DEBUG("SatSolver::CheckSat() No solution.");
+      // UNSAT Case.
+      return {};
+    case SatBackend::Result::Unknown:
+      DREAL_LOG_CRITICAL("SAT backend returns UNKNOWN.");
+      throw DREAL_RUNTIME_ERROR("SAT backend returns UNKNOWN.");
+  }
+  DREAL_UNREACHABLE();
+}
+
+SatBackend::Result SatSolver::Solve(const int decision_limit) {
+  // The backend drops the assumptions after each call.
+  for (const auto& p : assumptions_) {
+    backend_->Assume(p.second);
+  }
+  const SatBackend::Result ret{backend_->Solve(decision_limit)};
+  if (ret == SatBackend::Result::Unsat) {
+    failed_assumptions_.clear();
+    for (const auto& p : assumptions_) {
+      if (backend_->Failed(p.second)) {
+        failed_assumptions_.push_back(p.first);
+      }
+    }
+  }
+  return ret;
+}
+
+SatSolver::Model SatSolver::GetModel() const {
+  Model model;
+  const auto& var_to_formula_map = predicate_abstractor_.var_to_formula_map();
+  for (int i = 1; i <= backend_->num_variables(); ++i) {
+    if (!is_live(i)) {
+      // It only appears in the retracted or the learned clauses, or it is
+      // an activation variable of the backend.
+      continue;
+    }
+    const int model_i{backend_->Value(i)};
+    if (model_i == 0) {
+      continue;
+    }
+    const Variable& var{to_sym_var_.at(i)};
+    const auto it = var_to_formula_map.find(var);
+    if (it != var_to_formula_map.end()) {
+      DREAL_LOG_TRACE("SatSolver::CheckSat: Add theory literal {}{} to Model",
+                      model_i ? "" : "¬", var);
+      auto& theory_model = model.second;
+      theory_model.emplace_back(var, model_i == 1);
+    } else if (tseitin_variables_.count(var.get_id()) == 0) {
+      DREAL_LOG_TRACE("SatSolver::CheckSat: Add Boolean literal {}{} to Model ",
+                      model_i ? "" : "¬", var);
+      auto& boolean_model = model.first;
+      boolean_model.emplace_back(var, model_i == 1);
+    } else {
+      DREAL_LOG_TRACE(
+          "SatSolver::CheckSat: Skip {}{} which is a temporary variable.",
+          model_i ? "" : "¬", var);
+    }
+  }
+  return model;
+}
+
+bool SatSolver::PropagateTopLevel(const TheoryPropagator& propagator,
+                                  int* const num_assigned) {
+  vector<Formula> assigned;
+  vector<Formula> unassigned;
+  for (const auto& p : predicate_abstractor_.var_to_formula_map()) {
+    const auto it = to_sat_var_.find(p.first.get_id());
+    if (it == to_sat_var_.end() || !is_live(it->second)) {
+      continue;
+    }
+    switch (backend_->TopLevelValue(it->second)) {
+      case 1:
+        assigned.push_back(p.second);
+        break;
+      case -1:
+        assigned.push_back(!p.second);
+        break;
+      default:
+        unassigned.push_back(p.second);
+    }
+  }
+  // The top-level assignment only grows.
+  if (static_cast<int>(assigned.size()) == *num_assigned) {
+    return false;
+  }
+  *num_assigned = static_cast<int>(assigned.size());
+  DREAL_LOG_DEBUG(
+      "SatSolver::PropagateTopLevel() #assigned = {}, #unassigned = {}",
+      assigned.size(), unassigned.size());
+  for (const set<Formula>& formulas : propagator(assigned, unassigned)) {
+    DREAL_LOG_DEBUG("SatSolver::PropagateTopLevel() Learn a clause of {} "
+                    "literals.",
+                    formulas.size());
+    AddLearnedClause(formulas);
+  }
+  return true;
+}
+
+bool SatSolver::is_live(const int sat_var) const {
+  return sat_var < static_cast<int>(live_levels_.size()) &&
+         live_levels_[sat_var] >= 0;
+}
+
+void SatSolver::SetAssumptions(const vector<Formula>& literals) {
+  assumptions_.clear();
+  failed_assumptions_.clear();
+  for (const Formula& l : literals) {
+    for (const Variable& var : l.GetFreeVariables()) {
+      MakeSatVar(var);
+    }
+    vector<int> clause;
+    AddLiteral(l, &clause);
+    assumptions_.emplace_back(l, clause.front());
   }
 }
 
 void SatSolver::Pop() {
   DREAL_LOG_DEBUG("SatSolver::Pop()");
-  tseitin_variables_.pop();
-  to_sym_var_.pop();
-  to_sat_var_.pop();
-  picosat_pop(sat_);
-  has_picosat_pop_used_ = true;
+  // The variables whose clauses are all in this scope are not live
+  // anymore.
+  const int level{backend_->level()};
+  for (int& live_level : live_levels_) {
+    if (live_level == level) {
+      live_level = -1;
+    }
+  }
+  backend_->Pop();
+  cnfizer_.Pop();
 }
 
 void SatSolver::Push() {
   DREAL_LOG_DEBUG("SatSolver::Push()");
-  picosat_push(sat_);
-  to_sat_var_.push();
-  to_sym_var_.push();
-  tseitin_variables_.push();
+  backend_->Push();
+  cnfizer_.Push();
 }
 
-void SatSolver::AddLiteral(const Formula& f) {
+void SatSolver::AddLiteral(const Formula& f, vector<int>* const clause) const {
   DREAL_ASSERT(is_variable(f) ||
                (is_negation(f) && is_variable(get_operand(f))));
   if (is_variable(f)) {
@@ -188,28 +329,37 @@ void SatSolver::AddLiteral(const Formula& f) {
     const Variable& var{get_variable(f)};
     DREAL_ASSERT(var.get_type() == Variable::Type::BOOLEAN);
     // Add l = b
-    picosat_add(sat_, to_sat_var_[var.get_id()]);
+    clause->push_back(to_sat_var_.at(var.get_id()));
   } else {
     // f = ¬b
     DREAL_ASSERT(is_negation(f) && is_variable(get_operand(f)));
     const Variable& var{get_variable(get_operand(f))};
     DREAL_ASSERT(var.get_type() == Variable::Type::BOOLEAN);
     // Add l = ¬b
-    picosat_add(sat_, -to_sat_var_[var.get_id()]);
+    clause->push_back(-to_sat_var_.at(var.get_id()));
   }
 }
 
 void SatSolver::DoAddClause(const Formula& f) {
+  vector<int> clause;
   if (is_disjunction(f)) {
     // f = l₁ ∨ ... ∨ lₙ
     for (const Formula& l : get_operands(f)) {
-      AddLiteral(l);
+      AddLiteral(l, &clause);
     }
   } else {
     // f = b or f = ¬b.
-    AddLiteral(f);
+    AddLiteral(f, &clause);
   }
-  picosat_add(sat_, 0);
+  // The variables are live while this scope is open.
+  const int level{backend_->level()};
+  for (const int literal : clause) {
+    int& live_level{live_levels_[std::abs(literal)]};
+    if (live_level < 0 || live_level > level) {
+      live_level = level;
+    }
+  }
+  backend_->AddClause(clause, level);
 }
 
 void SatSolver::MakeSatVar(const Variable& var) {
@@ -219,9 +369,12 @@ void SatSolver::MakeSatVar(const Variable& var) {
     return;
   }
   // It's not in the maps, let's make one and add it.
-  const int sat_var{picosat_inc_max_var(sat_)};
-  to_sat_var_.insert(var.get_id(), sat_var);
-  to_sym_var_.insert(sat_var, var);
+  const int sat_var{backend_->NewVariable()};
+  to_sat_var_.emplace(var.get_id(), sat_var);
+  to_sym_var_.emplace(sat_var, var);
+  if (sat_var >= static_cast<int>(live_levels_.size())) {
+    live_levels_.resize(sat_var + 1, -1);
+  }
   DREAL_LOG_DEBUG("SatSolver::MakeSatVar({} ↦ {})", var, sat_var);
 }
 }  // namespace dreal
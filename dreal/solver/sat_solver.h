@@ -1,18 +1,18 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
-#include "./picosat.h"
-
 #include "dreal/solver/config.h"
+#include "dreal/solver/sat_backend.h"
 #include "dreal/symbolic/symbolic.h"
 #include "dreal/util/optional.h"
 #include "dreal/util/predicate_abstractor.h"
-#include "dreal/util/scoped_unordered_map.h"
-#include "dreal/util/scoped_unordered_set.h"
 #include "dreal/util/tseitin_cnfizer.h"
 
 namespace dreal {
@@ -24,6 +24,15 @@ class SatSolver {
   // Boolean model + Theory model.
   using Model = std::pair<std::vector<Literal>, std::vector<Literal>>;
 
+  /// Consults the theory side on a partial assignment during the search.
+  /// It takes the assigned theory literals, as formulas (f or ¬f), and
+  /// the unassigned ones. It returns sets of formulas, each of which is
+  /// inconsistent. The SAT solver learns a clause (¬f₁ ∨ ... ∨ ¬fₙ) from
+  /// each {f₁, ..., fₙ}. See AddLearnedClause.
+  using TheoryPropagator = std::function<std::vector<std::set<Formula>>(
+      const std::vector<Formula>& assigned,
+      const std::vector<Formula>& unassigned)>;
+
   /// Constructs a SatSolver.
   explicit SatSolver(const Config& config);
 
@@ -58,22 +67,95 @@ class SatSolver {
   /// the solver.
   void AddLearnedClause(const std::set<Formula>& formulas);
 
+  /// Adds a learned clause as above to the scope at @p level, which
+  /// outlives the current one if @p level < level(). It is kept until
+  /// that scope is popped.
+  ///
+  /// Returns the level of the scope where it is actually added.
+  ///
+  /// @note Only Config::SatBackendType::Assumption honors @p level. See
+  /// MakeSatBackend.
+  int AddLearnedClause(const std::set<Formula>& formulas, int level);
+
+  /// Returns true if every formula in @p formulas is abstracted by a
+  /// Boolean variable which appears in a clause of an open scope. A
+  /// clause learned from @p formulas is only useful in that case.
+  bool HasLiveAtoms(const std::set<Formula>& formulas);
+
   /// Checks the satisfiability of the current configuration.
   ///
   /// @returns a witness, satisfying model if the problem is satisfiable.
   /// @returns nullopt if UNSAT.
   optional<Model> CheckSat();
 
-  // TODO(soonho): Push/Pop cnfizer and predicate_abstractor?
+  /// Checks the satisfiability of the current configuration as
+  /// CheckSat() does. In addition, it consults @p propagator every
+  /// @p decision_interval decisions with the theory literals assigned at
+  /// the top level, and learns the clauses from it.
+  ///
+  /// @note PicoSAT does not expose the assignment in the middle of the
+  /// search. The search is run in slices of @p decision_interval
+  /// decisions, and only the literals fixed at the top level (implied by
+  /// the clauses) are passed to @p propagator between the slices. A
+  /// slice which fixes no new literal doubles the size of the next
+  /// one, so that the search terminates.
+  optional<Model> CheckSat(int decision_interval,
+                           const TheoryPropagator& propagator);
+
+  /// Assumes @p literals in the following calls of CheckSat, until it is
+  /// called again. Each literal is either b or ¬b for a Boolean variable
+  /// b. Unlike Push/Pop, it keeps the clauses and the scopes intact.
+  void SetAssumptions(const std::vector<Formula>& literals);
+
+  /// Returns the subset of the assumptions which the last call of
+  /// CheckSat used to show UNSAT. It is empty if the clauses are UNSAT
+  /// without the assumptions. See SetAssumptions.
+  const std::vector<Formula>& failed_assumptions() const {
+    return failed_assumptions_;
+  }
+
+  // TODO(soonho): Push/Pop predicate_abstractor?
   void Pop();
 
   void Push();
 
+  /// Returns the number of open scopes.
+  int level() const { return backend_->level(); }
+
+  /// Returns true if no formula is added and no scope is opened yet.
+  bool empty() const { return to_sat_var_.empty() && level() == 0; }
+
   Formula theory_literal(const Variable& var) const {
     return predicate_abstractor_[var];
   }
 
  private:
+  // Returns the model found by the backend.
+  Model GetModel() const;
+
+  // Calls the backend under the assumptions. It updates
+  // failed_assumptions_ if the result is UNSAT.
+  SatBackend::Result Solve(int decision_limit);
+
+  // Returns true if a clause in an open scope has @p sat_var. The other
+  // variables only appear in the retracted clauses or in the learned
+  // ones, and they are not part of the model.
+  bool is_live(int sat_var) const;
+
+  // Consults @p propagator with the theory literals assigned at the top
+  // level and learns the clauses from it. Returns false if there is
+  // nothing new to consult since the last call, whose number of
+  // assigned literals is @p num_assigned.
+  bool PropagateTopLevel(const TheoryPropagator& propagator,
+                         int* num_assigned);
+
+  // Adds the clauses between the theory literals found by the predicate
+  // abstraction. See PredicateAbstractor::TakeImplications.
+  //
+  // @note With Config::SatBackendType::Picosat, they are retracted when
+  // the current scope is popped, and they are not added again.
+  void AddImplications();
+
   // Adds a formula @p f to the solver.
   //
   // @pre @p f is a clause. That is, it is either a literal (b or ¬b)
@@ -94,34 +176,37 @@ class SatSolver {
   //
   // @pre @p f is either a Boolean variable or a negation of Boolean
   // variable.
-  void AddLiteral(const Formula& f);
+  void AddLiteral(const Formula& f, std::vector<int>* clause) const;
 
   // Add a clause @p f to sat solver.
   void DoAddClause(const Formula& f);
 
   // Member variables
   // ----------------
-  // Pointer to the PicoSat solver.
-  PicoSAT* const sat_{};
+  const std::unique_ptr<SatBackend> backend_;
   TseitinCnfizer cnfizer_;
   PredicateAbstractor predicate_abstractor_;
 
-  // Map symbolic::Variable → int (Variable type in PicoSat).
-  ScopedUnorderedMap<Variable::Id, int> to_sat_var_;
+  // Map symbolic::Variable → int (Variable type in the backend). The
+  // maps are not scoped, so that a formula asserted again after Pop()
+  // has the same variables, and the clauses learned about them are
+  // still useful.
+  std::unordered_map<Variable::Id, int> to_sat_var_;
+
+  // Map int (Variable type in the backend) → symbolic::Variable.
+  std::unordered_map<int, Variable> to_sym_var_;
 
-  // Map int (Variable type in PicoSat) → symbolic::Variable.
-  ScopedUnorderedMap<int, Variable> to_sym_var_;
+  // live_levels_[v] is the lowest level of the scopes whose clauses have
+  // the variable v, or -1 if there is none. See is_live().
+  std::vector<int> live_levels_;
 
   /// Set of temporary Boolean variables introduced by Tseitin
   /// transformations.
-  ScopedUnorderedSet<Variable::Id> tseitin_variables_;
+  std::unordered_set<Variable::Id> tseitin_variables_;
 
-  /// @note We found an issue when picosat_deref_partial is used with
-  /// picosat_pop. When this variable is true, we use `picosat_deref`
-  /// instead.
-  ///
-  /// TODO(soonho): Remove this hack when it's not needed.
-  bool has_picosat_pop_used_{false};
+  // The assumptions and their literals in the backend.
+  std::vector<std::pair<Formula, int>> assumptions_;
+  std::vector<Formula> failed_assumptions_;
 };
 
 }  // namespace dreal
@@ -0,0 +1,201 @@
+#include "dreal/solver/box_batch_evaluator.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace dreal {
+namespace {
+
+using std::numeric_limits;
+using std::vector;
+
+class BoxBatchEvaluatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    box_.Add(x_);
+    box_.Add(y_);
+    box_.Add(z_);
+  }
+
+  // Returns `n` random sub-boxes of [-5, 5]³ which share the layout
+  // of box_.
+  vector<Box> RandomBoxes(const int n) {
+    std::uniform_real_distribution<double> dist{-5.0, 5.0};
+    vector<Box> boxes;
+    for (int i = 0; i < n; ++i) {
+      Box box{box_};
+      for (int j = 0; j < box.size(); ++j) {
+        const double a{dist(random_generator_)};
+        const double b{dist(random_generator_)};
+        box[j] = Box::Interval{std::min(a, b), std::max(a, b)};
+      }
+      boxes.push_back(box);
+    }
+    return boxes;
+  }
+
+  static vector<const Box*> Pointers(const vector<Box>& boxes) {
+    vector<const Box*> pointers;
+    for (const Box& box : boxes) {
+      pointers.push_back(&box);
+    }
+    return pointers;
+  }
+
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  const Variable z_{"z"};
+  Box box_;
+  std::mt19937 random_generator_{1234};
+};
+
+TEST_F(BoxBatchEvaluatorTest, Enclosure) {
+  const vector<Formula> formulas{
+      x_ * y_ - z_ >= 0,
+      x_ * x_ + 2 * y_ * y_ <= 3 * z_ - 1,
+      !(sin(x_) + exp(y_ / 5) > z_),
+      pow(x_, 3) - abs(y_) * z_ == 0,
+      x_ + y_ + z_ < 1.5,
+  };
+  vector<FormulaEvaluator> formula_evaluators;
+  for (const Formula& f : formulas) {
+    formula_evaluators.push_back(make_relational_formula_evaluator(f));
+  }
+  const BoxBatchEvaluator evaluator{formula_evaluators};
+  ASSERT_EQ(evaluator.size(), static_cast<int>(formulas.size()));
+
+  // More boxes than a block, so that the last block is partial.
+  const vector<Box> boxes{RandomBoxes(150)};
+  vector<Box::Interval> evaluations;
+  evaluator.Evaluate(Pointers(boxes), &evaluations);
+  ASSERT_EQ(evaluations.size(), formulas.size() * boxes.size());
+
+  for (int i = 0; i < evaluator.size(); ++i) {
+    const Formula& f{formulas[evaluator.formula_index(i)]};
+    const Formula& atom{is_negation(f) ? get_operand(f) : f};
+    const Expression e{get_lhs_expression(atom) - get_rhs_expression(atom)};
+    for (size_t k = 0; k < boxes.size(); ++k) {
+      const Box& box{boxes[k]};
+      const Box::Interval& evaluation{evaluations[i * boxes.size() + k]};
+      // It includes the values at the corners and at the center.
+      for (const double t : {0.0, 0.5, 1.0}) {
+        Environment env;
+        for (const Variable& v : box.variables()) {
+          env.insert(v, box[v].lb() + t * (box[v].ub() - box[v].lb()));
+        }
+        EXPECT_TRUE(evaluation.contains(e.Evaluate(env)))
+            << f << " over\n"
+            << box;
+      }
+      // It is close to the evaluation by ibex.
+      const Box::Interval expected{
+          formula_evaluators[evaluator.formula_index(i)](box).evaluation()};
+      const double tolerance{1e-9 * (1.0 + expected.mag())};
+      EXPECT_NEAR(evaluation.lb(), expected.lb(), tolerance);
+      EXPECT_NEAR(evaluation.ub(), expected.ub(), tolerance);
+    }
+  }
+}
+
+TEST_F(BoxBatchEvaluatorTest, FindUnsat) {
+  const vector<FormulaEvaluator> formula_evaluators{
+      make_relational_formula_evaluator(x_ * x_ + y_ * y_ <= 4),
+      make_relational_formula_evaluator(x_ - z_ > 1),
+  };
+  const BoxBatchEvaluator evaluator{formula_evaluators};
+
+  const vector<Box> boxes{RandomBoxes(100)};
+  vector<int> unsat;
+  evaluator.FindUnsat(Pointers(boxes), &unsat);
+  ASSERT_EQ(unsat.size(), boxes.size());
+  for (size_t k = 0; k < boxes.size(); ++k) {
+    int expected{-1};
+    for (size_t i = 0; i < formula_evaluators.size(); ++i) {
+      if (formula_evaluators[i](boxes[k]).type() ==
+          FormulaEvaluationResult::Type::UNSAT) {
+        expected = static_cast<int>(i);
+        break;
+      }
+    }
+    EXPECT_EQ(unsat[k], expected) << boxes[k];
+  }
+}
+
+TEST_F(BoxBatchEvaluatorTest, BoxLayouts) {
+  const vector<FormulaEvaluator> formula_evaluators{
+      make_relational_formula_evaluator(x_ - 2 * z_ > 0)};
+  const BoxBatchEvaluator evaluator{formula_evaluators};
+
+  Box box1{box_};
+  box1[x_] = Box::Interval{1, 2};
+  box1[z_] = Box::Interval{3, 4};
+
+  // The same values in a box with a different layout.
+  Box box2;
+  box2.Add(z_, 0, 0.25);
+  box2.Add(x_, 1, 2);
+
+  vector<Box::Interval> evaluations;
+  evaluator.Evaluate({&box1, &box2}, &evaluations);
+  ASSERT_EQ(evaluations.size(), 2u);
+  EXPECT_TRUE(evaluations[0].contains(-7.0));
+  EXPECT_TRUE(evaluations[0].contains(-4.0));
+  EXPECT_LT(evaluations[0].ub(), 0.0);
+  EXPECT_TRUE(evaluations[1].contains(0.5));
+  EXPECT_TRUE(evaluations[1].contains(2.0));
+
+  vector<int> unsat;
+  evaluator.FindUnsat({&box1, &box2}, &unsat);
+  EXPECT_EQ(unsat, (vector<int>{0, -1}));
+}
+
+TEST_F(BoxBatchEvaluatorTest, IndeterminateForms) {
+  // [-∞, ∞] × [0, 0] is [0, 0] while the products of the bounds include
+  // NaN. The batched evaluation falls back to ibex for such a lane.
+  const vector<FormulaEvaluator> formula_evaluators{
+      make_relational_formula_evaluator(x_ * y_ > 1)};
+  const BoxBatchEvaluator evaluator{formula_evaluators};
+
+  const double inf{numeric_limits<double>::infinity()};
+  Box box1{box_};
+  box1[y_] = Box::Interval{0, 0};
+  Box box2{box_};
+  box2[x_] = Box::Interval{-inf, inf};
+  box2[y_] = Box::Interval{1, 2};
+
+  vector<Box::Interval> evaluations;
+  evaluator.Evaluate({&box1, &box2}, &evaluations);
+  EXPECT_TRUE(evaluations[0].contains(-1.0));
+  EXPECT_LT(evaluations[0].ub(), 0.0);
+  EXPECT_EQ(evaluations[1].lb(), -inf);
+  EXPECT_EQ(evaluations[1].ub(), inf);
+
+  vector<int> unsat;
+  evaluator.FindUnsat({&box1, &box2}, &unsat);
+  EXPECT_EQ(unsat, (vector<int>{0, -1}));
+}
+
+TEST_F(BoxBatchEvaluatorTest, UnsupportedFormulas) {
+  // A formula with an if-then-else is not handled.
+  const vector<FormulaEvaluator> formula_evaluators{
+      make_relational_formula_evaluator(if_then_else(x_ > y_, x_, y_) > z_),
+      make_relational_formula_evaluator(x_ > z_),
+  };
+  const BoxBatchEvaluator evaluator{formula_evaluators};
+  ASSERT_EQ(evaluator.size(), 1);
+  EXPECT_EQ(evaluator.formula_index(0), 1);
+
+  Box box{box_};
+  box[x_] = Box::Interval{0, 1};
+  box[z_] = Box::Interval{2, 3};
+  vector<int> unsat;
+  evaluator.FindUnsat({&box}, &unsat);
+  EXPECT_EQ(unsat, (vector<int>{1}));
+}
+
+}  // namespace
+}  // namespace dreal
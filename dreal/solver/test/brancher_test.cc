@@ -0,0 +1,184 @@
+#include "dreal/solver/brancher.h"
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace dreal {
+namespace {
+
+using std::shared_ptr;
+using std::unique_ptr;
+using std::vector;
+
+class BrancherTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    box_.Add(x_, -1, 1);
+    box_.Add(y_, -2, 2);
+    box_.Add(z_, -3, 3);
+    active_set_ = DynamicBitset(box_.size());
+    active_set_.set();
+  }
+
+  unique_ptr<StatefulBrancher> Make(const BranchingHeuristic heuristic,
+                                    const vector<Formula>& formulas) const {
+    return MakeStatefulBrancher(heuristic, BranchLargestFirst, formulas);
+  }
+
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  const Variable z_{"z"};
+  Box box_;
+  DynamicBitset active_set_;
+};
+
+TEST_F(BrancherTest, LargestFirst) {
+  const unique_ptr<StatefulBrancher> brancher{
+      Make(BranchingHeuristic::LargestFirst, {})};
+  Box left;
+  Box right;
+  EXPECT_EQ((*brancher)(box_, active_set_, &left, &right), box_.index(z_));
+  EXPECT_EQ(left[z_], Box::Interval(-3, 0));
+  EXPECT_EQ(right[z_], Box::Interval(0, 3));
+  EXPECT_EQ(left[x_], box_[x_]);
+}
+
+TEST_F(BrancherTest, SmearSumRelative) {
+  // z is the widest, but x dominates the smears of both constraints.
+  const vector<Formula> formulas{100 * x_ + y_ + z_ == 0,
+                                 exp(5 * x_) - z_ >= 1};
+  const unique_ptr<StatefulBrancher> brancher{
+      Make(BranchingHeuristic::SmearSumRelative, formulas)};
+  Box left;
+  Box right;
+  EXPECT_EQ((*brancher)(box_, active_set_, &left, &right), box_.index(x_));
+
+  // Only the active dimensions are considered.
+  DynamicBitset active_set(box_.size());
+  active_set.set(box_.index(y_));
+  active_set.set(box_.index(z_));
+  EXPECT_EQ((*brancher)(box_, active_set, &left, &right), box_.index(z_));
+}
+
+TEST_F(BrancherTest, SmearSumRelativeFallback) {
+  // Bounds are ignored. Without a smear, it branches on the widest one.
+  const unique_ptr<StatefulBrancher> brancher{
+      Make(BranchingHeuristic::SmearSumRelative, {x_ >= 0, abs(y_) <= 1})};
+  Box left;
+  Box right;
+  EXPECT_EQ((*brancher)(box_, active_set_, &left, &right), box_.index(z_));
+}
+
+TEST_F(BrancherTest, SharedSmearGradients) {
+  EXPECT_FALSE(MakeSmearGradient(x_ >= 0));
+  EXPECT_FALSE(MakeSmearGradient(abs(y_) <= 1));
+  const vector<shared_ptr<const AutoDiff>> gradients{
+      MakeSmearGradient(100 * x_ + y_ + z_ == 0),
+      MakeSmearGradient(!(exp(5 * x_) - z_ < 1))};
+  ASSERT_TRUE(gradients[0] && gradients[1]);
+
+  // The branchers made from the same gradients share them.
+  for (const BranchingHeuristic heuristic :
+       {BranchingHeuristic::SmearSumRelative, BranchingHeuristic::Hybrid}) {
+    const unique_ptr<StatefulBrancher> brancher1{
+        MakeStatefulBrancher(heuristic, BranchLargestFirst, gradients)};
+    const unique_ptr<StatefulBrancher> brancher2{
+        MakeStatefulBrancher(heuristic, BranchLargestFirst, gradients)};
+    Box left;
+    Box right;
+    EXPECT_EQ((*brancher1)(box_, active_set_, &left, &right), box_.index(x_));
+    EXPECT_EQ((*brancher2)(box_, active_set_, &left, &right), box_.index(x_));
+  }
+  EXPECT_EQ(gradients[0].use_count(), 1);
+}
+
+TEST_F(BrancherTest, RoundRobin) {
+  const unique_ptr<StatefulBrancher> brancher{
+      Make(BranchingHeuristic::RoundRobin, {})};
+  Box left;
+  Box right;
+  EXPECT_EQ((*brancher)(box_, active_set_, &left, &right), 0);
+  EXPECT_EQ((*brancher)(box_, active_set_, &left, &right), 1);
+  EXPECT_EQ((*brancher)(box_, active_set_, &left, &right), 2);
+  EXPECT_EQ((*brancher)(box_, active_set_, &left, &right), 0);
+
+  // Skip the inactive and the degenerated dimensions.
+  Box box{box_};
+  box[0] = Box::Interval{1, 1};
+  DynamicBitset active_set(box_.size());
+  active_set.set(0);
+  active_set.set(2);
+  EXPECT_EQ((*brancher)(box, active_set, &left, &right), 2);
+  EXPECT_EQ((*brancher)(box, active_set, &left, &right), 2);
+}
+
+TEST_F(BrancherTest, MaxImpact) {
+  const unique_ptr<StatefulBrancher> brancher{
+      Make(BranchingHeuristic::MaxImpact, {})};
+  EXPECT_TRUE(brancher->uses_pruning());
+  // Branching on z has no impact while branching on y halves all the
+  // dimensions.
+  Box pruned{box_};
+  for (int i = 0; i < 10; ++i) {
+    brancher->Pruned(box_.index(z_), box_, box_);
+    for (int j = 0; j < box_.size(); ++j) {
+      pruned[j] = Box::Interval{box_[j].lb(), box_[j].mid()};
+    }
+    brancher->Pruned(box_.index(y_), box_, pruned);
+  }
+  Box left;
+  Box right;
+  EXPECT_EQ((*brancher)(box_, active_set_, &left, &right), box_.index(y_));
+}
+
+TEST_F(BrancherTest, Hybrid) {
+  const unique_ptr<StatefulBrancher> brancher{
+      Make(BranchingHeuristic::Hybrid, {100 * x_ + y_ + z_ == 0})};
+  EXPECT_TRUE(brancher->uses_pruning());
+  Box left;
+  Box right;
+  EXPECT_EQ((*brancher)(box_, active_set_, &left, &right), box_.index(x_));
+}
+
+TEST_F(BrancherTest, Unbounded) {
+  // An unbounded dimension is branched first.
+  box_[y_] = Box::Interval{0, std::numeric_limits<double>::infinity()};
+  for (const BranchingHeuristic heuristic :
+       {BranchingHeuristic::SmearSumRelative, BranchingHeuristic::MaxImpact,
+        BranchingHeuristic::Hybrid}) {
+    const unique_ptr<StatefulBrancher> brancher{
+        Make(heuristic, {100 * x_ + y_ + z_ == 0})};
+    Box left;
+    Box right;
+    EXPECT_EQ((*brancher)(box_, active_set_, &left, &right), box_.index(y_))
+        << heuristic;
+  }
+}
+
+TEST_F(BrancherTest, MultisectLargestFirst) {
+  const vector<Box> boxes{MultisectLargestFirst(box_, active_set_, 12)};
+  // z is split into 8 pieces and then y is split into 2.
+  ASSERT_EQ(boxes.size(), 16u);
+  double volume{0.0};
+  for (const Box& b : boxes) {
+    EXPECT_EQ(b[x_], box_[x_]);
+    EXPECT_EQ(b[y_].diam(), 2.0);
+    EXPECT_EQ(b[z_].diam(), 0.75);
+    volume += b[y_].diam() * b[z_].diam();
+  }
+  EXPECT_DOUBLE_EQ(volume, box_[y_].diam() * box_[z_].diam());
+
+  // Only the active dimensions are split.
+  DynamicBitset active_set(box_.size());
+  active_set.set(box_.index(x_));
+  for (const Box& b : MultisectLargestFirst(box_, active_set, 4)) {
+    EXPECT_EQ(b[x_].diam(), 0.5);
+    EXPECT_EQ(b[z_], box_[z_]);
+  }
+}
+
+}  // namespace
+}  // namespace dreal
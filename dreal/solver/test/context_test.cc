@@ -1,5 +1,8 @@
 #include "dreal/solver/context.h"
 
+#include <stdexcept>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "dreal/symbolic/symbolic.h"
@@ -45,5 +48,195 @@ TEST_F(ContextTest, AssertionsAndBox) {
   EXPECT_EQ(box[x_].ub(), 5.0);
 }
 
+TEST_F(ContextTest, SymbolicArena) {
+  Formula escaped;
+  {
+    Config config;
+    config.mutable_use_symbolic_arena() = true;
+    Context context{config};
+    context.DeclareVariable(x_);
+    context.Assert(x_ >= 0);
+    context.Assert(sin(x_) == 1.0 || cos(x_) == 0.0);
+    EXPECT_TRUE(context.CheckSat());
+    escaped = context.assertions()[0];
+  }
+  // The formulas built inside of the context outlive it.
+  EXPECT_TRUE(escaped.EqualTo(sin(x_) == 1.0 || cos(x_) == 0.0));
+}
+
+TEST_F(ContextTest, IcpBatchSize) {
+  const Variable y{"y"};
+  Config config;
+  config.mutable_icp_batch_size() = 4;
+  // The maximum of x + y on the unit disk is √2.
+  for (const double c : {1.4, 1.5}) {
+    Context context{config};
+    context.DeclareVariable(x_, -10, 10);
+    context.DeclareVariable(y, -10, 10);
+    context.Assert(x_ * x_ + y * y <= 1);
+    context.Assert(x_ + y >= c);
+    const optional<Box> result{context.CheckSat()};
+    EXPECT_EQ(static_cast<bool>(result), c < 1.5);
+  }
+}
+
+TEST_F(ContextTest, PipelinedTheorySolver) {
+  const Variable y{"y"};
+  Config config;
+  config.mutable_use_pipelined_theory_solver() = true;
+  config.mutable_number_of_jobs() = 2;
+  Context context{config};
+  context.DeclareVariable(x_, -10, 10);
+  context.DeclareVariable(y, -10, 10);
+  // Only the last disjunct of the first assertion is consistent with
+  // the others.
+  context.Assert(x_ + y >= 5 || x_ * y >= 30 || x_ - y >= 3);
+  context.Assert(x_ <= 1);
+  context.Assert(y <= 1);
+  context.Push(1);
+  context.Assert(x_ + y >= 0);
+  const optional<Box> result1{context.CheckSat()};
+  ASSERT_TRUE(result1);
+  EXPECT_GE((*result1)[x_].ub() - (*result1)[y].lb(), 3 - 1e-3);
+  context.Assert(y >= 0);
+  EXPECT_FALSE(context.CheckSat());
+  context.Pop(1);
+
+  // The models blocked in the pipeline are not blocked anymore.
+  EXPECT_TRUE(context.CheckSat());
+}
+
+TEST_F(ContextTest, PipelinedTheorySolverForall) {
+  const Variable y{"y"};
+  Config config;
+  config.mutable_use_pipelined_theory_solver() = true;
+  config.mutable_number_of_jobs() = 2;
+  Context context{config};
+  context.DeclareVariable(x_, -3, 3.14);
+  // ∀y ∈ [7, 50]. -50 ≤ xy ≤ -7 holds only if x = -1.
+  context.Assert(forall(
+      {y}, !(7 <= y) || !(y <= 50) || (x_ * y >= -50 && x_ * y <= -7)));
+  context.Assert(x_ >= 0 || x_ <= -0.5);
+  const optional<Box> result{context.CheckSat()};
+  ASSERT_TRUE(result);
+  EXPECT_NEAR((*result)[x_].mid(), -1.0, 1e-2);
+  context.Assert(x_ >= -0.5);
+  EXPECT_FALSE(context.CheckSat());
+}
+
+TEST_F(ContextTest, CheckSatAssuming) {
+  const Variable y{"y"};
+  const Variable b1{"b1", Variable::Type::BOOLEAN};
+  const Variable b2{"b2", Variable::Type::BOOLEAN};
+  context_.DeclareVariable(y, -10, 10);
+  context_.DeclareVariable(b1);
+  context_.DeclareVariable(b2);
+  context_.Assert(x_ == y + 5);
+  context_.Assert(imply(b1, y == x_ - 3));
+
+  EXPECT_FALSE(context_.CheckSatAssuming({Formula{b1}, Formula{b2}}));
+  ASSERT_EQ(context_.get_unsat_assumptions().size(), 1u);
+  EXPECT_TRUE(context_.get_unsat_assumptions()[0].EqualTo(Formula{b1}));
+
+  // The assumptions are not asserted.
+  EXPECT_TRUE(context_.CheckSatAssuming({Formula{b2}}));
+  EXPECT_TRUE(context_.get_unsat_assumptions().empty());
+  EXPECT_TRUE(context_.CheckSat());
+
+  // An assumption which is not a literal.
+  const Formula f{x_ <= y};
+  EXPECT_FALSE(context_.CheckSatAssuming({f, Formula{b2}}));
+  ASSERT_EQ(context_.get_unsat_assumptions().size(), 1u);
+  EXPECT_TRUE(context_.get_unsat_assumptions()[0].EqualTo(f));
+  EXPECT_FALSE(context_.CheckSatAssuming({f, Formula::False()}));
+  ASSERT_EQ(context_.get_unsat_assumptions().size(), 1u);
+  EXPECT_TRUE(is_false(context_.get_unsat_assumptions()[0]));
+  EXPECT_TRUE(context_.CheckSatAssuming({!f}));
+}
+
+// Returns the number of the Boolean variables in @p vars which are
+// assigned in the model of the context after a push and a pop. With
+// Config::SatBackendType::Assumption, the model is the partial one of
+// PicoSAT, which assigns one variable per clause.
+int CountAssignedAfterPushPop(Context* context,
+                              const std::vector<Variable>& vars) {
+  context->Assert(vars[0] || vars[1]);
+  context->Push(1);
+  context->Pop(1);
+  const optional<Box> result{context->CheckSat()};
+  EXPECT_TRUE(result);
+  int num_assigned{0};
+  for (const Variable& var : vars) {
+    num_assigned += result && (*result)[var].diam() == 0.0;
+  }
+  return num_assigned;
+}
+
+TEST_F(ContextTest, SatBackendOption) {
+  const std::vector<Variable> vars{Variable{"b1", Variable::Type::BOOLEAN},
+                                   Variable{"b2", Variable::Type::BOOLEAN}};
+  Context context1;
+  Context context2;
+  for (const Variable& var : vars) {
+    context1.DeclareVariable(var);
+    context2.DeclareVariable(var);
+  }
+  context2.SetOption(":sat-backend", "assumption");
+  EXPECT_EQ(context2.config().sat_backend(),
+            Config::SatBackendType::Assumption);
+  EXPECT_EQ(CountAssignedAfterPushPop(&context1, vars), 2);
+  EXPECT_EQ(CountAssignedAfterPushPop(&context2, vars), 1);
+
+  // It cannot be changed once the SAT solver is in use.
+  EXPECT_THROW(context2.SetOption(":sat-backend", "picosat"),
+               std::runtime_error);
+}
+
+TEST_F(ContextTest, PolarityAwareCnfOption) {
+  const Variable y{"y"};
+  context_.DeclareVariable(y, -10, 10);
+  context_.SetOption(":polarity-aware-cnf", "true");
+  EXPECT_TRUE(context_.config().use_polarity_aware_cnf());
+
+  // The formulas are CNFized in the new mode.
+  context_.Assert((x_ >= 0 && y >= 0) || (x_ <= -1 && y <= -1));
+  context_.Assert(!((x_ >= 0 && y >= -20) || x_ + y <= -10));
+  const optional<Box> result{context_.CheckSat()};
+  ASSERT_TRUE(result);
+  EXPECT_LE((*result)[x_].ub(), -1 + 1e-3);
+  EXPECT_LE((*result)[y].ub(), -1 + 1e-3);
+
+  // It cannot be changed once the SAT solver is in use.
+  EXPECT_THROW(context_.SetOption(":polarity-aware-cnf", "false"),
+               std::runtime_error);
+  EXPECT_TRUE(context_.config().use_polarity_aware_cnf());
+}
+
+TEST_F(ContextTest, TheoryLemmaStore) {
+  const Variable y{"y"};
+  Config config;
+  config.mutable_theory_lemma_store_size() = 100;
+  Context context{config};
+  context.DeclareVariable(x_, -10, 10);
+  context.DeclareVariable(y, -10, 10);
+  context.Assert(x_ + y >= 5 || x_ * y >= 30 || x_ - y >= 3);
+  context.Assert(y >= 0);
+  for (int i = 0; i < 2; ++i) {
+    context.Push(1);
+    // It narrows the box. The lemmas learned here do not hold after Pop.
+    context.Assert(x_ <= 1);
+    context.Assert(y <= 1);
+    EXPECT_FALSE(context.CheckSat());
+    context.Pop(1);
+
+    // The lemmas which are still valid are learned again.
+    context.Push(1);
+    context.Assert(x_ * y >= 30);
+    EXPECT_TRUE(context.CheckSat());
+    context.Pop(1);
+    EXPECT_TRUE(context.CheckSat());
+  }
+}
+
 }  // namespace
 }  // namespace dreal
@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 
 #include <gtest/gtest.h>
 
@@ -11,6 +12,7 @@ namespace {
 using std::cerr;
 using std::endl;
 using std::ostringstream;
+using std::runtime_error;
 
 class ExpressionEvaluatorTest : public ::testing::Test {
  protected:
@@ -40,7 +42,55 @@ TEST_F(ExpressionEvaluatorTest, Arithmetic1) {
   EXPECT_EQ(oss.str(), "ExpressionEvaluator((x + y + z))");
 }
 
-// TODO(soonho): Add more tests.
+TEST_F(ExpressionEvaluatorTest, BoxLayouts) {
+  const Expression e{x_ * y_ - z_};
+  const ExpressionEvaluator evaluator{e};
+
+  box_[x_] = Box::Interval{1, 2};
+  box_[y_] = Box::Interval{2, 3};
+  box_[z_] = Box::Interval{3, 4};
+  const Box::Interval expected{evaluator(box_)};
+  EXPECT_TRUE(expected.is_superset(Box::Interval(1 * 2 - 4, 2 * 3 - 3)));
+
+  // The same values in a box with a different layout.
+  const Variable w{"w"};
+  Box box2;
+  box2.Add(w, 0, 1);
+  box2.Add(z_, 3, 4);
+  box2.Add(x_, 1, 2);
+  box2.Add(y_, 2, 3);
+  EXPECT_EQ(evaluator(box2), expected);
+  EXPECT_EQ(evaluator(box_), expected);
+}
+
+TEST_F(ExpressionEvaluatorTest, PowWithPointExponent) {
+  const ExpressionEvaluator evaluator{pow(x_, y_)};
+  box_[x_] = Box::Interval{-1, 2};
+  box_[y_] = Box::Interval{2, 2};
+  EXPECT_EQ(evaluator(box_), sqr(Box::Interval(-1, 2)));
+}
+
+TEST_F(ExpressionEvaluatorTest, EnclosureMode) {
+  // The natural extension of x² - 2x over x ∈ [0, 2] is [-4, 4] while
+  // its range is [-1, 0].
+  const Expression e{x_ * x_ - 2 * x_};
+  box_[x_] = Box::Interval{0, 2};
+  const Box::Interval natural{ExpressionEvaluator{e}(box_)};
+  for (const EnclosureMode mode :
+       {EnclosureMode::MeanValue, EnclosureMode::Affine, EnclosureMode::Taylor,
+        EnclosureMode::Adaptive}) {
+    const ExpressionEvaluator evaluator{e, mode};
+    const Box::Interval enclosure{evaluator(box_)};
+    EXPECT_TRUE(enclosure.contains(-1.0)) << mode;
+    EXPECT_TRUE(enclosure.contains(0.0)) << mode;
+    EXPECT_LT(enclosure.diam(), natural.diam()) << mode;
+  }
+}
+
+TEST_F(ExpressionEvaluatorTest, IfThenElse) {
+  const ExpressionEvaluator evaluator{if_then_else(x_ > y_, x_, y_)};
+  EXPECT_THROW(evaluator(box_), runtime_error);
+}
 
 }  // namespace
 }  // namespace dreal
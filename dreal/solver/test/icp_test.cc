@@ -1,12 +1,160 @@
 #include "dreal/solver/icp.h"
 
+#include <vector>
+
 #include <gtest/gtest.h>
 
 namespace dreal {
 namespace {
 
-GTEST_TEST(ICP, Test) {
-  // Add
+using std::vector;
+
+class IcpTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    box_.Add(x_, -10, 10);
+    box_.Add(y_, -10, 10);
+    box_.Add(z_, -10, 10);
+  }
+
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  const Variable z_{"z"};
+  Box box_;
+};
+
+// Checks that IncrementalBoxEvaluator gives the same results as
+// EvaluateBox over a lineage of boxes.
+TEST_F(IcpTest, IncrementalBoxEvaluator) {
+  const vector<FormulaEvaluator> formula_evaluators{
+      make_relational_formula_evaluator(x_ * x_ + y_ <= 5),
+      make_relational_formula_evaluator(sin(y_) + z_ > -1),
+      make_relational_formula_evaluator(z_ * z_ < 50),
+      make_relational_formula_evaluator(x_ - z_ >= -15),
+  };
+  const IncrementalBoxEvaluator evaluator{formula_evaluators, box_};
+  const double precision{0.001};
+
+  ContractorStatus cs1{box_};
+  IncrementalBoxEvaluator::Results results;
+  const optional<DynamicBitset> result1{
+      evaluator(box_, precision, nullptr, &results, &cs1)};
+  ContractorStatus expected_cs1{box_};
+  const optional<DynamicBitset> expected1{
+      EvaluateBox(formula_evaluators, box_, precision, &expected_cs1)};
+  ASSERT_TRUE(result1);
+  ASSERT_TRUE(expected1);
+  EXPECT_EQ(*result1, *expected1);
+  ASSERT_EQ(results.size(), formula_evaluators.size());
+  const IncrementalBoxEvaluator::Snapshot snapshot{box_, results};
+
+  // Only z changes. The first formula is not re-evaluated.
+  Box box2{box_};
+  box2[z_] = Box::Interval{-5, 5};
+  ContractorStatus cs2{box2};
+  const optional<DynamicBitset> result2{
+      evaluator(box2, precision, &snapshot, &results, &cs2)};
+  ContractorStatus expected_cs2{box2};
+  const optional<DynamicBitset> expected2{
+      EvaluateBox(formula_evaluators, box2, precision, &expected_cs2)};
+  ASSERT_TRUE(result2);
+  ASSERT_TRUE(expected2);
+  EXPECT_EQ(*result2, *expected2);
+  for (size_t i = 0; i < formula_evaluators.size(); ++i) {
+    const FormulaEvaluationResult expected{formula_evaluators[i](box2)};
+    ASSERT_TRUE(results[i]);
+    EXPECT_EQ(results[i]->type(), expected.type());
+    EXPECT_EQ(results[i]->evaluation(), expected.evaluation());
+  }
+
+  // x changes such that the first formula is UNSAT.
+  Box box3{box_};
+  box3[x_] = Box::Interval{4, 5};
+  ContractorStatus cs3{box3};
+  EXPECT_FALSE(evaluator(box3, precision, &snapshot, &results, &cs3));
+  EXPECT_TRUE(cs3.box().empty());
+  EXPECT_EQ(cs3.Explanation().size(), 1u);
+  EXPECT_EQ(cs3.Explanation().count(formula_evaluators[0].formula()), 1u);
+}
+
+// Checks that the evaluators which often refute boxes go first.
+TEST_F(IcpTest, IncrementalBoxEvaluatorOrder) {
+  const vector<FormulaEvaluator> formula_evaluators{
+      make_relational_formula_evaluator(x_ + y_ > 30),
+      make_relational_formula_evaluator(x_ - y_ > 30),
+  };
+  // Only the second one has refuted boxes so far.
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(formula_evaluators[1](box_).type(),
+              FormulaEvaluationResult::Type::UNSAT);
+  }
+  EXPECT_EQ(formula_evaluators[0].refutation_rate(), 0.0);
+  EXPECT_EQ(formula_evaluators[1].refutation_rate(), 1.0);
+  EXPECT_GT(formula_evaluators[1].average_cost(), 0.0);
+
+  // Both refute box_. The second one is responsible for the UNSAT.
+  const IncrementalBoxEvaluator evaluator{formula_evaluators, box_};
+  ContractorStatus cs{box_};
+  IncrementalBoxEvaluator::Results results;
+  EXPECT_FALSE(evaluator(box_, 0.001, nullptr, &results, &cs));
+  EXPECT_EQ(cs.Explanation().size(), 1u);
+  EXPECT_EQ(cs.Explanation().count(formula_evaluators[1].formula()), 1u);
+  EXPECT_FALSE(results[0]);
+}
+
+// Checks that a fixed order ignores the statistics.
+TEST_F(IcpTest, IncrementalBoxEvaluatorFixedOrder) {
+  const vector<FormulaEvaluator> formula_evaluators{
+      make_relational_formula_evaluator(x_ + y_ > 30),
+      make_relational_formula_evaluator(x_ - y_ > 30),
+  };
+  for (int i = 0; i < 10; ++i) {
+    formula_evaluators[1](box_);
+  }
+  const IncrementalBoxEvaluator evaluator{
+      formula_evaluators, box_, IncrementalBoxEvaluator::Order::Fixed};
+  ContractorStatus cs{box_};
+  IncrementalBoxEvaluator::Results results;
+  EXPECT_FALSE(evaluator(box_, 0.001, nullptr, &results, &cs));
+  EXPECT_EQ(cs.Explanation().size(), 1u);
+  EXPECT_EQ(cs.Explanation().count(formula_evaluators[0].formula()), 1u);
+  EXPECT_FALSE(results[1]);
+}
+
+// Checks that the default order does not depend on the costs of the
+// evaluators. Both of them refute every box, so the given order is kept
+// whatever their measured costs are.
+TEST_F(IcpTest, IncrementalBoxEvaluatorOrderWithoutCost) {
+  const vector<FormulaEvaluator> formula_evaluators{
+      make_relational_formula_evaluator(x_ + y_ > 30),
+      make_relational_formula_evaluator(sin(x_) * cos(y_) > 30),
+  };
+  for (int i = 0; i < 10; ++i) {
+    formula_evaluators[0](box_);
+    formula_evaluators[1](box_);
+  }
+  EXPECT_EQ(formula_evaluators[0].refutation_rate(),
+            formula_evaluators[1].refutation_rate());
+
+  const IncrementalBoxEvaluator evaluator{formula_evaluators, box_};
+  ContractorStatus cs{box_};
+  IncrementalBoxEvaluator::Results results;
+  EXPECT_FALSE(evaluator(box_, 0.001, nullptr, &results, &cs));
+  EXPECT_EQ(cs.Explanation().size(), 1u);
+  EXPECT_EQ(cs.Explanation().count(formula_evaluators[0].formula()), 1u);
+  EXPECT_FALSE(results[1]);
+}
+
+TEST_F(IcpTest, MakeEvaluationOrder) {
+  Config config;
+  EXPECT_EQ(MakeEvaluationOrder(config),
+            IncrementalBoxEvaluator::Order::RefutationRate);
+  config.mutable_use_cost_based_evaluation_order() = true;
+  EXPECT_EQ(MakeEvaluationOrder(config),
+            IncrementalBoxEvaluator::Order::RefutationRatePerCost);
+  config.mutable_use_deterministic_icp() = true;
+  EXPECT_EQ(MakeEvaluationOrder(config),
+            IncrementalBoxEvaluator::Order::Fixed);
 }
 
 }  // namespace
@@ -0,0 +1,106 @@
+#include "dreal/solver/sat_backend.h"
+
+#include <memory>
+
+#include <gtest/gtest.h>
+
+namespace dreal {
+namespace {
+
+using std::unique_ptr;
+
+// Returns a backend of @p sat_backend.
+unique_ptr<SatBackend> Make(const Config::SatBackendType sat_backend) {
+  Config config;
+  config.mutable_sat_backend() = sat_backend;
+  return MakeSatBackend(config);
+}
+
+const Config::SatBackendType kSatBackends[] = {
+    Config::SatBackendType::Picosat, Config::SatBackendType::Assumption};
+
+TEST(SatBackendTest, Solve) {
+  for (const Config::SatBackendType sat_backend : kSatBackends) {
+    const unique_ptr<SatBackend> backend{Make(sat_backend)};
+    const int a{backend->NewVariable()};
+    const int b{backend->NewVariable()};
+    // (a ∨ b) ∧ ¬a
+    backend->AddClause({a, b}, 0);
+    backend->AddClause({-a}, 0);
+    ASSERT_EQ(backend->Solve(-1), SatBackend::Result::Sat) << sat_backend;
+    EXPECT_EQ(backend->Value(b), 1) << sat_backend;
+    EXPECT_EQ(backend->TopLevelValue(a), -1) << sat_backend;
+    backend->AddClause({-b}, 0);
+    EXPECT_EQ(backend->Solve(-1), SatBackend::Result::Unsat) << sat_backend;
+  }
+}
+
+TEST(SatBackendTest, PushPop) {
+  for (const Config::SatBackendType sat_backend : kSatBackends) {
+    const unique_ptr<SatBackend> backend{Make(sat_backend)};
+    const int a{backend->NewVariable()};
+    const int b{backend->NewVariable()};
+    backend->AddClause({a, b}, 0);
+    backend->Push();
+    backend->Push();
+    EXPECT_EQ(backend->level(), 2) << sat_backend;
+    backend->AddClause({-a}, 2);
+    backend->AddClause({-b}, 2);
+    EXPECT_EQ(backend->Solve(-1), SatBackend::Result::Unsat) << sat_backend;
+    backend->Pop();
+    EXPECT_EQ(backend->level(), 1) << sat_backend;
+    EXPECT_EQ(backend->Solve(-1), SatBackend::Result::Sat) << sat_backend;
+    backend->Pop();
+    EXPECT_EQ(backend->level(), 0) << sat_backend;
+    EXPECT_EQ(backend->Solve(-1), SatBackend::Result::Sat) << sat_backend;
+  }
+}
+
+TEST(SatBackendTest, Assume) {
+  for (const Config::SatBackendType sat_backend : kSatBackends) {
+    const unique_ptr<SatBackend> backend{Make(sat_backend)};
+    const int a{backend->NewVariable()};
+    const int b{backend->NewVariable()};
+    const int c{backend->NewVariable()};
+    // a → b
+    backend->AddClause({-a, b}, 0);
+    backend->Push();
+    backend->Assume(a);
+    backend->Assume(-b);
+    backend->Assume(c);
+    ASSERT_EQ(backend->Solve(-1), SatBackend::Result::Unsat) << sat_backend;
+    EXPECT_TRUE(backend->Failed(a)) << sat_backend;
+    EXPECT_TRUE(backend->Failed(-b)) << sat_backend;
+    EXPECT_FALSE(backend->Failed(c)) << sat_backend;
+    // The assumptions are dropped.
+    EXPECT_EQ(backend->Solve(-1), SatBackend::Result::Sat) << sat_backend;
+    backend->Pop();
+  }
+}
+
+TEST(SatBackendTest, AddClauseToOuterScope) {
+  // PicoSAT adds a clause to the current scope only. So it is only
+  // supported by the assumption-based backend.
+  const unique_ptr<SatBackend> backend{
+      Make(Config::SatBackendType::Assumption)};
+  const int a{backend->NewVariable()};
+  const int b{backend->NewVariable()};
+  backend->Push();
+  backend->Push();
+  EXPECT_EQ(backend->AddClause({-a}, 1), 1);
+  EXPECT_EQ(backend->AddClause({-b}, 2), 2);
+  backend->Pop();
+  // ¬b is retracted, but ¬a is not.
+  backend->AddClause({a, b}, 0);
+  ASSERT_EQ(backend->Solve(-1), SatBackend::Result::Sat);
+  EXPECT_EQ(backend->Value(a), -1);
+  EXPECT_EQ(backend->Value(b), 1);
+  backend->Pop();
+  // ¬a is retracted.
+  backend->AddClause({-b}, 0);
+  ASSERT_EQ(backend->Solve(-1), SatBackend::Result::Sat);
+  EXPECT_EQ(backend->Value(a), 1);
+}
+
+}  // namespace
+}  // namespace dreal
@@ -1,5 +1,8 @@
 #include "dreal/solver/sat_solver.h"
 
+#include <set>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "dreal/solver/config.h"
@@ -62,5 +65,150 @@ TEST_F(SatSolverTest, UNSAT2) {
   EXPECT_FALSE(sat_.CheckSat());
 }
 
+TEST_F(SatSolverTest, TheoryPropagation) {
+  const Variable x{"x"};
+  // (x > 3) ∧ (x < 1 ∨ b1). The other clauses need decisions so that the
+  // search is interrupted.
+  sat_.AddFormula(x > 3);
+  sat_.AddFormula(x < 1 || b1_);
+  std::vector<Variable> bs;
+  for (int i = 0; i < 20; ++i) {
+    bs.emplace_back("b" + std::to_string(i + 3), Variable::Type::BOOLEAN);
+  }
+  for (int i = 0; i + 1 < 20; ++i) {
+    sat_.AddFormula(bs[i] || bs[i + 1]);
+  }
+
+  // The theory side finds that x > 3 implies ¬(x < 1).
+  int num_calls{0};
+  const auto propagator = [&](const std::vector<Formula>& assigned,
+                              const std::vector<Formula>& unassigned) {
+    ++num_calls;
+    EXPECT_FALSE(assigned.empty());
+    std::vector<std::set<Formula>> result;
+    for (const Formula& f : unassigned) {
+      result.push_back({x > 3, f});
+    }
+    return result;
+  };
+  const auto model = sat_.CheckSat(1, propagator);
+  ASSERT_TRUE(model);
+  EXPECT_GE(num_calls, 1);
+  for (const SatSolver::Literal& l : model->second) {
+    EXPECT_EQ(l.second, sat_.theory_literal(l.first).EqualTo(x > 3));
+  }
+}
+
+// Checks that the sliced search terminates when the propagator has
+// nothing to learn and the instance needs more decisions than a slice.
+TEST_F(SatSolverTest, TheoryPropagationWithoutProgress) {
+  std::vector<Variable> bs;
+  for (int i = 0; i < 200; ++i) {
+    bs.emplace_back("b" + std::to_string(i + 3), Variable::Type::BOOLEAN);
+  }
+  for (int i = 0; i + 1 < 200; ++i) {
+    sat_.AddFormula(bs[i] || bs[i + 1]);
+  }
+  const auto propagator = [](const std::vector<Formula>&,
+                             const std::vector<Formula>&) {
+    return std::vector<std::set<Formula>>{};
+  };
+  const auto model = sat_.CheckSat(1, propagator);
+  ASSERT_TRUE(model);
+  EXPECT_FALSE(model->first.empty());
+}
+
+// Returns a config which uses @p sat_backend.
+Config MakeConfig(const Config::SatBackendType sat_backend) {
+  Config config;
+  config.mutable_sat_backend() = sat_backend;
+  return config;
+}
+
+TEST_F(SatSolverTest, PushPop) {
+  const Variable b3{"b3", Variable::Type::BOOLEAN};
+  for (const Config::SatBackendType sat_backend :
+       {Config::SatBackendType::Picosat, Config::SatBackendType::Assumption}) {
+    SatSolver sat{MakeConfig(sat_backend)};
+    sat.AddFormula(b1_ || b2_);
+    sat.Push();
+    EXPECT_EQ(sat.level(), 1);
+    sat.AddFormula(!b1_ && !b3);
+    sat.AddFormula(!b2_);
+    EXPECT_FALSE(sat.CheckSat()) << sat_backend;
+    sat.Pop();
+    EXPECT_EQ(sat.level(), 0);
+    const optional<SatSolver::Model> model{sat.CheckSat()};
+    ASSERT_TRUE(model) << sat_backend;
+    // b3 only appears in the popped scope.
+    for (const SatSolver::Literal& l : model->first) {
+      EXPECT_FALSE(l.first.equal_to(b3)) << sat_backend;
+    }
+
+    // Assert the same formula again.
+    sat.Push();
+    sat.AddFormula(!b1_);
+    const optional<SatSolver::Model> model2{sat.CheckSat()};
+    ASSERT_TRUE(model2) << sat_backend;
+    for (const SatSolver::Literal& l : model2->first) {
+      if (l.first.equal_to(b1_)) {
+        EXPECT_FALSE(l.second) << sat_backend;
+      }
+    }
+  }
+}
+
+TEST_F(SatSolverTest, Assumptions) {
+  const Variable x{"x"};
+  for (const Config::SatBackendType sat_backend :
+       {Config::SatBackendType::Picosat, Config::SatBackendType::Assumption}) {
+    SatSolver sat{MakeConfig(sat_backend)};
+    sat.AddFormula(imply(b1_, x > 0));
+    sat.AddFormula(imply(b2_, x < 0));
+    sat.AddLearnedClause({x > 0, x < 0});
+    sat.SetAssumptions({Formula{b1_}, Formula{b2_}});
+    EXPECT_FALSE(sat.CheckSat()) << sat_backend;
+    EXPECT_EQ(sat.failed_assumptions().size(), 2u) << sat_backend;
+
+    sat.SetAssumptions({Formula{b1_}});
+    EXPECT_TRUE(sat.CheckSat()) << sat_backend;
+    EXPECT_TRUE(sat.failed_assumptions().empty()) << sat_backend;
+
+    // The clauses are kept intact.
+    sat.SetAssumptions({});
+    sat.AddFormula(Formula{b2_});
+    sat.SetAssumptions({Formula{b1_}});
+    EXPECT_FALSE(sat.CheckSat()) << sat_backend;
+    ASSERT_EQ(sat.failed_assumptions().size(), 1u) << sat_backend;
+    EXPECT_TRUE(sat.failed_assumptions()[0].EqualTo(Formula{b1_}))
+        << sat_backend;
+  }
+}
+
+TEST_F(SatSolverTest, LearnedClauseSurvivesPop) {
+  const Variable x{"x"};
+  SatSolver sat{MakeConfig(Config::SatBackendType::Assumption)};
+  sat.AddFormula(x > 0 || b1_);
+  sat.AddFormula(x < 5 || b2_);
+  sat.Push();
+  sat.AddFormula(!b1_);
+  // A lemma ¬(x > 0) learned in the scope, which is valid at level 0, and
+  // a lemma ¬(x < 5) valid only in the scope.
+  sat.AddLearnedClause({x > 0}, 0);
+  sat.AddLearnedClause({x < 5});
+  EXPECT_FALSE(sat.CheckSat());
+  sat.Pop();
+
+  sat.Push();
+  sat.AddFormula(!b1_);
+  EXPECT_FALSE(sat.CheckSat());
+  sat.Pop();
+
+  sat.Push();
+  sat.AddFormula(!b2_);
+  EXPECT_TRUE(sat.CheckSat());
+  sat.Pop();
+}
+
 }  // namespace
 }  // namespace dreal
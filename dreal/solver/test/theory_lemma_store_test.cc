@@ -0,0 +1,123 @@
+#include "dreal/solver/theory_lemma_store.h"
+
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace dreal {
+namespace {
+
+using std::set;
+using std::vector;
+
+class TheoryLemmaStoreTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    config_.mutable_theory_lemma_store_size() = 4;
+    box_.Add(x_, -10, 10);
+    box_.Add(y_, -10, 10);
+  }
+
+  // Returns the lemmas passed to the callback of Reinstate, which adds
+  // them at @p level.
+  vector<set<Formula>> Reinstate(const Box& box, const int level) {
+    vector<set<Formula>> reinstated;
+    store_.Reinstate(box, [&reinstated, level](const set<Formula>& lemma) {
+      reinstated.push_back(lemma);
+      return level;
+    });
+    return reinstated;
+  }
+
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  const Formula f1_{x_ >= 2};
+  const Formula f2_{x_ + y_ <= 0};
+  const Formula f3_{y_ >= 0};
+  Config config_;
+  Box box_;
+  TheoryLemmaStore store_{config_};
+};
+
+TEST_F(TheoryLemmaStoreTest, Add) {
+  store_.Add(box_, {f1_, f2_, f3_}, 1);
+  EXPECT_EQ(store_.size(), 1);
+
+  // The same lemma is stored once.
+  store_.Add(box_, {f3_, f2_, f1_}, 1);
+  EXPECT_EQ(store_.size(), 1);
+
+  store_.Add(box_, {f1_, f3_}, 1);
+  EXPECT_EQ(store_.size(), 2);
+}
+
+TEST_F(TheoryLemmaStoreTest, PopAndReinstate) {
+  store_.Add(box_, {f1_, f3_}, 0);
+  store_.Add(box_, {f1_, f2_, f3_}, 1);
+
+  // Both of them are in the SAT solver.
+  EXPECT_TRUE(Reinstate(box_, 1).empty());
+
+  // The one at level 1 is retracted.
+  store_.Pop(0);
+  const vector<set<Formula>> reinstated{Reinstate(box_, 0)};
+  ASSERT_EQ(reinstated.size(), 1u);
+  EXPECT_EQ(reinstated[0].size(), 3u);
+
+  // It is in the SAT solver again.
+  EXPECT_TRUE(Reinstate(box_, 0).empty());
+}
+
+TEST_F(TheoryLemmaStoreTest, Holds) {
+  store_.Add(box_, {f1_, f3_}, 1);
+  store_.Pop(0);
+
+  // A box where y is wider. The lemma does not hold.
+  Box super_box{box_};
+  super_box[y_] = Box::Interval(-20, 20);
+  EXPECT_TRUE(Reinstate(super_box, 0).empty());
+
+  // A box without y.
+  Box x_box;
+  x_box.Add(x_, -10, 10);
+  EXPECT_TRUE(Reinstate(x_box, 0).empty());
+
+  // A box with another variable, where x is narrower.
+  Box sub_box{box_};
+  sub_box.Add(Variable{"z"}, 0, 1);
+  sub_box[x_] = Box::Interval(0, 5);
+  EXPECT_EQ(Reinstate(sub_box, 0).size(), 1u);
+}
+
+TEST_F(TheoryLemmaStoreTest, NotReinstated) {
+  store_.Add(box_, {f1_, f3_}, 1);
+  store_.Pop(0);
+
+  // The callback may decline a lemma. It is offered again later.
+  store_.Reinstate(box_, [](const set<Formula>&) { return -1; });
+  EXPECT_EQ(Reinstate(box_, 0).size(), 1u);
+}
+
+TEST_F(TheoryLemmaStoreTest, Reduce) {
+  const Variable z{"z"};
+  box_.Add(z, -10, 10);
+  const vector<Formula> atoms{x_ >= 0, x_ >= 1, x_ >= 2,
+                              x_ >= 3, x_ >= 4, x_ >= 5};
+  for (const Formula& atom : atoms) {
+    store_.Add(box_, {atom, z >= 0}, 1);
+  }
+  // The size is capped by config_.theory_lemma_store_size().
+  EXPECT_LE(store_.size(), config_.theory_lemma_store_size());
+
+  // The most recent lemma is kept.
+  store_.Pop(0);
+  bool found{false};
+  for (const set<Formula>& lemma : Reinstate(box_, 0)) {
+    found = found || lemma.count(atoms.back()) > 0;
+  }
+  EXPECT_TRUE(found);
+}
+
+}  // namespace
+}  // namespace dreal
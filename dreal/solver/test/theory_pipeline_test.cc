@@ -0,0 +1,57 @@
+#include "dreal/solver/theory_pipeline.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace dreal {
+namespace {
+
+using std::vector;
+
+class TheoryPipelineTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    box_.Add(x_, -10, 10);
+    box_.Add(y_, -10, 10);
+    config_.mutable_number_of_jobs() = 2;
+  }
+
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  Box box_;
+  Config config_;
+};
+
+TEST_F(TheoryPipelineTest, SubmitAndTake) {
+  TheoryPipeline pipeline{config_};
+  EXPECT_EQ(pipeline.num_workers(), 2);
+
+  // x ≥ 2 ∧ x + y ≤ 0 ∧ y ≥ 0 is UNSAT, and x ≥ 2 ∧ y ≥ 0 is delta-SAT.
+  pipeline.Submit(box_, {x_ >= 2, x_ + y_ <= 0, y_ >= 0});
+  pipeline.Submit(box_, {x_ >= 2, y_ >= 0});
+  EXPECT_TRUE(pipeline.is_full());
+  EXPECT_EQ(pipeline.num_running(), 2);
+
+  int num_unsat{0};
+  int num_delta_sat{0};
+  for (int i = 0; i < 2; ++i) {
+    const TheoryPipeline::Result result{pipeline.Take()};
+    if (result.model) {
+      ++num_delta_sat;
+      EXPECT_EQ(result.assertions.size(), 2u);
+      EXPECT_GE((*result.model)[x_].ub(), 2);
+    } else {
+      ++num_unsat;
+      EXPECT_EQ(result.assertions.size(), 3u);
+      EXPECT_FALSE(result.explanation.empty());
+    }
+  }
+  EXPECT_EQ(num_unsat, 1);
+  EXPECT_EQ(num_delta_sat, 1);
+  EXPECT_EQ(pipeline.num_running(), 0);
+  EXPECT_FALSE(pipeline.is_full());
+}
+
+}  // namespace
+}  // namespace dreal
@@ -0,0 +1,94 @@
+#include "dreal/solver/theory_result_cache.h"
+
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace dreal {
+namespace {
+
+using std::set;
+using std::vector;
+
+class TheoryResultCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    box_.Add(x_, -10, 10);
+    box_.Add(y_, -10, 10);
+  }
+
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  const Formula f1_{x_ >= 2};
+  const Formula f2_{x_ + y_ <= 0};
+  const Formula f3_{y_ >= 0};
+  const Formula f4_{x_ * y_ <= 5};
+  Box box_;
+  TheoryResultCache cache_;
+};
+
+TEST_F(TheoryResultCacheTest, UnsatCore) {
+  EXPECT_FALSE(cache_.FindUnsatCore(box_, {f1_, f2_, f3_}));
+  cache_.AddUnsatCore(box_, {f1_, f2_, f3_});
+  EXPECT_EQ(cache_.num_unsat_cores(), 1);
+
+  // The same literals in a different order.
+  const optional<set<Formula>> core1{
+      cache_.FindUnsatCore(box_, {f3_, f2_, f1_})};
+  ASSERT_TRUE(core1);
+  EXPECT_EQ(core1->size(), 3u);
+
+  // A superset of the literals.
+  EXPECT_TRUE(cache_.FindUnsatCore(box_, {f4_, f1_, f2_, f3_}));
+
+  // Not a superset.
+  EXPECT_FALSE(cache_.FindUnsatCore(box_, {f1_, f2_, f4_}));
+
+  // A sub-box.
+  Box sub_box{box_};
+  sub_box[x_] = Box::Interval(0, 5);
+  EXPECT_TRUE(cache_.FindUnsatCore(sub_box, {f1_, f2_, f3_}));
+
+  // Not a sub-box.
+  Box super_box{box_};
+  super_box[x_] = Box::Interval(-20, 20);
+  EXPECT_FALSE(cache_.FindUnsatCore(super_box, {f1_, f2_, f3_}));
+}
+
+TEST_F(TheoryResultCacheTest, Model) {
+  Box model{box_};
+  model[x_] = Box::Interval(2, 2.001);
+  model[y_] = Box::Interval(-2.001, -2);
+  cache_.AddModel(box_, {f1_, f2_}, model);
+  EXPECT_EQ(cache_.num_models(), 1);
+
+  const optional<Box> found{cache_.FindModel(box_, {f2_, f1_})};
+  ASSERT_TRUE(found);
+  EXPECT_EQ(*found, model);
+
+  // Only the exact match is found.
+  EXPECT_FALSE(cache_.FindModel(box_, {f1_}));
+  EXPECT_FALSE(cache_.FindModel(box_, {f1_, f2_, f4_}));
+  Box sub_box{box_};
+  sub_box[x_] = Box::Interval(0, 5);
+  EXPECT_FALSE(cache_.FindModel(sub_box, {f1_, f2_}));
+}
+
+TEST_F(TheoryResultCacheTest, NumLiterals) {
+  cache_.AddUnsatCore(box_, {f1_, f2_});
+  EXPECT_EQ(cache_.num_literals(), 2);
+
+  // The literals of the queries are interned as well, but their number
+  // is bounded. The cache is cleared when it overflows.
+  const int n{1 << 17};
+  for (int i = 0; i < n; ++i) {
+    cache_.FindModel(box_, {x_ <= i});
+    EXPECT_LE(cache_.num_literals(), n / 2);
+  }
+  EXPECT_EQ(cache_.num_unsat_cores(), 0);
+  EXPECT_FALSE(cache_.FindUnsatCore(box_, {f1_, f2_}));
+}
+
+}  // namespace
+}  // namespace dreal
@@ -1,6 +1,7 @@
 #include "dreal/solver/theory_solver.h"
 
 #include <iostream>
+#include <set>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -8,8 +9,102 @@
 namespace dreal {
 namespace {
 
-GTEST_TEST(TheorySolver, Test) {
-  // TODO(soonho): Add more tests.
+using std::set;
+using std::vector;
+
+class TheorySolverTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    box_.Add(x_, -10, 10);
+    box_.Add(y_, -10, 10);
+    box_.Add(z_, 1, 10);
+  }
+
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  const Variable z_{"z"};
+  Box box_;
+  Config config_;
+  TheorySolver theory_solver_{config_};
+};
+
+TEST_F(TheorySolverTest, PropagateConflict) {
+  const Formula f1{x_ >= 2};
+  const Formula f2{x_ + y_ <= 0};
+  const Formula f3{y_ >= 0};
+  const vector<set<Formula>> result{
+      theory_solver_.Propagate(box_, {f1, f2, f3}, {})};
+  ASSERT_EQ(result.size(), 1u);
+  EXPECT_EQ(result[0].count(f2), 1u);
+}
+
+TEST_F(TheorySolverTest, PropagateImplied) {
+  const Formula f1{x_ >= 2};
+  const Formula f2{x_ - y_ <= 0};
+  // x ≥ 2 ∧ x ≤ y implies y > 1 and ¬(y < 0). x * y < 50 is unknown.
+  const Formula c1{y_ > 1};
+  const Formula c2{y_ < 0};
+  const Formula c3{x_ * y_ < 50};
+  const vector<set<Formula>> result{
+      theory_solver_.Propagate(box_, {f1, f2}, {c1, c2, c3})};
+  ASSERT_EQ(result.size(), 2u);
+  EXPECT_EQ(result[0].size(), 3u);
+  EXPECT_EQ(result[0].count(!c1), 1u);
+  EXPECT_EQ(result[1].size(), 3u);
+  EXPECT_EQ(result[1].count(c2), 1u);
+}
+
+TEST_F(TheorySolverTest, MinimizeExplanation) {
+  config_.mutable_explanation_minimization_budget() = 1.0;
+  const Formula f1{x_ >= 2};
+  const Formula f2{x_ + y_ <= 0};
+  const Formula f3{y_ >= 0};
+  // It shares x with the others, but it is not needed for the conflict.
+  const Formula f4{x_ * z_ >= 0};
+  EXPECT_FALSE(theory_solver_.CheckSat(box_, {f1, f2, f3, f4}));
+  const set<Formula>& explanation{theory_solver_.GetExplanation()};
+  EXPECT_EQ(explanation.size(), 3u);
+  EXPECT_EQ(explanation.count(f4), 0u);
+}
+
+TEST_F(TheorySolverTest, IncrementalAddLiterals) {
+  config_.mutable_use_incremental_theory_solver() = true;
+  const Formula f1{x_ * x_ + y_ * y_ <= 4};
+  ASSERT_TRUE(theory_solver_.CheckSat(box_, {f1}));
+
+  // Exclude the previous model. There are solutions in the frontier.
+  const bool positive{theory_solver_.GetModel()[x_].mid() >= 0};
+  const Formula f2{positive ? x_ <= -1 : x_ >= 1};
+  ASSERT_TRUE(theory_solver_.CheckSat(box_, {f1, f2}));
+  const Box::Interval& x{theory_solver_.GetModel()[x_]};
+  EXPECT_TRUE(positive ? x.lb() <= -1 : x.ub() >= 1);
+
+  // Adding more literals makes it UNSAT.
+  const Formula f3{positive ? y_ <= -1.5 : y_ >= 1.5};
+  const Formula f4{positive ? x_ <= -1.5 : x_ >= 1.5};
+  EXPECT_FALSE(theory_solver_.CheckSat(box_, {f1, f2, f3, f4}));
+  const set<Formula>& explanation{theory_solver_.GetExplanation()};
+  EXPECT_FALSE(explanation.empty());
+  EXPECT_EQ(explanation.count(f1), 1u);
+
+  // Removing a literal restarts from the root box.
+  EXPECT_TRUE(theory_solver_.CheckSat(box_, {f1, f3}));
+}
+
+TEST_F(TheorySolverTest, IncrementalSameAsFromScratch) {
+  const vector<vector<Formula>> queries{
+      {x_ * y_ >= 2},
+      {x_ * y_ >= 2, x_ + y_ <= 0},
+      {x_ * y_ >= 2, x_ + y_ <= 0, x_ >= -1},
+      {x_ * y_ >= 2, x_ + y_ <= 0, x_ >= -1, y_ >= -1},
+      {x_ * y_ >= 2, y_ >= -1}};
+  Config incremental_config;
+  incremental_config.mutable_use_incremental_theory_solver() = true;
+  TheorySolver incremental_theory_solver{incremental_config};
+  for (const vector<Formula>& assertions : queries) {
+    EXPECT_EQ(incremental_theory_solver.CheckSat(box_, assertions),
+              theory_solver_.CheckSat(box_, assertions));
+  }
 }
 
 }  // namespace
@@ -0,0 +1,104 @@
+#include "dreal/solver/theory_lemma_store.h"
+
+#include <algorithm>
+
+#include "dreal/util/logging.h"
+
+namespace dreal {
+
+using std::set;
+using std::vector;
+
+namespace {
+// The activities decay by this factor whenever a lemma is bumped.
+constexpr double kActivityDecay{0.95};
+
+// The activities are rescaled when the increment exceeds this.
+constexpr double kActivityLimit{1e100};
+}  // namespace
+
+TheoryLemmaStore::TheoryLemmaStore(const Config& config) : config_{config} {}
+
+void TheoryLemmaStore::Add(const Box& box, const set<Formula>& lemma,
+                           const int level) {
+  const Formula key{make_conjunction(lemma)};
+  const auto it = index_.find(key);
+  if (it != index_.end()) {
+    Lemma& existing{lemmas_[it->second]};
+    existing.level = std::max(existing.level, level);
+    Bump(&existing);
+    return;
+  }
+  Lemma new_lemma;
+  new_lemma.formulas = lemma;
+  for (const Variable& var : key.GetFreeVariables()) {
+    new_lemma.intervals.emplace_back(var, box[var]);
+  }
+  new_lemma.level = level;
+  index_.emplace(key, static_cast<int>(lemmas_.size()));
+  lemmas_.push_back(std::move(new_lemma));
+  Bump(&lemmas_.back());
+  if (size() > config_.theory_lemma_store_size()) {
+    Reduce();
+  }
+}
+
+void TheoryLemmaStore::Reinstate(
+    const Box& box,
+    const std::function<int(const set<Formula>&)>& reinstate) {
+  int num_reinstated{0};
+  for (Lemma& lemma : lemmas_) {
+    if (lemma.level >= 0 || !Holds(lemma, box)) {
+      continue;
+    }
+    lemma.level = reinstate(lemma.formulas);
+    if (lemma.level >= 0) {
+      Bump(&lemma);
+      ++num_reinstated;
+    }
+  }
+  DREAL_LOG_DEBUG("TheoryLemmaStore::Reinstate() {} of {} lemmas.",
+                  num_reinstated, size());
+}
+
+void TheoryLemmaStore::Pop(const int level) {
+  for (Lemma& lemma : lemmas_) {
+    if (lemma.level > level) {
+      lemma.level = -1;
+    }
+  }
+}
+
+bool TheoryLemmaStore::Holds(const Lemma& lemma, const Box& box) {
+  return std::all_of(lemma.intervals.begin(), lemma.intervals.end(),
+                     [&box](const auto& p) {
+                       return box.has_variable(p.first) &&
+                              box[p.first].is_subset(p.second);
+                     });
+}
+
+void TheoryLemmaStore::Bump(Lemma* const lemma) {
+  lemma->activity += activity_increment_;
+  activity_increment_ /= kActivityDecay;
+  if (activity_increment_ > kActivityLimit) {
+    for (Lemma& l : lemmas_) {
+      l.activity /= kActivityLimit;
+    }
+    activity_increment_ /= kActivityLimit;
+  }
+}
+
+void TheoryLemmaStore::Reduce() {
+  std::sort(lemmas_.begin(), lemmas_.end(),
+            [](const Lemma& l1, const Lemma& l2) {
+              return l1.activity > l2.activity;
+            });
+  lemmas_.resize(lemmas_.size() / 2);
+  index_.clear();
+  for (int i = 0; i < size(); ++i) {
+    index_.emplace(make_conjunction(lemmas_[i].formulas), i);
+  }
+  DREAL_LOG_DEBUG("TheoryLemmaStore::Reduce() {} lemmas are left.", size());
+}
+
+}  // namespace dreal
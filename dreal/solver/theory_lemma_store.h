@@ -0,0 +1,84 @@
+#pragma once
+
+#include <functional>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dreal/solver/config.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+
+namespace dreal {
+
+/// Keeps the theory lemmas learned in the lazy SMT loop across Push/Pop,
+/// so that they can be added to the SAT solver again after the scope
+/// which learned them is popped. See Context::Impl::CheckSatCore.
+///
+/// A lemma {f₁, ..., fₙ} stands for the clause (¬f₁ ∨ ... ∨ ¬fₙ). It is
+/// learned over a box, and it holds over any box whose intervals of the
+/// variables in the lemma are included in the ones of that box.
+///
+/// The store keeps at most `config.theory_lemma_store_size()` lemmas.
+/// Each lemma has an activity which is bumped when it is learned or
+/// reinstated. The recent bumps weigh more than the old ones. When the
+/// store is full, the less active half of the lemmas are removed.
+class TheoryLemmaStore {
+ public:
+  /// Constructs a store with @p config.
+  explicit TheoryLemmaStore(const Config& config);
+
+  TheoryLemmaStore(const TheoryLemmaStore&) = delete;
+  TheoryLemmaStore(TheoryLemmaStore&&) = delete;
+  TheoryLemmaStore& operator=(const TheoryLemmaStore&) = delete;
+  TheoryLemmaStore& operator=(TheoryLemmaStore&&) = delete;
+  ~TheoryLemmaStore() = default;
+
+  /// Stores @p lemma learned over @p box, which is added to the scope of
+  /// the SAT solver at @p level. If it is already stored, it bumps the
+  /// activity of it.
+  void Add(const Box& box, const std::set<Formula>& lemma, int level);
+
+  /// Calls @p reinstate with each lemma which holds over @p box and is
+  /// not in the SAT solver. @p reinstate returns the level of the scope
+  /// where it adds the lemma, or -1 if it does not add it.
+  void Reinstate(const Box& box,
+                 const std::function<int(const std::set<Formula>&)>&
+                     reinstate);
+
+  /// Records that the SAT solver popped the scopes above @p level. The
+  /// lemmas added to them are not in the SAT solver anymore.
+  void Pop(int level);
+
+  /// Returns the number of the stored lemmas.
+  int size() const { return static_cast<int>(lemmas_.size()); }
+
+ private:
+  struct Lemma {
+    std::set<Formula> formulas;
+    // The intervals of the variables in formulas where it holds.
+    std::vector<std::pair<Variable, Box::Interval>> intervals;
+    double activity{0.0};
+    // The level of the scope of the SAT solver which has this lemma,
+    // or -1 if it is not in the SAT solver.
+    int level{-1};
+  };
+
+  // Returns true if @p lemma holds over @p box.
+  static bool Holds(const Lemma& lemma, const Box& box);
+
+  // Increases the activity of @p lemma, which is in lemmas_.
+  void Bump(Lemma* lemma);
+
+  // Removes the less active half of the lemmas.
+  void Reduce();
+
+  const Config& config_;
+  std::vector<Lemma> lemmas_;
+  // Maps the conjunction of a lemma to its index in lemmas_.
+  std::unordered_map<Formula, int> index_;
+  double activity_increment_{1.0};
+};
+
+}  // namespace dreal
@@ -0,0 +1,94 @@
+#include "dreal/solver/theory_pipeline.h"
+
+#include <algorithm>
+
+#include "dreal/util/assert.h"
+#include "dreal/util/logging.h"
+
+namespace dreal {
+
+using std::exception_ptr;
+using std::lock_guard;
+using std::make_unique;
+using std::max;
+using std::mutex;
+using std::unique_lock;
+using std::vector;
+
+namespace {
+// Returns a copy of @p config for the workers. Parallelism is at the
+// level of the pipeline, so each worker runs a sequential ICP. The
+// contexts nested in a worker (e.g. the ones of the forall contractors
+// and evaluators) do not pipeline either.
+Config MakeWorkerConfig(const Config& config) {
+  Config worker_config{config};
+  worker_config.mutable_number_of_jobs() = 1;
+  worker_config.mutable_use_pipelined_theory_solver() = false;
+  return worker_config;
+}
+}  // namespace
+
+TheoryPipeline::TheoryPipeline(const Config& config)
+    : config_{MakeWorkerConfig(config)},
+      pool_(max(config.number_of_jobs(), 1)) {
+  const int n{max(config.number_of_jobs(), 1)};
+  for (int i = 0; i < n; ++i) {
+    theory_solvers_.push_back(make_unique<TheorySolver>(config_));
+    idle_workers_.push_back(i);
+  }
+}
+
+void TheoryPipeline::Submit(const Box& box, vector<Formula> assertions) {
+  DREAL_ASSERT(!is_full());
+  const int worker{idle_workers_.back()};
+  idle_workers_.pop_back();
+  ++num_running_;
+  DREAL_LOG_DEBUG("TheoryPipeline::Submit() worker = {}, #assertions = {}",
+                  worker, assertions.size());
+  pool_.enqueue([this, worker, box, assertions]() {
+    TheorySolver& theory_solver{*theory_solvers_[worker]};
+    Result result{box, assertions, {}, {}};
+    exception_ptr exception;
+    try {
+      if (theory_solver.CheckSat(box, assertions)) {
+        result.model = theory_solver.GetModel();
+      } else {
+        result.explanation = theory_solver.GetExplanation();
+      }
+    } catch (...) {
+      exception = std::current_exception();
+    }
+    {
+      lock_guard<mutex> guard{mutex_};
+      if (exception) {
+        exceptions_.emplace_back(worker, exception);
+      } else {
+        results_.emplace_back(worker, std::move(result));
+      }
+    }
+    finished_.notify_one();
+  });
+}
+
+TheoryPipeline::Result TheoryPipeline::Take() {
+  DREAL_ASSERT(num_running_ > 0);
+  unique_lock<mutex> lock{mutex_};
+  finished_.wait(lock, [this]() {
+    return !results_.empty() || !exceptions_.empty();
+  });
+  --num_running_;
+  if (!exceptions_.empty()) {
+    const auto p = exceptions_.front();
+    exceptions_.pop_front();
+    idle_workers_.push_back(p.first);
+    std::rethrow_exception(p.second);
+  }
+  auto p = std::move(results_.front());
+  results_.pop_front();
+  idle_workers_.push_back(p.first);
+  DREAL_LOG_DEBUG("TheoryPipeline::Take() worker = {}, result = {}", p.first,
+                  p.second.model ? "delta-SAT" : "UNSAT");
+  return std::move(p.second);
+}
+
+}  // namespace dreal
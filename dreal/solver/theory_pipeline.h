@@ -0,0 +1,98 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "ThreadPool/ThreadPool.h"
+
+#include "dreal/solver/config.h"
+#include "dreal/solver/theory_solver.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+#include "dreal/util/optional.h"
+
+namespace dreal {
+
+/// Runs theory checks concurrently on a pool of workers, each of which
+/// has its own TheorySolver. Context uses it to check the Boolean models
+/// enumerated by the SAT solver while the SAT solver keeps searching.
+///
+/// The methods are called by the thread which owns the pipeline.
+class TheoryPipeline {
+ public:
+  /// The result of a theory check.
+  struct Result {
+    /// The checked box and assertions.
+    Box box;
+    std::vector<Formula> assertions;
+
+    /// A delta-SAT box, or nullopt if the assertions are UNSAT.
+    optional<Box> model;
+
+    /// Explains the UNSAT result.
+    std::set<Formula> explanation;
+  };
+
+  /// Constructs a pipeline of `config.number_of_jobs()` workers. Each
+  /// worker runs a sequential ICP.
+  explicit TheoryPipeline(const Config& config);
+
+  TheoryPipeline(const TheoryPipeline&) = delete;
+  TheoryPipeline(TheoryPipeline&&) = delete;
+  TheoryPipeline& operator=(const TheoryPipeline&) = delete;
+  TheoryPipeline& operator=(TheoryPipeline&&) = delete;
+
+  /// Waits for the running checks, whose results are discarded.
+  ~TheoryPipeline() = default;
+
+  /// Returns the number of workers.
+  int num_workers() const { return static_cast<int>(theory_solvers_.size()); }
+
+  /// Returns the number of the checks submitted but not taken yet.
+  int num_running() const { return num_running_; }
+
+  /// Returns true if every worker is busy.
+  bool is_full() const { return idle_workers_.empty(); }
+
+  /// Checks @p assertions over @p box on an idle worker.
+  ///
+  /// @pre !is_full().
+  void Submit(const Box& box, std::vector<Formula> assertions);
+
+  /// Waits for a submitted check to finish and returns its result. The
+  /// results are returned in the order that the checks finish. If the
+  /// check throws an exception, it is rethrown here.
+  ///
+  /// @pre num_running() > 0.
+  Result Take();
+
+ private:
+  // The configuration of the workers, which is referred by
+  // theory_solvers_.
+  const Config config_;
+
+  std::vector<std::unique_ptr<TheorySolver>> theory_solvers_;
+
+  // The workers which are not running a check.
+  std::vector<int> idle_workers_;
+  int num_running_{0};
+
+  // The finished checks and their workers. They are guarded by mutex_.
+  std::mutex mutex_;
+  std::condition_variable finished_;
+  std::deque<std::pair<int, Result>> results_;
+  std::deque<std::pair<int, std::exception_ptr>> exceptions_;
+
+  // It is declared last so that it is destroyed first. Then, its
+  // destructor waits for the running checks before the other members
+  // are destroyed.
+  ThreadPool pool_;
+};
+
+}  // namespace dreal
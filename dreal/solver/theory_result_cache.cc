@@ -0,0 +1,118 @@
+#include "dreal/solver/theory_result_cache.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include "dreal/util/logging.h"
+
+namespace dreal {
+
+using std::set;
+using std::vector;
+
+namespace {
+// The cache is cleared once it has this many entries of a kind or this
+// many interned literals, to bound its memory.
+constexpr int kMaxEntries{1 << 16};
+
+// Returns true if @p box is a sub-box of @p super. They need to have
+// the same variables.
+bool IsSubBox(const Box& box, const Box& super) {
+  return std::equal(box.variables().begin(), box.variables().end(),
+                    super.variables().begin(), super.variables().end(),
+                    std::equal_to<Variable>{}) &&
+         box.interval_vector().is_subset(super.interval_vector());
+}
+}  // namespace
+
+template <typename Formulas>
+vector<int> TheoryResultCache::Intern(const Formulas& formulas) {
+  if (num_literals() + static_cast<int>(formulas.size()) > kMaxEntries) {
+    // The stored entries refer to the ids, so they go together.
+    Clear();
+  }
+  vector<int> ids;
+  ids.reserve(formulas.size());
+  for (const Formula& f : formulas) {
+    const auto it = ids_.emplace(f, static_cast<int>(ids_.size())).first;
+    ids.push_back(it->second);
+  }
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  return ids;
+}
+
+optional<set<Formula>> TheoryResultCache::FindUnsatCore(
+    const Box& box, const vector<Formula>& assertions) {
+  const vector<int> ids{Intern(assertions)};
+  for (const int id : ids) {
+    const auto it = watches_.find(id);
+    if (it == watches_.end()) {
+      continue;
+    }
+    for (const int i : it->second) {
+      const UnsatCore& core{cores_[i]};
+      if (std::includes(ids.begin(), ids.end(), core.ids.begin(),
+                        core.ids.end()) &&
+          IsSubBox(box, core.box)) {
+        DREAL_LOG_DEBUG(
+            "TheoryResultCache::FindUnsatCore() Found a core of {} literals.",
+            core.formulas.size());
+        return core.formulas;
+      }
+    }
+  }
+  return nullopt;
+}
+
+optional<Box> TheoryResultCache::FindModel(const Box& box,
+                                           const vector<Formula>& assertions) {
+  const auto it = models_.find(Intern(assertions));
+  if (it == models_.end()) {
+    return nullopt;
+  }
+  for (const ModelEntry& entry : it->second) {
+    if (entry.box == box) {
+      DREAL_LOG_DEBUG("TheoryResultCache::FindModel() Found a model.");
+      return entry.model;
+    }
+  }
+  return nullopt;
+}
+
+void TheoryResultCache::AddUnsatCore(const Box& box, const set<Formula>& core) {
+  if (core.empty()) {
+    // It does not depend on the literals. It is not worth caching.
+    return;
+  }
+  if (num_unsat_cores() >= kMaxEntries) {
+    cores_.clear();
+    watches_.clear();
+  }
+  vector<int> ids{Intern(core)};
+  watches_[ids.front()].push_back(num_unsat_cores());
+  cores_.push_back(UnsatCore{box, std::move(ids), core});
+}
+
+void TheoryResultCache::Clear() {
+  DREAL_LOG_DEBUG("TheoryResultCache::Clear()");
+  ids_.clear();
+  cores_.clear();
+  watches_.clear();
+  models_.clear();
+  num_models_ = 0;
+}
+
+void TheoryResultCache::AddModel(const Box& box,
+                                 const vector<Formula>& assertions,
+                                 const Box& model) {
+  if (num_models_ >= kMaxEntries) {
+    models_.clear();
+    num_models_ = 0;
+  }
+  models_[Intern(assertions)].push_back(ModelEntry{box, model});
+  ++num_models_;
+}
+
+}  // namespace dreal
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+#include "dreal/util/optional.h"
+
+namespace dreal {
+
+/// Caches the results of the theory solver in the lazy SMT loop. See
+/// Context::Impl::CheckSatCore.
+///
+/// A set of theory literals is keyed by the sorted ids of its literals,
+/// which are interned by this class, and by the root box given to the
+/// theory solver.
+///
+///  - It stores the explanations of the UNSAT results (UNSAT cores). An
+///    UNSAT core over a box B remains UNSAT over any sub-box of B and
+///    for any superset of the literals. FindUnsatCore() looks them up
+///    by subsumption.
+///
+///  - It stores the models of the delta-SAT results. FindModel() looks
+///    them up only by exact match of the literals and the box.
+///
+/// The cache outlives Push/Pop. The literals and the boxes are
+/// compared by their structures and values, which do not depend on the
+/// scopes.
+class TheoryResultCache {
+ public:
+  TheoryResultCache() = default;
+  TheoryResultCache(const TheoryResultCache&) = delete;
+  TheoryResultCache(TheoryResultCache&&) = delete;
+  TheoryResultCache& operator=(const TheoryResultCache&) = delete;
+  TheoryResultCache& operator=(TheoryResultCache&&) = delete;
+  ~TheoryResultCache() = default;
+
+  /// Returns a stored UNSAT core which is a subset of @p assertions over
+  /// a box including @p box. Returns nullopt if there is none.
+  optional<std::set<Formula>> FindUnsatCore(
+      const Box& box, const std::vector<Formula>& assertions);
+
+  /// Returns the stored model of @p assertions over @p box. Returns
+  /// nullopt if there is none.
+  optional<Box> FindModel(const Box& box,
+                          const std::vector<Formula>& assertions);
+
+  /// Stores @p core, the explanation of an UNSAT result over @p box.
+  void AddUnsatCore(const Box& box, const std::set<Formula>& core);
+
+  /// Stores @p model, the result of @p assertions over @p box.
+  void AddModel(const Box& box, const std::vector<Formula>& assertions,
+                const Box& model);
+
+  /// Returns the number of the stored UNSAT cores.
+  int num_unsat_cores() const { return static_cast<int>(cores_.size()); }
+
+  /// Returns the number of the stored models.
+  int num_models() const { return num_models_; }
+
+  /// Returns the number of the interned literals.
+  int num_literals() const { return static_cast<int>(ids_.size()); }
+
+ private:
+  struct UnsatCore {
+    Box box;
+    std::vector<int> ids;  // Sorted.
+    std::set<Formula> formulas;
+  };
+
+  struct ModelEntry {
+    Box box;
+    Box model;
+  };
+
+  // Returns the sorted ids of @p formulas, interning new ones. It
+  // clears the cache first if there would be too many literals.
+  template <typename Formulas>
+  std::vector<int> Intern(const Formulas& formulas);
+
+  // Removes all the entries and the interned literals.
+  void Clear();
+
+  std::unordered_map<Formula, int> ids_;
+  std::vector<UnsatCore> cores_;
+  // watches_[i] is the indices of the cores whose least literal id is i.
+  std::unordered_map<int, std::vector<int>> watches_;
+  // Sorted literal ids ↦ the models over different boxes.
+  std::unordered_map<std::vector<int>, std::vector<ModelEntry>,
+                     hash_value<std::vector<int>>>
+      models_;
+  int num_models_{0};
+};
+
+}  // namespace dreal
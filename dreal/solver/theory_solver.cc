@@ -1,7 +1,11 @@
 #include "dreal/solver/theory_solver.h"
 
+#include <algorithm>
 #include <atomic>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <utility>
@@ -80,15 +84,43 @@ class TheorySolverStat : public Stat {
       print(cout, "{:<45} @ {:<20} = {:>15f} sec\n",
             "Total time spent in CheckSat", "Theory level",
             timer_check_sat_.seconds());
+      if (num_explanation_) {
+        print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of Explanations",
+              "Theory level", num_explanation_);
+        print(cout, "{:<45} @ {:<20} = {:>15f}\n",
+              "Average size of Explanations", "Theory level",
+              static_cast<double>(total_explanation_size_) /
+                  num_explanation_);
+        print(cout, "{:<45} @ {:<20} = {:>15f}\n",
+              "Average size of minimized Explanations", "Theory level",
+              static_cast<double>(total_minimized_explanation_size_) /
+                  num_explanation_);
+        print(cout, "{:<45} @ {:<20} = {:>15f} sec\n",
+              "Total time spent in minimizing Explanations", "Theory level",
+              timer_minimize_explanation_.seconds());
+      }
     }
   }
 
   void increase_num_check_sat() { increase(&num_check_sat_); }
 
+  // Records the size of an explanation before and after minimization.
+  void add_explanation(const int size, const int minimized_size) {
+    if (enabled()) {
+      num_explanation_++;
+      total_explanation_size_ += size;
+      total_minimized_explanation_size_ += minimized_size;
+    }
+  }
+
   Timer timer_check_sat_;
+  Timer timer_minimize_explanation_;
 
  private:
   std::atomic<int> num_check_sat_{0};
+  std::atomic<int> num_explanation_{0};
+  std::atomic<int64_t> total_explanation_size_{0};
+  std::atomic<int64_t> total_minimized_explanation_size_{0};
 };
 
 }  // namespace
@@ -96,10 +128,28 @@ class TheorySolverStat : public Stat {
 optional<Contractor> TheorySolver::BuildContractor(
     const vector<Formula>& assertions,
     ContractorStatus* const contractor_status) {
-  Box& box = contractor_status->mutable_box();
   if (assertions.empty()) {
-    return make_contractor_integer(box, config_);
+    return make_contractor_integer(contractor_status->box(), config_);
+  }
+  const optional<vector<Contractor>> ctcs{
+      BuildContractors(assertions, contractor_status)};
+  if (!ctcs) {
+    return {};
+  }
+  if (config_.use_worklist_fixpoint()) {
+    return make_contractor_worklist_fixpoint(DefaultTerminationCondition,
+                                             *ctcs, config_);
+  } else {
+    return make_contractor_fixpoint(DefaultTerminationCondition, *ctcs,
+                                    config_);
   }
+}
+
+optional<vector<Contractor>> TheorySolver::BuildContractors(
+    const vector<Formula>& assertions,
+    ContractorStatus* const contractor_status) {
+  DREAL_ASSERT(!assertions.empty());
+  Box& box = contractor_status->mutable_box();
   vector<Contractor> ctcs;
   for (const Formula& f : assertions) {
     switch (FilterAssertion(f, &box)) {
@@ -146,12 +196,7 @@ optional<Contractor> TheorySolver::BuildContractor(
     // Add polytope contractor.
     ctcs.push_back(make_contractor_ibex_polytope(assertions, box, config_));
   }
-  if (config_.use_worklist_fixpoint()) {
-    return make_contractor_worklist_fixpoint(DefaultTerminationCondition, ctcs,
-                                             config_);
-  } else {
-    return make_contractor_fixpoint(DefaultTerminationCondition, ctcs, config_);
-  }
+  return ctcs;
 }
 
 vector<FormulaEvaluator> TheorySolver::BuildFormulaEvaluator(
@@ -171,7 +216,8 @@ vector<FormulaEvaluator> TheorySolver::BuildFormulaEvaluator(
         formula_evaluators.push_back(make_forall_formula_evaluator(
             f, epsilon, inner_delta, config_.number_of_jobs()));
       } else {
-        formula_evaluators.push_back(make_relational_formula_evaluator(f));
+        formula_evaluators.push_back(
+            make_relational_formula_evaluator(f, config_.enclosure_mode()));
       }
       formula_evaluator_cache_.emplace_hint(it, f, formula_evaluators.back());
     } else {
@@ -182,7 +228,7 @@ vector<FormulaEvaluator> TheorySolver::BuildFormulaEvaluator(
 }
 
 bool TheorySolver::CheckSat(const Box& box, const vector<Formula>& assertions) {
-  static TheorySolverStat stat{DREAL_LOG_INFO_ENABLED};
+  thread_local TheorySolverStat stat{DREAL_LOG_INFO_ENABLED};
   stat.increase_num_check_sat();
   TimerGuard check_sat_timer_guard(&stat.timer_check_sat_, stat.enabled(),
                                    true /* start_timer */);
@@ -191,24 +237,197 @@ bool TheorySolver::CheckSat(const Box& box, const vector<Formula>& assertions) {
   ContractorStatus contractor_status(box);
 
   // Icp Step
+  const bool sat{config_.use_incremental_theory_solver()
+                     ? CheckSatIncremental(box, assertions, &contractor_status)
+                     : Search(assertions, &contractor_status)};
+  if (sat) {
+    model_ = contractor_status.box();
+    return true;
+  }
+  explanation_ = contractor_status.Explanation();
+  if (config_.explanation_minimization_budget() > 0) {
+    const int size{static_cast<int>(explanation_.size())};
+    TimerGuard minimize_timer_guard(&stat.timer_minimize_explanation_,
+                                    stat.enabled());
+    explanation_ = MinimizeExplanation(box, std::move(explanation_));
+    stat.add_explanation(size, static_cast<int>(explanation_.size()));
+  } else {
+    stat.add_explanation(static_cast<int>(explanation_.size()),
+                         static_cast<int>(explanation_.size()));
+  }
+  return false;
+}
+
+bool TheorySolver::Search(const vector<Formula>& assertions,
+                          ContractorStatus* const contractor_status) {
+  const optional<Contractor> contractor{
+      BuildContractor(assertions, contractor_status)};
+  if (!contractor) {
+    DREAL_ASSERT(contractor_status->box().empty());
+    return false;
+  }
+  icp_->CheckSat(*contractor, BuildFormulaEvaluator(assertions),
+                 contractor_status);
+  return !contractor_status->box().empty();
+}
+
+bool TheorySolver::CheckSatIncremental(
+    const Box& box, const vector<Formula>& assertions,
+    ContractorStatus* const contractor_status) {
+  const set<Formula> assertion_set(assertions.begin(), assertions.end());
+  // The boxes to search, the next one at the back. They include all the
+  // solutions which `refutation` does not explain.
+  vector<Box> boxes{box};
+  ContractorStatus refutation{box};
+  if (last_search_ && last_search_->box == box) {
+    if (last_search_->frontier &&
+        std::includes(assertion_set.begin(), assertion_set.end(),
+                      last_search_->assertions.begin(),
+                      last_search_->assertions.end(),
+                      std::less<Formula>{})) {
+      DREAL_LOG_DEBUG(
+          "TheorySolver::CheckSatIncremental() Resume from {} boxes.",
+          last_search_->frontier->size() + 1);
+      boxes = std::move(*last_search_->frontier);
+      refutation = std::move(last_search_->refutation);
+    }
+    boxes.push_back(model_);
+  }
+  last_search_.reset();
+
+  while (!boxes.empty()) {
+    ContractorStatus cs{std::move(boxes.back())};
+    boxes.pop_back();
+    if (Search(assertions, &cs)) {
+      // Save the search to resume. The frontier of this call is explored
+      // before the remaining boxes.
+      optional<vector<Box>> frontier{icp_->TakeFrontier()};
+      if (frontier) {
+        boxes.insert(boxes.end(), std::make_move_iterator(frontier->begin()),
+                     std::make_move_iterator(frontier->end()));
+        frontier = std::move(boxes);
+      }
+      refutation.InplaceJoin(cs);
+      last_search_ = SearchState{box, assertion_set, std::move(frontier),
+                                 std::move(refutation)};
+      *contractor_status = std::move(cs);
+      return true;
+    }
+    refutation.InplaceJoin(cs);
+  }
+  *contractor_status = std::move(refutation);
+  contractor_status->mutable_box().set_empty();
+  return false;
+}
+
+vector<set<Formula>> TheorySolver::Propagate(
+    const Box& box, const vector<Formula>& assertions,
+    const vector<Formula>& candidates) {
+  DREAL_LOG_DEBUG("TheorySolver::Propagate()");
+  vector<Formula> quantifier_free_assertions;
+  for (const Formula& f : assertions) {
+    if (!is_forall(f)) {
+      quantifier_free_assertions.push_back(f);
+    }
+  }
+  if (quantifier_free_assertions.empty()) {
+    return {};
+  }
+  const set<Formula> all_assertions(quantifier_free_assertions.begin(),
+                                    quantifier_free_assertions.end());
+  ContractorStatus contractor_status(box);
+  const optional<vector<Contractor>> ctcs{
+      BuildContractors(quantifier_free_assertions, &contractor_status)};
+  if (ctcs) {
+    make_contractor_seq(*ctcs, config_).Prune(&contractor_status);
+  }
+  const Box& pruned_box{contractor_status.box()};
+  if (pruned_box.empty()) {
+    set<Formula> explanation{contractor_status.Explanation()};
+    if (explanation.empty()) {
+      // Be conservative. Blame all the assertions.
+      explanation = all_assertions;
+    }
+    DREAL_LOG_DEBUG("TheorySolver::Propagate() Found a conflict of {} literals",
+                    explanation.size());
+    return {explanation};
+  }
+
+  // The pruned box depends on all the assertions. They explain the
+  // implied literals.
+  vector<set<Formula>> result;
+  vector<Formula> quantifier_free_candidates;
+  for (const Formula& f : candidates) {
+    if (!is_forall(f)) {
+      quantifier_free_candidates.push_back(f);
+    }
+  }
+  const vector<FormulaEvaluator> formula_evaluators{
+      BuildFormulaEvaluator(quantifier_free_candidates)};
+  for (size_t i = 0; i < formula_evaluators.size(); ++i) {
+    const Formula& f{quantifier_free_candidates[i]};
+    switch (formula_evaluators[i](pruned_box).type()) {
+      case FormulaEvaluationResult::Type::VALID:
+        result.push_back(all_assertions);
+        result.back().insert(!f);
+        break;
+      case FormulaEvaluationResult::Type::UNSAT:
+        result.push_back(all_assertions);
+        result.back().insert(f);
+        break;
+      case FormulaEvaluationResult::Type::UNKNOWN:
+        break;
+    }
+  }
+  DREAL_LOG_DEBUG("TheorySolver::Propagate() Found {} implied literals",
+                  result.size());
+  return result;
+}
+
+bool TheorySolver::IsRefutedByContractors(const Box& box,
+                                          const vector<Formula>& assertions) {
+  ContractorStatus contractor_status(box);
   const optional<Contractor> contractor{
       BuildContractor(assertions, &contractor_status)};
   if (contractor) {
-    icp_->CheckSat(*contractor, BuildFormulaEvaluator(assertions),
-                   &contractor_status);
-    if (contractor_status.box().empty()) {
-      explanation_ = contractor_status.Explanation();
-      return false;
-    } else {
-      model_ = contractor_status.box();
-      return true;
+    contractor->Prune(&contractor_status);
+  }
+  return contractor_status.box().empty();
+}
+
+set<Formula> TheorySolver::MinimizeExplanation(const Box& box,
+                                               set<Formula> explanation) {
+  Timer timer;
+  timer.start();
+  // The explanation may need branching to be refuted. Then, the checks
+  // without branching cannot shrink it.
+  if (explanation.size() <= 1 ||
+      !IsRefutedByContractors(box, vector<Formula>(explanation.begin(),
+                                                   explanation.end()))) {
+    return explanation;
+  }
+  const size_t size{explanation.size()};
+  const vector<Formula> candidates(explanation.begin(), explanation.end());
+  for (const Formula& f : candidates) {
+    if (timer.seconds() > config_.explanation_minimization_budget()) {
+      DREAL_LOG_DEBUG(
+          "TheorySolver::MinimizeExplanation() Ran out of the time budget.");
+      break;
+    }
+    vector<Formula> rest;
+    rest.reserve(explanation.size() - 1);
+    for (const Formula& g : explanation) {
+      if (!g.EqualTo(f)) {
+        rest.push_back(g);
+      }
+    }
+    if (IsRefutedByContractors(box, rest)) {
+      explanation.erase(f);
     }
-    return !contractor_status.box().empty();
-  } else {
-    DREAL_ASSERT(contractor_status.box().empty());
-    explanation_ = contractor_status.Explanation();
-    return false;
   }
+  DREAL_LOG_DEBUG("TheorySolver::MinimizeExplanation() {} -> {}", size,
+                  explanation.size());
+  return explanation;
 }
 
 const Box& TheorySolver::GetModel() const {
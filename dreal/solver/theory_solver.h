@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "dreal/contractor/contractor.h"
+#include "dreal/contractor/contractor_status.h"
 #include "dreal/solver/config.h"
 #include "dreal/solver/formula_evaluator.h"
 #include "dreal/solver/icp.h"
@@ -23,8 +24,24 @@ class TheorySolver {
 
   /// Checks consistency. Returns true if there is a satisfying
   /// assignment. Otherwise, return false.
+  ///
+  /// If Config::use_incremental_theory_solver() is set, it resumes the
+  /// search of the last delta-SAT call. See CheckSatIncremental.
   bool CheckSat(const Box& box, const std::vector<Formula>& assertions);
 
+  /// Checks @p assertions, a partial assignment of the theory literals,
+  /// cheaply. It filters @p box by the bounds in @p assertions and runs
+  /// one pass of the contractors, without ICP. The universally
+  /// quantified assertions are ignored as they are expensive.
+  ///
+  /// @returns sets of inconsistent formulas. If it finds @p assertions
+  /// inconsistent, it returns their explanation. Otherwise, for each
+  /// formula f in @p candidates which is valid (resp. unsatisfiable) over
+  /// the pruned box, it returns the assertions with ¬f (resp. f).
+  std::vector<std::set<Formula>> Propagate(
+      const Box& box, const std::vector<Formula>& assertions,
+      const std::vector<Formula>& candidates);
+
   /// Gets a satisfying Model.
   const Box& GetModel() const;
 
@@ -32,6 +49,42 @@ class TheorySolver {
   const std::set<Formula>& GetExplanation() const;
 
  private:
+  // The search of the last delta-SAT call of CheckSat, which the
+  // incremental mode resumes.
+  struct SearchState {
+    // The input box and assertions.
+    Box box;
+    std::set<Formula> assertions;
+    // The boxes left unexplored, the next one at the back. With the
+    // model, they include all the solutions of the assertions in the
+    // box. It is nullopt if the ICP does not keep them.
+    optional<std::vector<Box>> frontier;
+    // Explains why the rest of the box has no solution.
+    ContractorStatus refutation;
+  };
+
+  // Runs ICP over @p contractor_status's box. Returns true if it finds
+  // a delta-SAT box, which is left in @p contractor_status. Otherwise,
+  // @p contractor_status explains the UNSAT result.
+  bool Search(const std::vector<Formula>& assertions,
+              ContractorStatus* contractor_status);
+
+  // Checks @p assertions over @p box by resuming the last search.
+  //
+  //  - It first searches the previous model box. The model of a call
+  //    often survives a small change of the literals.
+  //
+  //  - If the literals were only added, the new solutions are solutions
+  //    of the previous literals. So it searches the previous frontier
+  //    instead of @p box, and the previous refutation explains the rest.
+  //
+  //  - Otherwise, it searches @p box from scratch.
+  //
+  // Its results are the same as the ones of Search.
+  bool CheckSatIncremental(const Box& box,
+                           const std::vector<Formula>& assertions,
+                           ContractorStatus* contractor_status);
+
   // Builds a contractor using @p box and @p assertions. It returns
   // nullopt if it detects an empty box while building a contractor.
   //
@@ -39,13 +92,35 @@ class TheorySolver {
   // function.
   optional<Contractor> BuildContractor(const std::vector<Formula>& assertions,
                                        ContractorStatus* contractor_status);
+
+  // Builds the contractors which BuildContractor combines. It returns
+  // nullopt if it detects an empty box.
+  //
+  // @pre @p assertions is not empty.
+  optional<std::vector<Contractor>> BuildContractors(
+      const std::vector<Formula>& assertions,
+      ContractorStatus* contractor_status);
   std::vector<FormulaEvaluator> BuildFormulaEvaluator(
       const std::vector<Formula>& assertions);
 
+  // Returns true if the contractors of @p assertions, without
+  // branching, prune @p box into the empty box.
+  bool IsRefutedByContractors(const Box& box,
+                              const std::vector<Formula>& assertions);
+
+  // Shrinks @p explanation, a set of assertions found inconsistent over
+  // @p box, by deletion. It drops an assertion if the rest is still
+  // refuted by IsRefutedByContractors. It stops when it runs out of the
+  // time budget (see Config::explanation_minimization_budget()) and
+  // returns the smallest explanation found so far.
+  std::set<Formula> MinimizeExplanation(const Box& box,
+                                        std::set<Formula> explanation);
+
   const Config& config_;
   std::unique_ptr<Icp> icp_;
   Box model_;
   std::set<Formula> explanation_;
+  optional<SearchState> last_search_;
   std::unordered_map<Formula, Contractor> contractor_cache_;
   std::unordered_map<Formula, FormulaEvaluator> formula_evaluator_cache_;
 };
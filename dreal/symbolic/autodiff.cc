@@ -0,0 +1,45 @@
+#include "dreal/symbolic/autodiff.h"
+
+#include <utility>
+
+#include <fmt/ostream.h>
+
+#include "dreal/util/exception.h"
+
+namespace dreal {
+
+using std::vector;
+
+namespace {
+
+// Returns @p tape if all of its instructions are differentiable.
+// Otherwise, throws std::runtime_error.
+ExpressionTape CheckDifferentiable(ExpressionTape tape) {
+  for (const ExpressionTape::Instruction& inst : tape.instructions()) {
+    switch (inst.op) {
+      case ExpressionTape::Op::Abs:
+      case ExpressionTape::Op::Min:
+      case ExpressionTape::Op::Max:
+        throw DREAL_RUNTIME_ERROR("AutoDiff: {} is not differentiable.",
+                                  inst.op);
+      default:
+        break;
+    }
+  }
+  return tape;
+}
+
+}  // namespace
+
+AutoDiff::AutoDiff(const vector<Expression>& expressions,
+                   vector<Variable> variables)
+    : tape_{CheckDifferentiable(
+          ExpressionTape{expressions, std::move(variables)})} {}
+
+AutoDiff::AutoDiff(const Expression& e, vector<Variable> variables)
+    : AutoDiff{vector<Expression>{e}, std::move(variables)} {}
+
+AutoDiff::AutoDiff(const Expression& e)
+    : tape_{CheckDifferentiable(ExpressionTape{e})} {}
+
+}  // namespace dreal
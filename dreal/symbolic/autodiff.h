@@ -0,0 +1,294 @@
+#pragma once
+
+#include <vector>
+
+#include "dreal/symbolic/expression_tape.h"
+#include "dreal/symbolic/symbolic.h"
+
+namespace dreal {
+
+/// Computes derivatives of symbolic expressions by automatic
+/// differentiation over their DAGs.
+///
+/// Unlike `Expression::Differentiate`, it does not construct derivative
+/// expressions. Instead, it evaluates the expressions once on an
+/// ExpressionTape and propagates derivatives through the tape, so that
+/// the cost of computing a gradient (reverse mode) or a Jacobian-vector
+/// product (forward mode) is proportional to the size of the tape.
+///
+/// All the evaluation functions are templates over the type of values.
+/// They work both for `double` and for `Box::Interval`. In the latter
+/// case, the results are enclosures of the derivatives over the given
+/// box.
+class AutoDiff {
+ public:
+  /// Constructs an AutoDiff for @p expressions over @p variables.
+  ///
+  /// @throws std::runtime_error if an expression is not differentiable
+  ///         (see `IsDifferentiable`).
+  AutoDiff(const std::vector<Expression>& expressions,
+           std::vector<Variable> variables);
+
+  /// Constructs an AutoDiff for @p e over @p variables.
+  AutoDiff(const Expression& e, std::vector<Variable> variables);
+
+  /// Constructs an AutoDiff for @p e over the variables in @p e.
+  explicit AutoDiff(const Expression& e);
+
+  /// Returns the underlying tape.
+  const ExpressionTape& tape() const { return tape_; }
+
+  /// Returns the variables. The i-th input is the value of the i-th
+  /// variable.
+  const std::vector<Variable>& variables() const { return tape_.variables(); }
+
+  /// Returns the number of inputs.
+  int num_inputs() const { return static_cast<int>(variables().size()); }
+
+  /// Returns the number of outputs.
+  int num_outputs() const { return static_cast<int>(tape_.outputs().size()); }
+
+  /// Computes the gradient of the @p i-th expression at @p x and stores
+  /// it in @p grad. Returns the value of the @p i-th expression at @p x.
+  ///
+  /// @pre `x` and `grad` point to arrays of `num_inputs()` values.
+  template <typename T>
+  T Gradient(const T* x, T* grad, int i = 0) const;
+
+  /// Computes wᵀJ(x), where J is the Jacobian of the expressions, by
+  /// one reverse sweep. The result is stored in @p out.
+  ///
+  /// @pre `x` and `out` point to arrays of `num_inputs()` values.
+  /// @pre `w` points to an array of `num_outputs()` values.
+  template <typename T>
+  void VectorJacobianProduct(const T* x, const T* w, T* out) const;
+
+  /// Computes J(x)v, where J is the Jacobian of the expressions, by one
+  /// forward sweep. The result is stored in @p out.
+  ///
+  /// @pre `x` and `v` point to arrays of `num_inputs()` values.
+  /// @pre `out` points to an array of `num_outputs()` values.
+  template <typename T>
+  void JacobianVectorProduct(const T* x, const T* v, T* out) const;
+
+  /// Computes the Jacobian of the expressions at @p x and stores it in
+  /// @p jacobian in row-major order, that is, ∂fᵢ/∂xⱼ is stored at
+  /// `(*jacobian)[i * num_inputs() + j]`.
+  template <typename T>
+  void Jacobian(const T* x, std::vector<T>* jacobian) const;
+
+ private:
+  // Computes the local partial derivatives of the @p i-th instruction
+  // with respect to its operands and stores them in @p d1 and @p d2.
+  template <typename T>
+  static void Partials(const ExpressionTape::Instruction& inst, int i,
+                       const std::vector<T>& values, T* d1, T* d2);
+
+  // Propagates @p adjoints backward through the tape evaluated at
+  // @p values and accumulates the adjoints of the inputs in @p out.
+  template <typename T>
+  void Reverse(const std::vector<T>& values, std::vector<T>* adjoints,
+               T* out) const;
+
+  ExpressionTape tape_;
+};
+
+template <typename T>
+void AutoDiff::Partials(const ExpressionTape::Instruction& inst, const int i,
+                        const std::vector<T>& values, T* const d1,
+                        T* const d2) {
+  using internal::sqr;
+  using std::cos;
+  using std::cosh;
+  using std::log;
+  using std::pow;
+  using std::sin;
+  using std::sinh;
+  using std::sqrt;
+  using Op = ExpressionTape::Op;
+  const T* const v{values.data()};
+  switch (inst.op) {
+    case Op::Constant:
+    case Op::RealConstant:
+    case Op::Var:
+      // Leaves do not have operands.
+      return;
+    case Op::Add:
+      *d1 = T(1.0);
+      *d2 = T(1.0);
+      return;
+    case Op::AddConstant:
+      *d1 = T(1.0);
+      return;
+    case Op::Mul:
+      *d1 = v[inst.arg2];
+      *d2 = v[inst.arg1];
+      return;
+    case Op::Scale:
+      *d1 = T(inst.c);
+      return;
+    case Op::Div:
+      // (x / y)' = (1 / y, -(x / y) / y).
+      *d1 = 1.0 / v[inst.arg2];
+      *d2 = -v[i] / v[inst.arg2];
+      return;
+    case Op::Pow:
+      // (x^y)' = (y * x^(y-1), x^y * log(x)).
+      *d1 = v[inst.arg2] * pow(v[inst.arg1], v[inst.arg2] - 1.0);
+      *d2 = v[i] * log(v[inst.arg1]);
+      return;
+    case Op::PowConstant:
+      *d1 = inst.c * internal::PowConstant(v[inst.arg1], inst.c - 1.0);
+      return;
+    case Op::Log:
+      *d1 = 1.0 / v[inst.arg1];
+      return;
+    case Op::Exp:
+      *d1 = v[i];
+      return;
+    case Op::Sqrt:
+      *d1 = 0.5 / v[i];
+      return;
+    case Op::Sin:
+      *d1 = cos(v[inst.arg1]);
+      return;
+    case Op::Cos:
+      *d1 = -sin(v[inst.arg1]);
+      return;
+    case Op::Tan:
+      *d1 = 1.0 + sqr(v[i]);
+      return;
+    case Op::Asin:
+      *d1 = 1.0 / sqrt(1.0 - sqr(v[inst.arg1]));
+      return;
+    case Op::Acos:
+      *d1 = -1.0 / sqrt(1.0 - sqr(v[inst.arg1]));
+      return;
+    case Op::Atan:
+      *d1 = 1.0 / (1.0 + sqr(v[inst.arg1]));
+      return;
+    case Op::Atan2: {
+      // atan2(y, x)' = (x / (x² + y²), -y / (x² + y²)).
+      const T& y{v[inst.arg1]};
+      const T& x{v[inst.arg2]};
+      const T denominator{sqr(x) + sqr(y)};
+      *d1 = x / denominator;
+      *d2 = -y / denominator;
+      return;
+    }
+    case Op::Sinh:
+      *d1 = cosh(v[inst.arg1]);
+      return;
+    case Op::Cosh:
+      *d1 = sinh(v[inst.arg1]);
+      return;
+    case Op::Tanh:
+      *d1 = 1.0 - sqr(v[i]);
+      return;
+    case Op::Abs:
+    case Op::Min:
+    case Op::Max:
+      // Rejected at construction.
+      return;
+  }
+}
+
+template <typename T>
+void AutoDiff::Reverse(const std::vector<T>& values,
+                       std::vector<T>* const adjoints, T* const out) const {
+  const std::vector<ExpressionTape::Instruction>& instructions{
+      tape_.instructions()};
+  T* const a{adjoints->data()};
+  for (int i = 0; i < num_inputs(); ++i) {
+    out[i] = T(0.0);
+  }
+  T d1(0.0);
+  T d2(0.0);
+  for (int i = tape_.size() - 1; i >= 0; --i) {
+    const ExpressionTape::Instruction& inst{instructions[i]};
+    if (inst.op == ExpressionTape::Op::Var) {
+      out[inst.arg1] += a[i];
+      continue;
+    }
+    if (inst.arg1 == -1) {
+      // Constants.
+      continue;
+    }
+    Partials(inst, i, values, &d1, &d2);
+    a[inst.arg1] += a[i] * d1;
+    if (inst.arg2 != -1) {
+      a[inst.arg2] += a[i] * d2;
+    }
+  }
+}
+
+template <typename T>
+T AutoDiff::Gradient(const T* const x, T* const grad, const int i) const {
+  std::vector<T> values;
+  tape_.Evaluate(x, &values);
+  std::vector<T> adjoints(values.size(), T(0.0));
+  adjoints[tape_.outputs()[i]] = T(1.0);
+  Reverse(values, &adjoints, grad);
+  return values[tape_.outputs()[i]];
+}
+
+template <typename T>
+void AutoDiff::VectorJacobianProduct(const T* const x, const T* const w,
+                                     T* const out) const {
+  std::vector<T> values;
+  tape_.Evaluate(x, &values);
+  std::vector<T> adjoints(values.size(), T(0.0));
+  for (int i = 0; i < num_outputs(); ++i) {
+    // The same instruction can be the output of several expressions.
+    adjoints[tape_.outputs()[i]] += w[i];
+  }
+  Reverse(values, &adjoints, out);
+}
+
+template <typename T>
+void AutoDiff::JacobianVectorProduct(const T* const x, const T* const v,
+                                     T* const out) const {
+  const std::vector<ExpressionTape::Instruction>& instructions{
+      tape_.instructions()};
+  std::vector<T> values;
+  tape_.Evaluate(x, &values);
+  std::vector<T> tangents(values.size(), T(0.0));
+  T d1(0.0);
+  T d2(0.0);
+  for (int i = 0; i < tape_.size(); ++i) {
+    const ExpressionTape::Instruction& inst{instructions[i]};
+    if (inst.op == ExpressionTape::Op::Var) {
+      tangents[i] = v[inst.arg1];
+      continue;
+    }
+    if (inst.arg1 == -1) {
+      // Constants.
+      continue;
+    }
+    Partials(inst, i, values, &d1, &d2);
+    tangents[i] = d1 * tangents[inst.arg1];
+    if (inst.arg2 != -1) {
+      tangents[i] += d2 * tangents[inst.arg2];
+    }
+  }
+  for (int i = 0; i < num_outputs(); ++i) {
+    out[i] = tangents[tape_.outputs()[i]];
+  }
+}
+
+template <typename T>
+void AutoDiff::Jacobian(const T* const x,
+                        std::vector<T>* const jacobian) const {
+  const int n{num_inputs()};
+  jacobian->assign(num_outputs() * n, T(0.0));
+  std::vector<T> values;
+  tape_.Evaluate(x, &values);
+  std::vector<T> adjoints(values.size());
+  for (int i = 0; i < num_outputs(); ++i) {
+    adjoints.assign(values.size(), T(0.0));
+    adjoints[tape_.outputs()[i]] = T(1.0);
+    Reverse(values, &adjoints, jacobian->data() + i * n);
+  }
+}
+
+}  // namespace dreal
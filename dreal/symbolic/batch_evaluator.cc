@@ -0,0 +1,195 @@
+#include "dreal/symbolic/batch_evaluator.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+#include <fmt/ostream.h>
+
+#include "dreal/util/exception.h"
+
+namespace dreal {
+
+using std::min;
+using std::vector;
+
+namespace {
+// The number of points which FormulaBatchEvaluator processes at a time.
+constexpr int kBlockSize{256};
+
+// out[i] = cmp(lhs[i], rhs[i]) for i ∈ [0, n).
+template <typename Compare>
+void CompareBlock(const int n, const double* const lhs,
+                  const double* const rhs, unsigned char* const out,
+                  Compare cmp) {
+  for (int i = 0; i < n; ++i) {
+    out[i] = cmp(lhs[i], rhs[i]);
+  }
+}
+}  // namespace
+
+// ------------------------
+// ExpressionBatchEvaluator
+// ------------------------
+ExpressionBatchEvaluator::ExpressionBatchEvaluator(const Expression& e,
+                                                   vector<Variable> variables)
+    : tape_{e, std::move(variables)} {}
+
+ExpressionBatchEvaluator::ExpressionBatchEvaluator(const Expression& e)
+    : tape_{e} {}
+
+void ExpressionBatchEvaluator::Evaluate(const double* const points,
+                                        const int num_points,
+                                        double* const results) const {
+  tape_.EvaluateBatch(num_points, points, results);
+}
+
+// ---------------------
+// FormulaBatchEvaluator
+// ---------------------
+FormulaBatchEvaluator::FormulaBatchEvaluator(const Formula& f,
+                                             vector<Variable> variables)
+    : tape_{Compile(f, &nodes_), std::move(variables)} {}
+
+FormulaBatchEvaluator::FormulaBatchEvaluator(const Formula& f)
+    : FormulaBatchEvaluator{f,
+                            vector<Variable>(f.GetFreeVariables().begin(),
+                                             f.GetFreeVariables().end())} {}
+
+vector<Expression> FormulaBatchEvaluator::Compile(const Formula& f,
+                                                  vector<Node>* const nodes) {
+  vector<Expression> expressions;
+  Build(f, nodes, &expressions);
+  return expressions;
+}
+
+int FormulaBatchEvaluator::Build(const Formula& f, vector<Node>* const nodes,
+                                 vector<Expression>* const expressions) {
+  Node node;
+  node.kind = f.get_kind();
+  switch (f.get_kind()) {
+    case FormulaKind::True:
+    case FormulaKind::False:
+      break;
+    case FormulaKind::Eq:
+    case FormulaKind::Neq:
+    case FormulaKind::Gt:
+    case FormulaKind::Geq:
+    case FormulaKind::Lt:
+    case FormulaKind::Leq:
+      node.atom = static_cast<int>(expressions->size()) / 2;
+      expressions->push_back(get_lhs_expression(f));
+      expressions->push_back(get_rhs_expression(f));
+      break;
+    case FormulaKind::And:
+    case FormulaKind::Or:
+      for (const Formula& f_i : get_operands(f)) {
+        node.operands.push_back(Build(f_i, nodes, expressions));
+      }
+      break;
+    case FormulaKind::Not:
+      node.operands.push_back(Build(get_operand(f), nodes, expressions));
+      break;
+    case FormulaKind::Var:
+    case FormulaKind::Forall:
+      throw DREAL_RUNTIME_ERROR(
+          "FormulaBatchEvaluator: {} is not supported.", f);
+  }
+  nodes->push_back(std::move(node));
+  return static_cast<int>(nodes->size()) - 1;
+}
+
+void FormulaBatchEvaluator::Evaluate(const double* const points,
+                                     const int num_points,
+                                     bool* const results) const {
+  const vector<int>& outputs{tape_.outputs()};
+  const int num_outputs{static_cast<int>(outputs.size())};
+  vector<double> values(static_cast<size_t>(num_outputs) * kBlockSize);
+  vector<unsigned char> truth(nodes_.size() * kBlockSize);
+  for (int start = 0; start < num_points; start += kBlockSize) {
+    const int m{min(kBlockSize, num_points - start)};
+    if (num_outputs > 0) {
+      tape_.EvaluateBatch(m, points + start, num_points, values.data(),
+                          kBlockSize);
+    }
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+      const Node& node{nodes_[i]};
+      unsigned char* const out{&truth[i * kBlockSize]};
+      const double* const lhs{
+          node.atom != -1 ? &values[2 * node.atom * kBlockSize] : nullptr};
+      const double* const rhs{
+          node.atom != -1 ? &values[(2 * node.atom + 1) * kBlockSize]
+                          : nullptr};
+      switch (node.kind) {
+        case FormulaKind::True:
+          std::fill(out, out + m, 1);
+          break;
+        case FormulaKind::False:
+          std::fill(out, out + m, 0);
+          break;
+        case FormulaKind::Eq:
+          CompareBlock(m, lhs, rhs, out,
+                       [](double a, double b) { return a == b; });
+          break;
+        case FormulaKind::Neq:
+          CompareBlock(m, lhs, rhs, out,
+                       [](double a, double b) { return a != b; });
+          break;
+        case FormulaKind::Gt:
+          CompareBlock(m, lhs, rhs, out,
+                       [](double a, double b) { return a > b; });
+          break;
+        case FormulaKind::Geq:
+          CompareBlock(m, lhs, rhs, out,
+                       [](double a, double b) { return a >= b; });
+          break;
+        case FormulaKind::Lt:
+          CompareBlock(m, lhs, rhs, out,
+                       [](double a, double b) { return a < b; });
+          break;
+        case FormulaKind::Leq:
+          CompareBlock(m, lhs, rhs, out,
+                       [](double a, double b) { return a <= b; });
+          break;
+        case FormulaKind::And:
+        case FormulaKind::Or: {
+          const unsigned char* const first{
+              &truth[node.operands[0] * kBlockSize]};
+          std::copy(first, first + m, out);
+          for (size_t k = 1; k < node.operands.size(); ++k) {
+            const unsigned char* const operand{
+                &truth[node.operands[k] * kBlockSize]};
+            if (node.kind == FormulaKind::And) {
+              for (int j = 0; j < m; ++j) {
+                out[j] &= operand[j];
+              }
+            } else {
+              for (int j = 0; j < m; ++j) {
+                out[j] |= operand[j];
+              }
+            }
+          }
+          break;
+        }
+        case FormulaKind::Not: {
+          const unsigned char* const operand{
+              &truth[node.operands[0] * kBlockSize]};
+          for (int j = 0; j < m; ++j) {
+            out[j] = !operand[j];
+          }
+          break;
+        }
+        case FormulaKind::Var:
+        case FormulaKind::Forall:
+          // Rejected at construction.
+          DREAL_UNREACHABLE();
+      }
+    }
+    const unsigned char* const root{&truth[(nodes_.size() - 1) * kBlockSize]};
+    for (int j = 0; j < m; ++j) {
+      results[start + j] = root[j] != 0;
+    }
+  }
+}
+
+}  // namespace dreal
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <vector>
+
+#include "dreal/symbolic/expression_tape.h"
+#include "dreal/symbolic/symbolic.h"
+
+namespace dreal {
+
+/// Evaluates an expression at many points at once.
+///
+/// The expression is compiled into an ExpressionTape at construction,
+/// and the points are evaluated block by block with vectorized loops
+/// (see `ExpressionTape::EvaluateBatch`). This is much faster than
+/// calling `Expression::Evaluate` once per point.
+///
+/// The results may differ from the ones of `Expression::Evaluate` by
+/// rounding errors, since the tape can apply the operations of an
+/// n-ary addition or multiplication in a different order.
+class ExpressionBatchEvaluator {
+ public:
+  /// Constructs an evaluator for @p e over @p variables.
+  ///
+  /// @throws std::runtime_error if @p e includes an if-then-else, an
+  ///         uninterpreted function, or a variable which is not in
+  ///         @p variables.
+  ExpressionBatchEvaluator(const Expression& e,
+                           std::vector<Variable> variables);
+
+  /// Constructs an evaluator for @p e over the variables in @p e.
+  explicit ExpressionBatchEvaluator(const Expression& e);
+
+  /// Returns the variables. The j-th column of a matrix of points is
+  /// the values of the j-th variable.
+  const std::vector<Variable>& variables() const {
+    return tape_.variables();
+  }
+
+  /// Evaluates the expression at @p num_points points and stores the
+  /// results in @p results.
+  ///
+  /// @p points is a column-major `num_points × variables().size()`
+  /// matrix, that is, the value of the j-th variable at the i-th point
+  /// is `points[j * num_points + i]`.
+  ///
+  /// @pre `results` points to an array of `num_points` values.
+  void Evaluate(const double* points, int num_points, double* results) const;
+
+ private:
+  ExpressionTape tape_;
+};
+
+/// Evaluates a formula at many points at once.
+///
+/// The expressions in the atomic formulas are compiled into one
+/// ExpressionTape so that the sub-expressions shared by the atoms are
+/// evaluated once. The Boolean structure is then evaluated block by
+/// block over the results of the atoms.
+///
+/// It supports conjunctions, disjunctions, and negations of relational
+/// formulas (and the constants true and false).
+class FormulaBatchEvaluator {
+ public:
+  /// Constructs an evaluator for @p f over @p variables.
+  ///
+  /// @throws std::runtime_error if @p f includes a Boolean variable, a
+  ///         quantified formula, or an expression not supported by
+  ///         ExpressionBatchEvaluator.
+  FormulaBatchEvaluator(const Formula& f, std::vector<Variable> variables);
+
+  /// Constructs an evaluator for @p f over the free variables in @p f.
+  explicit FormulaBatchEvaluator(const Formula& f);
+
+  /// Returns the variables. The j-th column of a matrix of points is
+  /// the values of the j-th variable.
+  const std::vector<Variable>& variables() const {
+    return tape_.variables();
+  }
+
+  /// Evaluates the formula at @p num_points points and stores the
+  /// results in @p results. See `ExpressionBatchEvaluator::Evaluate`
+  /// for the layout of @p points.
+  ///
+  /// @pre `results` points to an array of `num_points` values.
+  void Evaluate(const double* points, int num_points, bool* results) const;
+
+ private:
+  // A node of the Boolean structure of the formula. The operands of a
+  // node precede the node.
+  struct Node {
+    FormulaKind kind;
+    // For a relational formula, the lhs and rhs are the 2 * atom-th and
+    // (2 * atom + 1)-th outputs of tape_.
+    int atom{-1};
+    std::vector<int> operands;
+  };
+
+  // Collects the nodes of @p f in @p nodes and returns the expressions
+  // in its atoms (lhs and rhs in turn).
+  static std::vector<Expression> Compile(const Formula& f,
+                                         std::vector<Node>* nodes);
+
+  // Adds the nodes of @p f to @p nodes and the expressions in its atoms
+  // to @p expressions. Returns the position of the node for @p f.
+  static int Build(const Formula& f, std::vector<Node>* nodes,
+                   std::vector<Expression>* expressions);
+
+  std::vector<Node> nodes_;
+  ExpressionTape tape_;
+};
+
+}  // namespace dreal
@@ -0,0 +1,435 @@
+#include "dreal/symbolic/expression_tape.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+
+#include <fmt/ostream.h>
+
+#include "dreal/util/assert.h"
+#include "dreal/util/exception.h"
+
+namespace dreal {
+
+using std::min;
+using std::ostream;
+using std::unordered_map;
+using std::vector;
+
+namespace {
+
+using Op = ExpressionTape::Op;
+using Instruction = ExpressionTape::Instruction;
+
+// Visits an expression and appends instructions to a tape. Shared
+// sub-expressions are emitted only once.
+class TapeBuilder {
+ public:
+  TapeBuilder(const vector<Variable>& variables,
+              vector<Instruction>* const instructions)
+      : instructions_{instructions} {
+    for (size_t i = 0; i < variables.size(); ++i) {
+      var_to_input_.emplace(variables[i].get_id(), i);
+    }
+  }
+
+  // Returns the position of the instruction computing @p e.
+  int Build(const Expression& e) {
+    const auto it = memo_.find(e);
+    if (it != memo_.end()) {
+      return it->second;
+    }
+    const int pos{VisitExpression<int>(this, e)};
+    memo_.emplace(e, pos);
+    return pos;
+  }
+
+ private:
+  int Emit(const Op op, const int arg1 = -1, const int arg2 = -1,
+           const double c = 0.0) {
+    Instruction inst;
+    inst.op = op;
+    inst.arg1 = arg1;
+    inst.arg2 = arg2;
+    inst.c = c;
+    instructions_->push_back(inst);
+    return static_cast<int>(instructions_->size()) - 1;
+  }
+
+  int EmitUnary(const Op op, const Expression& e) {
+    return Emit(op, Build(get_argument(e)));
+  }
+
+  int EmitBinary(const Op op, const Expression& e) {
+    const int arg1{Build(get_first_argument(e))};
+    const int arg2{Build(get_second_argument(e))};
+    return Emit(op, arg1, arg2);
+  }
+
+  int VisitVariable(const Expression& e) {
+    const Variable& var{get_variable(e)};
+    const auto it = var_to_input_.find(var.get_id());
+    if (it == var_to_input_.end()) {
+      throw DREAL_RUNTIME_ERROR(
+          "ExpressionTape: variable {} is not in the given variables.", var);
+    }
+    return Emit(Op::Var, it->second);
+  }
+
+  int VisitConstant(const Expression& e) {
+    return Emit(Op::Constant, -1, -1, get_constant_value(e));
+  }
+
+  int VisitRealConstant(const Expression& e) {
+    const int pos{Emit(Op::RealConstant, -1, -1, e.Evaluate())};
+    Instruction& inst{(*instructions_)[pos]};
+    inst.lb = get_lb_of_real_constant(e);
+    inst.ub = get_ub_of_real_constant(e);
+    return pos;
+  }
+
+  // c₀ + ∑ cᵢeᵢ is emitted as a chain of binary additions.
+  int VisitAddition(const Expression& e) {
+    int acc{-1};
+    for (const auto& p : get_expr_to_coeff_map_in_addition(e)) {
+      int term{Build(p.first)};
+      if (p.second != 1.0) {
+        term = Emit(Op::Scale, term, -1, p.second);
+      }
+      acc = acc == -1 ? term : Emit(Op::Add, acc, term);
+    }
+    const double constant{get_constant_in_addition(e)};
+    if (constant != 0.0) {
+      acc = Emit(Op::AddConstant, acc, -1, constant);
+    }
+    return acc;
+  }
+
+  // c₀ * ∏ bᵢ^eᵢ is emitted as a chain of binary multiplications.
+  int VisitMultiplication(const Expression& e) {
+    int acc{-1};
+    for (const auto& p : get_base_to_exponent_map_in_multiplication(e)) {
+      const Expression& base{p.first};
+      const Expression& exponent{p.second};
+      int term{Build(base)};
+      if (is_constant(exponent)) {
+        const double c{get_constant_value(exponent)};
+        if (c != 1.0) {
+          term = Emit(Op::PowConstant, term, -1, c);
+        }
+      } else {
+        term = Emit(Op::Pow, term, Build(exponent));
+      }
+      acc = acc == -1 ? term : Emit(Op::Mul, acc, term);
+    }
+    const double constant{get_constant_in_multiplication(e)};
+    if (constant != 1.0) {
+      acc = Emit(Op::Scale, acc, -1, constant);
+    }
+    return acc;
+  }
+
+  int VisitDivision(const Expression& e) { return EmitBinary(Op::Div, e); }
+  int VisitLog(const Expression& e) { return EmitUnary(Op::Log, e); }
+  int VisitAbs(const Expression& e) { return EmitUnary(Op::Abs, e); }
+  int VisitExp(const Expression& e) { return EmitUnary(Op::Exp, e); }
+  int VisitSqrt(const Expression& e) { return EmitUnary(Op::Sqrt, e); }
+
+  int VisitPow(const Expression& e) {
+    const Expression& exponent{get_second_argument(e)};
+    if (is_constant(exponent)) {
+      return Emit(Op::PowConstant, Build(get_first_argument(e)), -1,
+                  get_constant_value(exponent));
+    }
+    return EmitBinary(Op::Pow, e);
+  }
+
+  int VisitSin(const Expression& e) { return EmitUnary(Op::Sin, e); }
+  int VisitCos(const Expression& e) { return EmitUnary(Op::Cos, e); }
+  int VisitTan(const Expression& e) { return EmitUnary(Op::Tan, e); }
+  int VisitAsin(const Expression& e) { return EmitUnary(Op::Asin, e); }
+  int VisitAcos(const Expression& e) { return EmitUnary(Op::Acos, e); }
+  int VisitAtan(const Expression& e) { return EmitUnary(Op::Atan, e); }
+  int VisitAtan2(const Expression& e) { return EmitBinary(Op::Atan2, e); }
+  int VisitSinh(const Expression& e) { return EmitUnary(Op::Sinh, e); }
+  int VisitCosh(const Expression& e) { return EmitUnary(Op::Cosh, e); }
+  int VisitTanh(const Expression& e) { return EmitUnary(Op::Tanh, e); }
+  int VisitMin(const Expression& e) { return EmitBinary(Op::Min, e); }
+  int VisitMax(const Expression& e) { return EmitBinary(Op::Max, e); }
+
+  static int VisitIfThenElse(const Expression& e) {
+    throw DREAL_RUNTIME_ERROR(
+        "ExpressionTape: if-then-else expression {} is not supported.", e);
+  }
+
+  static int VisitUninterpretedFunction(const Expression& e) {
+    throw DREAL_RUNTIME_ERROR(
+        "ExpressionTape: uninterpreted function {} is not supported.", e);
+  }
+
+  // Makes VisitExpression a friend of this class so that it can use private
+  // methods.
+  friend int drake::symbolic::VisitExpression<int>(TapeBuilder*,
+                                                   const Expression&);
+
+  vector<Instruction>* const instructions_;
+  unordered_map<Variable::Id, int> var_to_input_;
+  unordered_map<Expression, int> memo_;
+};
+
+}  // namespace
+
+ExpressionTape::ExpressionTape(const vector<Expression>& expressions,
+                               vector<Variable> variables)
+    : variables_{std::move(variables)} {
+  TapeBuilder builder{variables_, &instructions_};
+  outputs_.reserve(expressions.size());
+  for (const Expression& e : expressions) {
+    outputs_.push_back(builder.Build(e));
+  }
+}
+
+ExpressionTape::ExpressionTape(const Expression& e, vector<Variable> variables)
+    : ExpressionTape{vector<Expression>{e}, std::move(variables)} {}
+
+ExpressionTape::ExpressionTape(const Expression& e)
+    : ExpressionTape{e, vector<Variable>(e.GetVariables().begin(),
+                                         e.GetVariables().end())} {}
+
+namespace {
+
+// The number of points which EvaluateBatch processes at a time. The
+// values of all the instructions for a block should stay in cache.
+constexpr int kBatchBlockSize{256};
+
+// out[i] = f(x[i]) for i ∈ [0, n).
+template <typename F>
+void Map(const int n, const double* const x, double* const out, F f) {
+  for (int i = 0; i < n; ++i) {
+    out[i] = f(x[i]);
+  }
+}
+
+// out[i] = f(x[i], y[i]) for i ∈ [0, n).
+template <typename F>
+void Map(const int n, const double* const x, const double* const y,
+         double* const out, F f) {
+  for (int i = 0; i < n; ++i) {
+    out[i] = f(x[i], y[i]);
+  }
+}
+
+// Applies @p inst to @p n points. rows[k] points to the values of the
+// k-th instruction at the points.
+void EvaluateBlock(const Instruction& inst, const vector<const double*>& rows,
+                   const int n, double* const out) {
+  const double* const x{inst.arg1 != -1 ? rows[inst.arg1] : nullptr};
+  const double* const y{inst.arg2 != -1 ? rows[inst.arg2] : nullptr};
+  const double c{inst.c};
+  switch (inst.op) {
+    case Op::Constant:
+    case Op::RealConstant:
+    case Op::Var:
+      // Handled by EvaluateBatch.
+      DREAL_UNREACHABLE();
+    case Op::Add:
+      return Map(n, x, y, out, [](double a, double b) { return a + b; });
+    case Op::AddConstant:
+      return Map(n, x, out, [c](double a) { return a + c; });
+    case Op::Mul:
+      return Map(n, x, y, out, [](double a, double b) { return a * b; });
+    case Op::Scale:
+      return Map(n, x, out, [c](double a) { return a * c; });
+    case Op::Div:
+      return Map(n, x, y, out, [](double a, double b) { return a / b; });
+    case Op::Pow:
+      return Map(n, x, y, out,
+                 [](double a, double b) { return std::pow(a, b); });
+    case Op::PowConstant:
+      if (c == 2.0) {
+        return Map(n, x, out, [](double a) { return a * a; });
+      }
+      return Map(n, x, out, [c](double a) { return std::pow(a, c); });
+    case Op::Log:
+      return Map(n, x, out, [](double a) { return std::log(a); });
+    case Op::Abs:
+      return Map(n, x, out, [](double a) { return std::abs(a); });
+    case Op::Exp:
+      return Map(n, x, out, [](double a) { return std::exp(a); });
+    case Op::Sqrt:
+      return Map(n, x, out, [](double a) { return std::sqrt(a); });
+    case Op::Sin:
+      return Map(n, x, out, [](double a) { return std::sin(a); });
+    case Op::Cos:
+      return Map(n, x, out, [](double a) { return std::cos(a); });
+    case Op::Tan:
+      return Map(n, x, out, [](double a) { return std::tan(a); });
+    case Op::Asin:
+      return Map(n, x, out, [](double a) { return std::asin(a); });
+    case Op::Acos:
+      return Map(n, x, out, [](double a) { return std::acos(a); });
+    case Op::Atan:
+      return Map(n, x, out, [](double a) { return std::atan(a); });
+    case Op::Atan2:
+      return Map(n, x, y, out,
+                 [](double a, double b) { return std::atan2(a, b); });
+    case Op::Sinh:
+      return Map(n, x, out, [](double a) { return std::sinh(a); });
+    case Op::Cosh:
+      return Map(n, x, out, [](double a) { return std::cosh(a); });
+    case Op::Tanh:
+      return Map(n, x, out, [](double a) { return std::tanh(a); });
+    case Op::Min:
+      return Map(n, x, y, out,
+                 [](double a, double b) { return std::min(a, b); });
+    case Op::Max:
+      return Map(n, x, y, out,
+                 [](double a, double b) { return std::max(a, b); });
+  }
+  DREAL_UNREACHABLE();
+}
+
+}  // namespace
+
+void ExpressionTape::EvaluateBatch(const int num_points,
+                                   const double* const inputs,
+                                   const int inputs_stride,
+                                   double* const outputs,
+                                   const int outputs_stride) const {
+  DREAL_ASSERT(inputs_stride >= num_points);
+  DREAL_ASSERT(outputs_stride >= num_points);
+  const int n{size()};
+  vector<double> scratch(static_cast<size_t>(n) * kBatchBlockSize);
+  // rows[i] points to the values of the i-th instruction in the
+  // current block.
+  vector<const double*> rows(n, nullptr);
+  // The values of the constants do not change from block to block.
+  for (int i = 0; i < n; ++i) {
+    const Instruction& inst{instructions_[i]};
+    if (inst.op == Op::Constant || inst.op == Op::RealConstant) {
+      double* const row{&scratch[static_cast<size_t>(i) * kBatchBlockSize]};
+      std::fill(row, row + kBatchBlockSize, inst.c);
+      rows[i] = row;
+    }
+  }
+  for (int start = 0; start < num_points; start += kBatchBlockSize) {
+    const int m{min(kBatchBlockSize, num_points - start)};
+    for (int i = 0; i < n; ++i) {
+      const Instruction& inst{instructions_[i]};
+      if (inst.op == Op::Constant || inst.op == Op::RealConstant) {
+        continue;
+      }
+      if (inst.op == Op::Var) {
+        // Reads the inputs in place.
+        rows[i] = inputs + static_cast<ptrdiff_t>(inst.arg1) * inputs_stride +
+                  start;
+        continue;
+      }
+      double* const row{&scratch[static_cast<size_t>(i) * kBatchBlockSize]};
+      EvaluateBlock(inst, rows, m, row);
+      rows[i] = row;
+    }
+    for (size_t k = 0; k < outputs_.size(); ++k) {
+      const double* const row{rows[outputs_[k]]};
+      std::copy(row, row + m,
+                outputs + static_cast<ptrdiff_t>(k) * outputs_stride + start);
+    }
+  }
+}
+
+void ExpressionTape::EvaluateBatch(const int num_points,
+                                   const double* const inputs,
+                                   double* const outputs) const {
+  EvaluateBatch(num_points, inputs, num_points, outputs, num_points);
+}
+
+ostream& operator<<(ostream& os, const ExpressionTape::Op op) {
+  switch (op) {
+    case Op::Constant:
+      return os << "Constant";
+    case Op::RealConstant:
+      return os << "RealConstant";
+    case Op::Var:
+      return os << "Var";
+    case Op::Add:
+      return os << "Add";
+    case Op::AddConstant:
+      return os << "AddConstant";
+    case Op::Mul:
+      return os << "Mul";
+    case Op::Scale:
+      return os << "Scale";
+    case Op::Div:
+      return os << "Div";
+    case Op::Pow:
+      return os << "Pow";
+    case Op::PowConstant:
+      return os << "PowConstant";
+    case Op::Log:
+      return os << "Log";
+    case Op::Abs:
+      return os << "Abs";
+    case Op::Exp:
+      return os << "Exp";
+    case Op::Sqrt:
+      return os << "Sqrt";
+    case Op::Sin:
+      return os << "Sin";
+    case Op::Cos:
+      return os << "Cos";
+    case Op::Tan:
+      return os << "Tan";
+    case Op::Asin:
+      return os << "Asin";
+    case Op::Acos:
+      return os << "Acos";
+    case Op::Atan:
+      return os << "Atan";
+    case Op::Atan2:
+      return os << "Atan2";
+    case Op::Sinh:
+      return os << "Sinh";
+    case Op::Cosh:
+      return os << "Cosh";
+    case Op::Tanh:
+      return os << "Tanh";
+    case Op::Min:
+      return os << "Min";
+    case Op::Max:
+      return os << "Max";
+  }
+  DREAL_UNREACHABLE();
+}
+
+ostream& operator<<(ostream& os, const ExpressionTape& tape) {
+  const vector<ExpressionTape::Instruction>& instructions{
+      tape.instructions()};
+  for (size_t i = 0; i < instructions.size(); ++i) {
+    const ExpressionTape::Instruction& inst{instructions[i]};
+    os << "v" << i << " = " << inst.op;
+    switch (inst.op) {
+      case Op::Constant:
+      case Op::RealConstant:
+        os << " " << inst.c;
+        break;
+      case Op::Var:
+        os << " " << tape.variables()[inst.arg1];
+        break;
+      case Op::AddConstant:
+      case Op::Scale:
+      case Op::PowConstant:
+        os << " v" << inst.arg1 << " " << inst.c;
+        break;
+      default:
+        os << " v" << inst.arg1;
+        if (inst.arg2 != -1) {
+          os << " v" << inst.arg2;
+        }
+    }
+    os << "\n";
+  }
+  return os;
+}
+
+}  // namespace dreal
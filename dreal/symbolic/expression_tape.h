@@ -0,0 +1,281 @@
+#pragma once
+
+#include <cmath>
+#include <ostream>
+#include <vector>
+
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/math.h"
+
+namespace dreal {
+
+/// Represents a linearized form of a set of symbolic expressions.
+///
+/// An ExpressionTape is a topologically sorted list of instructions
+/// where each instruction refers to its operands by their positions in
+/// the list. Structurally equal sub-expressions are mapped to a single
+/// instruction, so that a tape represents the DAG (not the tree) of the
+/// given expressions and each shared sub-expression is evaluated once.
+///
+/// Variables are bound to the positions in the vector of variables
+/// which is provided at construction. The evaluation functions take
+/// values in this order.
+///
+/// The tape is parametrized neither by the type of values nor by the
+/// evaluation strategy. See `Evaluate<T>` which works both for `double`
+/// and for `Box::Interval`.
+class ExpressionTape {
+ public:
+  /// Kinds of instructions.
+  enum class Op {
+    Constant,      ///< c
+    RealConstant,  ///< [lb, ub] (representative value c)
+    Var,           ///< inputs[arg1]
+    Add,           ///< v[arg1] + v[arg2]
+    AddConstant,   ///< v[arg1] + c
+    Mul,           ///< v[arg1] * v[arg2]
+    Scale,         ///< v[arg1] * c
+    Div,           ///< v[arg1] / v[arg2]
+    Pow,           ///< pow(v[arg1], v[arg2])
+    PowConstant,   ///< pow(v[arg1], c)
+    Log,           ///< log(v[arg1])
+    Abs,           ///< abs(v[arg1])
+    Exp,           ///< exp(v[arg1])
+    Sqrt,          ///< sqrt(v[arg1])
+    Sin,           ///< sin(v[arg1])
+    Cos,           ///< cos(v[arg1])
+    Tan,           ///< tan(v[arg1])
+    Asin,          ///< asin(v[arg1])
+    Acos,          ///< acos(v[arg1])
+    Atan,          ///< atan(v[arg1])
+    Atan2,         ///< atan2(v[arg1], v[arg2])
+    Sinh,          ///< sinh(v[arg1])
+    Cosh,          ///< cosh(v[arg1])
+    Tanh,          ///< tanh(v[arg1])
+    Min,           ///< min(v[arg1], v[arg2])
+    Max,           ///< max(v[arg1], v[arg2])
+  };
+
+  /// Represents an instruction in a tape.
+  struct Instruction {
+    Op op;
+    /// Position of the first operand. For `Var`, it is the position of
+    /// the variable in `variables()`.
+    int arg1{-1};
+    /// Position of the second operand (binary operations only).
+    int arg2{-1};
+    /// Constant, coefficient, or exponent.
+    double c{0.0};
+    /// Lower and upper bounds of a real constant.
+    double lb{0.0};
+    double ub{0.0};
+  };
+
+  /// Constructs a tape for @p expressions over @p variables.
+  ///
+  /// @throws std::runtime_error if an expression includes an
+  ///         if-then-else or an uninterpreted function.
+  /// @throws std::runtime_error if an expression includes a variable
+  ///         which is not in @p variables.
+  ExpressionTape(const std::vector<Expression>& expressions,
+                 std::vector<Variable> variables);
+
+  /// Constructs a tape for @p e over @p variables.
+  ExpressionTape(const Expression& e, std::vector<Variable> variables);
+
+  /// Constructs a tape for @p e over the variables in @p e.
+  explicit ExpressionTape(const Expression& e);
+
+  /// Returns the instructions.
+  const std::vector<Instruction>& instructions() const {
+    return instructions_;
+  }
+
+  /// Returns the number of instructions.
+  int size() const { return static_cast<int>(instructions_.size()); }
+
+  /// Returns the variables. The i-th input of the evaluation functions
+  /// is the value of the i-th variable.
+  const std::vector<Variable>& variables() const { return variables_; }
+
+  /// Returns the positions of the instructions which compute the
+  /// expressions given at construction.
+  const std::vector<int>& outputs() const { return outputs_; }
+
+  /// Evaluates all the instructions with @p inputs and stores the
+  /// results in @p values. The result of the i-th expression is
+  /// `(*values)[outputs()[i]]`.
+  ///
+  /// @pre `inputs` points to an array of `variables().size()` values.
+  template <typename T>
+  void Evaluate(const T* inputs, std::vector<T>* values) const;
+
+  /// Evaluates the instruction @p inst with @p values (results of the
+  /// preceding instructions) and @p inputs.
+  template <typename T>
+  static T Evaluate(const Instruction& inst, const T* values,
+                    const T* inputs);
+
+  /// Evaluates the tape at @p num_points points.
+  ///
+  /// The inputs are given as a column-major matrix: the value of the
+  /// j-th variable at the i-th point is `inputs[j * inputs_stride + i]`.
+  /// The value of the k-th output at the i-th point is stored in
+  /// `outputs[k * outputs_stride + i]`.
+  ///
+  /// The points are processed in blocks. For each block, every
+  /// instruction is applied to all the points in the block by a
+  /// branch-free loop over contiguous arrays, which the compiler
+  /// vectorizes. The inputs are read in place.
+  ///
+  /// @pre `inputs_stride >= num_points` and `outputs_stride >=
+  /// num_points`.
+  void EvaluateBatch(int num_points, const double* inputs, int inputs_stride,
+                     double* outputs, int outputs_stride) const;
+
+  /// Evaluates the tape at @p num_points points whose inputs and
+  /// outputs are stored in column-major matrices without padding.
+  void EvaluateBatch(int num_points, const double* inputs,
+                     double* outputs) const;
+
+ private:
+  std::vector<Variable> variables_;
+  std::vector<Instruction> instructions_;
+  std::vector<int> outputs_;
+};
+
+std::ostream& operator<<(std::ostream& os, ExpressionTape::Op op);
+
+std::ostream& operator<<(std::ostream& os, const ExpressionTape& tape);
+
+namespace internal {
+
+/// Provides `sqr` for double. For intervals, `ibex::sqr` is found by ADL.
+inline double sqr(const double v) { return v * v; }
+
+/// Traits to construct a value of type T from a tape constant.
+template <typename T>
+struct TapeValueTraits {
+  static T FromRealConstant(const double lb, const double ub,
+                            const double /* representative */) {
+    return T(lb, ub);
+  }
+};
+
+template <>
+struct TapeValueTraits<double> {
+  static double FromRealConstant(const double /* lb */, const double /* ub */,
+                                 const double representative) {
+    return representative;
+  }
+};
+
+/// Returns pow(@p v, @p c). It uses the integer-exponent version when
+/// @p c is an `int`, which gives tighter results for intervals.
+template <typename T>
+T PowConstant(const T& v, const double c) {
+  using std::pow;
+  if (is_integer(c)) {
+    if (c == 2.0) {
+      return sqr(v);
+    }
+    return pow(v, static_cast<int>(c));
+  }
+  return pow(v, c);
+}
+
+}  // namespace internal
+
+template <typename T>
+T ExpressionTape::Evaluate(const Instruction& inst, const T* const values,
+                           const T* const inputs) {
+  // Bring the functions for double into scope. For intervals, the
+  // corresponding ibex functions are found by argument-dependent lookup.
+  using internal::sqr;
+  using std::abs;
+  using std::acos;
+  using std::asin;
+  using std::atan;
+  using std::atan2;
+  using std::cos;
+  using std::cosh;
+  using std::exp;
+  using std::log;
+  using std::max;
+  using std::min;
+  using std::pow;
+  using std::sin;
+  using std::sinh;
+  using std::sqrt;
+  using std::tan;
+  using std::tanh;
+  switch (inst.op) {
+    case Op::Constant:
+      return T(inst.c);
+    case Op::RealConstant:
+      return internal::TapeValueTraits<T>::FromRealConstant(inst.lb, inst.ub,
+                                                            inst.c);
+    case Op::Var:
+      return inputs[inst.arg1];
+    case Op::Add:
+      return values[inst.arg1] + values[inst.arg2];
+    case Op::AddConstant:
+      return values[inst.arg1] + inst.c;
+    case Op::Mul:
+      return values[inst.arg1] * values[inst.arg2];
+    case Op::Scale:
+      return values[inst.arg1] * inst.c;
+    case Op::Div:
+      return values[inst.arg1] / values[inst.arg2];
+    case Op::Pow:
+      return pow(values[inst.arg1], values[inst.arg2]);
+    case Op::PowConstant:
+      return internal::PowConstant(values[inst.arg1], inst.c);
+    case Op::Log:
+      return log(values[inst.arg1]);
+    case Op::Abs:
+      return abs(values[inst.arg1]);
+    case Op::Exp:
+      return exp(values[inst.arg1]);
+    case Op::Sqrt:
+      return sqrt(values[inst.arg1]);
+    case Op::Sin:
+      return sin(values[inst.arg1]);
+    case Op::Cos:
+      return cos(values[inst.arg1]);
+    case Op::Tan:
+      return tan(values[inst.arg1]);
+    case Op::Asin:
+      return asin(values[inst.arg1]);
+    case Op::Acos:
+      return acos(values[inst.arg1]);
+    case Op::Atan:
+      return atan(values[inst.arg1]);
+    case Op::Atan2:
+      return atan2(values[inst.arg1], values[inst.arg2]);
+    case Op::Sinh:
+      return sinh(values[inst.arg1]);
+    case Op::Cosh:
+      return cosh(values[inst.arg1]);
+    case Op::Tanh:
+      return tanh(values[inst.arg1]);
+    case Op::Min:
+      return min(values[inst.arg1], values[inst.arg2]);
+    case Op::Max:
+      return max(values[inst.arg1], values[inst.arg2]);
+  }
+  // Unreachable. All the cases are handled above.
+  return T(0.0);
+}
+
+template <typename T>
+void ExpressionTape::Evaluate(const T* const inputs,
+                              std::vector<T>* const values) const {
+  values->resize(instructions_.size());
+  T* const v{values->data()};
+  for (size_t i = 0; i < instructions_.size(); ++i) {
+    v[i] = Evaluate(instructions_[i], v, inputs);
+  }
+}
+
+}  // namespace dreal
@@ -446,7 +446,7 @@ class IsDifferentiableVisitor {
   bool VisitAddition(const Expression& e) const {
     const auto& expr_to_coeff_map = get_expr_to_coeff_map_in_addition(e);
     return all_of(expr_to_coeff_map.begin(), expr_to_coeff_map.end(),
-                  [this](const pair<const Expression, double>& p) {
+                  [this](const pair<Expression, double>& p) {
                     const Expression& e_i{p.first};
                     return Visit(e_i);
                   });
@@ -455,7 +455,7 @@ class IsDifferentiableVisitor {
     const auto& base_to_exponent_map =
         get_base_to_exponent_map_in_multiplication(e);
     return all_of(base_to_exponent_map.begin(), base_to_exponent_map.end(),
-                  [this](const pair<const Expression, Expression>& p) {
+                  [this](const pair<Expression, Expression>& p) {
                     const Expression& base{p.first};
                     const Expression& exponent{p.second};
                     return Visit(base) && Visit(exponent);
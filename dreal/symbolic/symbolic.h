@@ -21,6 +21,7 @@
 #include <string>
 #include <vector>
 
+#include "dreal/symbolic/symbolic_arena.h"
 #include "dreal/symbolic/symbolic_environment.h"
 #include "dreal/symbolic/symbolic_expression.h"
 #include "dreal/symbolic/symbolic_expression_visitor.h"
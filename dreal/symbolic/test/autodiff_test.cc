@@ -0,0 +1,133 @@
+#include "dreal/symbolic/autodiff.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dreal/util/box.h"
+
+namespace dreal {
+namespace {
+
+using std::vector;
+
+class AutoDiffTest : public ::testing::Test {
+ protected:
+  // Checks that the gradient of @p e computed by AutoDiff at @p inputs
+  // matches the one computed by symbolic differentiation.
+  void CheckGradient(const Expression& e, const vector<double>& inputs) const {
+    const vector<Variable> variables{x_, y_, z_};
+    const AutoDiff ad{e, variables};
+    Environment env;
+    for (size_t i = 0; i < variables.size(); ++i) {
+      env.insert(variables[i], inputs[i]);
+    }
+    vector<double> grad(variables.size());
+    EXPECT_DOUBLE_EQ(ad.Gradient(inputs.data(), grad.data()), e.Evaluate(env));
+    for (size_t i = 0; i < variables.size(); ++i) {
+      EXPECT_NEAR(grad[i], e.Differentiate(variables[i]).Evaluate(env), 1e-10)
+          << e << " w.r.t. " << variables[i];
+    }
+  }
+
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  const Variable z_{"z"};
+};
+
+TEST_F(AutoDiffTest, Gradient) {
+  const vector<double> inputs{0.5, 1.5, -0.3};
+  CheckGradient(3 + 2 * x_ - 4 * y_ * z_, inputs);
+  CheckGradient(x_ * y_ * z_ * x_, inputs);
+  CheckGradient(pow(x_, 3) / (y_ + 1), inputs);
+  CheckGradient(pow(y_, x_ + z_), inputs);
+  CheckGradient(pow(y_, 0.7) + pow(x_, -2), inputs);
+  CheckGradient(sqrt(y_) + log(y_ * x_) + exp(z_ * x_), inputs);
+  CheckGradient(sin(x_ * z_) * cos(y_) + tan(z_), inputs);
+  CheckGradient(asin(x_ * z_) + acos(x_) + atan(y_ * z_), inputs);
+  CheckGradient(atan2(y_ - x_, z_ * z_ + 1), inputs);
+  CheckGradient(sinh(x_) * cosh(y_) / tanh(z_), inputs);
+}
+
+TEST_F(AutoDiffTest, SharedSubexpression) {
+  // Symbolic differentiation of a deep product duplicates the shared
+  // sub-expression s at every level.
+  Expression e{x_};
+  for (int i = 0; i < 20; ++i) {
+    e = sin(e) * (e + y_);
+  }
+  const AutoDiff ad{e, {x_, y_}};
+  EXPECT_LT(ad.tape().size(), 200);
+  const Environment env{{x_, 0.3}, {y_, 0.1}};
+  const vector<double> inputs{0.3, 0.1};
+  vector<double> grad(2);
+  ad.Gradient(inputs.data(), grad.data());
+  EXPECT_NEAR(grad[0], e.Differentiate(x_).Evaluate(env), 1e-8);
+  EXPECT_NEAR(grad[1], e.Differentiate(y_).Evaluate(env), 1e-8);
+}
+
+TEST_F(AutoDiffTest, JacobianProducts) {
+  const vector<Expression> f{x_ * y_ + z_, sin(x_) * z_};
+  const AutoDiff ad{f, {x_, y_, z_}};
+  const vector<double> x{1.0, 2.0, 3.0};
+  vector<double> jacobian;
+  ad.Jacobian(x.data(), &jacobian);
+  const vector<double> expected{2.0,
+                                1.0,
+                                1.0,
+                                std::cos(1.0) * 3.0,
+                                0.0,
+                                std::sin(1.0)};
+  ASSERT_EQ(jacobian.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_DOUBLE_EQ(jacobian[i], expected[i]);
+  }
+
+  // J v
+  const vector<double> v{1.0, -1.0, 2.0};
+  vector<double> jv(2);
+  ad.JacobianVectorProduct(x.data(), v.data(), jv.data());
+  EXPECT_DOUBLE_EQ(jv[0], 2.0 - 1.0 + 2.0);
+  EXPECT_DOUBLE_EQ(jv[1], std::cos(1.0) * 3.0 + 2.0 * std::sin(1.0));
+
+  // wᵀ J
+  const vector<double> w{2.0, -1.0};
+  vector<double> wj(3);
+  ad.VectorJacobianProduct(x.data(), w.data(), wj.data());
+  for (int j = 0; j < 3; ++j) {
+    EXPECT_DOUBLE_EQ(wj[j], 2.0 * expected[j] - expected[3 + j]);
+  }
+}
+
+TEST_F(AutoDiffTest, IntervalGradient) {
+  // f = x² * y, ∇f = (2xy, x²).
+  const AutoDiff ad{x_ * x_ * y_, {x_, y_}};
+  const vector<Box::Interval> x{Box::Interval(1.0, 2.0),
+                                Box::Interval(3.0, 4.0)};
+  vector<Box::Interval> grad(2);
+  const Box::Interval value{ad.Gradient(x.data(), grad.data())};
+  EXPECT_TRUE(value.contains(1.0 * 3.0));
+  EXPECT_TRUE(value.contains(4.0 * 4.0));
+  // Enclosures of the partial derivatives over the box.
+  EXPECT_LE(grad[0].lb(), 6.0);
+  EXPECT_GE(grad[0].ub(), 16.0);
+  EXPECT_LE(grad[1].lb(), 1.0);
+  EXPECT_GE(grad[1].ub(), 4.0);
+  // Point values inside the box are enclosed.
+  vector<double> point_grad(2);
+  const vector<double> point{1.5, 3.5};
+  ad.Gradient(point.data(), point_grad.data());
+  EXPECT_TRUE(grad[0].contains(point_grad[0]));
+  EXPECT_TRUE(grad[1].contains(point_grad[1]));
+}
+
+TEST_F(AutoDiffTest, NotDifferentiable) {
+  EXPECT_THROW(AutoDiff(abs(x_)), std::runtime_error);
+  EXPECT_THROW(AutoDiff(min(x_, y_)), std::runtime_error);
+  EXPECT_THROW(AutoDiff(max(x_, y_) + 1), std::runtime_error);
+}
+
+}  // namespace
+}  // namespace dreal
@@ -0,0 +1,88 @@
+#include "dreal/symbolic/batch_evaluator.h"
+
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace dreal {
+namespace {
+
+using std::runtime_error;
+using std::unique_ptr;
+using std::vector;
+
+class BatchEvaluatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // Column-major matrix of points over (x, y).
+    points_.resize(2 * kNumPoints);
+    for (int i = 0; i < kNumPoints; ++i) {
+      points_[i] = -2.0 + 4.0 * i / kNumPoints;
+      points_[kNumPoints + i] = std::cos(i * 0.1);
+    }
+  }
+
+  // Returns the environment for the i-th point.
+  Environment point(const int i) const {
+    return Environment{{x_, points_[i]}, {y_, points_[kNumPoints + i]}};
+  }
+
+  static constexpr int kNumPoints{1000};
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  const Variable b_{"b", Variable::Type::BOOLEAN};
+  vector<double> points_;
+};
+
+TEST_F(BatchEvaluatorTest, Expression) {
+  const Expression e{x_ * x_ * sin(y_) + exp(y_) / (2 + x_ * x_) - 3 * y_};
+  const ExpressionBatchEvaluator evaluator{e, {x_, y_}};
+  vector<double> results(kNumPoints);
+  evaluator.Evaluate(points_.data(), kNumPoints, results.data());
+  for (int i = 0; i < kNumPoints; ++i) {
+    EXPECT_NEAR(results[i], e.Evaluate(point(i)), 1e-12);
+  }
+}
+
+TEST_F(BatchEvaluatorTest, ExpressionVariableOrder) {
+  // The columns follow the given variables.
+  const ExpressionBatchEvaluator evaluator{x_ - y_, {y_, x_}};
+  const vector<double> points{1.0, 2.0, 10.0, 20.0};
+  vector<double> results(2);
+  evaluator.Evaluate(points.data(), 2, results.data());
+  EXPECT_EQ(results[0], 9.0);
+  EXPECT_EQ(results[1], 18.0);
+}
+
+TEST_F(BatchEvaluatorTest, Formula) {
+  const Expression e{x_ * x_ + y_ * y_};
+  const vector<Formula> formulas{
+      e <= 1.0,
+      e > 1.0 && x_ < y_,
+      e >= 2.0 || !(x_ > 0.0),
+      (x_ == 0.0) || (y_ != 1.0),
+      Formula::True(),
+      Formula::False(),
+  };
+  unique_ptr<bool[]> results{new bool[kNumPoints]};
+  for (const Formula& f : formulas) {
+    const FormulaBatchEvaluator evaluator{f, {x_, y_}};
+    evaluator.Evaluate(points_.data(), kNumPoints, results.get());
+    for (int i = 0; i < kNumPoints; ++i) {
+      EXPECT_EQ(results[i], f.Evaluate(point(i))) << f << " at " << i;
+    }
+  }
+}
+
+TEST_F(BatchEvaluatorTest, Unsupported) {
+  EXPECT_THROW(FormulaBatchEvaluator{Formula{b_}}, runtime_error);
+  EXPECT_THROW(FormulaBatchEvaluator{forall({x_}, x_ > y_)}, runtime_error);
+  EXPECT_THROW(ExpressionBatchEvaluator(if_then_else(x_ > y_, x_, y_)),
+               runtime_error);
+}
+
+}  // namespace
+}  // namespace dreal
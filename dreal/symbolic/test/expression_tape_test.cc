@@ -0,0 +1,129 @@
+#include "dreal/symbolic/expression_tape.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace dreal {
+namespace {
+
+using std::vector;
+
+class ExpressionTapeTest : public ::testing::Test {
+ protected:
+  // Evaluates the i-th output of @p tape at @p inputs.
+  static double Evaluate(const ExpressionTape& tape,
+                         const vector<double>& inputs, const int i = 0) {
+    vector<double> values;
+    tape.Evaluate(inputs.data(), &values);
+    return values[tape.outputs()[i]];
+  }
+
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  const Variable z_{"z"};
+  const Variable b_{"b", Variable::Type::BOOLEAN};
+};
+
+TEST_F(ExpressionTapeTest, Evaluate) {
+  const vector<Expression> expressions{
+      3 + 2 * x_ - y_ * z_,
+      pow(x_, 3) / (y_ + 1),
+      pow(x_, y_),
+      sqrt(x_) + log(y_) + exp(z_),
+      sin(x_) * cos(y_) + tan(z_),
+      asin(x_ / 4) + acos(x_ / 4) + atan(y_) + atan2(y_, z_),
+      sinh(x_) + cosh(y_) + tanh(z_),
+      abs(-x_) + min(x_, y_) + max(y_, z_),
+  };
+  const vector<Variable> variables{x_, y_, z_};
+  const ExpressionTape tape{expressions, variables};
+  const vector<double> inputs{1.5, 0.5, -2.0};
+  const Environment env{{x_, 1.5}, {y_, 0.5}, {z_, -2.0}};
+  for (size_t i = 0; i < expressions.size(); ++i) {
+    EXPECT_DOUBLE_EQ(Evaluate(tape, inputs, i), expressions[i].Evaluate(env))
+        << expressions[i];
+  }
+}
+
+TEST_F(ExpressionTapeTest, EvaluateBatch) {
+  const vector<Expression> expressions{
+      3 + 2 * x_ - y_ * z_,
+      pow(x_, 2) / (y_ + 1) + pow(x_, y_),
+      sqrt(x_) + log(y_) + exp(z_) + 5.0,
+      sin(x_) * cos(y_) + tan(z_),
+      atan2(y_, z_) + sinh(x_) + abs(z_) + min(x_, y_) + max(y_, z_),
+  };
+  const ExpressionTape tape{expressions, {x_, y_, z_}};
+
+  // More points than a block, with padding in the matrices.
+  const int num_points{1000};
+  const int stride{1003};
+  vector<double> inputs(3 * stride);
+  for (int i = 0; i < num_points; ++i) {
+    inputs[i] = 0.1 + i * 0.01;                 // x
+    inputs[stride + i] = 1.0 + i * 0.001;       // y
+    inputs[2 * stride + i] = -1.0 + i * 0.002;  // z
+  }
+  vector<double> outputs(expressions.size() * stride);
+  tape.EvaluateBatch(num_points, inputs.data(), stride, outputs.data(), stride);
+
+  for (int i = 0; i < num_points; i += 37) {
+    const vector<double> point{inputs[i], inputs[stride + i],
+                               inputs[2 * stride + i]};
+    for (size_t k = 0; k < expressions.size(); ++k) {
+      EXPECT_EQ(outputs[k * stride + i], Evaluate(tape, point, k));
+    }
+  }
+}
+
+TEST_F(ExpressionTapeTest, CommonSubexpression) {
+  // sin(x * y) appears three times but is computed once.
+  const Expression s{sin(x_ * y_)};
+  const ExpressionTape tape{{s * s + s, s}, {x_, y_}};
+  int num_sin{0};
+  for (const ExpressionTape::Instruction& inst : tape.instructions()) {
+    if (inst.op == ExpressionTape::Op::Sin) {
+      ++num_sin;
+    }
+  }
+  EXPECT_EQ(num_sin, 1);
+  const vector<double> inputs{0.3, 2.0};
+  EXPECT_DOUBLE_EQ(Evaluate(tape, inputs, 0),
+                   std::sin(0.6) * std::sin(0.6) + std::sin(0.6));
+  EXPECT_DOUBLE_EQ(Evaluate(tape, inputs, 1), std::sin(0.6));
+}
+
+TEST_F(ExpressionTapeTest, VariableOrder) {
+  const ExpressionTape tape{x_ - y_, {y_, z_, x_}};
+  EXPECT_DOUBLE_EQ(Evaluate(tape, {1.0, 10.0, 3.0}), 2.0);
+}
+
+TEST_F(ExpressionTapeTest, RealConstant) {
+  const double lb{0.1};
+  const double ub{std::nextafter(lb, 1.0)};
+  const ExpressionTape tape{x_ + real_constant(lb, ub, false)};
+  EXPECT_EQ(Evaluate(tape, {1.0}), 1.0 + ub);
+}
+
+TEST_F(ExpressionTapeTest, LargeExponent) {
+  // The exponent is an integer, but it is not an int.
+  const double c{4294967296.0};
+  const ExpressionTape tape{pow(x_, c)};
+  EXPECT_EQ(Evaluate(tape, {1.0}), 1.0);
+  EXPECT_EQ(Evaluate(tape, {-1.0}), 1.0);
+  EXPECT_EQ(Evaluate(tape, {0.5}), 0.0);
+}
+
+TEST_F(ExpressionTapeTest, Unsupported) {
+  EXPECT_THROW(ExpressionTape(if_then_else(x_ > y_, x_, y_)),
+               std::runtime_error);
+  EXPECT_THROW(ExpressionTape(uninterpreted_function("f", {x_})),
+               std::runtime_error);
+  EXPECT_THROW((ExpressionTape{x_ + y_, {x_}}), std::runtime_error);
+}
+
+}  // namespace
+}  // namespace dreal
@@ -289,6 +289,38 @@ TEST_F(SymbolicTest, Prod) {
   EXPECT_PRED2(ExprEqual, (Prod({e1, e2, e3})), e1 * e2 * e3);
 }
 
+TEST_F(SymbolicTest, SumMergesCommonTerms) {
+  // Sum builds its result with a single sort. It should give the same result
+  // as repeated additions.
+  vector<Expression> terms;
+  Expression expected;
+  for (int i = 0; i < 100; ++i) {
+    const Expression term{(i % 2 == 0 ? x_ : y_) * (i % 7) + sin(i % 5 * z_)};
+    terms.push_back(term);
+    expected += term;
+  }
+  EXPECT_PRED2(ExprEqual, Sum(terms), expected);
+
+  // Common terms are merged and cancelled out.
+  EXPECT_PRED2(ExprEqual, Sum({x_, y_, -x_, 2 * y_, x_}), x_ + 3 * y_);
+  EXPECT_PRED2(ExprEqual, Sum({x_, y_, -x_, -y_, 3.0}), 3.0);
+}
+
+TEST_F(SymbolicTest, ProdMergesCommonFactors) {
+  vector<Expression> factors;
+  Expression expected{1.0};
+  for (int i = 0; i < 100; ++i) {
+    const Expression factor{pow(i % 2 == 0 ? x_ : y_, i % 3) + (i % 5) * z_};
+    factors.push_back(factor);
+    expected *= factor;
+  }
+  EXPECT_PRED2(ExprEqual, Prod(factors), expected);
+
+  EXPECT_PRED2(ExprEqual, Prod({x_, y_, pow(x_, -1), pow(y_, 2), x_}),
+               x_ * pow(y_, 3));
+  EXPECT_PRED2(ExprEqual, Prod({x_, pow(x_, -1), 2.0}), 2.0);
+}
+
 TEST_F(SymbolicTest, DestructiveUpdateAddition1) {
   constexpr int N{1000};
   Expression e;
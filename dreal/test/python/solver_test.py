@@ -3,7 +3,9 @@ from __future__ import absolute_import
 from __future__ import division
 from __future__ import print_function
 
-from dreal import (Config, Variable, Context, Logic, cos, sin)
+from dreal import (BranchingHeuristic, Config, EnclosureMode, Formula,
+                   SatBackendType, Variable, Context, Logic, cos,
+                   logical_imply, sin)
 
 import unittest
 
@@ -44,6 +46,93 @@ class ConfigTest(unittest.TestCase):
         c.use_local_optimization = True
         self.assertTrue(c.use_local_optimization)
 
+    def test_use_symbolic_arena(self):
+        c = Config()
+        c.use_symbolic_arena = False
+        self.assertFalse(c.use_symbolic_arena)
+        c.use_symbolic_arena = True
+        self.assertTrue(c.use_symbolic_arena)
+
+    def test_use_theory_result_cache(self):
+        c = Config()
+        self.assertFalse(c.use_theory_result_cache)
+        c.use_theory_result_cache = True
+        self.assertTrue(c.use_theory_result_cache)
+
+    def test_use_incremental_theory_solver(self):
+        c = Config()
+        self.assertFalse(c.use_incremental_theory_solver)
+        c.use_incremental_theory_solver = True
+        self.assertTrue(c.use_incremental_theory_solver)
+
+    def test_use_pipelined_theory_solver(self):
+        c = Config()
+        self.assertFalse(c.use_pipelined_theory_solver)
+        c.use_pipelined_theory_solver = True
+        self.assertTrue(c.use_pipelined_theory_solver)
+
+    def test_use_deterministic_icp(self):
+        c = Config()
+        self.assertFalse(c.use_deterministic_icp)
+        c.use_deterministic_icp = True
+        self.assertTrue(c.use_deterministic_icp)
+
+    def test_use_cost_based_evaluation_order(self):
+        c = Config()
+        self.assertFalse(c.use_cost_based_evaluation_order)
+        c.use_cost_based_evaluation_order = True
+        self.assertTrue(c.use_cost_based_evaluation_order)
+
+    def test_icp_batch_size(self):
+        c = Config()
+        self.assertEqual(c.icp_batch_size, 0)
+        c.icp_batch_size = 32
+        self.assertEqual(c.icp_batch_size, 32)
+
+    def test_theory_propagation_interval(self):
+        c = Config()
+        self.assertEqual(c.theory_propagation_interval, 0)
+        c.theory_propagation_interval = 100
+        self.assertEqual(c.theory_propagation_interval, 100)
+
+    def test_explanation_minimization_budget(self):
+        c = Config()
+        self.assertEqual(c.explanation_minimization_budget, 0.0)
+        c.explanation_minimization_budget = 0.5
+        self.assertEqual(c.explanation_minimization_budget, 0.5)
+
+    def test_theory_lemma_store_size(self):
+        c = Config()
+        self.assertEqual(c.theory_lemma_store_size, 0)
+        c.theory_lemma_store_size = 1000
+        self.assertEqual(c.theory_lemma_store_size, 1000)
+
+    def test_enclosure_mode(self):
+        c = Config()
+        self.assertEqual(c.enclosure_mode, EnclosureMode.Natural)
+        c.enclosure_mode = EnclosureMode.Taylor
+        self.assertEqual(c.enclosure_mode, EnclosureMode.Taylor)
+
+    def test_branching_heuristic(self):
+        c = Config()
+        self.assertEqual(c.branching_heuristic,
+                         BranchingHeuristic.LargestFirst)
+        c.branching_heuristic = BranchingHeuristic.SmearSumRelative
+        self.assertEqual(c.branching_heuristic,
+                         BranchingHeuristic.SmearSumRelative)
+
+    def test_sat_backend(self):
+        c = Config()
+        self.assertEqual(c.sat_backend, SatBackendType.Picosat)
+        c.sat_backend = SatBackendType.Assumption
+        self.assertEqual(c.sat_backend, SatBackendType.Assumption)
+
+    def test_use_polarity_aware_cnf(self):
+        c = Config()
+        self.assertFalse(c.use_polarity_aware_cnf)
+        c.use_polarity_aware_cnf = True
+        self.assertTrue(c.use_polarity_aware_cnf)
+
 
 x = Variable("x")
 y = Variable("y")
@@ -96,6 +185,28 @@ class ContextTest(unittest.TestCase):
         ctx.Exit()
         self.assertTrue(ctx.box)
 
+    def test_check_sat_assuming(self):
+        ctx = Context()
+        ctx.SetLogic(Logic.QF_NRA)
+        x = Variable("x")
+        y = Variable("y")
+        ctx.DeclareVariable(x, -10, 10)
+        ctx.DeclareVariable(y, -10, 10)
+        b1 = Variable("b1", Variable.Bool)
+        b2 = Variable("b2", Variable.Bool)
+        ctx.DeclareVariable(b1)
+        ctx.DeclareVariable(b2)
+        ctx.Assert(x == y + 5)
+        ctx.Assert(logical_imply(Formula(b1), y == x - 3))
+        result = ctx.CheckSatAssuming([Formula(b1), Formula(b2)])
+        self.assertFalse(result)
+        self.assertEqual(len(ctx.unsat_assumptions), 1)
+        self.assertEqual(str(ctx.unsat_assumptions[0]), "b1")
+        result = ctx.CheckSatAssuming([Formula(b2)])
+        self.assertTrue(result)
+        self.assertEqual(len(ctx.unsat_assumptions), 0)
+        ctx.Exit()
+
     def test_config(self):
         ctx = Context()
         config1 = ctx.config
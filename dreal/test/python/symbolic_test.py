@@ -4,11 +4,17 @@ from __future__ import absolute_import, division, print_function
 import math
 import unittest
 
-from dreal import (And, Expression, Formula, Iff, Implies, Not, Or, Variable,
+from dreal import (And, Expression, ExpressionBatchEvaluator, Formula,
+                   FormulaBatchEvaluator, Iff, Implies, Not, Or, Variable,
                    Variables, acos, asin, atan, atan2, cos, cosh, exp, forall,
                    if_then_else, intersect, log, logical_imply, Max, Min, sin,
                    sinh, sqrt, tan, tanh)
 
+try:
+    import numpy as np
+except ImportError:
+    np = None
+
 x = Variable("x")
 y = Variable("y")
 z = Variable("z")
@@ -583,5 +589,42 @@ class TestSymbolicFormula(unittest.TestCase):
         self.assertEqual((x > y).ToPrefix(), "(> x y)")
 
 
+@unittest.skipIf(np is None, "numpy is not available")
+class TestBatchEvaluator(unittest.TestCase):
+    def setUp(self):
+        # Rows are variables (x, y) and columns are points. Its transpose
+        # is a Fortran-order matrix of points, which is passed without a
+        # copy.
+        self.points = np.array([[1.0, 2.0, 3.0], [0.5, 0.0, -1.0]])
+
+    def test_expression(self):
+        e = x * sin(y) + x * x
+        evaluator = ExpressionBatchEvaluator(e, [x, y])
+        self.assertEqual([str(v) for v in evaluator.variables()],
+                         ["x", "y"])
+        results = evaluator.Evaluate(self.points.T)
+        self.assertEqual(results.shape, (3, ))
+        for i in range(3):
+            env = {x: self.points[0, i], y: self.points[1, i]}
+            self.assertAlmostEqual(results[i], e.Evaluate(env))
+
+    def test_c_order(self):
+        # A C-order matrix of points is converted.
+        evaluator = ExpressionBatchEvaluator(x - y, [x, y])
+        points = np.ascontiguousarray(self.points.T)
+        self.assertEqual(list(evaluator.Evaluate(points)), [0.5, 2.0, 4.0])
+
+    def test_formula(self):
+        f = And(x > 1.5, y <= 0)
+        evaluator = FormulaBatchEvaluator(f, [x, y])
+        self.assertEqual(list(evaluator.Evaluate(self.points.T)),
+                         [False, True, True])
+
+    def test_wrong_shape(self):
+        evaluator = ExpressionBatchEvaluator(x + y, [x, y])
+        with self.assertRaises(RuntimeError):
+            evaluator.Evaluate(self.points)
+
+
 if __name__ == '__main__':
     unittest.main()
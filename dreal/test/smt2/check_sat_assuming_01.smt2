@@ -0,0 +1,16 @@
+(set-logic QF_NRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun b1 () Bool)
+(declare-fun b2 () Bool)
+(assert (<= -10 y))
+(assert (<= y 10))
+(assert (= x (+ y 5)))
+(assert (=> b1 (= y (- x 3))))
+(check-sat-assuming (b1 b2))
+(get-unsat-assumptions)
+(check-sat-assuming ((not b1) (<= x y)))
+(get-unsat-assumptions)
+(check-sat-assuming ((not b1) b2))
+(get-unsat-assumptions)
+(exit)
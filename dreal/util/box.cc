@@ -204,6 +204,78 @@ pair<Box, Box> Box::bisect_continuous(const int i) const {
   return make_pair(b1, b2);
 }
 
+vector<Box> Box::multisect(const int i, const int k) const {
+  const Variable& var{(*idx_to_var_)[i]};
+  if (!values_[i].is_bisectable()) {
+    throw DREAL_RUNTIME_ERROR(
+        "Variable {} = {} is not bisectable but Box::multisect is called.",
+        var, values_[i]);
+  }
+  if (k < 2) {
+    throw DREAL_RUNTIME_ERROR(
+        "Box::multisect is called with k = {}, which is less than 2.", k);
+  }
+  switch (var.get_type()) {
+    case Variable::Type::CONTINUOUS:
+      return multisect_continuous(i, k);
+    case Variable::Type::INTEGER:
+    case Variable::Type::BINARY:
+      return multisect_int(i, k);
+    case Variable::Type::BOOLEAN:
+      DREAL_UNREACHABLE();
+  }
+  DREAL_UNREACHABLE();
+}
+
+vector<Box> Box::multisect(const Variable& var, const int k) const {
+  auto it = var_to_idx_->find(var);
+  if (it != var_to_idx_->end()) {
+    return multisect(it->second, k);
+  } else {
+    throw DREAL_RUNTIME_ERROR("Variable {} is not found in this box.", var);
+  }
+}
+
+vector<Box> Box::multisect_int(const int i, const int k) const {
+  DREAL_ASSERT(idx_to_var_->at(i).get_type() == Variable::Type::INTEGER ||
+               idx_to_var_->at(i).get_type() == Variable::Type::BINARY);
+  const Interval& intv_i{values_[i]};
+  const double lb{ceil(intv_i.lb())};
+  const double ub{floor(intv_i.ub())};
+  DREAL_ASSERT(lb < ub);
+  // Distributes the (ub - lb + 1) integers over n sub-boxes.
+  const double count{ub - lb + 1};
+  const int n{static_cast<int>(std::min(static_cast<double>(k), count))};
+  vector<Box> boxes;
+  boxes.reserve(n);
+  double next_lb{lb};
+  for (int j = 1; j <= n; ++j) {
+    const double next_ub{j == n ? ub : lb + floor(count * j / n) - 1};
+    boxes.push_back(*this);
+    boxes.back()[i] = Interval(next_lb, next_ub);
+    next_lb = next_ub + 1;
+  }
+  return boxes;
+}
+
+vector<Box> Box::multisect_continuous(const int i, const int k) const {
+  DREAL_ASSERT(idx_to_var_->at(i).get_type() == Variable::Type::CONTINUOUS);
+  vector<Box> boxes;
+  boxes.reserve(k);
+  // Splits off the j-th piece from the rest, [rest.lb(), ub], with the
+  // ratio 1/(k - j). Interval::bisect takes care of unbounded intervals.
+  Interval rest{values_[i]};
+  for (int j = 0; j < k - 1 && rest.is_bisectable(); ++j) {
+    const pair<Interval, Interval> p{rest.bisect(1.0 / (k - j))};
+    boxes.push_back(*this);
+    boxes.back()[i] = p.first;
+    rest = p.second;
+  }
+  boxes.push_back(*this);
+  boxes.back()[i] = rest;
+  return boxes;
+}
+
 Box& Box::InplaceUnion(const Box& b) {
   // Checks variables() == b.variables().
   DREAL_ASSERT(equal(variables().begin(), variables().end(),
@@ -96,6 +96,18 @@ class Box {
   /// @throws std::runtime if @p i -th dimension is not bisectable.
   std::pair<Box, Box> bisect(const Variable& var) const;
 
+  /// Splits the box at @p i -th dimension into @p k sub-boxes of equal
+  /// width, ordered from the lowest to the highest. It returns fewer
+  /// than @p k sub-boxes if the dimension cannot be split further (for
+  /// example, an integer dimension with less than @p k values).
+  /// @throws std::runtime if @p i -th dimension is not bisectable or
+  ///         @p k is less than 2.
+  std::vector<Box> multisect(int i, int k) const;
+
+  /// Splits the box at the dimension represented by @p var into @p k
+  /// sub-boxes. See multisect(int, int).
+  std::vector<Box> multisect(const Variable& var, int k) const;
+
   /// Updates the current box by taking union with @p b.
   ///
   /// @pre variables() == b.variables().
@@ -112,6 +124,16 @@ class Box {
   /// @pre i-th variable is of continuous type.
   std::pair<Box, Box> bisect_continuous(int i) const;
 
+  /// Splits the box at @p i -th dimension into @p k sub-boxes.
+  /// @pre i-th variable is bisectable.
+  /// @pre i-th variable is of integer type.
+  std::vector<Box> multisect_int(int i, int k) const;
+
+  /// Splits the box at @p i -th dimension into @p k sub-boxes.
+  /// @pre i-th variable is bisectable.
+  /// @pre i-th variable is of continuous type.
+  std::vector<Box> multisect_continuous(int i, int k) const;
+
   std::shared_ptr<std::vector<Variable>> variables_;
 
   ibex::IntervalVector values_;
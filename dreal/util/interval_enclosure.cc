@@ -0,0 +1,658 @@
+#include "dreal/util/interval_enclosure.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "dreal/util/assert.h"
+#include "dreal/util/exception.h"
+#include "dreal/util/math.h"
+
+namespace dreal {
+
+using std::make_unique;
+using std::numeric_limits;
+using std::size_t;
+using std::vector;
+
+namespace {
+using Op = ExpressionTape::Op;
+
+constexpr double kEpsilon{numeric_limits<double>::epsilon()};
+constexpr double kDenormMin{numeric_limits<double>::denorm_min()};
+constexpr double kInfinity{numeric_limits<double>::infinity()};
+
+// In the adaptive mode, the refinement is considered to pay off if it
+// is tighter than the natural extension by this ratio in at least
+// 1/kImprovementRate of the attempts. Otherwise, it is attempted once
+// every kProbePeriod evaluations, since the forms get tighter as the
+// boxes get smaller. The statistics are halved every kMaxAttempts
+// attempts to forget old boxes.
+constexpr double kImprovementRatio{0.9};
+constexpr int kImprovementRate{8};
+constexpr int kMinAttempts{16};
+constexpr int kMaxAttempts{1024};
+constexpr int kProbePeriod{32};
+
+// Returns an upper bound of the rounding error of a floating-point
+// operation whose result is @p x when rounded to nearest. |x| * ε is
+// at least one ulp of x and the smallest denormal covers underflows.
+inline double Ulp(const double x) {
+  return std::abs(x) * kEpsilon + kDenormMin;
+}
+
+// Returns an upper bound of the rounding error of `p * q`, whose result
+// is @p x. It is zero if the product is exact.
+inline double MulError(const double p, const double q, const double x) {
+  return (p == 0.0 || q == 0.0 || p == 1.0 || p == -1.0) ? 0.0 : Ulp(x);
+}
+
+// Returns an upper bound of a + b, where a, b ≥ 0.
+inline double AddUp(const double a, const double b) {
+  const double s{a + b};
+  return s + Ulp(s);
+}
+
+// Returns an upper bound of a * b, where a, b ≥ 0.
+inline double MulUp(const double a, const double b) {
+  if (a == 0.0 || b == 0.0) {
+    return 0.0;
+  }
+  const double p{a * b};
+  return p + Ulp(p);
+}
+
+// Returns true if @p iv is neither empty nor unbounded.
+inline bool IsBounded(const Box::Interval& iv) {
+  return !iv.is_empty() && !iv.is_unbounded();
+}
+
+// Stores the midpoint of a bounded interval @p iv in @p c and an upper
+// bound of the distance from c to the bounds of iv in @p r.
+void Center(const Box::Interval& iv, double* const c, double* const r) {
+  *c = iv.mid();
+  const double d{std::max(iv.ub() - *c, *c - iv.lb())};
+  *r = d + Ulp(d);
+}
+
+// Returns @p op with parameter @p c applied to @p x.
+Box::Interval Apply(const Op op, const double c, const Box::Interval& x) {
+  ExpressionTape::Instruction inst;
+  inst.op = op;
+  inst.arg1 = 0;
+  inst.c = c;
+  return ExpressionTape::Evaluate<Box::Interval>(inst, &x, nullptr);
+}
+
+// Computes enclosures of the first and the second derivatives of the
+// unary function @p op with parameter @p c over @p x. Returns false if
+// they are not available.
+bool Derivatives(const Op op, const double c, const Box::Interval& x,
+                 Box::Interval* const d1, Box::Interval* const d2) {
+  switch (op) {
+    case Op::PowConstant:
+      *d1 = c * internal::PowConstant(x, c - 1.0);
+      *d2 = c * (c - 1.0) * internal::PowConstant(x, c - 2.0);
+      return true;
+    case Op::Log:
+      *d1 = 1.0 / x;
+      *d2 = -1.0 / sqr(x);
+      return true;
+    case Op::Exp:
+      *d1 = *d2 = exp(x);
+      return true;
+    case Op::Sqrt:
+      *d1 = 0.5 / sqrt(x);
+      *d2 = -0.25 / (x * sqrt(x));
+      return true;
+    case Op::Sin:
+      *d1 = cos(x);
+      *d2 = -sin(x);
+      return true;
+    case Op::Cos:
+      *d1 = -sin(x);
+      *d2 = -cos(x);
+      return true;
+    case Op::Tan: {
+      const Box::Interval t{tan(x)};
+      *d1 = 1.0 + sqr(t);
+      *d2 = 2.0 * t * *d1;
+      return true;
+    }
+    case Op::Asin:
+    case Op::Acos: {
+      const Box::Interval s{1.0 - sqr(x)};
+      const double sign{op == Op::Asin ? 1.0 : -1.0};
+      *d1 = sign / sqrt(s);
+      *d2 = sign * x / (s * sqrt(s));
+      return true;
+    }
+    case Op::Atan: {
+      const Box::Interval s{1.0 + sqr(x)};
+      *d1 = 1.0 / s;
+      *d2 = -2.0 * x / sqr(s);
+      return true;
+    }
+    case Op::Sinh:
+      *d1 = cosh(x);
+      *d2 = sinh(x);
+      return true;
+    case Op::Cosh:
+      *d1 = sinh(x);
+      *d2 = cosh(x);
+      return true;
+    case Op::Tanh: {
+      const Box::Interval t{tanh(x)};
+      *d1 = 1.0 - sqr(t);
+      *d2 = -2.0 * t * *d1;
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+// Linear forms `c + Σₖ aₖ ξₖ ± r` over the deviations ξₖ ∈ [-ρₖ, ρₖ] of
+// the inputs from the midpoints of their intervals. The i-th form
+// represents the i-th instruction of a tape. The storage is reused by
+// all the enclosures in a thread.
+class LinearForms {
+ public:
+  LinearForms(const int size, const vector<double>& radii)
+      : radii_{radii}, n_{static_cast<int>(radii.size())} {
+    thread_local vector<double> storage;
+    storage.assign(static_cast<size_t>(size) * (n_ + 2), 0.0);
+    data_ = storage.data();
+  }
+
+  double c(const int i) const { return data_[i * (n_ + 2)]; }
+  double r(const int i) const { return data_[i * (n_ + 2) + 1]; }
+  const double* a(const int i) const { return data_ + i * (n_ + 2) + 2; }
+
+  // Sets the i-th form to the k-th input whose midpoint is @p mid.
+  void SetInput(const int i, const int k, const double mid) {
+    Set(i, mid, 0.0);
+    mutable_a(i)[k] = 1.0;
+  }
+
+  // Sets the i-th form to the bounded interval @p iv, which forgets
+  // the dependencies on the inputs.
+  void SetInterval(const int i, const Box::Interval& iv) {
+    double c{};
+    double r{};
+    Center(iv, &c, &r);
+    Set(i, c, r);
+  }
+
+  // Sets the i-th form to `c + α (x - c(x)) + β (y - c(y)) ± error`,
+  // where `x` and `y` are the forms at @p x and @p y. If y is -1, the
+  // term is omitted.
+  void Combine(const int i, const double c, const int x, const double alpha,
+               const int y, const double beta, const double error) {
+    const double* const ax{a(x)};
+    const double* const ay{y >= 0 ? a(y) : nullptr};
+    double* const ai{mutable_a(i)};
+    double r{AddUp(MulUp(std::abs(alpha), this->r(x)), error)};
+    if (ay) {
+      r = AddUp(r, MulUp(std::abs(beta), this->r(y)));
+    }
+    for (int k = 0; k < n_; ++k) {
+      const double t1{alpha * ax[k]};
+      const double t2{ay ? beta * ay[k] : 0.0};
+      ai[k] = t1 + t2;
+      double e{MulError(alpha, ax[k], t1)};
+      if (ay) {
+        e += MulError(beta, ay[k], t2) + std::abs(ai[k]) * kEpsilon;
+      }
+      r = AddUp(r, MulUp(e, radii_[k]));
+    }
+    data_[i * (n_ + 2)] = c;
+    data_[i * (n_ + 2) + 1] = r;
+  }
+
+  // Returns an upper bound of |Σₖ aₖ ξₖ| + r of the i-th form.
+  double Deviation(const int i) const {
+    const double* const ai{a(i)};
+    double d{r(i)};
+    for (int k = 0; k < n_; ++k) {
+      d = AddUp(d, MulUp(std::abs(ai[k]), radii_[k]));
+    }
+    return d;
+  }
+
+  // Returns an enclosure of the range of the i-th form.
+  Box::Interval Range(const int i) const {
+    const double d{Deviation(i)};
+    const double lb{c(i) - d};
+    const double ub{c(i) + d};
+    return Box::Interval{lb - Ulp(lb), ub + Ulp(ub)};
+  }
+
+  // Returns true if the i-th form is finite.
+  bool is_finite(const int i) const {
+    return std::isfinite(c(i)) && r(i) < kInfinity;
+  }
+
+ private:
+  double* mutable_a(const int i) { return data_ + i * (n_ + 2) + 2; }
+
+  void Set(const int i, const double c, const double r) {
+    double* const form{data_ + i * (n_ + 2)};
+    form[0] = c;
+    form[1] = r;
+    std::fill(form + 2, form + 2 + n_, 0.0);
+  }
+
+  const vector<double>& radii_;
+  const int n_;
+  double* data_{nullptr};
+};
+
+// Sets the i-th form of @p forms to an affine (or a first-order
+// Taylor if @p taylor is true) approximation of the unary function
+// @p op with parameter @p c applied to the x-th form. @p natural is an
+// enclosure of the i-th instruction and @p x_natural is the one of its
+// operand. Returns false if the result is not bounded.
+bool Linearize(const Op op, const double c, const int i, const int x,
+               const Box::Interval& natural, const Box::Interval& x_natural,
+               const bool taylor, LinearForms* const forms) {
+  const Box::Interval u{forms->Range(x) & x_natural};
+  const double u0{forms->c(x)};
+  const Box::Interval g0{Apply(op, c, Box::Interval{u0})};
+  // The derivatives are taken over the hull of u and u0, which includes
+  // the intermediate points in the mean-value theorem.
+  const Box::Interval v{u | Box::Interval{u0}};
+  Box::Interval d1;
+  Box::Interval d2;
+  if (u.is_empty() || !IsBounded(g0) || !Derivatives(op, c, v, &d1, &d2) ||
+      !IsBounded(d1)) {
+    // Fall back to the interval extension.
+    const Box::Interval result{Apply(op, c, u) & natural};
+    if (!IsBounded(result)) {
+      return false;
+    }
+    forms->SetInterval(i, result);
+    return true;
+  }
+  double alpha{};
+  Box::Interval error;
+  const Box::Interval du{u - u0};
+  if (taylor && IsBounded(d2)) {
+    // g(u) = g(u0) + g'(u0)(u - u0) + ½ g''(ξ)(u - u0)².
+    Box::Interval d0;
+    Box::Interval unused;
+    Derivatives(op, c, Box::Interval{u0}, &d0, &unused);
+    alpha = d0.mid();
+    error = (d0 - alpha) * du + 0.5 * d2 * sqr(du);
+  } else {
+    // g(u) = g(u0) + g'(ξ)(u - u0).
+    alpha = d1.mid();
+    error = (d1 - alpha) * du;
+  }
+  double g0_center{};
+  double g0_radius{};
+  Center(g0, &g0_center, &g0_radius);
+  forms->Combine(i, g0_center, x, alpha, -1, 0.0,
+                 AddUp(g0_radius, error.mag()));
+  return forms->is_finite(i);
+}
+
+// Sets the i-th form of @p forms to the square of the x-th form. It
+// uses (c + x̂)² = c² + 2c x̂ + x̂², where x̂² ∈ [0, d²] for the
+// deviation d of the form, which is tighter than a product of two
+// forms.
+void Square(const int i, const int x, LinearForms* const forms) {
+  const double cx{forms->c(x)};
+  const double d{forms->Deviation(x)};
+  // [0, d²] ⊆ h ± h.
+  const double h{MulUp(d, d) / 2};
+  const double p{cx * cx};
+  const double c{p + h};
+  forms->Combine(i, c, x, cx, x, cx,
+                 AddUp(h, MulError(cx, cx, p) + std::abs(c) * kEpsilon));
+}
+}  // namespace
+
+std::ostream& operator<<(std::ostream& os, const EnclosureMode mode) {
+  switch (mode) {
+    case EnclosureMode::Natural:
+      return os << "Natural";
+    case EnclosureMode::MeanValue:
+      return os << "Mean-Value";
+    case EnclosureMode::Affine:
+      return os << "Affine";
+    case EnclosureMode::Taylor:
+      return os << "Taylor";
+    case EnclosureMode::Adaptive:
+      return os << "Adaptive";
+  }
+  DREAL_UNREACHABLE();
+}
+
+IntervalEnclosure::IntervalEnclosure(const Expression& e,
+                                     vector<Variable> variables,
+                                     const EnclosureMode mode)
+    : mode_{mode}, tape_{e, std::move(variables)} {
+  if (mode_ == EnclosureMode::MeanValue) {
+    try {
+      autodiff_ = make_unique<const AutoDiff>(e, tape_.variables());
+    } catch (const std::runtime_error&) {
+      // e includes abs, min, or max. The natural extension is used.
+    }
+  }
+  if (mode_ == EnclosureMode::Adaptive) {
+    const vector<ExpressionTape::Instruction>& instructions{
+        tape_.instructions()};
+    vector<int> num_uses(instructions.size(), 0);
+    for (const ExpressionTape::Instruction& inst : instructions) {
+      if (inst.op != Op::Var && inst.arg1 >= 0) {
+        ++num_uses[inst.arg1];
+      }
+      if (inst.arg2 >= 0) {
+        ++num_uses[inst.arg2];
+      }
+    }
+    has_dependency_ = false;
+    for (size_t i = 0; i < instructions.size(); ++i) {
+      if (num_uses[i] > 1 && instructions[i].op != Op::Constant &&
+          instructions[i].op != Op::RealConstant) {
+        has_dependency_ = true;
+      }
+    }
+  }
+}
+
+Box::Interval IntervalEnclosure::operator()(
+    const Box::Interval* const inputs) const {
+  thread_local vector<Box::Interval> values;
+  if (values.size() < static_cast<size_t>(tape_.size())) {
+    values.resize(tape_.size());
+  }
+  EvaluateNatural(inputs, values.data());
+  const Box::Interval& natural{values[tape_.outputs()[0]]};
+  if (mode_ == EnclosureMode::Natural || natural.is_empty()) {
+    return natural;
+  }
+  if (mode_ == EnclosureMode::Adaptive) {
+    if (!has_dependency_) {
+      return natural;
+    }
+    const int num_attempts{num_attempts_.load(std::memory_order_relaxed)};
+    if (num_attempts >= kMinAttempts &&
+        num_improvements_.load(std::memory_order_relaxed) * kImprovementRate <
+            num_attempts &&
+        num_calls_.fetch_add(1, std::memory_order_relaxed) % kProbePeriod !=
+            0) {
+      return natural;
+    }
+  }
+  if (!IsSmooth(values.data())) {
+    return natural;
+  }
+  Box::Interval refined;
+  switch (mode_) {
+    case EnclosureMode::MeanValue:
+      refined = MeanValue(inputs);
+      break;
+    case EnclosureMode::Affine:
+    case EnclosureMode::Adaptive:
+      refined = LinearForm(inputs, values.data(), false /* taylor */);
+      break;
+    case EnclosureMode::Taylor:
+      refined = LinearForm(inputs, values.data(), true /* taylor */);
+      break;
+    case EnclosureMode::Natural:
+      DREAL_UNREACHABLE();
+  }
+  const Box::Interval result{refined & natural};
+  if (mode_ == EnclosureMode::Adaptive) {
+    const int num_attempts{
+        num_attempts_.fetch_add(1, std::memory_order_relaxed) + 1};
+    if (result.diam() < kImprovementRatio * natural.diam()) {
+      num_improvements_.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (num_attempts >= kMaxAttempts) {
+      num_attempts_.store(num_attempts / 2, std::memory_order_relaxed);
+      num_improvements_.store(
+          num_improvements_.load(std::memory_order_relaxed) / 2,
+          std::memory_order_relaxed);
+    }
+  }
+  return result;
+}
+
+void IntervalEnclosure::EvaluateNatural(const Box::Interval* const inputs,
+                                        Box::Interval* const values) const {
+  const vector<ExpressionTape::Instruction>& instructions{
+      tape_.instructions()};
+  for (size_t i = 0; i < instructions.size(); ++i) {
+    const ExpressionTape::Instruction& inst{instructions[i]};
+    if (inst.op == Op::Pow) {
+      // As in ExpressionEvaluator, use the tighter versions of pow if
+      // the exponent is a point.
+      const Box::Interval& exponent{values[inst.arg2]};
+      if (exponent.is_degenerated() && !exponent.is_empty()) {
+        values[i] = internal::PowConstant(values[inst.arg1], exponent.lb());
+        continue;
+      }
+    }
+    values[i] = ExpressionTape::Evaluate<Box::Interval>(inst, values, inputs);
+  }
+}
+
+bool IntervalEnclosure::IsSmooth(const Box::Interval* const values) const {
+  const vector<ExpressionTape::Instruction>& instructions{
+      tape_.instructions()};
+  for (size_t i = 0; i < instructions.size(); ++i) {
+    const ExpressionTape::Instruction& inst{instructions[i]};
+    if (values[i].is_empty()) {
+      return false;
+    }
+    const Box::Interval* const x{
+        inst.op != Op::Var && inst.arg1 >= 0 ? &values[inst.arg1] : nullptr};
+    switch (inst.op) {
+      case Op::Div:
+        if (values[inst.arg2].contains(0.0)) {
+          return false;
+        }
+        break;
+      case Op::Pow:
+        // x^y = exp(y log(x)).
+        if (x->lb() <= 0.0) {
+          return false;
+        }
+        break;
+      case Op::PowConstant:
+        if (is_integer(inst.c)) {
+          if (inst.c < 0.0 && x->contains(0.0)) {
+            return false;
+          }
+        } else if (inst.c > 1.0 ? x->lb() < 0.0 : x->lb() <= 0.0) {
+          return false;
+        }
+        break;
+      case Op::Log:
+      case Op::Sqrt:
+        if (x->lb() <= 0.0) {
+          return false;
+        }
+        break;
+      case Op::Asin:
+      case Op::Acos:
+        if (x->lb() <= -1.0 || x->ub() >= 1.0) {
+          return false;
+        }
+        break;
+      case Op::Tan:
+        if (values[i].is_unbounded()) {
+          return false;
+        }
+        break;
+      case Op::Atan2:
+        // It is discontinuous at y = 0 for x ≤ 0.
+        if (x->contains(0.0) && values[inst.arg2].lb() <= 0.0) {
+          return false;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  return true;
+}
+
+Box::Interval IntervalEnclosure::MeanValue(
+    const Box::Interval* const inputs) const {
+  if (!autodiff_) {
+    return Box::Interval::ALL_REALS;
+  }
+  const size_t n{tape_.variables().size()};
+  thread_local vector<Box::Interval> midpoint;
+  thread_local vector<Box::Interval> gradient;
+  thread_local vector<Box::Interval> midpoint_values;
+  midpoint.resize(n);
+  gradient.resize(n);
+  midpoint_values.resize(tape_.size());
+  for (size_t k = 0; k < n; ++k) {
+    if (!IsBounded(inputs[k])) {
+      return Box::Interval::ALL_REALS;
+    }
+    midpoint[k] = Box::Interval{inputs[k].mid()};
+  }
+  EvaluateNatural(midpoint.data(), midpoint_values.data());
+  Box::Interval result{midpoint_values[tape_.outputs()[0]]};
+  if (!IsBounded(result)) {
+    return Box::Interval::ALL_REALS;
+  }
+  autodiff_->Gradient<Box::Interval>(inputs, gradient.data());
+  for (size_t k = 0; k < n; ++k) {
+    if (!IsBounded(gradient[k])) {
+      return Box::Interval::ALL_REALS;
+    }
+    result += gradient[k] * (inputs[k] - midpoint[k]);
+  }
+  return result;
+}
+
+Box::Interval IntervalEnclosure::LinearForm(const Box::Interval* const inputs,
+                                            const Box::Interval* const values,
+                                            const bool taylor) const {
+  const vector<ExpressionTape::Instruction>& instructions{
+      tape_.instructions()};
+  const size_t n{tape_.variables().size()};
+  thread_local vector<double> midpoints;
+  thread_local vector<double> radii;
+  midpoints.resize(n);
+  radii.resize(n);
+  for (size_t k = 0; k < n; ++k) {
+    if (!IsBounded(inputs[k])) {
+      return Box::Interval::ALL_REALS;
+    }
+    Center(inputs[k], &midpoints[k], &radii[k]);
+  }
+  // The last form is a scratch for the reciprocals of divisors.
+  const int scratch{tape_.size()};
+  LinearForms forms{tape_.size() + 1, radii};
+  for (int i = 0; i < tape_.size(); ++i) {
+    const ExpressionTape::Instruction& inst{instructions[i]};
+    const int x{inst.arg1};
+    const int y{inst.arg2};
+    bool ok{true};
+    switch (inst.op) {
+      case Op::Constant:
+        forms.SetInterval(i, Box::Interval{inst.c});
+        break;
+      case Op::RealConstant:
+        forms.SetInterval(i, Box::Interval{inst.lb, inst.ub});
+        break;
+      case Op::Var:
+        forms.SetInput(i, x, midpoints[x]);
+        break;
+      case Op::Add: {
+        const double c{forms.c(x) + forms.c(y)};
+        forms.Combine(i, c, x, 1.0, y, 1.0, std::abs(c) * kEpsilon);
+        break;
+      }
+      case Op::AddConstant: {
+        const double c{forms.c(x) + inst.c};
+        forms.Combine(i, c, x, 1.0, -1, 0.0, std::abs(c) * kEpsilon);
+        break;
+      }
+      case Op::Scale: {
+        const double c{forms.c(x) * inst.c};
+        forms.Combine(i, c, x, inst.c, -1, 0.0,
+                      MulError(inst.c, forms.c(x), c));
+        break;
+      }
+      case Op::Mul:
+      case Op::Div: {
+        int rhs{y};
+        if (inst.op == Op::Div) {
+          // x / y = x * y⁻¹.
+          rhs = scratch;
+          ok = Linearize(Op::PowConstant, -1.0, rhs, y,
+                         Box::Interval::ALL_REALS, values[y], taylor, &forms);
+          if (!ok) {
+            break;
+          }
+        }
+        if (x == rhs) {
+          Square(i, x, &forms);
+          break;
+        }
+        // (cx + x̂)(cy + ŷ) = cx cy + cy x̂ + cx ŷ + x̂ ŷ.
+        const double cx{forms.c(x)};
+        const double cy{forms.c(rhs)};
+        const double c{cx * cy};
+        forms.Combine(i, c, x, cy, rhs, cx,
+                      AddUp(MulUp(forms.Deviation(x), forms.Deviation(rhs)),
+                            MulError(cx, cy, c)));
+        break;
+      }
+      case Op::PowConstant:
+        if (inst.c == 2.0) {
+          Square(i, x, &forms);
+        } else {
+          ok = Linearize(inst.op, inst.c, i, x, values[i], values[x], taylor,
+                         &forms);
+        }
+        break;
+      case Op::Abs: {
+        const Box::Interval u{forms.Range(x) & values[x]};
+        if (u.lb() >= 0.0) {
+          forms.Combine(i, forms.c(x), x, 1.0, -1, 0.0, 0.0);
+        } else if (u.ub() <= 0.0) {
+          forms.Combine(i, -forms.c(x), x, -1.0, -1, 0.0, 0.0);
+        } else {
+          ok = IsBounded(values[i]);
+          if (ok) {
+            forms.SetInterval(i, abs(u) & values[i]);
+          }
+        }
+        break;
+      }
+      case Op::Pow:
+      case Op::Atan2:
+      case Op::Min:
+      case Op::Max:
+        // Use the interval extension.
+        ok = IsBounded(values[i]);
+        if (ok) {
+          forms.SetInterval(i, values[i]);
+        }
+        break;
+      default:
+        ok = Linearize(inst.op, inst.c, i, x, values[i], values[x], taylor,
+                       &forms);
+    }
+    if (!ok || !forms.is_finite(i)) {
+      return Box::Interval::ALL_REALS;
+    }
+  }
+  return forms.Range(tape_.outputs()[0]);
+}
+
+}  // namespace dreal
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "./ibex.h"
+
+#include "dreal/symbolic/autodiff.h"
+#include "dreal/symbolic/expression_tape.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+
+namespace dreal {
+
+/// Methods to enclose the range of an expression over a box.
+enum class EnclosureMode {
+  Natural = 0,    ///< Natural interval extension (default).
+  MeanValue = 1,  ///< Mean-value form.
+  Affine = 2,     ///< Affine arithmetic.
+  Taylor = 3,     ///< First-order Taylor model.
+  Adaptive = 4,   ///< Affine arithmetic where it pays off.
+};
+
+std::ostream& operator<<(std::ostream& os, EnclosureMode mode);
+
+/// Encloses the range of an expression over boxes.
+///
+/// The natural interval extension evaluates each occurrence of a
+/// variable independently, so it over-approximates the range of an
+/// expression with repeated variables. For example, it gives [-4, 4]
+/// for `x * x - 2 * x` over x ∈ [0, 2] while the range is [-1, 0].
+/// This class provides the following alternatives, which keep track of
+/// the dependencies on the variables:
+///
+///  - MeanValue: `f(m) + ∇f(B) · (B - m)` where `m` is the midpoint of
+///    the box `B` and `∇f(B)` is an enclosure of the gradient computed
+///    by AutoDiff.
+///
+///  - Affine: every sub-expression is represented by a form `c + Σᵢ
+///    aᵢ(xᵢ - mᵢ) ± r`. Sums and products are propagated exactly up to
+///    the quadratic terms, which are added to `r`. A nonlinear function
+///    g of a form u ranging over U is replaced by the linear function
+///    through g(c) with slope mid(g'(U)), and the error of the
+///    replacement is added to `r`.
+///
+///  - Taylor: the same forms, but g is linearized by its derivative at
+///    the center c with the remainder `½ g''(U) (U - c)²`. It is
+///    tighter than Affine on small boxes.
+///
+///  - Adaptive: Affine, applied only to expressions with a repeated
+///    sub-expression, and skipped for the expressions where it has
+///    seldom been tighter than the natural extension.
+///
+/// The forms are computed in floating-point arithmetic and their
+/// rounding errors are added to `r`. The result is always intersected
+/// with the natural extension. When a method does not apply (e.g. an
+/// unbounded input, or a box which is not in the domain of a
+/// sub-expression), the natural extension is returned.
+class IntervalEnclosure {
+ public:
+  /// Constructs an enclosure of @p e over @p variables using @p mode.
+  ///
+  /// @throws std::runtime_error if @p e includes an if-then-else or an
+  ///         uninterpreted function.
+  IntervalEnclosure(const Expression& e, std::vector<Variable> variables,
+                    EnclosureMode mode);
+
+  /// Deleted copy-constructor.
+  IntervalEnclosure(const IntervalEnclosure&) = delete;
+
+  /// Deleted move-constructor.
+  IntervalEnclosure(IntervalEnclosure&&) = delete;
+
+  /// Deleted copy-assignment operator.
+  IntervalEnclosure& operator=(const IntervalEnclosure&) = delete;
+
+  /// Deleted move-assignment operator.
+  IntervalEnclosure& operator=(IntervalEnclosure&&) = delete;
+
+  ~IntervalEnclosure() = default;
+
+  /// Returns the mode.
+  EnclosureMode mode() const { return mode_; }
+
+  /// Returns the variables. The i-th input is the interval of the i-th
+  /// variable.
+  const std::vector<Variable>& variables() const { return tape_.variables(); }
+
+  /// Returns an enclosure of the expression over the box @p inputs.
+  ///
+  /// @pre `inputs` points to an array of `variables().size()` intervals.
+  Box::Interval operator()(const Box::Interval* inputs) const;
+
+ private:
+  // Evaluates the natural extension of all the instructions of tape_
+  // with @p inputs and stores them in @p values.
+  void EvaluateNatural(const Box::Interval* inputs,
+                       Box::Interval* values) const;
+
+  // Returns the mean-value form over @p inputs, or the entire real
+  // line if it does not apply.
+  Box::Interval MeanValue(const Box::Interval* inputs) const;
+
+  // Returns the affine form (or the first-order Taylor model if
+  // @p taylor is true) over @p inputs, or the entire real line if it
+  // does not apply. @p values are the natural extensions of the
+  // instructions.
+  Box::Interval LinearForm(const Box::Interval* inputs,
+                           const Box::Interval* values, bool taylor) const;
+
+  // Returns true if the instructions are defined and continuously
+  // differentiable over the box given by @p values, the natural
+  // extensions of the instructions. The refined enclosures are sound
+  // only in that case.
+  bool IsSmooth(const Box::Interval* values) const;
+
+  const EnclosureMode mode_;
+  const ExpressionTape tape_;
+
+  // AutoDiff of the expression for the mean-value form. It is nullptr
+  // in the other modes or if the expression is not differentiable.
+  std::unique_ptr<const AutoDiff> autodiff_;
+
+  // In the adaptive mode, it is false if no sub-expression is used more
+  // than once, in which case the natural extension is already exact up
+  // to rounding.
+  bool has_dependency_{true};
+
+  // Statistics of the adaptive mode. They can be updated by ICP worker
+  // threads concurrently, hence the atomics.
+  mutable std::atomic<int> num_calls_{0};
+  mutable std::atomic<int> num_attempts_{0};
+  mutable std::atomic<int> num_improvements_{0};
+};
+
+}  // namespace dreal
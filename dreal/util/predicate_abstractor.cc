@@ -1,10 +1,14 @@
 #include "dreal/util/predicate_abstractor.h"
 
 #include <atomic>
+#include <cmath>
 #include <iostream>
 #include <set>
 #include <sstream>
+#include <utility>
 
+#include "dreal/util/assert.h"
+#include "dreal/util/exception.h"
 #include "dreal/util/logging.h"
 #include "dreal/util/stat.h"
 #include "dreal/util/timer.h"
@@ -12,6 +16,7 @@
 namespace dreal {
 
 using std::cout;
+using std::pair;
 using std::set;
 using std::stringstream;
 using std::vector;
@@ -46,6 +51,131 @@ class PredicateAbstractorStat : public Stat {
   std::atomic<int> num_convert_{0};
 };
 
+// Returns true if x / y is exact in floating-point arithmetic.
+bool IsExactQuotient(const double x, const double y) {
+  return std::fma(x / y, y, -x) == 0.0;
+}
+
+// Returns `lhs ⋈ rhs`.
+Formula MakeRelational(const FormulaKind kind, const Expression& lhs,
+                       const Expression& rhs) {
+  switch (kind) {
+    case FormulaKind::Eq:
+      return lhs == rhs;
+    case FormulaKind::Lt:
+      return lhs < rhs;
+    case FormulaKind::Leq:
+      return lhs <= rhs;
+    default:
+      DREAL_UNREACHABLE();
+  }
+}
+
+// Puts a relational formula @p f into the form `p ⋈ k` where
+// `⋈ ∈ {=, <, ≤}`. It returns the pair of `p ⋈ k` and whether @p f is
+// the negation of it.
+pair<Formula, bool> Canonicalize(const Formula& f) {
+  // f = (lhs ⋈ rhs) or ¬(lhs ⋈ rhs), where ⋈ ∈ {=, <, ≤}.
+  FormulaKind kind{};
+  bool negated{false};
+  switch (f.get_kind()) {
+    case FormulaKind::Eq:
+    case FormulaKind::Lt:
+    case FormulaKind::Leq:
+      kind = f.get_kind();
+      break;
+    case FormulaKind::Neq:  // ¬(lhs = rhs)
+      kind = FormulaKind::Eq;
+      negated = true;
+      break;
+    case FormulaKind::Gt:  // ¬(lhs ≤ rhs)
+      kind = FormulaKind::Leq;
+      negated = true;
+      break;
+    case FormulaKind::Geq:  // ¬(lhs < rhs)
+      kind = FormulaKind::Lt;
+      negated = true;
+      break;
+    default:
+      DREAL_UNREACHABLE();
+  }
+  const Expression& lhs{get_lhs_expression(f)};
+  const Expression& rhs{get_rhs_expression(f)};
+  const Expression e{lhs - rhs};
+  if (is_constant(e)) {
+    return {MakeRelational(kind, lhs, rhs), negated};
+  }
+
+  // e = c + c₁t₁ + ... + cₙtₙ where c₁ is the leading coefficient.
+  double c{0.0};
+  double leading{1.0};
+  if (is_addition(e)) {
+    c = get_constant_in_addition(e);
+    leading = get_expr_to_coeff_map_in_addition(e).begin()->second;
+  } else if (is_multiplication(e)) {
+    leading = get_constant_in_multiplication(e);
+  }
+  // Divide e by the leading coefficient if it is exact and |leading| ≤
+  // 1. Otherwise, only divide it by its sign. A larger divisor would
+  // shrink the residual of `p ⋈ k` below the one of `e ⋈ 0`, and a
+  // δ-satisfying model of the abstracted atom could violate the
+  // original one by more than δ.
+  double divisor{leading};
+  bool exact{std::abs(leading) <= 1.0 && IsExactQuotient(c, divisor)};
+  if (exact && is_addition(e)) {
+    for (const auto& p : get_expr_to_coeff_map_in_addition(e)) {
+      if (!IsExactQuotient(p.second, divisor)) {
+        exact = false;
+        break;
+      }
+    }
+  }
+  if (!exact) {
+    divisor = leading < 0 ? -1.0 : 1.0;
+  }
+
+  // p = (e - c) / divisor.
+  Expression p{0.0};
+  if (is_addition(e)) {
+    for (const auto& term : get_expr_to_coeff_map_in_addition(e)) {
+      p += (term.second / divisor) * term.first;
+    }
+  } else if (is_multiplication(e)) {
+    p = get_constant_in_multiplication(e) / divisor;
+    for (const auto& term : get_base_to_exponent_map_in_multiplication(e)) {
+      p *= pow(term.first, term.second);
+    }
+  } else {
+    // The leading coefficient is 1.
+    p = e;
+  }
+  // e ⋈ 0 ⇔ p ⋈ k (resp. p ⋈⁻¹ k) if divisor > 0 (resp. divisor < 0).
+  const double k{-c / divisor};
+  if (divisor < 0) {
+    switch (kind) {
+      case FormulaKind::Lt:  // p > k = ¬(p ≤ k)
+        kind = FormulaKind::Leq;
+        negated = !negated;
+        break;
+      case FormulaKind::Leq:  // p ≥ k = ¬(p < k)
+        kind = FormulaKind::Lt;
+        negated = !negated;
+        break;
+      default:
+        break;
+    }
+  }
+  return {MakeRelational(kind, p, k), negated};
+}
+
+// Returns true if `p ⋈₁ k₁` implies `p ⋈₂ k₂`, where ⋈₂ is either `<`
+// or `≤`.
+bool Implies(const FormulaKind kind1, const double k1, const FormulaKind kind2,
+             const double k2) {
+  DREAL_ASSERT(kind2 != FormulaKind::Eq);
+  return k1 < k2 ||
+         (k1 == k2 && (kind1 == FormulaKind::Lt || kind2 == FormulaKind::Leq));
+}
 }  // namespace
 
 void PredicateAbstractor::Add(const Variable& var, const Formula& f) {
@@ -60,6 +190,12 @@ Formula PredicateAbstractor::Convert(const Formula& f) {
   return Visit(f);
 }
 
+vector<Formula> PredicateAbstractor::TakeImplications() {
+  vector<Formula> implications;
+  implications.swap(implications_);
+  return implications;
+}
+
 Formula PredicateAbstractor::Convert(const vector<Formula>& formulas) {
   return Convert(
       make_conjunction(set<Formula>{formulas.begin(), formulas.end()}));
@@ -107,34 +243,80 @@ Formula PredicateAbstractor::VisitAtomic(const Formula& f) {
   }
 }
 
+Formula PredicateAbstractor::VisitRelational(const Formula& f) {
+  const pair<Formula, bool> canonical{Canonicalize(f)};
+  const Formula& atom{canonical.first};
+  if (is_true(atom) || is_false(atom)) {
+    return canonical.second ? !atom : atom;
+  }
+  const bool is_new{formula_to_var_map_.count(atom) == 0};
+  const Formula literal{VisitAtomic(atom)};
+  if (is_new && is_relational(atom)) {
+    const Expression& rhs{get_rhs_expression(atom)};
+    if (is_constant(rhs) && std::isfinite(get_constant_value(rhs))) {
+      AddImplications(get_lhs_expression(atom),
+                      Bound{get_variable(literal), atom.get_kind(),
+                            get_constant_value(rhs)});
+    }
+  }
+  return canonical.second ? !literal : literal;
+}
+
+void PredicateAbstractor::AddImplications(const Expression& p,
+                                          const Bound& bound) {
+  vector<Bound>& bounds{bounds_[p]};
+  const Formula b{bound.var};
+  for (const Bound& other : bounds) {
+    const Formula b_other{other.var};
+    if (bound.kind != FormulaKind::Eq && other.kind != FormulaKind::Eq) {
+      // Between two bounds, one may imply the other.
+      if (Implies(bound.kind, bound.k, other.kind, other.k)) {
+        implications_.push_back(!b || b_other);
+      } else if (Implies(other.kind, other.k, bound.kind, bound.k)) {
+        implications_.push_back(!b_other || b);
+      }
+    } else if (bound.kind == FormulaKind::Eq &&
+               other.kind == FormulaKind::Eq) {
+      // p = k₁ and p = k₂ exclude each other.
+      implications_.push_back(!b || !b_other);
+    } else {
+      // p = k₁ either implies or excludes p ⋈ k₂.
+      const Bound& eq{bound.kind == FormulaKind::Eq ? bound : other};
+      const Bound& ineq{bound.kind == FormulaKind::Eq ? other : bound};
+      const Formula b_eq{eq.var};
+      const Formula b_ineq{ineq.var};
+      if (Implies(eq.kind, eq.k, ineq.kind, ineq.k)) {
+        implications_.push_back(!b_eq || b_ineq);
+      } else {
+        implications_.push_back(!b_eq || !b_ineq);
+      }
+    }
+  }
+  bounds.push_back(bound);
+}
+
 Formula PredicateAbstractor::VisitEqualTo(const Formula& f) {
-  return VisitAtomic(f);
+  return VisitRelational(f);
 }
 
 Formula PredicateAbstractor::VisitNotEqualTo(const Formula& f) {
-  const Expression& lhs{get_lhs_expression(f)};
-  const Expression& rhs{get_rhs_expression(f)};
-  return !VisitAtomic(lhs == rhs);
+  return VisitRelational(f);
 }
 
 Formula PredicateAbstractor::VisitGreaterThan(const Formula& f) {
-  const Expression& lhs{get_lhs_expression(f)};
-  const Expression& rhs{get_rhs_expression(f)};
-  return !VisitAtomic(lhs <= rhs);
+  return VisitRelational(f);
 }
 
 Formula PredicateAbstractor::VisitGreaterThanOrEqualTo(const Formula& f) {
-  const Expression& lhs{get_lhs_expression(f)};
-  const Expression& rhs{get_rhs_expression(f)};
-  return !VisitAtomic(lhs < rhs);
+  return VisitRelational(f);
 }
 
 Formula PredicateAbstractor::VisitLessThan(const Formula& f) {
-  return VisitAtomic(f);
+  return VisitRelational(f);
 }
 
 Formula PredicateAbstractor::VisitLessThanOrEqualTo(const Formula& f) {
-  return VisitAtomic(f);
+  return VisitRelational(f);
 }
 
 Formula PredicateAbstractor::VisitConjunction(const Formula& f) {
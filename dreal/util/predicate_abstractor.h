@@ -16,6 +16,18 @@ class PredicateAbstractor {
   /// `x > 0` and `b₂` corresponds with `y < 0`. The class provides
   /// `operator[b]` which looks up the corresponding formula for a
   /// Boolean variable `b`.
+  ///
+  /// A relational formula is put into a canonical form `p ⋈ k` before
+  /// the abstraction, where `⋈ ∈ {=, <, ≤}`, `k` is a constant, and the
+  /// leading coefficient of `p` is 1. The other relations are negations
+  /// of them. For example, `x > 0`, `0 < x`, `¬(x ≤ 0)`, and `0.5x > 0`
+  /// are all abstracted into `¬b` where `b` corresponds with `x ≤ 0`.
+  ///
+  /// @note The leading coefficient is only scaled to 1 if its absolute
+  /// value is at most 1 and the division is exact, so that the scaling
+  /// does not weaken the δ of the atom. Otherwise, only its sign is
+  /// normalized. For example, `2x > 0` is abstracted into `¬b'` where
+  /// `b'` corresponds with `2x ≤ 0`.
   Formula Convert(const Formula& f);
 
   /// Converts @p formulas into a conjunction of Boolean formulas. See
@@ -35,7 +47,28 @@ class PredicateAbstractor {
     return var_to_formula_map_.at(var);
   }
 
+  /// Returns the clauses between the Boolean variables of the canonical
+  /// atoms found since the last call, which hold by the atoms over the
+  /// same expression. For example, it returns `¬b₁ ∨ b₂` if `b₁` and
+  /// `b₂` correspond with `x < 3` and `x ≤ 5`, and `¬b₁ ∨ ¬b₃` if `b₃`
+  /// corresponds with `x = 4`.
+  std::vector<Formula> TakeImplications();
+
  private:
+  // A canonical atom `p ⋈ k` and its Boolean variable.
+  struct Bound {
+    Variable var;
+    FormulaKind kind;  // Eq, Lt, or Leq.
+    double k;
+  };
+
+  // Abstracts a relational formula @p f by its canonical form.
+  Formula VisitRelational(const Formula& f);
+
+  // Adds the clauses between @p bound and the other bounds over the
+  // same expression @p p to implications_.
+  void AddImplications(const Expression& p, const Bound& bound);
+
   Formula Visit(const Formula& f);
   Formula VisitFalse(const Formula& f);
   Formula VisitTrue(const Formula& f);
@@ -58,6 +91,12 @@ class PredicateAbstractor {
       var_to_formula_map_;
   std::unordered_map<Formula, Variable> formula_to_var_map_;
 
+  // Maps an expression p to the canonical atoms `p ⋈ k`.
+  std::unordered_map<Expression, std::vector<Bound>> bounds_;
+
+  // The clauses found by AddImplications, which are not taken yet.
+  std::vector<Formula> implications_;
+
   // Makes VisitFormula a friend of this class so that it can use private
   // operator()s.
   friend Formula drake::symbolic::VisitFormula<Formula, PredicateAbstractor>(
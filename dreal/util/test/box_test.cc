@@ -237,6 +237,63 @@ TEST_F(BoxTest, NotBisectable) {
   EXPECT_THROW(box.bisect(y_), std::runtime_error);
 }
 
+TEST_F(BoxTest, MultisectReal) {
+  Box box;
+  box.Add(x_, -10, 20);
+  box.Add(i_, -5, 5);
+
+  const vector<Box> boxes{box.multisect(x_, 3)};
+  ASSERT_EQ(boxes.size(), 3u);
+  EXPECT_EQ(boxes[0][x_], Box::Interval(-10, 0));
+  EXPECT_EQ(boxes[1][x_], Box::Interval(0, 10));
+  EXPECT_EQ(boxes[2][x_], Box::Interval(10, 20));
+  for (const Box& b : boxes) {
+    EXPECT_EQ(b[i_], box[i_]);
+  }
+
+  // Unbounded. As in bisect, [0, ∞] is split at the max double, and
+  // [max double, ∞] is not split further.
+  box[x_] = Box::Interval(0, inf_);
+  const vector<Box> unbounded{box.multisect(x_, 4)};
+  ASSERT_EQ(unbounded.size(), 2u);
+  EXPECT_EQ(unbounded.front()[x_].lb(), 0.0);
+  EXPECT_EQ(unbounded.back()[x_].ub(), inf_);
+  for (size_t j = 1; j < unbounded.size(); ++j) {
+    EXPECT_EQ(unbounded[j][x_].lb(), unbounded[j - 1][x_].ub());
+  }
+}
+
+TEST_F(BoxTest, MultisectInteger) {
+  Box box;
+  box.Add(x_, -10, 10);
+  box.Add(i_, -5, 5);
+  box.Add(b1_, 0, 1);
+
+  const vector<Box> boxes{box.multisect(i_, 3)};
+  ASSERT_EQ(boxes.size(), 3u);
+  EXPECT_EQ(boxes[0][i_], Box::Interval(-5, -3));
+  EXPECT_EQ(boxes[1][i_], Box::Interval(-2, 1));
+  EXPECT_EQ(boxes[2][i_], Box::Interval(2, 5));
+  for (const Box& b : boxes) {
+    EXPECT_EQ(b[x_], box[x_]);
+  }
+
+  // Binary variables have only two values.
+  const vector<Box> binary{box.multisect(b1_, 4)};
+  ASSERT_EQ(binary.size(), 2u);
+  EXPECT_EQ(binary[0][b1_], Box::Interval(0, 0));
+  EXPECT_EQ(binary[1][b1_], Box::Interval(1, 1));
+}
+
+TEST_F(BoxTest, NotMultisectable) {
+  Box box;
+  box.Add(x_, 10, std::nextafter(10, 11));
+  box.Add(z_, 0, 1);
+  EXPECT_THROW(box.multisect(x_, 2), std::runtime_error);
+  EXPECT_THROW(box.multisect(y_, 2), std::runtime_error);
+  EXPECT_THROW(box.multisect(z_, 1), std::runtime_error);
+}
+
 TEST_F(BoxTest, Equality) {
   Box b1;
   b1.Add(x_, -10, 10);
@@ -0,0 +1,122 @@
+#include "dreal/util/interval_enclosure.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace dreal {
+namespace {
+
+using std::numeric_limits;
+using std::vector;
+
+class IntervalEnclosureTest : public ::testing::Test {
+ protected:
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  const vector<EnclosureMode> modes_{
+      EnclosureMode::Natural, EnclosureMode::MeanValue, EnclosureMode::Affine,
+      EnclosureMode::Taylor, EnclosureMode::Adaptive};
+  std::mt19937 random_generator_{1234};
+};
+
+TEST_F(IntervalEnclosureTest, Dependency) {
+  // The range of x² - 2x over [0, 2] is [-1, 0].
+  const Expression e{x_ * x_ - 2 * x_};
+  const Box::Interval inputs[]{Box::Interval{0, 2}};
+  const Box::Interval natural{
+      IntervalEnclosure{e, {x_}, EnclosureMode::Natural}(inputs)};
+  EXPECT_LE(natural.lb(), -4.0);
+  EXPECT_GE(natural.ub(), 4.0);
+  for (const EnclosureMode mode : modes_) {
+    const Box::Interval enclosure{IntervalEnclosure{e, {x_}, mode}(inputs)};
+    EXPECT_LE(enclosure.lb(), -1.0) << mode;
+    EXPECT_GE(enclosure.ub(), 0.0) << mode;
+    if (mode != EnclosureMode::Natural) {
+      EXPECT_LT(enclosure.diam(), natural.diam()) << mode;
+    }
+  }
+  // x = 1 + ξ for ξ ∈ [-1, 1]. Then, x² - 2x = -1 + ξ², which the
+  // linear forms enclose exactly up to rounding.
+  for (const EnclosureMode mode :
+       {EnclosureMode::Affine, EnclosureMode::Taylor}) {
+    const Box::Interval enclosure{IntervalEnclosure{e, {x_}, mode}(inputs)};
+    EXPECT_NEAR(enclosure.lb(), -1.0, 1e-12) << mode;
+    EXPECT_NEAR(enclosure.ub(), 0.0, 1e-12) << mode;
+  }
+}
+
+TEST_F(IntervalEnclosureTest, Enclosure) {
+  const vector<Expression> expressions{
+      x_ * y_ - x_ * x_ + 3 * y_,
+      exp(x_ / 3) - x_ * x_ * y_,
+      sqrt(x_ * x_ + 1) * y_ - x_ / (y_ * y_ + 1),
+      atan(x_) * tanh(y_) + cosh(x_ / 4) - sinh(y_ / 4),
+      log(x_ * x_ + 2) - pow(x_, 3) + abs(y_) * x_,
+      sin(x_) * cos(y_) - x_ * y_,
+  };
+  std::uniform_real_distribution<double> dist{-3.0, 3.0};
+  for (const Expression& e : expressions) {
+    for (const EnclosureMode mode : modes_) {
+      const IntervalEnclosure enclosure{e, {x_, y_}, mode};
+      const IntervalEnclosure natural{e, {x_, y_}, EnclosureMode::Natural};
+      for (int i = 0; i < 50; ++i) {
+        // Random boxes, half of which are small.
+        const double scale{i % 2 == 0 ? 1.0 : 1e-3};
+        Box::Interval inputs[2];
+        for (Box::Interval& input : inputs) {
+          const double a{dist(random_generator_)};
+          const double b{a + scale * std::abs(dist(random_generator_))};
+          input = Box::Interval{a, b};
+        }
+        const Box::Interval result{enclosure(inputs)};
+        EXPECT_TRUE(result.is_subset(natural(inputs))) << e << " " << mode;
+        for (const double t : {0.0, 0.3, 0.5, 1.0}) {
+          for (const double s : {0.0, 0.7, 1.0}) {
+            const double x{inputs[0].lb() + t * inputs[0].diam()};
+            const double y{inputs[1].lb() + s * inputs[1].diam()};
+            const Environment env{{x_, x}, {y_, y}};
+            EXPECT_TRUE(result.contains(e.Evaluate(env)))
+                << e << " " << mode << " at (" << x << ", " << y << ")";
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_F(IntervalEnclosureTest, OutOfDomain) {
+  // sqrt is not differentiable at 0. The natural extension is used.
+  const Expression e{sqrt(x_) - x_};
+  const Box::Interval inputs[]{Box::Interval{-1, 1}};
+  const Box::Interval natural{
+      IntervalEnclosure{e, {x_}, EnclosureMode::Natural}(inputs)};
+  for (const EnclosureMode mode : modes_) {
+    EXPECT_EQ(IntervalEnclosure(e, {x_}, mode)(inputs), natural) << mode;
+  }
+}
+
+TEST_F(IntervalEnclosureTest, Unbounded) {
+  const Expression e{x_ * x_ - x_ * y_};
+  const double inf{numeric_limits<double>::infinity()};
+  const Box::Interval inputs[]{Box::Interval{0, inf}, Box::Interval{1, 2}};
+  for (const EnclosureMode mode : modes_) {
+    const Box::Interval result{IntervalEnclosure{e, {x_, y_}, mode}(inputs)};
+    EXPECT_TRUE(result.contains(0.0)) << mode;
+    EXPECT_EQ(result.ub(), inf) << mode;
+  }
+}
+
+TEST_F(IntervalEnclosureTest, NoDependency) {
+  // Each variable occurs once. The adaptive mode does not refine it.
+  const Expression e{sin(x_) + 2 * y_};
+  const Box::Interval inputs[]{Box::Interval{0, 1}, Box::Interval{1, 2}};
+  EXPECT_EQ(IntervalEnclosure(e, {x_, y_}, EnclosureMode::Adaptive)(inputs),
+            IntervalEnclosure(e, {x_, y_}, EnclosureMode::Natural)(inputs));
+}
+
+}  // namespace
+}  // namespace dreal
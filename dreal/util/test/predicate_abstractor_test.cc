@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <set>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -9,6 +10,7 @@
 #include "dreal/symbolic/symbolic_test_util.h"
 
 using std::set;
+using std::vector;
 
 namespace dreal {
 namespace {
@@ -211,5 +213,79 @@ TEST_F(PredicateAbstractorTest, Forall) {
   EXPECT_PRED2(VarEqual, abstractor_[f], var);
 }
 
+TEST_F(PredicateAbstractorTest, Canonicalization) {
+  // x > 0 <-> !(x <= 0)
+  const Formula f{abstractor_.Convert(x_ > 0)};
+  ASSERT_TRUE(is_negation(f));
+  ASSERT_TRUE(is_variable(get_operand(f)));
+  EXPECT_PRED2(FormulaEqual, abstractor_[get_variable(get_operand(f))],
+               x_ <= 0);
+
+  // They share the same Boolean variable.
+  EXPECT_PRED2(FormulaEqual, abstractor_.Convert(0 < x_), f);
+  EXPECT_PRED2(FormulaEqual, abstractor_.Convert(!(x_ <= 0)), f);
+  EXPECT_PRED2(FormulaEqual, abstractor_.Convert(0.5 * x_ > 0), f);
+  EXPECT_PRED2(FormulaEqual, abstractor_.Convert(-x_ < 0), f);
+
+  // x - y + 3 >= 2 <-> !(x - y < -1)
+  const Formula g{abstractor_.Convert(x_ - y_ + 3 >= 2)};
+  EXPECT_PRED2(FormulaEqual, abstractor_.Convert(y_ - x_ <= 1), g);
+  EXPECT_PRED2(FormulaEqual,
+               abstractor_.Convert(0.5 * x_ >= 0.5 * y_ - 0.5), g);
+}
+
+TEST_F(PredicateAbstractorTest, CanonicalizationLargeCoefficient) {
+  // 1000x > 0 is not divided by 1000, which would weaken its δ.
+  const Formula f{abstractor_.Convert(1000 * x_ > 0)};
+  ASSERT_TRUE(is_negation(f));
+  ASSERT_TRUE(is_variable(get_operand(f)));
+  EXPECT_PRED2(FormulaEqual, abstractor_[get_variable(get_operand(f))],
+               1000 * x_ <= 0);
+  EXPECT_FALSE(abstractor_.Convert(x_ > 0).EqualTo(f));
+
+  // Only the sign is normalized.
+  EXPECT_PRED2(FormulaEqual, abstractor_.Convert(-1000 * x_ < 0), f);
+
+  // Neither is 2x > 0 merged with x > 0.
+  const Formula g{abstractor_.Convert(2 * x_ > 0)};
+  EXPECT_FALSE(g.EqualTo(abstractor_.Convert(x_ > 0)));
+  EXPECT_FALSE(g.EqualTo(f));
+}
+
+TEST_F(PredicateAbstractorTest, CanonicalizationInexact) {
+  // 3x < 1 is not divided by 3 since 1 / 3 is not exact.
+  const Formula f{abstractor_.Convert(3 * x_ < 1)};
+  ASSERT_TRUE(is_variable(f));
+  EXPECT_PRED2(FormulaEqual, abstractor_[get_variable(f)], 3 * x_ < 1);
+
+  // Only the sign is normalized.
+  EXPECT_PRED2(FormulaEqual, abstractor_.Convert(-3 * x_ > -1), f);
+}
+
+TEST_F(PredicateAbstractorTest, Implications) {
+  const Formula b1{abstractor_.Convert(x_ < 3)};
+  EXPECT_TRUE(abstractor_.TakeImplications().empty());
+
+  // x < 3 ⇒ x ≤ 5
+  const Formula b2{abstractor_.Convert(x_ <= 5)};
+  const vector<Formula> implications{abstractor_.TakeImplications()};
+  ASSERT_EQ(implications.size(), 1u);
+  EXPECT_PRED2(FormulaEqual, implications[0], !b1 || b2);
+  EXPECT_TRUE(abstractor_.TakeImplications().empty());
+
+  // x = 4 excludes x < 3 and implies x ≤ 5.
+  const Formula b3{abstractor_.Convert(x_ == 4)};
+  const set<Formula> expected{!b3 || !b1, !b3 || b2};
+  const vector<Formula> implications2{abstractor_.TakeImplications()};
+  EXPECT_EQ(implications2.size(), 2u);
+  for (const Formula& f : implications2) {
+    EXPECT_EQ(expected.count(f), 1u) << f;
+  }
+
+  // A bound over another expression has none.
+  abstractor_.Convert(y_ < 3);
+  EXPECT_TRUE(abstractor_.TakeImplications().empty());
+}
+
 }  // namespace
 }  // namespace dreal
@@ -32,8 +32,12 @@ bool IsSatisfiable(const Formula& f) {
 
 class TseitinCnfizerTest : public ::testing::Test {
  protected:
-  ::testing::AssertionResult CnfChecker(const Formula& f) {
-    const vector<Formula> clauses{cnfizer_.Convert(f)};
+  ::testing::AssertionResult CnfChecker(const Formula& f,
+                                        const bool polarity_aware = false) {
+    // Uses a fresh cnfizer so that the clauses do not refer to the Boolean
+    // variables defined by the previous calls.
+    TseitinCnfizer cnfizer{polarity_aware};
+    const vector<Formula> clauses{cnfizer.Convert(f)};
     const Formula f_cnf{
         make_conjunction(set<Formula>{clauses.begin(), clauses.end()})};
     // Check1: f_cnf should be in CNF.
@@ -89,5 +93,49 @@ TEST_F(TseitinCnfizerTest, Test) {
   }
 }
 
+TEST_F(TseitinCnfizerTest, PolarityAware) {
+  vector<Formula> formulas;
+  formulas.push_back((b1_ && b2_) || (b1_ && !b3_));
+  formulas.push_back(!((b1_ && b2_) || b3_));
+  formulas.push_back(!(b1_ && !(b2_ || b3_)) || (b2_ && b3_));
+  formulas.push_back(((b1_ && b2_) || b3_) && !((b1_ && b2_) || b3_));
+
+  for (const auto& f : formulas) {
+    EXPECT_TRUE(CnfChecker(f, true /* polarity_aware */));
+  }
+
+  // (b1 ∧ b2) only occurs positively. It only needs the clauses of
+  // b → (b1 ∧ b2), not the one of (b1 ∧ b2) → b.
+  TseitinCnfizer full;
+  TseitinCnfizer polarity_aware{true};
+  const Formula f{(b1_ && b2_) || b3_};
+  EXPECT_EQ(full.Convert(f).size(), 4u);
+  EXPECT_EQ(polarity_aware.Convert(f).size(), 3u);
+}
+
+TEST_F(TseitinCnfizerTest, Memoization) {
+  // (b1 ∧ b2) is defined by the first call.
+  EXPECT_EQ(cnfizer_.Convert((b1_ && b2_) || b3_).size(), 4u);
+  EXPECT_EQ(cnfizer_.map().size(), 1u);
+
+  // The second call reuses its definition.
+  EXPECT_EQ(cnfizer_.Convert((b1_ && b2_) || !b3_).size(), 1u);
+  EXPECT_TRUE(cnfizer_.map().empty());
+}
+
+TEST_F(TseitinCnfizerTest, PushPop) {
+  const Formula f{(b1_ && b2_) || b3_};
+  cnfizer_.Push();
+  cnfizer_.Convert(f);
+  EXPECT_EQ(cnfizer_.map().size(), 1u);
+  cnfizer_.Convert(f);
+  EXPECT_TRUE(cnfizer_.map().empty());
+  cnfizer_.Pop();
+
+  // The definition is forgotten.
+  cnfizer_.Convert(f);
+  EXPECT_EQ(cnfizer_.map().size(), 1u);
+}
+
 }  // namespace
 }  // namespace dreal
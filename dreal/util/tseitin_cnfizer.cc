@@ -51,62 +51,147 @@ class TseitinCnfizerStat : public Stat {
   std::atomic<int> num_convert_{0};
 };
 
-// Forward declarations for the helper functions.
-void Cnfize(const Variable& b, const Formula& f, vector<Formula>* clauses);
-void CnfizeNegation(const Variable& b, const Formula& f,
-                    vector<Formula>* clauses);
-void CnfizeConjunction(const Variable& b, const Formula& f,
-                       vector<Formula>* clauses);
-void CnfizeDisjunction(const Variable& b, const Formula& f,
-                       vector<Formula>* clauses);
+// Add f to clauses if f is not true.
+void Add(const Formula& f, vector<Formula>* clauses) {
+  if (!is_true(f)) {
+    clauses->push_back(f);
+  }
+}
+
+// Cnfize b → f and add it to @p clauses, where f is a conjunction or a
+// disjunction of literals, or a literal:
+//   b → (b₁ ∧ ... ∧ bₙ) = (¬b ∨ b₁) ∧ ... ∧ (¬b ∨ bₙ)   (✓CNF)
+//   b → (b₁ ∨ ... ∨ bₙ) = (¬b ∨ b₁ ∨ ... ∨ bₙ)          (✓CNF)
+void CnfizeImplication(const Variable& b, const Formula& f,
+                       vector<Formula>* clauses) {
+  if (is_conjunction(f)) {
+    for (const Formula& b_i : get_operands(f)) {
+      Add(!b || b_i, clauses);
+    }
+  } else {
+    Add(!b || f, clauses);
+  }
+}
+
+// Cnfize f → b and add it to @p clauses, where f is a conjunction or a
+// disjunction of literals, or a literal:
+//   (b₁ ∧ ... ∧ bₙ) → b = (¬b₁ ∨ ... ∨ ¬bₙ ∨ b)          (✓CNF)
+//   (b₁ ∨ ... ∨ bₙ) → b = (¬b₁ ∨ b) ∧ ... ∧ (¬bₙ ∨ b)   (✓CNF)
+void CnfizeReverseImplication(const Variable& b, const Formula& f,
+                              vector<Formula>* clauses) {
+  if (is_disjunction(f)) {
+    for (const Formula& b_i : get_operands(f)) {
+      Add(!b_i || b, clauses);
+    }
+  } else if (is_conjunction(f)) {
+    // negated_operands = {¬b₁, ..., ¬bₙ}
+    const set<Formula> negated_operands{
+        map(get_operands(f), [](const Formula& formula) { return !formula; })};
+    Add(make_disjunction(negated_operands) || b, clauses);
+  } else {
+    Add(!f || b, clauses);
+  }
+}
 }  // namespace
 
+TseitinCnfizer::TseitinCnfizer(const bool polarity_aware)
+    : polarity_aware_{polarity_aware} {}
+
 // The main function of the TseitinCnfizer:
 //  - It visits each node and introduce a Boolean variable `b` for
-//    each subterm `f`, and keep the relation `b ⇔ f`.
-//  - Then it cnfizes each `b ⇔ f` and make a conjunction of them.
+//    each subterm `f`, and keep the relation `b ⇔ f`. In the
+//    polarity-aware mode, it only keeps `b → f` (resp. `f → b`) if `f`
+//    occurs positively (resp. negatively).
+//  - Then it cnfizes each relation and make a conjunction of them.
 vector<Formula> TseitinCnfizer::Convert(const Formula& f) {
   static TseitinCnfizerStat stat{DREAL_LOG_INFO_ENABLED};
   TimerGuard timer_guard(&stat.timer_convert_, stat.enabled());
   stat.increase_num_convert();
   map_.clear();
-  vector<Formula> ret;
-  const Formula head{Visit(f)};
-  if (map_.empty()) {
-    return {head};
-  }
-  for (auto const& p : map_) {
-    if (get_variable(head).equal_to(p.first)) {
-      if (is_conjunction(p.second)) {
-        const set<Formula>& conjuncts(get_operands(p.second));
-        copy(conjuncts.begin(), conjuncts.end(), back_inserter(ret));
-      } else {
-        ret.push_back(p.second);
+  clauses_.clear();
+  AddAssertion(f);
+  return std::move(clauses_);
+}
+
+void TseitinCnfizer::Push() { definitions_.push(); }
+
+void TseitinCnfizer::Pop() { definitions_.pop(); }
+
+void TseitinCnfizer::AddAssertion(const Formula& f) {
+  // The top-level formula does not need a Boolean variable.
+  switch (f.get_kind()) {
+    case FormulaKind::And:
+      for (const Formula& f_i : get_operands(f)) {
+        AddAssertion(f_i);
       }
-    } else {
-      Cnfize(p.first, p.second, &ret);
-    }
+      return;
+    case FormulaKind::Or:
+    case FormulaKind::Not:
+      return Add(Transform(f, true), &clauses_);
+    case FormulaKind::Forall:
+      for (const Formula& clause : ForallClauses(f)) {
+        Add(clause, &clauses_);
+      }
+      return;
+    default:
+      return Add(f, &clauses_);
   }
-  return ret;
 }
 
-Formula TseitinCnfizer::Visit(const Formula& f) {
-  // TODO(soonho): use cache.
-  return VisitFormula<Formula>(this, f);
+Formula TseitinCnfizer::Define(const Formula& f, const bool polarity,
+                               const char* const prefix) {
+  const auto it = definitions_.find(f);
+  Definition definition;
+  if (it != definitions_.end()) {
+    definition = it->second;
+  } else {
+    static size_t id{0};
+    definition.var = Variable{string(prefix) + to_string(id++),
+                              Variable::Type::BOOLEAN};
+    map_.emplace(definition.var, f);
+  }
+  const bool positive{!polarity_aware_ || polarity};
+  const bool negative{!polarity_aware_ || !polarity};
+  bool updated{it == definitions_.end()};
+  if (positive && !definition.positive) {
+    CnfizeImplication(definition.var, Transform(f, true), &clauses_);
+    definition.positive = true;
+    updated = true;
+  }
+  if (negative && !definition.negative) {
+    CnfizeReverseImplication(definition.var, Transform(f, false), &clauses_);
+    definition.negative = true;
+    updated = true;
+  }
+  if (updated) {
+    definitions_.insert(f, definition);
+  }
+  return Formula{definition.var};
 }
 
-Formula TseitinCnfizer::VisitFalse(const Formula& f) { return f; }
-Formula TseitinCnfizer::VisitTrue(const Formula& f) { return f; }
-Formula TseitinCnfizer::VisitVariable(const Formula& f) { return f; }
-Formula TseitinCnfizer::VisitEqualTo(const Formula& f) { return f; }
-Formula TseitinCnfizer::VisitNotEqualTo(const Formula& f) { return f; }
-Formula TseitinCnfizer::VisitGreaterThan(const Formula& f) { return f; }
-Formula TseitinCnfizer::VisitGreaterThanOrEqualTo(const Formula& f) {
-  return f;
+Formula TseitinCnfizer::Transform(const Formula& f, const bool polarity) {
+  switch (f.get_kind()) {
+    case FormulaKind::And:
+      return make_conjunction(
+          ::dreal::map(get_operands(f), [this, polarity](const Formula& f_i) {
+            return this->Visit(f_i, polarity);
+          }));
+    case FormulaKind::Or:
+      return make_disjunction(
+          ::dreal::map(get_operands(f), [this, polarity](const Formula& f_i) {
+            return this->Visit(f_i, polarity);
+          }));
+    case FormulaKind::Not:
+      // The operand occurs with the opposite polarity.
+      return !Visit(get_operand(f), !polarity);
+    case FormulaKind::Forall:
+      return make_conjunction(ForallClauses(f));
+    default:
+      return f;
+  }
 }
-Formula TseitinCnfizer::VisitLessThan(const Formula& f) { return f; }
-Formula TseitinCnfizer::VisitLessThanOrEqualTo(const Formula& f) { return f; }
-Formula TseitinCnfizer::VisitForall(const Formula& f) {
+
+set<Formula> TseitinCnfizer::ForallClauses(const Formula& f) const {
   // Given: f := ∀y. φ(x, y), this process CNFizes φ(x, y) and push the
   // universal quantifier over conjunctions:
   //
@@ -126,147 +211,54 @@ Formula TseitinCnfizer::VisitForall(const Formula& f) {
           return clause;
         }
       })};
-
   DREAL_ASSERT(!new_clauses.empty());
-  if (new_clauses.size() == 1) {
-    return *(new_clauses.begin());
-  } else {
-    static size_t id{0};
-    const Variable bvar{string("forall") + to_string(id++),
-                        Variable::Type::BOOLEAN};
-    map_.emplace(bvar, make_conjunction(new_clauses));
-    return Formula{bvar};
-  }
+  return new_clauses;
 }
 
-Formula TseitinCnfizer::VisitConjunction(const Formula& f) {
-  // Introduce a new Boolean variable, `bvar` for `f` and record the
-  // relation `bvar ⇔ f`.
-  static size_t id{0};
-  const set<Formula> transformed_operands{::dreal::map(
-      get_operands(f),
-      [this](const Formula& formula) { return this->Visit(formula); })};
-  const Variable bvar{string("conj") + to_string(id++),
-                      Variable::Type::BOOLEAN};
-  map_.emplace(bvar, make_conjunction(transformed_operands));
-  return Formula{bvar};
+Formula TseitinCnfizer::Visit(const Formula& f, const bool polarity) {
+  return VisitFormula<Formula>(this, f, polarity);
 }
 
-Formula TseitinCnfizer::VisitDisjunction(const Formula& f) {
-  static size_t id{0};
-  const set<Formula>& transformed_operands{::dreal::map(
-      get_operands(f),
-      [this](const Formula& formula) { return this->Visit(formula); })};
-  const Variable bvar{string("disj") + to_string(id++),
-                      Variable::Type::BOOLEAN};
-  map_.emplace(bvar, make_disjunction(transformed_operands));
-  return Formula{bvar};
-}
-
-Formula TseitinCnfizer::VisitNegation(const Formula& f) {
-  const Formula& operand{get_operand(f)};
-  if (is_atomic(operand)) {
-    return f;
-  } else {
-    const Variable bvar{"neg", Variable::Type::BOOLEAN};
-    const Formula transformed_operand{Visit(operand)};
-    map_.emplace(bvar, !transformed_operand);
-    return Formula{bvar};
-  }
+Formula TseitinCnfizer::VisitFalse(const Formula& f, bool) { return f; }
+Formula TseitinCnfizer::VisitTrue(const Formula& f, bool) { return f; }
+Formula TseitinCnfizer::VisitVariable(const Formula& f, bool) { return f; }
+Formula TseitinCnfizer::VisitEqualTo(const Formula& f, bool) { return f; }
+Formula TseitinCnfizer::VisitNotEqualTo(const Formula& f, bool) { return f; }
+Formula TseitinCnfizer::VisitGreaterThan(const Formula& f, bool) { return f; }
+Formula TseitinCnfizer::VisitGreaterThanOrEqualTo(const Formula& f, bool) {
+  return f;
 }
-
-namespace {
-// Cnfize b ⇔ f and add it to @p clauses. It calls Cnfize<FormulaKind> using
-// pattern-matching.
-void Cnfize(const Variable& b, const Formula& f, vector<Formula>* clauses) {
-  switch (f.get_kind()) {
-    case FormulaKind::False:
-      DREAL_UNREACHABLE();
-    case FormulaKind::True:
-      DREAL_UNREACHABLE();
-    case FormulaKind::Var:
-      DREAL_UNREACHABLE();
-    case FormulaKind::Eq:
-      DREAL_UNREACHABLE();
-    case FormulaKind::Neq:
-      DREAL_UNREACHABLE();
-    case FormulaKind::Gt:
-      DREAL_UNREACHABLE();
-    case FormulaKind::Geq:
-      DREAL_UNREACHABLE();
-    case FormulaKind::Lt:
-      DREAL_UNREACHABLE();
-    case FormulaKind::Leq:
-      DREAL_UNREACHABLE();
-    case FormulaKind::Forall:
-      DREAL_UNREACHABLE();
-    case FormulaKind::And:
-      return CnfizeConjunction(b, f, clauses);
-    case FormulaKind::Or:
-      return CnfizeDisjunction(b, f, clauses);
-    case FormulaKind::Not:
-      return CnfizeNegation(b, f, clauses);
-  }
-  DREAL_UNREACHABLE();
+Formula TseitinCnfizer::VisitLessThan(const Formula& f, bool) { return f; }
+Formula TseitinCnfizer::VisitLessThanOrEqualTo(const Formula& f, bool) {
+  return f;
 }
 
-// Add f to clauses if f is not true.
-void Add(const Formula& f, vector<Formula>* clauses) {
-  if (!is_true(f)) {
-    clauses->push_back(f);
+Formula TseitinCnfizer::VisitForall(const Formula& f, const bool polarity) {
+  const set<Formula> clauses{ForallClauses(f)};
+  if (clauses.size() == 1 && !is_disjunction(*clauses.begin())) {
+    return *(clauses.begin());
   }
+  return Define(f, polarity, "forall");
 }
 
-// Add f₁ ⇔ f₂ to clauses.
-void AddIff(const Formula& f1, const Formula& f2, vector<Formula>* clauses) {
-  Add(imply(f1, f2), clauses);
-  Add(imply(f2, f1), clauses);
+Formula TseitinCnfizer::VisitConjunction(const Formula& f,
+                                         const bool polarity) {
+  // Introduce a new Boolean variable, `bvar` for `f` and record the
+  // relation `bvar ⇔ f`.
+  return Define(f, polarity, "conj");
 }
 
-// Cnfize b ⇔ ¬b₁ using the following equalities and add to clauses:
-//   b ⇔ ¬b₁
-// = (b → ¬b₁) ∧ (¬b₁ → b)
-// = (¬b ∨ ¬b₁) ∧ (b₁ ∨ b)   (✓CNF)
-void CnfizeNegation(const Variable& b, const Formula& f,
-                    vector<Formula>* clauses) {
-  AddIff(Formula{b}, f, clauses);
-}  // namespace
-
-// Cnfize b ⇔ (b₁ ∧ ... ∧ bₙ) using the following equalities and add
-// to clauses:
-//   b ⇔ (b₁ ∧ ... ∧ bₙ)
-// = (b → (b₁ ∧ ... ∧ bₙ)) ∧ ((b₁ ∧ ... ∧ bₙ) → b)
-// = (¬b ∨ (b₁ ∧ ... ∧ bₙ)) ∧ (¬b₁ ∨ ... ∨ ¬bₙ ∨ b)
-// = (¬b ∨ b₁) ∧ ... (¬b ∨ bₙ) ∧ (¬b₁ ∨ ... ∨ ¬bₙ ∨ b)   (✓CNF)
-void CnfizeConjunction(const Variable& b, const Formula& f,
-                       vector<Formula>* clauses) {
-  // operands = {b₁, ..., bₙ}
-  const set<Formula>& operands{get_operands(f)};
-  // negated_operands = {¬b₁, ..., ¬bₙ}
-  const set<Formula>& negated_operands{
-      map(operands, [](const Formula& formula) { return !formula; })};
-  Formula ret{Formula::True()};
-  for (const Formula& b_i : operands) {
-    Add(!b || b_i, clauses);
-  }
-  Add(make_disjunction(negated_operands) || b, clauses);
+Formula TseitinCnfizer::VisitDisjunction(const Formula& f,
+                                         const bool polarity) {
+  return Define(f, polarity, "disj");
 }
 
-// Cnfize b ⇔ (b₁ ∨ ... ∨ bₙ) using the following equalities and add
-// to clauses:
-//   b ⇔ (b₁ ∨ ... ∨ bₙ)
-// = (b → (b₁ ∨ ... ∨ bₙ)) ∧ ((b₁ ∨ ... ∨ bₙ) → b)
-// = (¬b ∨ b₁ ∨ ... ∨ bₙ) ∧ ((¬b₁ ∧ ... ∧ ¬bₙ) ∨ b)
-// = (¬b ∨ b₁ ∨ ... ∨ bₙ) ∧ (¬b₁ ∨ b) ∧ ... ∧ (¬bₙ ∨ b)   (✓CNF)
-void CnfizeDisjunction(const Variable& b, const Formula& f,
-                       vector<Formula>* clauses) {
-  // negated_operands = {¬b₁, ..., ¬bₙ}
-  const set<Formula>& negated_operands{
-      map(get_operands(f), [](const Formula& formula) { return !formula; })};
-  Add(!b || f, clauses);  // (¬b ∨ b₁ ∨ ... ∨ bₙ)
-  for (const Formula& neg_b_i : negated_operands) {
-    Add(neg_b_i || b, clauses);
+Formula TseitinCnfizer::VisitNegation(const Formula& f, const bool polarity) {
+  const Formula& operand{get_operand(f)};
+  if (is_atomic(operand)) {
+    return f;
+  } else {
+    return Define(f, polarity, "neg");
   }
 }
-}  // namespace
 }  // namespace dreal
@@ -1,18 +1,39 @@
 #pragma once
 
 #include <map>
+#include <set>
 #include <unordered_map>
 #include <vector>
 
 #include "dreal/symbolic/symbolic.h"
 #include "dreal/util/naive_cnfizer.h"
+#include "dreal/util/scoped_unordered_map.h"
 
 namespace dreal {
 /// Transforms a symbolic formula @p f into an equi-satisfiable CNF
 /// formula by introducing extra Boolean variables (Tseitin transformation).
+///
+/// The Boolean variables of the subformulas are memoized across the
+/// calls of Convert. A subformula which is seen again reuses its variable
+/// and its clauses, which were returned by a previous call. The memo is
+/// scoped by Push and Pop, so that it can follow the scopes of the SAT
+/// solver which receives the clauses.
+///
+/// In the polarity-aware mode (Plaisted-Greenbaum transformation), a
+/// Boolean variable b for a subformula f only has the clauses of b → f
+/// (resp. f → b) if f occurs positively (resp. negatively). The other
+/// direction is added when f occurs with the other polarity later.
 class TseitinCnfizer {
  public:
+  /// Constructs a TseitinCnfizer. If @p polarity_aware is true, it uses
+  /// the Plaisted-Greenbaum transformation.
+  explicit TseitinCnfizer(bool polarity_aware = false);
+
   /// Convert @p f into an equi-satisfiable formula @c f' in CNF.
+  ///
+  /// @note @c f' is equi-satisfiable with @p f together with the clauses
+  /// returned by the previous calls in the open scopes, as it may refer to
+  /// the Boolean variables defined there.
   std::vector<Formula> Convert(const Formula& f);
 
   /// Returns a const reference of `map_` member.
@@ -21,21 +42,53 @@ class TseitinCnfizer {
   /// method.
   const std::map<Variable, Formula>& map() const { return map_; }
 
+  /// Opens a new scope of the memo.
+  void Push();
+
+  /// Forgets the Boolean variables and the clauses introduced in the
+  /// current scope.
+  void Pop();
+
  private:
-  Formula Visit(const Formula& f);
-  Formula VisitFalse(const Formula& f);
-  Formula VisitTrue(const Formula& f);
-  Formula VisitVariable(const Formula& f);
-  Formula VisitEqualTo(const Formula& f);
-  Formula VisitNotEqualTo(const Formula& f);
-  Formula VisitGreaterThan(const Formula& f);
-  Formula VisitGreaterThanOrEqualTo(const Formula& f);
-  Formula VisitLessThan(const Formula& f);
-  Formula VisitLessThanOrEqualTo(const Formula& f);
-  Formula VisitConjunction(const Formula& f);
-  Formula VisitDisjunction(const Formula& f);
-  Formula VisitNegation(const Formula& f);
-  Formula VisitForall(const Formula& f);
+  // The Boolean variable of a subformula, and the directions of its
+  // definition whose clauses are returned.
+  struct Definition {
+    Variable var;
+    bool positive{false};  // var → f
+    bool negative{false};  // f → var
+  };
+
+  // Adds the clauses of a top-level assertion @p f.
+  void AddAssertion(const Formula& f);
+
+  // Returns the Boolean variable for @p f, introducing one if needed. It
+  // adds the clauses of the directions required by @p polarity, unless
+  // they are added already.
+  Formula Define(const Formula& f, bool polarity, const char* prefix);
+
+  // Returns @p f whose operands are replaced by their literals, visiting
+  // them under @p polarity.
+  Formula Transform(const Formula& f, bool polarity);
+
+  // Returns the clauses of ∀y. φ(x, y) in CNF.
+  std::set<Formula> ForallClauses(const Formula& f) const;
+
+  Formula Visit(const Formula& f, bool polarity);
+  Formula VisitFalse(const Formula& f, bool polarity);
+  Formula VisitTrue(const Formula& f, bool polarity);
+  Formula VisitVariable(const Formula& f, bool polarity);
+  Formula VisitEqualTo(const Formula& f, bool polarity);
+  Formula VisitNotEqualTo(const Formula& f, bool polarity);
+  Formula VisitGreaterThan(const Formula& f, bool polarity);
+  Formula VisitGreaterThanOrEqualTo(const Formula& f, bool polarity);
+  Formula VisitLessThan(const Formula& f, bool polarity);
+  Formula VisitLessThanOrEqualTo(const Formula& f, bool polarity);
+  Formula VisitConjunction(const Formula& f, bool polarity);
+  Formula VisitDisjunction(const Formula& f, bool polarity);
+  Formula VisitNegation(const Formula& f, bool polarity);
+  Formula VisitForall(const Formula& f, bool polarity);
+
+  const bool polarity_aware_{false};
 
   // Maps a temporary variable, which is introduced by a Tseitin
   // transformation, to a corresponding Formula.
@@ -44,12 +97,19 @@ class TseitinCnfizer {
   // call.
   std::map<Variable, Formula> map_;
 
+  // Maps a subformula to its definition.
+  ScopedUnorderedMap<Formula, Definition> definitions_;
+
+  // The clauses produced by the current call of Convert.
+  std::vector<Formula> clauses_;
+
   // To transform nested formulas inside of universal quantifications.
   const NaiveCnfizer naive_cnfizer_{};
 
   // Makes VisitFormula a friend of this class so that it can use private
   // operator()s.
-  friend Formula drake::symbolic::VisitFormula<Formula, TseitinCnfizer>(
-      TseitinCnfizer*, const Formula&);
+  friend Formula drake::symbolic::VisitFormula<Formula>(TseitinCnfizer*,
+                                                        const Formula&,
+                                                        const bool&);
 };
 }  // namespace dreal
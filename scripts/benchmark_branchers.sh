@@ -0,0 +1,60 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+# Runs dReal with each branching heuristic (--brancher) over the smt2
+# benchmarks and reports, per heuristic, the number of benchmarks whose
+# result (the first line of the output) matches the expected one and the
+# total time spent on them.
+
+display_usage() {
+    echo "usage: $0 [dreal_binary] [timeout_in_seconds]"
+    echo "  default: bazel-bin/dreal/dreal 60"
+}
+
+if [ $# -gt 2 ]
+then
+    display_usage
+    exit 1
+fi
+
+SCRIPT_PATH="`dirname \"$0\"`"
+ROOT_PATH="${SCRIPT_PATH}/.."
+DREAL=${1:-"${ROOT_PATH}/bazel-bin/dreal/dreal"}
+TIMEOUT=${2:-60}
+BRANCHERS="largest-first smear round-robin max-impact hybrid"
+
+printf "%-15s %8s %8s %8s %12s\n" "brancher" "solved" "wrong" "timeout" "time (s)"
+for BRANCHER in ${BRANCHERS}
+do
+    SOLVED=0
+    WRONG=0
+    TIMEDOUT=0
+    TOTAL_NS=0
+    for SMT2 in "${ROOT_PATH}"/dreal/test/smt2/*.smt2
+    do
+        EXPECTED="${SMT2}.expected"
+        if [ ! -f "${EXPECTED}" ]
+        then
+            continue
+        fi
+        START_NS=`date +%s%N`
+        if OUTPUT=`timeout "${TIMEOUT}" "${DREAL}" --brancher "${BRANCHER}" "${SMT2}" 2>/dev/null`
+        then
+            if [ "`echo \"${OUTPUT}\" | head -n 1`" == "`head -n 1 \"${EXPECTED}\"`" ]
+            then
+                SOLVED=$((SOLVED + 1))
+            else
+                WRONG=$((WRONG + 1))
+            fi
+        elif [ $? -eq 124 ]
+        then
+            TIMEDOUT=$((TIMEDOUT + 1))
+        else
+            WRONG=$((WRONG + 1))
+        fi
+        TOTAL_NS=$((TOTAL_NS + `date +%s%N` - START_NS))
+    done
+    TOTAL_MS=$((TOTAL_NS / 1000000))
+    printf "%-15s %8d %8d %8d %8d.%03d\n" "${BRANCHER}" "${SOLVED}" \
+           "${WRONG}" "${TIMEDOUT}" $((TOTAL_MS / 1000)) $((TOTAL_MS % 1000))
+done
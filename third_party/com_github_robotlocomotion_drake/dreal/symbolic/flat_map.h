@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "dreal/symbolic/hash.h"
+
+namespace dreal {
+namespace drake {
+
+/** Tag type to indicate that a vector is already sorted and has unique keys.
+ */
+struct sorted_unique_t {};
+constexpr sorted_unique_t sorted_unique{};
+
+/** Associative container which stores its elements in a vector sorted by keys.
+ *
+ * Compared to std::map, it does not allocate a node per element and its
+ * iteration is cache-friendly. It is immutable once constructed except via
+ * `release()`, which is used to build another flat_map from this one. To
+ * build a flat_map with many elements, collect the elements in a vector, sort
+ * them once, and use the constructor taking `sorted_unique`.
+ */
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class flat_map {
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<Key, Value>;
+  using container_type = std::vector<value_type>;
+  using size_type = std::size_t;
+  using const_iterator = typename container_type::const_iterator;
+  using iterator = const_iterator;
+
+  flat_map() = default;
+
+  /** Constructs from @p elements which are sorted by keys and have unique
+   * keys. */
+  flat_map(sorted_unique_t, container_type elements)
+      : elements_{std::move(elements)} {}
+
+  /** Constructs from @p elements. If there are elements with equal keys, only
+   * the first one is kept. */
+  flat_map(std::initializer_list<value_type> elements) : elements_{elements} {
+    std::stable_sort(elements_.begin(), elements_.end(), value_compare{});
+    elements_.erase(std::unique(elements_.begin(), elements_.end(),
+                                [](const value_type& a, const value_type& b) {
+                                  return !Compare{}(a.first, b.first) &&
+                                         !Compare{}(b.first, a.first);
+                                }),
+                    elements_.end());
+  }
+
+  const_iterator begin() const { return elements_.cbegin(); }
+  const_iterator end() const { return elements_.cend(); }
+  const_iterator cbegin() const { return elements_.cbegin(); }
+  const_iterator cend() const { return elements_.cend(); }
+
+  bool empty() const { return elements_.empty(); }
+  size_type size() const { return elements_.size(); }
+
+  /** Returns an iterator to the element with key @p key, or end() if there is
+   * no such element. */
+  const_iterator find(const Key& key) const {
+    const auto it = std::lower_bound(elements_.cbegin(), elements_.cend(), key,
+                                     [](const value_type& p, const Key& k) {
+                                       return Compare{}(p.first, k);
+                                     });
+    if (it != elements_.cend() && !Compare{}(key, it->first)) {
+      return it;
+    }
+    return elements_.cend();
+  }
+
+  /** Returns the number of elements with key @p key (0 or 1). */
+  size_type count(const Key& key) const { return find(key) != end() ? 1 : 0; }
+
+  /** Returns the value of the element with key @p key.
+   * @throws std::out_of_range if there is no such element. */
+  const Value& at(const Key& key) const {
+    const auto it = find(key);
+    if (it == end()) {
+      throw std::out_of_range("flat_map::at");
+    }
+    return it->second;
+  }
+
+  /** Moves out the underlying sorted vector, leaving this empty. */
+  container_type release() {
+    container_type ret{std::move(elements_)};
+    elements_.clear();
+    return ret;
+  }
+
+  /** Compares values by their keys. */
+  struct value_compare {
+    bool operator()(const value_type& a, const value_type& b) const {
+      return Compare{}(a.first, b.first);
+    }
+  };
+
+ private:
+  container_type elements_;
+};
+
+/** Computes the hash value of a flat_map @p map. It is the same as the one of
+ * std::map with the same elements. */
+template <class T1, class T2, class C>
+struct hash_value<flat_map<T1, T2, C>> {
+  size_t operator()(const flat_map<T1, T2, C>& map) const {
+    return hash_range(map.begin(), map.end());
+  }
+};
+
+}  // namespace drake
+}  // namespace dreal
@@ -0,0 +1,118 @@
+#include "dreal/symbolic/symbolic_arena.h"
+
+#include <atomic>
+#include <cassert>
+#include <new>
+
+namespace dreal {
+namespace drake {
+namespace symbolic {
+
+using std::max_align_t;
+using std::size_t;
+
+namespace {
+// Every block handed out by SymbolicArena::Allocate is preceded by a header
+// which records the chunk that the block belongs to (nullptr if it is
+// allocated from the global heap). The header keeps the blocks max-aligned.
+constexpr size_t kHeaderSize{alignof(max_align_t)};
+static_assert(kHeaderSize >= sizeof(void*), "A header should fit a pointer.");
+
+// Rounds up @p n to a multiple of kHeaderSize.
+size_t RoundUp(const size_t n) {
+  return (n + kHeaderSize - 1) / kHeaderSize * kHeaderSize;
+}
+
+// The arena entered by the current thread.
+thread_local SymbolicArena* current_arena{nullptr};
+}  // namespace
+
+struct SymbolicArena::Chunk {
+  // Allocates a chunk with @p capacity bytes of storage.
+  static Chunk* New(const size_t capacity) {
+    void* const p{::operator new(RoundUp(sizeof(Chunk)) + capacity)};
+    return new (p) Chunk{};
+  }
+
+  // Returns the beginning of the storage.
+  char* data() {
+    return reinterpret_cast<char*>(this) + RoundUp(sizeof(Chunk));
+  }
+
+  // Drops a reference, and releases this chunk if it was the last one.
+  void Unref() {
+    if (refs.fetch_sub(1U, std::memory_order_acq_rel) == 1U) {
+      this->~Chunk();
+      ::operator delete(this);
+    }
+  }
+
+  // The number of live cells in this chunk plus one for the arena which owns
+  // it. Cells can be deleted by any thread.
+  std::atomic<size_t> refs{1U};
+};
+
+SymbolicArena::Scope::Scope(SymbolicArena* const arena)
+    : previous_{current_arena} {
+  current_arena = arena;
+}
+
+SymbolicArena::Scope::~Scope() { current_arena = previous_; }
+
+SymbolicArena::SymbolicArena(const size_t chunk_size)
+    : chunk_size_{RoundUp(chunk_size)} {}
+
+SymbolicArena::~SymbolicArena() {
+  assert(current_arena != this);
+  for (Chunk* const chunk : chunks_) {
+    chunk->Unref();
+  }
+}
+
+SymbolicArena* SymbolicArena::current() { return current_arena; }
+
+void* SymbolicArena::Allocate(const size_t size) {
+  SymbolicArena* const arena{current_arena};
+  // Large blocks would waste the rest of a chunk. They go to the heap.
+  if (arena != nullptr &&
+      kHeaderSize + RoundUp(size) <= arena->chunk_size_ / 4) {
+    return arena->AllocateInChunk(size);
+  }
+  char* const block{static_cast<char*>(::operator new(kHeaderSize + size))};
+  *reinterpret_cast<Chunk**>(block) = nullptr;
+  return block + kHeaderSize;
+}
+
+void SymbolicArena::Deallocate(void* const p) {
+  if (p == nullptr) {
+    return;
+  }
+  char* const block{static_cast<char*>(p) - kHeaderSize};
+  Chunk* const chunk{*reinterpret_cast<Chunk**>(block)};
+  if (chunk == nullptr) {
+    ::operator delete(block);
+  } else {
+    chunk->Unref();
+  }
+}
+
+void* SymbolicArena::AllocateInChunk(const size_t size) {
+  const size_t block_size{kHeaderSize + RoundUp(size)};
+  if (static_cast<size_t>(end_ - next_) < block_size) {
+    Chunk* const chunk{Chunk::New(chunk_size_)};
+    chunks_.push_back(chunk);
+    next_ = chunk->data();
+    end_ = next_ + chunk_size_;
+  }
+  Chunk* const chunk{chunks_.back()};
+  chunk->refs.fetch_add(1U, std::memory_order_relaxed);
+  char* const block{next_};
+  next_ += block_size;
+  ++num_allocations_;
+  *reinterpret_cast<Chunk**>(block) = chunk;
+  return block + kHeaderSize;
+}
+
+}  // namespace symbolic
+}  // namespace drake
+}  // namespace dreal
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace dreal {
+namespace drake {
+namespace symbolic {
+
+/** Represents a region allocator for expression and formula cells.
+ *
+ * While an arena is entered by a thread (see SymbolicArena::Scope), the cells
+ * created by the thread are placed contiguously in large chunks owned by the
+ * arena instead of being allocated one by one from the global heap. Deleting
+ * such a cell does not call the allocator; the memory of a chunk is returned
+ * to the heap in bulk once the arena is destroyed.
+ *
+ * It is safe for cells to escape the arena, that is, to outlive it (for
+ * example, when a formula built inside of an arena is stored in a global
+ * variable or shared with another thread via hash-consing). Each chunk counts
+ * the live cells in it, and a chunk which still has live cells when the arena
+ * is destroyed is kept until its last cell is deleted. Note that a single
+ * escaped cell keeps its whole chunk alive.
+ *
+ * An arena can be entered by at most one thread at a time. Cells created by
+ * other threads, or created when no arena is entered, are allocated from the
+ * global heap as usual.
+ *
+ * Example:
+ * @code
+ * SymbolicArena arena;
+ * {
+ *   SymbolicArena::Scope scope{&arena};
+ *   // Cells built here are allocated in `arena`.
+ * }
+ * // The chunks of `arena` are released when it goes out of scope.
+ * @endcode
+ */
+class SymbolicArena {
+ public:
+  /** Activates an arena in the current thread for the lifetime of this
+   * object. Scopes can be nested; the innermost one is used. If @p arena is
+   * nullptr, the cells are allocated from the global heap in this scope. */
+  class Scope {
+   public:
+    explicit Scope(SymbolicArena* arena);
+    Scope(const Scope&) = delete;
+    Scope(Scope&&) = delete;
+    Scope& operator=(const Scope&) = delete;
+    Scope& operator=(Scope&&) = delete;
+    ~Scope();
+
+   private:
+    SymbolicArena* const previous_;
+  };
+
+  /** Default size of a chunk in bytes. */
+  static constexpr std::size_t kDefaultChunkSize{64 * 1024};
+
+  /** Constructs an arena which allocates chunks of @p chunk_size bytes. */
+  explicit SymbolicArena(std::size_t chunk_size = kDefaultChunkSize);
+  SymbolicArena(const SymbolicArena&) = delete;
+  SymbolicArena(SymbolicArena&&) = delete;
+  SymbolicArena& operator=(const SymbolicArena&) = delete;
+  SymbolicArena& operator=(SymbolicArena&&) = delete;
+
+  /** Releases the chunks. Chunks which have escaped cells are released
+   * later, when their last cells are deleted.
+   * @pre This arena is not entered. */
+  ~SymbolicArena();
+
+  /** Returns the number of chunks allocated by this arena. */
+  std::size_t num_chunks() const { return chunks_.size(); }
+
+  /** Returns the number of cells allocated in this arena. */
+  std::size_t num_allocations() const { return num_allocations_; }
+
+  /** Returns the arena entered by the current thread, or nullptr. */
+  static SymbolicArena* current();
+
+  /** Allocates @p size bytes for a cell. It uses the current arena if any.
+   * Otherwise, it uses the global heap. */
+  static void* Allocate(std::size_t size);
+
+  /** Deallocates @p p which is returned by Allocate. */
+  static void Deallocate(void* p);
+
+ private:
+  struct Chunk;
+
+  void* AllocateInChunk(std::size_t size);
+
+  const std::size_t chunk_size_;
+  std::vector<Chunk*> chunks_;
+  // Current bump pointer and its end in the last chunk.
+  char* next_{nullptr};
+  char* end_{nullptr};
+  std::size_t num_allocations_{0};
+};
+
+}  // namespace symbolic
+}  // namespace drake
+}  // namespace dreal
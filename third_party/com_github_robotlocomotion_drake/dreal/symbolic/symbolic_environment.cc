@@ -1,5 +1,6 @@
 #include "dreal/symbolic/symbolic_environment.h"
 
+#include <algorithm>
 #include <cmath>
 #include <initializer_list>
 #include <iostream>
@@ -13,6 +14,7 @@ namespace drake {
 namespace symbolic {
 
 using std::endl;
+using std::lower_bound;
 using std::initializer_list;
 using std::ostream;
 using std::ostringstream;
@@ -111,6 +113,91 @@ ostream& operator<<(ostream& os, const Environment& env) {
   }
   return os;
 }
+
+namespace {
+// The dense table of IndexedEnvironment is used if it has at most
+// kDenseFactor * n + kDenseSlack entries where n is the number of variables.
+constexpr size_t kDenseFactor{4};
+constexpr size_t kDenseSlack{64};
+}  // namespace
+
+IndexedEnvironment::IndexedEnvironment(const Variables& variables)
+    : variables_(variables.begin(), variables.end()),
+      values_(variables_.size(), 0.0) {
+  for (const Variable& var : variables_) {
+    throw_if_dummy(var);
+  }
+  if (variables_.empty()) {
+    return;
+  }
+  min_id_ = variables_.front().get_id();
+  const size_t span{variables_.back().get_id() - min_id_ + 1};
+  if (span <= kDenseFactor * variables_.size() + kDenseSlack) {
+    dense_ = true;
+    slots_.assign(span, -1);
+    for (size_t i = 0; i < variables_.size(); ++i) {
+      slots_[variables_[i].get_id() - min_id_] = static_cast<int>(i);
+    }
+  }
+}
+
+int IndexedEnvironment::FindSlot(const Variable::Id id) const {
+  const auto it = lower_bound(variables_.begin(), variables_.end(), id,
+                              [](const Variable& var, const Variable::Id v) {
+                                return var.get_id() < v;
+                              });
+  if (it != variables_.end() && it->get_id() == id) {
+    return static_cast<int>(it - variables_.begin());
+  }
+  return -1;
+}
+
+double& IndexedEnvironment::operator[](const Variable& var) {
+  const int i{slot(var)};
+  if (i == -1) {
+    ostringstream oss;
+    oss << "IndexedEnvironment::operator[] is called with an unbound variable "
+        << var << ".";
+    throw runtime_error(oss.str());
+  }
+  return values_[i];
+}
+
+const double& IndexedEnvironment::operator[](const Variable& var) const {
+  const int i{slot(var)};
+  if (i == -1) {
+    ostringstream oss;
+    oss << "IndexedEnvironment::operator[] is called with an unbound variable "
+        << var << ".";
+    throw runtime_error(oss.str());
+  }
+  return values_[i];
+}
+
+void IndexedEnvironment::Update(const Environment& env) {
+  if (env.size() < variables_.size()) {
+    for (const auto& p : env) {
+      const int i{slot(p.first)};
+      if (i != -1) {
+        values_[i] = p.second;
+      }
+    }
+  } else {
+    for (size_t i = 0; i < variables_.size(); ++i) {
+      const auto it = env.find(variables_[i]);
+      if (it != env.end()) {
+        values_[i] = it->second;
+      }
+    }
+  }
+}
+
+ostream& operator<<(ostream& os, const IndexedEnvironment& env) {
+  for (int i = 0; i < env.size(); ++i) {
+    os << env.variables_[i] << " -> " << env.values_[i] << endl;
+  }
+  return os;
+}
 }  // namespace symbolic
 }  // namespace drake
 }  // namespace dreal
@@ -4,6 +4,7 @@
 #include <ostream>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "dreal/symbolic/symbolic_variable.h"
 #include "dreal/symbolic/symbolic_variables.h"
@@ -128,6 +129,108 @@ class Environment {
  private:
   map map_;
 };
+
+/** Represents an environment whose variables are bound to slots.
+ *
+ * Evaluating an expression under an Environment looks up a hash table at every
+ * occurrence of a variable. When the same expression is evaluated many times
+ * with only the values changing (for example, in sampling or in the callbacks
+ * of a local optimizer), it is faster to bind the variables of the expression
+ * to slots once and to update the values in place:
+ *
+ * \code{.cpp}
+ *   const Expression e{x * sin(y) + y};
+ *   IndexedEnvironment env{e.GetVariables()};
+ *   const int slot_x{env.slot(var_x)};
+ *   const int slot_y{env.slot(var_y)};
+ *   for (...) {
+ *     env[slot_x] = ...;
+ *     env[slot_y] = ...;
+ *     const double v{e.Evaluate(env)};
+ *   }
+ * \endcode
+ *
+ * The values are stored in a contiguous array in the order of the variables
+ * (that is, sorted by their IDs), so they can also be written via data(). The
+ * slot of a variable is found in a dense table indexed by variable IDs if the
+ * IDs are close to each other, or by binary search otherwise.
+ *
+ * Unlike Environment, the set of variables is fixed at construction and every
+ * variable always has a value (0.0 initially).
+ */
+class IndexedEnvironment {
+ public:
+  /** Constructs an empty environment. */
+  IndexedEnvironment() = default;
+
+  /** Constructs an environment which binds @p variables to slots
+   * 0, ..., variables.size() - 1, in order. The values are initialized with
+   * 0.0.
+   *
+   * @throws std::runtime_error if @p variables includes a dummy variable. */
+  explicit IndexedEnvironment(const Variables& variables);
+
+  /** Returns the variables. The i-th slot holds the value of the i-th
+   * variable. */
+  const std::vector<Variable>& variables() const { return variables_; }
+
+  /** Checks whether the environment is empty. */
+  bool empty() const { return variables_.empty(); }
+  /** Returns the number of slots. */
+  int size() const { return static_cast<int>(variables_.size()); }
+
+  /** Returns the slot of @p var, or -1 if @p var is not bound. */
+  int slot(const Variable& var) const {
+    const Variable::Id id{var.get_id()};
+    if (dense_) {
+      return id >= min_id_ && id - min_id_ < slots_.size()
+                 ? slots_[id - min_id_]
+                 : -1;
+    }
+    return FindSlot(id);
+  }
+
+  /** Checks whether @p var is bound. */
+  bool has_variable(const Variable& var) const { return slot(var) != -1; }
+
+  /** Returns a reference to the value in the slot @p i. */
+  double& operator[](const int i) { return values_[i]; }
+  /** Returns a const reference to the value in the slot @p i. */
+  const double& operator[](const int i) const { return values_[i]; }
+
+  /** Returns a reference to the value of @p var.
+   * @throws std::runtime_error if @p var is not bound. */
+  double& operator[](const Variable& var);
+  /** Returns a const reference to the value of @p var.
+   * @throws std::runtime_error if @p var is not bound. */
+  const double& operator[](const Variable& var) const;
+
+  /** Returns a pointer to the array of values. */
+  double* data() { return values_.data(); }
+  /** Returns a const pointer to the array of values. */
+  const double* data() const { return values_.data(); }
+
+  /** Copies the values of the variables in @p env which are bound in this
+   * environment. The other slots are unchanged. */
+  void Update(const Environment& env);
+
+  friend std::ostream& operator<<(std::ostream& os,
+                                  const IndexedEnvironment& env);
+
+ private:
+  // Returns the slot of a variable whose ID is @p id by binary search.
+  int FindSlot(Variable::Id id) const;
+
+  // Sorted by IDs.
+  std::vector<Variable> variables_;
+  std::vector<double> values_;
+
+  // If dense_ is true, slots_[id - min_id_] is the slot of the variable whose
+  // ID is id, or -1. Otherwise, FindSlot is used.
+  bool dense_{false};
+  Variable::Id min_id_{0};
+  std::vector<int> slots_;
+};
 }  // namespace symbolic
 }  // namespace drake
 }  // namespace dreal
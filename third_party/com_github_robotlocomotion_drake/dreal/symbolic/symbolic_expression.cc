@@ -4,7 +4,6 @@
 #include <cassert>
 #include <cmath>
 #include <cstddef>
-#include <map>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
@@ -21,7 +20,6 @@ namespace dreal {
 namespace drake {
 namespace symbolic {
 
-using std::map;
 using std::ostream;
 using std::ostringstream;
 using std::pair;
@@ -134,7 +132,12 @@ Expression::Expression(const double d) : Expression{make_cell(d)} {}
 
 Expression::Expression(ExpressionCell* ptr) : ptr_{ptr} {
   assert(ptr_ != nullptr);
-  ptr_->increase_rc();
+  if (ptr_->use_count() == 0) {
+    // A fresh cell. Shares the structurally equal one if it exists.
+    ptr_ = InternTable<ExpressionCell>::GetInstance().Intern(ptr_);
+  } else {
+    ptr_->increase_rc();
+  }
 }
 
 ExpressionKind Expression::get_kind() const {
@@ -179,18 +182,9 @@ const Variables& Expression::GetVariables() const {
 bool Expression::EqualTo(const Expression& e) const {
   assert(ptr_ != nullptr);
   assert(e.ptr_ != nullptr);
-  if (ptr_ == e.ptr_) {
-    return true;
-  }
-  if (get_kind() != e.get_kind()) {
-    return false;
-  }
-  if (get_hash() != e.get_hash()) {
-    return false;
-  }
-  // Same kind/hash, but it could be the result of hash collision,
-  // check structural equality.
-  return ptr_->EqualTo(*(e.ptr_));
+  // Cells are hash-consed (see InternTable). Two expressions are
+  // structurally equal if and only if they share the same cell.
+  return ptr_ == e.ptr_;
 }
 
 bool Expression::Less(const Expression& e) const {
@@ -226,6 +220,11 @@ double Expression::Evaluate(const Environment& env) const {
   return ptr_->Evaluate(env);
 }
 
+double Expression::Evaluate(const IndexedEnvironment& env) const {
+  assert(ptr_ != nullptr);
+  return ptr_->Evaluate(env);
+}
+
 Expression Expression::EvaluatePartial(const Environment& env) const {
   if (env.empty()) {
     return *this;
@@ -332,7 +331,7 @@ Expression& operator+=(Expression& lhs, const Expression& rhs) {
   // ExpressionAddFactory which holds intermediate terms and does
   // simplifications internally.
   if (is_addition(lhs)) {
-    if (lhs.ptr_->use_count() == 1) {
+    if (InternTable<ExpressionCell>::GetInstance().Detach(lhs.ptr_)) {
       return lhs =
                  ExpressionAddFactory{
                      get_constant_in_addition(lhs),
@@ -414,13 +413,12 @@ Expression operator-(const Expression& e) {
 }
 
 Expression operator-(Expression&& e) {
-  if (e.ptr_->use_count() == 1) {
+  if ((is_addition(e) || is_multiplication(e)) &&
+      InternTable<ExpressionCell>::GetInstance().Detach(e.ptr_)) {
     if (is_addition(e)) {
       return NegateAddition(to_addition(e));
     }
-    if (is_multiplication(e)) {
-      return NegateMultiplication(to_multiplication(e));
-    }
+    return NegateMultiplication(to_multiplication(e));
   }
   return -e;
 }
@@ -565,7 +563,7 @@ Expression& operator*=(Expression& lhs, const Expression& rhs) {
   ExpressionMulFactory mul_factory{};
   if (is_multiplication(lhs)) {
     // (e_1 * ... * e_n) * rhs
-    if (lhs.ptr_->use_count() == 1) {
+    if (InternTable<ExpressionCell>::GetInstance().Detach(lhs.ptr_)) {
       return lhs =
                  ExpressionMulFactory{
                      get_constant_in_multiplication(lhs),
@@ -644,22 +642,14 @@ Expression Sum(const std::vector<Expression>& expressions) {
   if (expressions.empty()) {
     return Expression::Zero();
   }
-  ExpressionAddFactory f;
-  for (const Expression& e : expressions) {
-    f.AddExpression(e);
-  }
-  return f.GetExpression();
+  return ExpressionAddFactory{}.AddExpressions(expressions).GetExpression();
 }
 
 Expression Prod(const std::vector<Expression>& expressions) {
   if (expressions.empty()) {
     return Expression::One();
   }
-  ExpressionMulFactory f;
-  for (const Expression& e : expressions) {
-    f.AddExpression(e);
-  }
-  return f.GetExpression();
+  return ExpressionMulFactory{}.AddExpressions(expressions).GetExpression();
 }
 
 Expression real_constant(const double lb, const double ub,
@@ -864,14 +854,14 @@ const Expression& get_second_argument(const Expression& e) {
 double get_constant_in_addition(const Expression& e) {
   return to_addition(e)->get_constant();
 }
-const map<Expression, double>& get_expr_to_coeff_map_in_addition(
+const ExpressionToCoeffMap& get_expr_to_coeff_map_in_addition(
     const Expression& e) {
   return to_addition(e)->get_expr_to_coeff_map();
 }
 double get_constant_in_multiplication(const Expression& e) {
   return to_multiplication(e)->get_constant();
 }
-const map<Expression, Expression>& get_base_to_exponent_map_in_multiplication(
+const BaseToExponentMap& get_base_to_exponent_map_in_multiplication(
     const Expression& e) {
   return to_multiplication(e)->get_base_to_exponent_map();
 }
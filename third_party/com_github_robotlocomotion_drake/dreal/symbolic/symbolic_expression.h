@@ -12,6 +12,7 @@
 #include <utility>
 #include <vector>
 
+#include "dreal/symbolic/flat_map.h"
 #include "dreal/symbolic/hash.h"
 #include "dreal/symbolic/symbolic_environment.h"
 #include "dreal/symbolic/symbolic_variable.h"
@@ -233,6 +234,15 @@ class Expression {
    */
   double Evaluate(const Environment& env = Environment{}) const;
 
+  /** Evaluates under a given indexed environment @p env. It is faster than
+   * the above when the same expression is evaluated many times, since it does
+   * not hash the variables.
+   *
+   * @throws std::runtime_error if a variable in this expression is not bound in
+   * @p env or if NaN is detected during evaluation.
+   */
+  double Evaluate(const IndexedEnvironment& env) const;
+
   /** Partially evaluates this expression using an environment @p
    * env. Internally, this method promotes @p env into a substitution
    * (Variable → Expression) and call Evaluate::Substitute with it.
@@ -493,6 +503,14 @@ class Expression {
   ExpressionCell* ptr_{nullptr};
 };
 
+/** Represents the terms of an addition, a map from a term to its
+ * coefficient. It is sorted by terms. */
+using ExpressionToCoeffMap = flat_map<Expression, double>;
+
+/** Represents the factors of a multiplication, a map from a base to its
+ * exponent. It is sorted by bases. */
+using BaseToExponentMap = flat_map<Expression, Expression>;
+
 Expression operator+(const Expression& lhs, const Expression& rhs);
 Expression operator+(const Expression& lhs, Expression&& rhs);
 Expression operator+(Expression&& lhs, const Expression& rhs);
@@ -668,7 +686,7 @@ double get_constant_in_addition(const Expression& e);
  *  maps 'x' to 2 and 'y' to 3.
  *  @pre @p e is an addition expression.
  */
-const std::map<Expression, double>& get_expr_to_coeff_map_in_addition(
+const ExpressionToCoeffMap& get_expr_to_coeff_map_in_addition(
     const Expression& e);
 /** Returns the constant part of the multiplication expression @p e. For
  *  instance, given 7 * x^2 * y^3, it returns 7.
@@ -680,8 +698,8 @@ double get_constant_in_multiplication(const Expression& e);
  * return value maps 'x' to 2, 'y' to 3, and 'z' to 'x'.
  *  @pre @p e is a multiplication expression.
  */
-const std::map<Expression, Expression>&
-get_base_to_exponent_map_in_multiplication(const Expression& e);
+const BaseToExponentMap& get_base_to_exponent_map_in_multiplication(
+    const Expression& e);
 
 /** Returns the conditional formula in the if-then-else expression @p e.
  * @pre @p e is an if-then-else expression.
@@ -6,13 +6,13 @@
 #include <functional>
 #include <iomanip>
 #include <limits>
-#include <map>
 #include <numeric>
 #include <ostream>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "dreal/symbolic/hash.h"
 #include "dreal/symbolic/symbolic_environment.h"
@@ -31,15 +31,17 @@ using std::domain_error;
 using std::endl;
 using std::equal;
 using std::hash;
+using std::inplace_merge;
 using std::lexicographical_compare;
-using std::map;
 using std::numeric_limits;
 using std::ostream;
 using std::ostringstream;
 using std::pair;
 using std::runtime_error;
 using std::setprecision;
+using std::stable_sort;
 using std::string;
+using std::vector;
 
 namespace {
 bool is_integer(const double v) {
@@ -60,20 +62,18 @@ bool is_non_negative_integer(const double v) {
 // Determines if the summation represented by term_to_coeff_map is
 // polynomial-convertible or not. This function is used in the
 // constructor of ExpressionAdd.
-bool determine_polynomial(
-    const std::map<Expression, double>& term_to_coeff_map) {
+bool determine_polynomial(const ExpressionToCoeffMap& term_to_coeff_map) {
   return all_of(term_to_coeff_map.begin(), term_to_coeff_map.end(),
-                [](const pair<const Expression, double>& p) {
+                [](const pair<Expression, double>& p) {
                   return p.first.is_polynomial();
                 });
 }
 
 // Determines if the summation represented by term_to_coeff_map includes an ITE
 // expression or not. This function is used in the constructor of ExpressionAdd.
-bool determine_include_ite(
-    const std::map<Expression, double>& term_to_coeff_map) {
+bool determine_include_ite(const ExpressionToCoeffMap& term_to_coeff_map) {
   return any_of(term_to_coeff_map.begin(), term_to_coeff_map.end(),
-                [](const pair<const Expression, double>& p) {
+                [](const pair<Expression, double>& p) {
                   return p.first.include_ite();
                 });
 }
@@ -81,10 +81,9 @@ bool determine_include_ite(
 // Determines if the product represented by term_to_coeff_map is
 // polynomial-convertible or not. This function is used in the
 // constructor of ExpressionMul.
-bool determine_polynomial(
-    const std::map<Expression, Expression>& base_to_exponent_map) {
+bool determine_polynomial(const BaseToExponentMap& base_to_exponent_map) {
   return all_of(base_to_exponent_map.begin(), base_to_exponent_map.end(),
-                [](const pair<const Expression, Expression>& p) {
+                [](const pair<Expression, Expression>& p) {
                   // For each base^exponent, it has to satisfy the following
                   // conditions:
                   //     - base is polynomial-convertible.
@@ -102,10 +101,9 @@ bool determine_polynomial(
 // Determines if the product represented by term_to_coeff_map includes
 // an ITE expression or not. This function is used in the constructor
 // of ExpressionMul.
-bool determine_include_ite(
-    const std::map<Expression, Expression>& base_to_exponent_map) {
+bool determine_include_ite(const BaseToExponentMap& base_to_exponent_map) {
   return any_of(base_to_exponent_map.begin(), base_to_exponent_map.end(),
-                [](const pair<const Expression, Expression>& p) {
+                [](const pair<Expression, Expression>& p) {
                   const Expression& base{p.first};
                   const Expression& exponent{p.second};
                   return base.include_ite() || exponent.include_ite();
@@ -273,6 +271,11 @@ double UnaryExpressionCell::Evaluate(const Environment& env) const {
   return DoEvaluate(v);
 }
 
+double UnaryExpressionCell::Evaluate(const IndexedEnvironment& env) const {
+  const double v{e_.Evaluate(env)};
+  return DoEvaluate(v);
+}
+
 BinaryExpressionCell::BinaryExpressionCell(const ExpressionKind k,
                                            const Expression& e1,
                                            const Expression& e2,
@@ -310,6 +313,12 @@ double BinaryExpressionCell::Evaluate(const Environment& env) const {
   return DoEvaluate(v1, v2);
 }
 
+double BinaryExpressionCell::Evaluate(const IndexedEnvironment& env) const {
+  const double v1{e1_.Evaluate(env)};
+  const double v2{e2_.Evaluate(env)};
+  return DoEvaluate(v1, v2);
+}
+
 ExpressionVar::ExpressionVar(const Variable& v)
     : ExpressionCell{ExpressionKind::Var,
                      hash_value<Variable>{}(v),
@@ -361,6 +370,20 @@ double ExpressionVar::Evaluate(const Environment& env) const {
   throw runtime_error(oss.str());
 }
 
+double ExpressionVar::Evaluate(const IndexedEnvironment& env) const {
+  const int slot{env.slot(var_)};
+  if (slot != -1) {
+    assert(!std::isnan(env[slot]));
+    return env[slot];
+  }
+  ostringstream oss;
+  oss << "The following environment does not have an entry for the "
+         "variable "
+      << var_ << endl;
+  oss << env << endl;
+  throw runtime_error(oss.str());
+}
+
 Expression ExpressionVar::Expand() { return GetExpression(); }
 
 Expression ExpressionVar::Substitute(const ExpressionSubstitution& expr_subst,
@@ -405,6 +428,11 @@ double ExpressionConstant::Evaluate(const Environment&) const {
   return v_;
 }
 
+double ExpressionConstant::Evaluate(const IndexedEnvironment&) const {
+  assert(!std::isnan(v_));
+  return v_;
+}
+
 Expression ExpressionConstant::Expand() { return GetExpression(); }
 
 Expression ExpressionConstant::Substitute(const ExpressionSubstitution&,
@@ -455,6 +483,10 @@ double ExpressionRealConstant::Evaluate(const Environment&) const {
   return get_value();
 }
 
+double ExpressionRealConstant::Evaluate(const IndexedEnvironment&) const {
+  return get_value();
+}
+
 Expression ExpressionRealConstant::Expand() { return GetExpression(); }
 
 Expression ExpressionRealConstant::Substitute(const ExpressionSubstitution&,
@@ -496,6 +528,10 @@ double ExpressionNaN::Evaluate(const Environment&) const {
   throw runtime_error("NaN is detected during Symbolic computation.");
 }
 
+double ExpressionNaN::Evaluate(const IndexedEnvironment&) const {
+  throw runtime_error("NaN is detected during Symbolic computation.");
+}
+
 Expression ExpressionNaN::Expand() {
   throw runtime_error("NaN is detected during expansion.");
 }
@@ -512,7 +548,7 @@ Expression ExpressionNaN::Differentiate(const Variable&) const {
 ostream& ExpressionNaN::Display(ostream& os) const { return os << "NaN"; }
 
 ExpressionAdd::ExpressionAdd(const double constant,
-                             map<Expression, double> expr_to_coeff_map)
+                             ExpressionToCoeffMap expr_to_coeff_map)
     : ExpressionCell{ExpressionKind::Add,
                      hash_combine(hash<double>{}(constant), expr_to_coeff_map),
                      determine_polynomial(expr_to_coeff_map),
@@ -524,7 +560,7 @@ ExpressionAdd::ExpressionAdd(const double constant,
 }
 
 Variables ExpressionAdd::ExtractVariables(
-    const std::map<Expression, double>& expr_to_coeff_map) {
+    const ExpressionToCoeffMap& expr_to_coeff_map) {
   Variables ret{};
   for (const auto& p : expr_to_coeff_map) {
     ret.insert(p.first.GetVariables());
@@ -543,8 +579,8 @@ bool ExpressionAdd::EqualTo(const ExpressionCell& e) const {
   return equal(expr_to_coeff_map_.cbegin(), expr_to_coeff_map_.cend(),
                add_e.expr_to_coeff_map_.cbegin(),
                add_e.expr_to_coeff_map_.cend(),
-               [](const pair<const Expression, double>& p1,
-                  const pair<const Expression, double>& p2) {
+               [](const pair<Expression, double>& p1,
+                  const pair<Expression, double>& p2) {
                  return p1.first.EqualTo(p2.first) && p1.second == p2.second;
                });
 }
@@ -564,8 +600,8 @@ bool ExpressionAdd::Less(const ExpressionCell& e) const {
   return lexicographical_compare(
       expr_to_coeff_map_.cbegin(), expr_to_coeff_map_.cend(),
       add_e.expr_to_coeff_map_.cbegin(), add_e.expr_to_coeff_map_.cend(),
-      [](const pair<const Expression, double>& p1,
-         const pair<const Expression, double>& p2) {
+      [](const pair<Expression, double>& p1,
+         const pair<Expression, double>& p2) {
         const Expression& term1{p1.first};
         const Expression& term2{p2.first};
         if (term1.Less(term2)) {
@@ -583,7 +619,15 @@ bool ExpressionAdd::Less(const ExpressionCell& e) const {
 double ExpressionAdd::Evaluate(const Environment& env) const {
   return accumulate(
       expr_to_coeff_map_.begin(), expr_to_coeff_map_.end(), constant_,
-      [&env](const double init, const pair<const Expression, double>& p) {
+      [&env](const double init, const pair<Expression, double>& p) {
+        return init + p.first.Evaluate(env) * p.second;
+      });
+}
+
+double ExpressionAdd::Evaluate(const IndexedEnvironment& env) const {
+  return accumulate(
+      expr_to_coeff_map_.begin(), expr_to_coeff_map_.end(), constant_,
+      [&env](const double init, const pair<Expression, double>& p) {
         return init + p.first.Evaluate(env) * p.second;
       });
 }
@@ -664,8 +708,10 @@ ostream& ExpressionAdd::DisplayTerm(ostream& os, const bool print_plus,
 }
 
 ExpressionAddFactory::ExpressionAddFactory(
-    const double constant, map<Expression, double> expr_to_coeff_map)
-    : constant_{constant}, expr_to_coeff_map_{std::move(expr_to_coeff_map)} {}
+    const double constant, ExpressionToCoeffMap expr_to_coeff_map)
+    : constant_{constant},
+      terms_{expr_to_coeff_map.release()},
+      num_sorted_{terms_.size()} {}
 
 ExpressionAddFactory::ExpressionAddFactory(const ExpressionAdd* const ptr)
     : ExpressionAddFactory{ptr->get_constant(), ptr->get_expr_to_coeff_map()} {}
@@ -693,6 +739,15 @@ ExpressionAddFactory& ExpressionAddFactory::AddExpression(const Expression& e) {
   return AddTerm(1.0, e);
 }
 
+ExpressionAddFactory& ExpressionAddFactory::AddExpressions(
+    const vector<Expression>& expressions) {
+  terms_.reserve(terms_.size() + expressions.size());
+  for (const Expression& e : expressions) {
+    AddExpression(e);
+  }
+  return *this;
+}
+
 ExpressionAddFactory& ExpressionAddFactory::Add(
     const ExpressionAdd* const ptr) {
   AddConstant(ptr->get_constant());
@@ -702,13 +757,15 @@ ExpressionAddFactory& ExpressionAddFactory::Add(
 ExpressionAddFactory& ExpressionAddFactory::operator=(
     const ExpressionAdd* const ptr) {
   constant_ = ptr->get_constant();
-  expr_to_coeff_map_ = ptr->get_expr_to_coeff_map();
+  const ExpressionToCoeffMap& expr_to_coeff_map{ptr->get_expr_to_coeff_map()};
+  terms_.assign(expr_to_coeff_map.begin(), expr_to_coeff_map.end());
+  num_sorted_ = terms_.size();
   return *this;
 }
 
 ExpressionAddFactory& ExpressionAddFactory::Negate() {
   constant_ = -constant_;
-  for (auto& p : expr_to_coeff_map_) {
+  for (auto& p : terms_) {
     p.second = -p.second;
   }
   return *this;
@@ -721,16 +778,16 @@ Expression ExpressionAddFactory::GetExpression() {
         "should not be invoked again.");
   }
   get_expression_is_called_ = true;
-  if (expr_to_coeff_map_.empty()) {
+  Normalize();
+  if (terms_.empty()) {
     return Expression{constant_};
   }
-  if (constant_ == 0.0 && expr_to_coeff_map_.size() == 1U) {
+  if (constant_ == 0.0 && terms_.size() == 1U) {
     // 0.0 + c1 * t1 -> c1 * t1
-    const auto it(expr_to_coeff_map_.cbegin());
-    return it->first * it->second;
+    return terms_.front().first * terms_.front().second;
   }
-  return Expression{
-      new ExpressionAdd(constant_, std::move(expr_to_coeff_map_))};
+  return Expression{new ExpressionAdd(
+      constant_, ExpressionToCoeffMap{sorted_unique, std::move(terms_)})};
 }
 
 ExpressionAddFactory& ExpressionAddFactory::AddConstant(const double constant) {
@@ -741,36 +798,53 @@ ExpressionAddFactory& ExpressionAddFactory::AddConstant(const double constant) {
 ExpressionAddFactory& ExpressionAddFactory::AddTerm(const double coeff,
                                                     const Expression& term) {
   assert(!is_constant(term));
-
-  const auto it(expr_to_coeff_map_.find(term));
-  if (it != expr_to_coeff_map_.end()) {
-    // Case1: term is already in the map
-    double& this_coeff{it->second};
-    this_coeff += coeff;
-    if (this_coeff == 0.0) {
-      // If the coefficient becomes zero, remove the entry.
-      // TODO(soonho-tri): The following operation is not sound since it cancels
-      // `term` which might contain 0/0 problems.
-      expr_to_coeff_map_.erase(it);
-    }
-  } else {
-    // Case2: term is not found in expr_to_coeff_map_.
-    // Add the entry (term, coeff).
-    expr_to_coeff_map_.emplace(term, coeff);
-  }
+  terms_.emplace_back(term, coeff);
   return *this;
 }
 
 ExpressionAddFactory& ExpressionAddFactory::AddMap(
-    const map<Expression, double>& expr_to_coeff_map) {
+    const ExpressionToCoeffMap& expr_to_coeff_map) {
   for (const auto& p : expr_to_coeff_map) {
     AddTerm(p.second, p.first);
   }
   return *this;
 }
 
+void ExpressionAddFactory::Normalize() {
+  if (num_sorted_ == terms_.size()) {
+    return;
+  }
+  const auto less = [](const pair<Expression, double>& p1,
+                       const pair<Expression, double>& p2) {
+    return p1.first.Less(p2.first);
+  };
+  // Sorts the pending terms and merges them into the sorted prefix. Both are
+  // stable, so that the coefficients of a common term are added in the order
+  // in which they are added to this factory.
+  const auto middle = terms_.begin() + num_sorted_;
+  stable_sort(middle, terms_.end(), less);
+  inplace_merge(terms_.begin(), middle, terms_.end(), less);
+
+  auto out = terms_.begin();
+  for (auto it = terms_.begin(); it != terms_.end();) {
+    pair<Expression, double> p{std::move(*it)};
+    for (++it; it != terms_.end() && it->first.EqualTo(p.first); ++it) {
+      p.second += it->second;
+    }
+    // If the coefficient becomes zero, remove the entry.
+    // TODO(soonho-tri): The following operation is not sound since it cancels
+    // `term` which might contain 0/0 problems.
+    if (p.second != 0.0) {
+      *out = std::move(p);
+      ++out;
+    }
+  }
+  terms_.erase(out, terms_.end());
+  num_sorted_ = terms_.size();
+}
+
 ExpressionMul::ExpressionMul(const double constant,
-                             map<Expression, Expression> base_to_exponent_map)
+                             BaseToExponentMap base_to_exponent_map)
     : ExpressionCell{ExpressionKind::Mul,
                      hash_combine(hash<double>{}(constant),
                                   base_to_exponent_map),
@@ -783,7 +857,7 @@ ExpressionMul::ExpressionMul(const double constant,
 }
 
 Variables ExpressionMul::ExtractVariables(
-    const std::map<Expression, Expression>& base_to_exponent_map) {
+    const BaseToExponentMap& base_to_exponent_map) {
   Variables ret{};
   for (const auto& p : base_to_exponent_map) {
     ret.insert(p.first.GetVariables());
@@ -804,8 +878,8 @@ bool ExpressionMul::EqualTo(const ExpressionCell& e) const {
   return equal(
       base_to_exponent_map_.cbegin(), base_to_exponent_map_.cend(),
       mul_e.base_to_exponent_map_.cbegin(), mul_e.base_to_exponent_map_.cend(),
-      [](const pair<const Expression, Expression>& p1,
-         const pair<const Expression, Expression>& p2) {
+      [](const pair<Expression, Expression>& p1,
+         const pair<Expression, Expression>& p2) {
         return p1.first.EqualTo(p2.first) && p1.second.EqualTo(p2.second);
       });
 }
@@ -825,8 +899,8 @@ bool ExpressionMul::Less(const ExpressionCell& e) const {
   return lexicographical_compare(
       base_to_exponent_map_.cbegin(), base_to_exponent_map_.cend(),
       mul_e.base_to_exponent_map_.cbegin(), mul_e.base_to_exponent_map_.cend(),
-      [](const pair<const Expression, Expression>& p1,
-         const pair<const Expression, Expression>& p2) {
+      [](const pair<Expression, Expression>& p1,
+         const pair<Expression, Expression>& p2) {
         const Expression& base1{p1.first};
         const Expression& base2{p2.first};
         if (base1.Less(base2)) {
@@ -844,7 +918,15 @@ bool ExpressionMul::Less(const ExpressionCell& e) const {
 double ExpressionMul::Evaluate(const Environment& env) const {
   return accumulate(
       base_to_exponent_map_.begin(), base_to_exponent_map_.end(), constant_,
-      [&env](const double init, const pair<const Expression, Expression>& p) {
+      [&env](const double init, const pair<Expression, Expression>& p) {
+        return init * std::pow(p.first.Evaluate(env), p.second.Evaluate(env));
+      });
+}
+
+double ExpressionMul::Evaluate(const IndexedEnvironment& env) const {
+  return accumulate(
+      base_to_exponent_map_.begin(), base_to_exponent_map_.end(), constant_,
+      [&env](const double init, const pair<Expression, Expression>& p) {
         return init * std::pow(p.first.Evaluate(env), p.second.Evaluate(env));
       });
 }
@@ -905,7 +987,7 @@ Expression ExpressionMul::Differentiate(const Variable& x) const {
   //       expr * (∂/∂x f_n^g_n) / f_n^g_n]
   //
   // where expr = (f_1^g_1 * f_2^g_2 * ... * f_n^g_n).
-  const map<Expression, Expression>& m{base_to_exponent_map_};
+  const BaseToExponentMap& m{base_to_exponent_map_};
   Expression ret{Expression::Zero()};
   const Expression expr{
       ExpressionMulFactory{1.0, base_to_exponent_map_}.GetExpression()};
@@ -951,9 +1033,10 @@ ostream& ExpressionMul::DisplayTerm(ostream& os, const bool print_mul,
 }
 
 ExpressionMulFactory::ExpressionMulFactory(
-    const double constant, map<Expression, Expression> base_to_exponent_map)
+    const double constant, BaseToExponentMap base_to_exponent_map)
     : constant_{constant},
-      base_to_exponent_map_{std::move(base_to_exponent_map)} {}
+      factors_{base_to_exponent_map.release()},
+      num_sorted_{factors_.size()} {}
 
 ExpressionMulFactory::ExpressionMulFactory(const ExpressionMul* const ptr)
     : ExpressionMulFactory{ptr->get_constant(),
@@ -974,6 +1057,15 @@ ExpressionMulFactory& ExpressionMulFactory::AddExpression(const Expression& e) {
   return AddTerm(e, Expression{1.0});
 }
 
+ExpressionMulFactory& ExpressionMulFactory::AddExpressions(
+    const vector<Expression>& expressions) {
+  factors_.reserve(factors_.size() + expressions.size());
+  for (const Expression& e : expressions) {
+    AddExpression(e);
+  }
+  return *this;
+}
+
 ExpressionMulFactory& ExpressionMulFactory::Add(
     const ExpressionMul* const ptr) {
   AddConstant(ptr->get_constant());
@@ -983,7 +1075,10 @@ ExpressionMulFactory& ExpressionMulFactory::Add(
 ExpressionMulFactory& ExpressionMulFactory::operator=(
     const ExpressionMul* const ptr) {
   constant_ = ptr->get_constant();
-  base_to_exponent_map_ = ptr->get_base_to_exponent_map();
+  const BaseToExponentMap& base_to_exponent_map{
+      ptr->get_base_to_exponent_map()};
+  factors_.assign(base_to_exponent_map.begin(), base_to_exponent_map.end());
+  num_sorted_ = factors_.size();
   return *this;
 }
 
@@ -999,16 +1094,16 @@ Expression ExpressionMulFactory::GetExpression() {
         "should not be invoked again.");
   }
   get_expression_is_called_ = true;
-  if (base_to_exponent_map_.empty()) {
+  Normalize();
+  if (factors_.empty()) {
     return Expression{constant_};
   }
-  if (constant_ == 1.0 && base_to_exponent_map_.size() == 1U) {
+  if (constant_ == 1.0 && factors_.size() == 1U) {
     // 1.0 * c1^t1 -> c1^t1
-    const auto it(base_to_exponent_map_.cbegin());
-    return pow(it->first, it->second);
+    return pow(factors_.front().first, factors_.front().second);
   }
-  return Expression{
-      new ExpressionMul(constant_, std::move(base_to_exponent_map_))};
+  return Expression{new ExpressionMul(
+      constant_, BaseToExponentMap{sorted_unique, std::move(factors_)})};
 }
 
 ExpressionMulFactory& ExpressionMulFactory::AddConstant(const double constant) {
@@ -1035,37 +1130,50 @@ ExpressionMulFactory& ExpressionMulFactory::AddTerm(
       }
     }
   }
-
-  const auto it(base_to_exponent_map_.find(base));
-  if (it != base_to_exponent_map_.end()) {
-    // base is already in map.
-    // (= b1^e1 * ... * (base^this_exponent) * ... * en^bn).
-    // Update it to be (... * (base^(this_exponent + exponent)) * ...)
-    // Example: x^3 * x^2 => x^5
-    Expression& this_exponent = it->second;
-    this_exponent += exponent;
-    if (is_zero(this_exponent)) {
-      // If it ends up with base^0 (= 1.0) then remove this entry from the map.
-      // TODO(soonho-tri): The following operation is not sound since it can
-      // cancels `base` which might include 0/0 problems.
-      base_to_exponent_map_.erase(it);
-    }
-  } else {
-    // Product is not found in base_to_exponent_map_. Add the entry (base,
-    // exponent).
-    base_to_exponent_map_.emplace(base, exponent);
-  }
+  factors_.emplace_back(base, exponent);
   return *this;
 }
 
 ExpressionMulFactory& ExpressionMulFactory::AddMap(
-    const map<Expression, Expression>& base_to_exponent_map) {
+    const BaseToExponentMap& base_to_exponent_map) {
   for (const auto& p : base_to_exponent_map) {
     AddTerm(p.first, p.second);
   }
   return *this;
 }
 
+void ExpressionMulFactory::Normalize() {
+  if (num_sorted_ == factors_.size()) {
+    return;
+  }
+  const auto less = [](const pair<Expression, Expression>& p1,
+                       const pair<Expression, Expression>& p2) {
+    return p1.first.Less(p2.first);
+  };
+  // See ExpressionAddFactory::Normalize.
+  const auto middle = factors_.begin() + num_sorted_;
+  stable_sort(middle, factors_.end(), less);
+  inplace_merge(factors_.begin(), middle, factors_.end(), less);
+
+  auto out = factors_.begin();
+  for (auto it = factors_.begin(); it != factors_.end();) {
+    pair<Expression, Expression> p{std::move(*it)};
+    // Example: x^3 * x^2 => x^5
+    for (++it; it != factors_.end() && it->first.EqualTo(p.first); ++it) {
+      p.second += it->second;
+    }
+    // If it ends up with base^0 (= 1.0) then remove this entry.
+    // TODO(soonho-tri): The following operation is not sound since it can
+    // cancels `base` which might include 0/0 problems.
+    if (!is_zero(p.second)) {
+      *out = std::move(p);
+      ++out;
+    }
+  }
+  factors_.erase(out, factors_.end());
+  num_sorted_ = factors_.size();
+}
+
 ExpressionDiv::ExpressionDiv(const Expression& e1, const Expression& e2)
     : BinaryExpressionCell{ExpressionKind::Div, e1, e2,
                            e1.is_polynomial() && is_constant(e2)} {}
@@ -1105,7 +1213,7 @@ class DivExpandVisitor {
     //   => c₀/n + ∑ᵢ (cᵢ / n * eᵢ)
     const double constant{get_constant_in_addition(e)};
     ExpressionAddFactory factory(constant / n, {});
-    for (const pair<const Expression, double>& p :
+    for (const pair<Expression, double>& p :
          get_expr_to_coeff_map_in_addition(e)) {
       factory.AddExpression(p.second / n * p.first);
     }
@@ -2036,6 +2144,13 @@ double ExpressionIfThenElse::Evaluate(const Environment& env) const {
   return e_else_.Evaluate(env);
 }
 
+double ExpressionIfThenElse::Evaluate(const IndexedEnvironment& env) const {
+  if (f_cond_.Evaluate(env)) {
+    return e_then_.Evaluate(env);
+  }
+  return e_else_.Evaluate(env);
+}
+
 Expression ExpressionIfThenElse::Expand() {
   // TODO(soonho): use the following line when Formula::Expand() is implemented.
   // return if_then_else(f_cond_.Expand(), e_then_.Expand(), e_else_.Expand());
@@ -2107,6 +2222,11 @@ double ExpressionUninterpretedFunction::Evaluate(const Environment&) const {
   throw runtime_error("Uninterpreted-function expression cannot be evaluated.");
 }
 
+double ExpressionUninterpretedFunction::Evaluate(
+    const IndexedEnvironment&) const {
+  throw runtime_error("Uninterpreted-function expression cannot be evaluated.");
+}
+
 Expression ExpressionUninterpretedFunction::Expand() { return GetExpression(); }
 
 Expression ExpressionUninterpretedFunction::Substitute(
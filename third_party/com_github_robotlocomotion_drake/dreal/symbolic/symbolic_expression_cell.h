@@ -3,13 +3,16 @@
 #include <algorithm>  // for cpplint only
 #include <atomic>
 #include <cstddef>
-#include <map>
 #include <ostream>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "dreal/symbolic/symbolic_arena.h"
 #include "dreal/symbolic/symbolic_environment.h"
 #include "dreal/symbolic/symbolic_expression.h"
 #include "dreal/symbolic/symbolic_formula.h"
+#include "dreal/symbolic/symbolic_intern_table.h"
 #include "dreal/symbolic/symbolic_variable.h"
 #include "dreal/symbolic/symbolic_variables.h"
 
@@ -25,6 +28,13 @@ namespace symbolic {
  */
 class ExpressionCell {
  public:
+  /** Allocates a cell. It is placed in the current SymbolicArena if any. */
+  static void* operator new(std::size_t size) {
+    return SymbolicArena::Allocate(size);
+  }
+  /** Deallocates a cell. */
+  static void operator delete(void* p) { SymbolicArena::Deallocate(p); }
+
   /** Returns expression kind. */
   ExpressionKind get_kind() const { return kind_; }
 
@@ -52,6 +62,11 @@ class ExpressionCell {
    */
   virtual double Evaluate(const Environment& env) const = 0;
 
+  /** Evaluates under a given indexed environment.
+   *  @throws std::runtime_error if NaN is detected during evaluation.
+   */
+  virtual double Evaluate(const IndexedEnvironment& env) const = 0;
+
   /** Expands out products and positive integer powers in expression.
    * @throws std::runtime_error if NaN is detected during expansion.
    */
@@ -118,12 +133,14 @@ class ExpressionCell {
   }
   void decrease_rc() const {
     if (atomic_fetch_sub_explicit(&rc_, 1U, std::memory_order_acq_rel) == 1U) {
-      delete this;
+      InternTable<ExpressionCell>::GetInstance().Release(this);
     }
   }
 
   // So that Expression can call {increase,decrease}_rc.
   friend Expression;
+  // So that InternTable can access rc_ and delete this.
+  friend class InternTable<ExpressionCell>;
 };
 
 /** Represents the base class for unary expressions.  */
@@ -132,6 +149,7 @@ class UnaryExpressionCell : public ExpressionCell {
   bool EqualTo(const ExpressionCell& e) const override;
   bool Less(const ExpressionCell& e) const override;
   double Evaluate(const Environment& env) const override;
+  double Evaluate(const IndexedEnvironment& env) const override;
   /** Returns the argument. */
   const Expression& get_argument() const { return e_; }
 
@@ -171,6 +189,7 @@ class BinaryExpressionCell : public ExpressionCell {
   bool EqualTo(const ExpressionCell& e) const override;
   bool Less(const ExpressionCell& e) const override;
   double Evaluate(const Environment& env) const override;
+  double Evaluate(const IndexedEnvironment& env) const override;
   /** Returns the first argument. */
   const Expression& get_first_argument() const { return e1_; }
   /** Returns the second argument. */
@@ -219,6 +238,7 @@ class ExpressionVar : public ExpressionCell {
   bool EqualTo(const ExpressionCell& e) const override;
   bool Less(const ExpressionCell& e) const override;
   double Evaluate(const Environment& env) const override;
+  double Evaluate(const IndexedEnvironment& env) const override;
   Expression Expand() override;
   Expression Substitute(const ExpressionSubstitution& expr_subst,
                         const FormulaSubstitution& formula_subst) override;
@@ -237,6 +257,7 @@ class ExpressionConstant : public ExpressionCell {
   bool EqualTo(const ExpressionCell& e) const override;
   bool Less(const ExpressionCell& e) const override;
   double Evaluate(const Environment& env) const override;
+  double Evaluate(const IndexedEnvironment& env) const override;
   Expression Expand() override;
   Expression Substitute(const ExpressionSubstitution& expr_subst,
                         const FormulaSubstitution& formula_subst) override;
@@ -262,6 +283,7 @@ class ExpressionRealConstant : public ExpressionCell {
   bool EqualTo(const ExpressionCell& e) const override;
   bool Less(const ExpressionCell& e) const override;
   double Evaluate(const Environment& env) const override;
+  double Evaluate(const IndexedEnvironment& env) const override;
   Expression Expand() override;
   Expression Substitute(const ExpressionSubstitution& expr_subst,
                         const FormulaSubstitution& formula_subst) override;
@@ -281,6 +303,7 @@ class ExpressionNaN : public ExpressionCell {
   bool EqualTo(const ExpressionCell& e) const override;
   bool Less(const ExpressionCell& e) const override;
   double Evaluate(const Environment& env) const override;
+  double Evaluate(const IndexedEnvironment& env) const override;
   Expression Expand() override;
   Expression Substitute(const ExpressionSubstitution& expr_subst,
                         const FormulaSubstitution& formula_subst) override;
@@ -305,11 +328,11 @@ class ExpressionAdd : public ExpressionCell {
  public:
   /** Constructs ExpressionAdd from @p constant_term and @p term_to_coeff_map.
    */
-  ExpressionAdd(double constant,
-                std::map<Expression, double> expr_to_coeff_map);
+  ExpressionAdd(double constant, ExpressionToCoeffMap expr_to_coeff_map);
   bool EqualTo(const ExpressionCell& e) const override;
   bool Less(const ExpressionCell& e) const override;
   double Evaluate(const Environment& env) const override;
+  double Evaluate(const IndexedEnvironment& env) const override;
   Expression Expand() override;
   Expression Substitute(const ExpressionSubstitution& expr_subst,
                         const FormulaSubstitution& formula_subst) override;
@@ -318,25 +341,25 @@ class ExpressionAdd : public ExpressionCell {
   /** Returns the constant. */
   double get_constant() const { return constant_; }
   /** Returns map from an expression to its coefficient. */
-  const std::map<Expression, double>& get_expr_to_coeff_map() const {
+  const ExpressionToCoeffMap& get_expr_to_coeff_map() const {
     return expr_to_coeff_map_;
   }
 
   // TODO(soonho): Make the following private and allow
   // only selected functions/method to use them.
   /** Returns map from an expression to its coefficient. */
-  std::map<Expression, double>& get_mutable_expr_to_coeff_map() {
+  ExpressionToCoeffMap& get_mutable_expr_to_coeff_map() {
     return expr_to_coeff_map_;
   }
 
  private:
   static Variables ExtractVariables(
-      const std::map<Expression, double>& expr_to_coeff_map);
+      const ExpressionToCoeffMap& expr_to_coeff_map);
   std::ostream& DisplayTerm(std::ostream& os, bool print_plus, double coeff,
                             const Expression& term) const;
 
   double constant_{};
-  std::map<Expression, double> expr_to_coeff_map_;
+  ExpressionToCoeffMap expr_to_coeff_map_;
 };
 
 /** Factory class to help build ExpressionAdd expressions.
@@ -361,13 +384,18 @@ class ExpressionAddFactory {
   /** Constructs ExpressionAddFactory with @p constant and @p
    * expr_to_coeff_map. */
   ExpressionAddFactory(double constant,
-                       std::map<Expression, double> expr_to_coeff_map);
+                       ExpressionToCoeffMap expr_to_coeff_map);
 
   /** Constructs ExpressionAddFactory from @p ptr. */
   explicit ExpressionAddFactory(const ExpressionAdd* ptr);
 
   /** Adds @p e to this factory. */
   ExpressionAddFactory& AddExpression(const Expression& e);
+  /** Adds @p expressions to this factory. It is equivalent to calling
+   * AddExpression for each of them, but the terms are sorted and merged only
+   * once, when GetExpression() is called. */
+  ExpressionAddFactory& AddExpressions(
+      const std::vector<Expression>& expressions);
   /** Adds ExpressionAdd pointed by @p ptr to this factory. */
   ExpressionAddFactory& Add(const ExpressionAdd* ptr);
   /** Assigns a factory from a pointer to ExpressionAdd.  */
@@ -397,17 +425,22 @@ class ExpressionAddFactory {
    *     c0 + c1 * t1 + ... + cn * tn
    *
    * results in c0 + c1 * t1 + ... + (coeff * term) + ... + cn * tn. Note that
-   * it also performs simplifications to merge the coefficients of common terms.
+   * the coefficients of common terms are merged later by Normalize().
    */
   ExpressionAddFactory& AddTerm(double coeff, const Expression& term);
   /* Adds expr_to_coeff_map to this factory. It calls AddConstant and AddTerm
    * methods. */
-  ExpressionAddFactory& AddMap(
-      const std::map<Expression, double>& expr_to_coeff_map);
+  ExpressionAddFactory& AddMap(const ExpressionToCoeffMap& expr_to_coeff_map);
+  /* Sorts the pending terms and merges the coefficients of common terms. Terms
+   * whose coefficients become zero are removed. */
+  void Normalize();
 
   bool get_expression_is_called_{false};
   double constant_{0.0};
-  std::map<Expression, double> expr_to_coeff_map_;
+  // The first num_sorted_ elements are sorted and have unique terms. The rest
+  // are pending terms to be merged by Normalize().
+  std::vector<std::pair<Expression, double>> terms_;
+  size_t num_sorted_{0};
 };
 
 /** Symbolic expression representing a multiplication of powers.
@@ -426,11 +459,11 @@ class ExpressionAddFactory {
 class ExpressionMul : public ExpressionCell {
  public:
   /** Constructs ExpressionMul from @p constant and @p base_to_exponent_map. */
-  ExpressionMul(double constant,
-                std::map<Expression, Expression> base_to_exponent_map);
+  ExpressionMul(double constant, BaseToExponentMap base_to_exponent_map);
   bool EqualTo(const ExpressionCell& e) const override;
   bool Less(const ExpressionCell& e) const override;
   double Evaluate(const Environment& env) const override;
+  double Evaluate(const IndexedEnvironment& env) const override;
   Expression Expand() override;
   Expression Substitute(const ExpressionSubstitution& expr_subst,
                         const FormulaSubstitution& formula_subst) override;
@@ -439,26 +472,26 @@ class ExpressionMul : public ExpressionCell {
   /** Returns constant term. */
   double get_constant() const { return constant_; }
   /** Returns map from a term to its exponent. */
-  const std::map<Expression, Expression>& get_base_to_exponent_map() const {
+  const BaseToExponentMap& get_base_to_exponent_map() const {
     return base_to_exponent_map_;
   }
 
   // TODO(soonho): Make the following private and allow
   // only selected functions/method to use them.
   /** Returns map from a term to its exponent. */
-  std::map<Expression, Expression>& get_mutable_base_to_exponent_map() {
+  BaseToExponentMap& get_mutable_base_to_exponent_map() {
     return base_to_exponent_map_;
   }
 
  private:
   static Variables ExtractVariables(
-      const std::map<Expression, Expression>& base_to_exponent_map);
+      const BaseToExponentMap& base_to_exponent_map);
   std::ostream& DisplayTerm(std::ostream& os, bool print_mul,
                             const Expression& base,
                             const Expression& exponent) const;
 
   double constant_{};
-  std::map<Expression, Expression> base_to_exponent_map_;
+  BaseToExponentMap base_to_exponent_map_;
 };
 
 /** Factory class to help build ExpressionMul expressions.
@@ -482,14 +515,18 @@ class ExpressionMulFactory {
 
   /** Constructs ExpressionMulFactory with @p constant and @p
    * base_to_exponent_map. */
-  ExpressionMulFactory(double constant,
-                       std::map<Expression, Expression> base_to_exponent_map);
+  ExpressionMulFactory(double constant, BaseToExponentMap base_to_exponent_map);
 
   /** Constructs ExpressionMulFactory from @p ptr. */
   explicit ExpressionMulFactory(const ExpressionMul* ptr);
 
   /** Adds @p e to this factory. */
   ExpressionMulFactory& AddExpression(const Expression& e);
+  /** Adds @p expressions to this factory. It is equivalent to calling
+   * AddExpression for each of them, but the factors are sorted and merged only
+   * once, when GetExpression() is called. */
+  ExpressionMulFactory& AddExpressions(
+      const std::vector<Expression>& expressions);
   /** Adds ExpressionMul pointed by @p ptr to this factory. */
   ExpressionMulFactory& Add(const ExpressionMul* ptr);
   /** Assigns a factory from a pointer to ExpressionMul.  */
@@ -517,18 +554,23 @@ class ExpressionMulFactory {
          c * b1 ^ e1 * ... * bn ^ en
 
      results in c * b1 ^ e1 * ... * base^exponent * ... * bn ^ en. Note that
-     it also performs simplifications to merge the exponents of common bases.
+     the exponents of common bases are merged later by Normalize().
   */
   ExpressionMulFactory& AddTerm(const Expression& base,
                                 const Expression& exponent);
   /* Adds base_to_exponent_map to this factory. It calls AddConstant and AddTerm
    * methods. */
-  ExpressionMulFactory& AddMap(
-      const std::map<Expression, Expression>& base_to_exponent_map);
+  ExpressionMulFactory& AddMap(const BaseToExponentMap& base_to_exponent_map);
+  /* Sorts the pending factors and merges the exponents of common bases.
+   * Factors whose exponents become zero are removed. */
+  void Normalize();
 
   bool get_expression_is_called_{false};
   double constant_{1.0};
-  std::map<Expression, Expression> base_to_exponent_map_;
+  // The first num_sorted_ elements are sorted and have unique bases. The rest
+  // are pending factors to be merged by Normalize().
+  std::vector<std::pair<Expression, Expression>> factors_;
+  size_t num_sorted_{0};
 };
 
 /** Symbolic expression representing division. */
@@ -818,6 +860,7 @@ class ExpressionIfThenElse : public ExpressionCell {
   bool EqualTo(const ExpressionCell& e) const override;
   bool Less(const ExpressionCell& e) const override;
   double Evaluate(const Environment& env) const override;
+  double Evaluate(const IndexedEnvironment& env) const override;
   Expression Expand() override;
   Expression Substitute(const ExpressionSubstitution& expr_subst,
                         const FormulaSubstitution& formula_subst) override;
@@ -851,6 +894,7 @@ class ExpressionUninterpretedFunction : public ExpressionCell {
   bool EqualTo(const ExpressionCell& e) const override;
   bool Less(const ExpressionCell& e) const override;
   double Evaluate(const Environment& env) const override;
+  double Evaluate(const IndexedEnvironment& env) const override;
   Expression Expand() override;
   Expression Substitute(const ExpressionSubstitution& expr_subst,
                         const FormulaSubstitution& formula_subst) override;
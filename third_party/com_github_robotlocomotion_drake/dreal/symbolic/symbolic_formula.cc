@@ -60,7 +60,15 @@ Formula::~Formula() {
   }
 }
 
-Formula::Formula(FormulaCell* const ptr) : ptr_{ptr} { ptr_->increase_rc(); }
+Formula::Formula(FormulaCell* const ptr) : ptr_{ptr} {
+  assert(ptr_ != nullptr);
+  if (ptr_->use_count() == 0) {
+    // A fresh cell. Shares the structurally equal one if it exists.
+    ptr_ = InternTable<FormulaCell>::GetInstance().Intern(ptr_);
+  } else {
+    ptr_->increase_rc();
+  }
+}
 
 Formula::Formula(const Variable& var) : Formula{new FormulaVar(var)} {}
 
@@ -82,22 +90,15 @@ const Variables& Formula::GetFreeVariables() const {
 bool Formula::EqualTo(const Formula& f) const {
   assert(ptr_ != nullptr);
   assert(f.ptr_ != nullptr);
-  if (ptr_ == f.ptr_) {
-    // pointer equality
-    return true;
-  }
-  if (get_kind() != f.get_kind()) {
-    return false;
-  }
-  if (get_hash() != f.get_hash()) {
-    return false;
-  }
-  // Same kind/hash, but it could be the result of hash collision,
-  // check structural equality.
-  return ptr_->EqualTo(*(f.ptr_));
+  // Cells are hash-consed (see InternTable). Two formulas are structurally
+  // equal if and only if they share the same cell.
+  return ptr_ == f.ptr_;
 }
 
 bool Formula::Less(const Formula& f) const {
+  if (ptr_ == f.ptr_) {
+    return false;  // this equals to f, not less-than.
+  }
   const FormulaKind k1{get_kind()};
   const FormulaKind k2{f.get_kind()};
   if (k1 < k2) {
@@ -114,6 +115,11 @@ bool Formula::Evaluate(const Environment& env) const {
   return ptr_->Evaluate(env);
 }
 
+bool Formula::Evaluate(const IndexedEnvironment& env) const {
+  assert(ptr_ != nullptr);
+  return ptr_->Evaluate(env);
+}
+
 Formula Formula::Substitute(const Variable& var, const Expression& e) const {
   assert(ptr_ != nullptr);
   return ptr_->Substitute({{var, e}}, FormulaSubstitution{});
@@ -204,7 +210,7 @@ Formula Formula::make_conjunction(Formula& f1, const Formula& f2) {
     return f1;
   }
   if (is_conjunction(f1)) {
-    if (f1.ptr_->use_count() == 1) {
+    if (InternTable<FormulaCell>::GetInstance().Detach(f1.ptr_)) {
       set<Formula>& operands{to_nary(f1)->get_mutable_operands()};  // reference
       MergeConjunction(f2, &operands);
       return f1 = Formula{new FormulaAnd(std::move(operands))};
@@ -332,7 +338,7 @@ Formula Formula::make_disjunction(Formula& f1, const Formula& f2) {
     return f1;
   }
   if (is_disjunction(f1)) {
-    if (f1.ptr_->use_count() == 1) {
+    if (InternTable<FormulaCell>::GetInstance().Detach(f1.ptr_)) {
       set<Formula>& operands{to_nary(f1)->get_mutable_operands()};  // reference
       MergeDisjunction(f2, &operands);
       return f1 = Formula{new FormulaOr(std::move(operands))};
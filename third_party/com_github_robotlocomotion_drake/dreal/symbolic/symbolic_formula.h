@@ -159,6 +159,17 @@ class Formula {
    */
   bool Evaluate(const Environment& env = Environment{}) const;
 
+  /** Evaluates under a given indexed environment @p env.
+   *
+   * @throws runtime_error if a variable in this formula is not bound in
+   * @p env.
+   *
+   * Since @p env provides a value for every variable which it binds, an
+   * equality e₁ = e₂ (resp. an inequality e₁ ≠ e₂) is checked by comparing the
+   * values of e₁ and e₂.
+   */
+  bool Evaluate(const IndexedEnvironment& env) const;
+
   /** Returns a copy of this formula replacing all occurrences of @p var
    * with @p e.
    * @throws std::runtime_error if NaN is detected during substitution.
@@ -43,6 +43,14 @@ const Variables& FormulaCell::GetFreeVariables() const { return variables_; }
 
 bool FormulaCell::include_ite() const { return include_ite_; }
 
+bool FormulaCell::Evaluate(const IndexedEnvironment& env) const {
+  Environment map_env;
+  for (int i = 0; i < env.size(); ++i) {
+    map_env.insert(env.variables()[i], env[i]);
+  }
+  return Evaluate(map_env);
+}
+
 RelationalFormulaCell::RelationalFormulaCell(const FormulaKind k,
                                              const Expression& lhs,
                                              const Expression& rhs)
@@ -141,6 +149,8 @@ bool FormulaTrue::Less(const FormulaCell& f) const {
 
 bool FormulaTrue::Evaluate(const Environment&) const { return true; }
 
+bool FormulaTrue::Evaluate(const IndexedEnvironment&) const { return true; }
+
 Formula FormulaTrue::Substitute(const ExpressionSubstitution&,
                                 const FormulaSubstitution&) {
   return Formula::True();
@@ -167,6 +177,8 @@ bool FormulaFalse::Less(const FormulaCell& f) const {
 
 bool FormulaFalse::Evaluate(const Environment&) const { return false; }
 
+bool FormulaFalse::Evaluate(const IndexedEnvironment&) const { return false; }
+
 Formula FormulaFalse::Substitute(const ExpressionSubstitution&,
                                  const FormulaSubstitution&) {
   return Formula::False();
@@ -221,6 +233,20 @@ bool FormulaVar::Evaluate(const Environment& env) const {
   }
 }
 
+bool FormulaVar::Evaluate(const IndexedEnvironment& env) const {
+  const int slot{env.slot(var_)};
+  if (slot != -1) {
+    return static_cast<bool>(env[slot]);
+  } else {
+    ostringstream oss;
+    oss << "The following environment does not have an entry for the "
+           "variable "
+        << var_ << "\n";
+    oss << env << "\n";
+    throw runtime_error(oss.str());
+  }
+}
+
 Formula FormulaVar::Substitute(const ExpressionSubstitution&,
                                const FormulaSubstitution& formula_subst) {
   const auto it = formula_subst.find(var_);
@@ -267,6 +293,11 @@ bool FormulaEq::Evaluate(const Environment& env) const {
       get_lhs_expression(), get_rhs_expression(), env);
 }
 
+bool FormulaEq::Evaluate(const IndexedEnvironment& env) const {
+  return get_lhs_expression().Evaluate(env) ==
+         get_rhs_expression().Evaluate(env);
+}
+
 Formula FormulaEq::Substitute(const ExpressionSubstitution& expr_subst,
                               const FormulaSubstitution& formula_subst) {
   const Expression& lhs{get_lhs_expression()};
@@ -293,6 +324,11 @@ bool FormulaNeq::Evaluate(const Environment& env) const {
       get_lhs_expression(), get_rhs_expression(), env);
 }
 
+bool FormulaNeq::Evaluate(const IndexedEnvironment& env) const {
+  return get_lhs_expression().Evaluate(env) !=
+         get_rhs_expression().Evaluate(env);
+}
+
 Formula FormulaNeq::Substitute(const ExpressionSubstitution& expr_subst,
                                const FormulaSubstitution& formula_subst) {
   const Expression& lhs{get_lhs_expression()};
@@ -319,6 +355,11 @@ bool FormulaGt::Evaluate(const Environment& env) const {
          get_rhs_expression().Evaluate(env);
 }
 
+bool FormulaGt::Evaluate(const IndexedEnvironment& env) const {
+  return get_lhs_expression().Evaluate(env) >
+         get_rhs_expression().Evaluate(env);
+}
+
 Formula FormulaGt::Substitute(const ExpressionSubstitution& expr_subst,
                               const FormulaSubstitution& formula_subst) {
   const Expression& lhs{get_lhs_expression()};
@@ -345,6 +386,11 @@ bool FormulaGeq::Evaluate(const Environment& env) const {
          get_rhs_expression().Evaluate(env);
 }
 
+bool FormulaGeq::Evaluate(const IndexedEnvironment& env) const {
+  return get_lhs_expression().Evaluate(env) >=
+         get_rhs_expression().Evaluate(env);
+}
+
 Formula FormulaGeq::Substitute(const ExpressionSubstitution& expr_subst,
                                const FormulaSubstitution& formula_subst) {
   const Expression& lhs{get_lhs_expression()};
@@ -371,6 +417,11 @@ bool FormulaLt::Evaluate(const Environment& env) const {
          get_rhs_expression().Evaluate(env);
 }
 
+bool FormulaLt::Evaluate(const IndexedEnvironment& env) const {
+  return get_lhs_expression().Evaluate(env) <
+         get_rhs_expression().Evaluate(env);
+}
+
 Formula FormulaLt::Substitute(const ExpressionSubstitution& expr_subst,
                               const FormulaSubstitution& formula_subst) {
   const Expression& lhs{get_lhs_expression()};
@@ -397,6 +448,11 @@ bool FormulaLeq::Evaluate(const Environment& env) const {
          get_rhs_expression().Evaluate(env);
 }
 
+bool FormulaLeq::Evaluate(const IndexedEnvironment& env) const {
+  return get_lhs_expression().Evaluate(env) <=
+         get_rhs_expression().Evaluate(env);
+}
+
 Formula FormulaLeq::Substitute(const ExpressionSubstitution& expr_subst,
                                const FormulaSubstitution& formula_subst) {
   const Expression& lhs{get_lhs_expression()};
@@ -429,6 +485,12 @@ bool FormulaAnd::Evaluate(const Environment& env) const {
                 [&env](const Formula& f) { return f.Evaluate(env); });
 }
 
+bool FormulaAnd::Evaluate(const IndexedEnvironment& env) const {
+  const auto& operands = get_operands();
+  return all_of(operands.begin(), operands.end(),
+                [&env](const Formula& f) { return f.Evaluate(env); });
+}
+
 Formula FormulaAnd::Substitute(const ExpressionSubstitution& expr_subst,
                                const FormulaSubstitution& formula_subst) {
   Formula ret{Formula::True()};
@@ -471,6 +533,12 @@ bool FormulaOr::Evaluate(const Environment& env) const {
                 [&env](const Formula& f) { return f.Evaluate(env); });
 }
 
+bool FormulaOr::Evaluate(const IndexedEnvironment& env) const {
+  const auto& operands = get_operands();
+  return any_of(operands.begin(), operands.end(),
+                [&env](const Formula& f) { return f.Evaluate(env); });
+}
+
 Formula FormulaOr::Substitute(const ExpressionSubstitution& expr_subst,
                               const FormulaSubstitution& formula_subst) {
   Formula ret{Formula::False()};
@@ -522,6 +590,10 @@ bool FormulaNot::Evaluate(const Environment& env) const {
   return !f_.Evaluate(env);
 }
 
+bool FormulaNot::Evaluate(const IndexedEnvironment& env) const {
+  return !f_.Evaluate(env);
+}
+
 Formula FormulaNot::Substitute(const ExpressionSubstitution& expr_subst,
                                const FormulaSubstitution& formula_subst) {
   const Formula f_subst{f_.Substitute(expr_subst, formula_subst)};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
 #include <functional>
 #include <ostream>
 #include <set>
@@ -8,9 +9,11 @@
 #include <utility>
 
 #include "dreal/symbolic/hash.h"
+#include "dreal/symbolic/symbolic_arena.h"
 #include "dreal/symbolic/symbolic_environment.h"
 #include "dreal/symbolic/symbolic_expression.h"
 #include "dreal/symbolic/symbolic_formula.h"
+#include "dreal/symbolic/symbolic_intern_table.h"
 #include "dreal/symbolic/symbolic_variable.h"
 #include "dreal/symbolic/symbolic_variables.h"
 
@@ -26,6 +29,13 @@ namespace symbolic {
  */
 class FormulaCell {
  public:
+  /** Allocates a cell. It is placed in the current SymbolicArena if any. */
+  static void* operator new(std::size_t size) {
+    return SymbolicArena::Allocate(size);
+  }
+  /** Deallocates a cell. */
+  static void operator delete(void* p) { SymbolicArena::Deallocate(p); }
+
   /** Default constructor (DELETED). */
   FormulaCell() = delete;
 
@@ -53,6 +63,12 @@ class FormulaCell {
   virtual bool Less(const FormulaCell& c) const = 0;
   /** Evaluates under a given environment. */
   virtual bool Evaluate(const Environment& env) const = 0;
+  /** Evaluates under a given indexed environment.
+   *
+   * The default implementation copies @p env into an Environment and
+   * delegates to Evaluate(const Environment&). The cells which can be
+   * evaluated without it override this method. */
+  virtual bool Evaluate(const IndexedEnvironment& env) const;
   /** Returns a Formula obtained by replacing all occurrences of the
    * variables in @p s in the current formula cell with the corresponding
    * expressions in @p s.
@@ -93,12 +109,14 @@ class FormulaCell {
   }
   void decrease_rc() const {
     if (atomic_fetch_sub_explicit(&rc_, 1U, std::memory_order_acq_rel) == 1U) {
-      delete this;
+      InternTable<FormulaCell>::GetInstance().Release(this);
     }
   }
 
   // So that Expression can call {increase,decrease}_rc.
   friend Formula;
+  // So that InternTable can access rc_ and delete this.
+  friend class InternTable<FormulaCell>;
 };
 
 /** Represents the base class for relational operators (==, !=, <, <=, >, >=).
@@ -179,6 +197,7 @@ class FormulaTrue : public FormulaCell {
   bool EqualTo(const FormulaCell& f) const override;
   bool Less(const FormulaCell& f) const override;
   bool Evaluate(const Environment& env) const override;
+  bool Evaluate(const IndexedEnvironment& env) const override;
   Formula Substitute(const ExpressionSubstitution& expr_subst,
                      const FormulaSubstitution& formula_subst) override;
   std::ostream& Display(std::ostream& os) const override;
@@ -192,6 +211,7 @@ class FormulaFalse : public FormulaCell {
   bool EqualTo(const FormulaCell& f) const override;
   bool Less(const FormulaCell& f) const override;
   bool Evaluate(const Environment& env) const override;
+  bool Evaluate(const IndexedEnvironment& env) const override;
   Formula Substitute(const ExpressionSubstitution& expr_subst,
                      const FormulaSubstitution& formula_subst) override;
   std::ostream& Display(std::ostream& os) const override;
@@ -207,6 +227,7 @@ class FormulaVar : public FormulaCell {
   bool EqualTo(const FormulaCell& f) const override;
   bool Less(const FormulaCell& f) const override;
   bool Evaluate(const Environment& env) const override;
+  bool Evaluate(const IndexedEnvironment& env) const override;
   Formula Substitute(const ExpressionSubstitution& expr_subst,
                      const FormulaSubstitution& formula_substubst) override;
   std::ostream& Display(std::ostream& os) const override;
@@ -222,6 +243,7 @@ class FormulaEq : public RelationalFormulaCell {
   /** Constructs from @p e1 and @p e2. */
   FormulaEq(const Expression& e1, const Expression& e2);
   bool Evaluate(const Environment& env) const override;
+  bool Evaluate(const IndexedEnvironment& env) const override;
   Formula Substitute(const ExpressionSubstitution& expr_subst,
                      const FormulaSubstitution& formula_subst) override;
   std::ostream& Display(std::ostream& os) const override;
@@ -233,6 +255,7 @@ class FormulaNeq : public RelationalFormulaCell {
   /** Constructs from @p e1 and @p e2. */
   FormulaNeq(const Expression& e1, const Expression& e2);
   bool Evaluate(const Environment& env) const override;
+  bool Evaluate(const IndexedEnvironment& env) const override;
   Formula Substitute(const ExpressionSubstitution& expr_subst,
                      const FormulaSubstitution& formula_subst) override;
   std::ostream& Display(std::ostream& os) const override;
@@ -244,6 +267,7 @@ class FormulaGt : public RelationalFormulaCell {
   /** Constructs from @p e1 and @p e2. */
   FormulaGt(const Expression& e1, const Expression& e2);
   bool Evaluate(const Environment& env) const override;
+  bool Evaluate(const IndexedEnvironment& env) const override;
   Formula Substitute(const ExpressionSubstitution& expr_subst,
                      const FormulaSubstitution& formula_subst) override;
   std::ostream& Display(std::ostream& os) const override;
@@ -255,6 +279,7 @@ class FormulaGeq : public RelationalFormulaCell {
   /** Constructs from @p e1 and @p e2. */
   FormulaGeq(const Expression& e1, const Expression& e2);
   bool Evaluate(const Environment& env) const override;
+  bool Evaluate(const IndexedEnvironment& env) const override;
   Formula Substitute(const ExpressionSubstitution& expr_subst,
                      const FormulaSubstitution& formula_subst) override;
   std::ostream& Display(std::ostream& os) const override;
@@ -266,6 +291,7 @@ class FormulaLt : public RelationalFormulaCell {
   /** Constructs from @p e1 and @p e2. */
   FormulaLt(const Expression& e1, const Expression& e2);
   bool Evaluate(const Environment& env) const override;
+  bool Evaluate(const IndexedEnvironment& env) const override;
   Formula Substitute(const ExpressionSubstitution& expr_subst,
                      const FormulaSubstitution& formula_subst) override;
   std::ostream& Display(std::ostream& os) const override;
@@ -277,6 +303,7 @@ class FormulaLeq : public RelationalFormulaCell {
   /** Constructs from @p e1 and @p e2. */
   FormulaLeq(const Expression& e1, const Expression& e2);
   bool Evaluate(const Environment& env) const override;
+  bool Evaluate(const IndexedEnvironment& env) const override;
   Formula Substitute(const ExpressionSubstitution& expr_subst,
                      const FormulaSubstitution& formula_subst) override;
   std::ostream& Display(std::ostream& os) const override;
@@ -290,6 +317,7 @@ class FormulaAnd : public NaryFormulaCell {
   /** Constructs @p f1 ∧ @p f2. */
   FormulaAnd(const Formula& f1, const Formula& f2);
   bool Evaluate(const Environment& env) const override;
+  bool Evaluate(const IndexedEnvironment& env) const override;
   Formula Substitute(const ExpressionSubstitution& expr_subst,
                      const FormulaSubstitution& formula_subst) override;
   std::ostream& Display(std::ostream& os) const override;
@@ -303,6 +331,7 @@ class FormulaOr : public NaryFormulaCell {
   /** Constructs @p f1 ∨ @p f2. */
   FormulaOr(const Formula& f1, const Formula& f2);
   bool Evaluate(const Environment& env) const override;
+  bool Evaluate(const IndexedEnvironment& env) const override;
   Formula Substitute(const ExpressionSubstitution& expr_subst,
                      const FormulaSubstitution& formula_subst) override;
   std::ostream& Display(std::ostream& os) const override;
@@ -316,6 +345,7 @@ class FormulaNot : public FormulaCell {
   bool EqualTo(const FormulaCell& f) const override;
   bool Less(const FormulaCell& f) const override;
   bool Evaluate(const Environment& env) const override;
+  bool Evaluate(const IndexedEnvironment& env) const override;
   Formula Substitute(const ExpressionSubstitution& expr_subst,
                      const FormulaSubstitution& formula_subst) override;
   std::ostream& Display(std::ostream& os) const override;
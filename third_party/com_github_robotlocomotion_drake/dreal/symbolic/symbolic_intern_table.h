@@ -0,0 +1,157 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+
+#include "dreal/symbolic/never_destroyed.h"
+
+namespace dreal {
+namespace drake {
+namespace symbolic {
+
+/** Represents a global table of hash-consed cells (ExpressionCell or
+ * FormulaCell).
+ *
+ * Every cell is interned when it is wrapped by an Expression/Formula for the
+ * first time. If there is already a live cell which is structurally equal to
+ * the new one, the new one is discarded and the existing one is shared. As a
+ * result, two live Expressions (resp. Formulas) are structurally equal if and
+ * only if they point to the same cell, which makes their equality check a
+ * pointer comparison.
+ *
+ * The table does not own cells. When the reference count of a cell drops to
+ * zero, Release removes it from the table and deletes it.
+ *
+ * The table is split into shards, each of which is protected by its own mutex,
+ * so that it can be used from multiple threads.
+ *
+ * @tparam Cell ExpressionCell or FormulaCell. It should provide get_hash(),
+ * get_kind(), EqualTo(const Cell&), and a reference counter `rc_`, and make
+ * this class a friend.
+ */
+template <typename Cell>
+class InternTable {
+ public:
+  /** Returns the global instance. It is never destroyed so that cells in
+   * static storage can be released at exit. */
+  static InternTable& GetInstance() {
+    static never_destroyed<InternTable> instance;
+    return instance.access();
+  }
+
+  InternTable() = default;
+  InternTable(const InternTable&) = delete;
+  InternTable(InternTable&&) = delete;
+  InternTable& operator=(const InternTable&) = delete;
+  InternTable& operator=(InternTable&&) = delete;
+  ~InternTable() = default;
+
+  /** Interns a fresh cell @p cell whose reference count is zero. Returns the
+   * structurally equal cell in the table if any (and deletes @p cell).
+   * Otherwise, adds @p cell to the table and returns it. In both cases, the
+   * reference count of the returned cell is incremented. */
+  Cell* Intern(Cell* const cell) {
+    Shard& shard{GetShard(cell->get_hash())};
+    Cell* found{nullptr};
+    {
+      std::lock_guard<std::mutex> guard{shard.mutex};
+      const auto range = shard.cells.equal_range(cell->get_hash());
+      for (auto it = range.first; it != range.second; ++it) {
+        Cell* const c{it->second};
+        if (c->get_kind() == cell->get_kind() && c->EqualTo(*cell) &&
+            Revive(c)) {
+          found = c;
+          break;
+        }
+      }
+      if (!found) {
+        cell->rc_.fetch_add(1U, std::memory_order_relaxed);
+        shard.cells.emplace(cell->get_hash(), cell);
+        return cell;
+      }
+    }
+    // Deletes the duplicate outside of the critical section, since its
+    // destruction may release its sub-cells in the same shard.
+    delete cell;
+    return found;
+  }
+
+  /** Removes @p cell, whose reference count has dropped to zero, from the
+   * table and deletes it. */
+  void Release(const Cell* const cell) {
+    Shard& shard{GetShard(cell->get_hash())};
+    {
+      std::lock_guard<std::mutex> guard{shard.mutex};
+      Erase(&shard, cell);
+    }
+    delete cell;
+  }
+
+  /** Removes @p cell from the table if the caller holds its only reference.
+   * Returns true if it is removed. After this call, the caller may modify
+   * @p cell in place, as no one else can obtain it. */
+  bool Detach(const Cell* const cell) {
+    Shard& shard{GetShard(cell->get_hash())};
+    std::lock_guard<std::mutex> guard{shard.mutex};
+    if (cell->rc_.load(std::memory_order_acquire) != 1U) {
+      return false;
+    }
+    Erase(&shard, cell);
+    return true;
+  }
+
+  /** Returns the number of cells in the table. */
+  size_t size() const {
+    size_t n{0};
+    for (const Shard& shard : shards_) {
+      std::lock_guard<std::mutex> guard{shard.mutex};
+      n += shard.cells.size();
+    }
+    return n;
+  }
+
+ private:
+  static constexpr size_t kNumShards{64};
+
+  struct Shard {
+    mutable std::mutex mutex;
+    // hash → cells. There is at most one live cell per structure.
+    std::unordered_multimap<size_t, Cell*> cells;
+  };
+
+  Shard& GetShard(const size_t hash) { return shards_[hash % kNumShards]; }
+
+  // Increments the reference count of @p cell unless it is zero, in which
+  // case another thread is about to release it. Returns true if incremented.
+  static bool Revive(const Cell* const cell) {
+    unsigned rc{cell->rc_.load(std::memory_order_relaxed)};
+    while (rc != 0U) {
+      if (cell->rc_.compare_exchange_weak(rc, rc + 1U,
+                                          std::memory_order_acq_rel,
+                                          std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Removes @p cell from @p shard if it is there.
+  static void Erase(Shard* const shard, const Cell* const cell) {
+    const auto range = shard->cells.equal_range(cell->get_hash());
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == cell) {
+        shard->cells.erase(it);
+        return;
+      }
+    }
+  }
+
+  std::array<Shard, kNumShards> shards_;
+};
+
+}  // namespace symbolic
+}  // namespace drake
+}  // namespace dreal
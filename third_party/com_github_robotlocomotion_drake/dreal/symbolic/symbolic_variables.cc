@@ -8,28 +8,37 @@
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "dreal/symbolic/hash.h"
 
+using std::back_inserter;
 using std::includes;
 using std::initializer_list;
-using std::inserter;
+using std::inplace_merge;
 using std::less;
+using std::lower_bound;
 using std::ostream;
 using std::ostream_iterator;
 using std::ostringstream;
-using std::set;
+using std::set_difference;
 using std::set_intersection;
+using std::set_union;
+using std::sort;
 using std::string;
+using std::unique;
+using std::vector;
 
 namespace dreal {
 namespace drake {
 namespace symbolic {
 
-Variables::Variables(std::initializer_list<Variable> init) : vars_(init) {}
+Variables::Variables(std::initializer_list<Variable> init) : vars_(init) {
+  Normalize(0);
+}
 
 size_t Variables::get_hash() const {
-  return hash_value<set<Variable>>{}(vars_);
+  return hash_value<vector<Variable>>{}(vars_);
 }
 
 string Variables::to_string() const {
@@ -38,14 +47,66 @@ string Variables::to_string() const {
   return oss.str();
 }
 
+void Variables::insert(const Variable& var) {
+  const auto it =
+      lower_bound(vars_.begin(), vars_.end(), var, less<Variable>{});
+  if (it == vars_.end() || !it->equal_to(var)) {
+    vars_.insert(it, var);
+  }
+}
+
+void Variables::insert(const Variables& vars) {
+  if (vars.empty()) {
+    return;
+  }
+  if (vars_.empty()) {
+    vars_ = vars.vars_;
+    return;
+  }
+  if (vars_.back().less(vars.vars_.front())) {
+    // Fast path: all the variables in vars come after the ones in this set.
+    vars_.insert(vars_.end(), vars.vars_.begin(), vars.vars_.end());
+    return;
+  }
+  vector<Variable> result;
+  result.reserve(vars_.size() + vars.size());
+  set_union(vars_.begin(), vars_.end(), vars.vars_.begin(), vars.vars_.end(),
+            back_inserter(result), less<Variable>{});
+  vars_ = std::move(result);
+}
+
+Variables::size_type Variables::erase(const Variable& key) {
+  const auto it =
+      lower_bound(vars_.begin(), vars_.end(), key, less<Variable>{});
+  if (it == vars_.end() || !it->equal_to(key)) {
+    return 0;
+  }
+  vars_.erase(it);
+  return 1;
+}
+
 Variables::size_type Variables::erase(const Variables& vars) {
-  size_type num_of_erased_elements{0};
-  for (const Variable& var : vars) {
-    num_of_erased_elements += erase(var);
+  if (vars.empty() || vars_.empty()) {
+    return 0;
   }
+  vector<Variable> result;
+  result.reserve(vars_.size());
+  set_difference(vars_.begin(), vars_.end(), vars.vars_.begin(),
+                 vars.vars_.end(), back_inserter(result), less<Variable>{});
+  const size_type num_of_erased_elements{vars_.size() - result.size()};
+  vars_ = std::move(result);
   return num_of_erased_elements;
 }
 
+Variables::const_iterator Variables::find(const Variable& key) const {
+  const auto it =
+      lower_bound(vars_.cbegin(), vars_.cend(), key, less<Variable>{});
+  if (it == vars_.cend() || !it->equal_to(key)) {
+    return vars_.cend();
+  }
+  return it;
+}
+
 bool Variables::IsSubsetOf(const Variables& vars) const {
   return includes(vars.begin(), vars.end(), begin(), end(),
                   std::less<Variable>{});
@@ -127,13 +188,23 @@ Variables operator-(Variables vars, const Variable& var) {
   return vars;
 }
 
-Variables::Variables(set<Variable> vars) : vars_{std::move(vars)} {}
+Variables::Variables(vector<Variable> vars) : vars_{std::move(vars)} {}
+
+void Variables::Normalize(const size_type num_sorted) {
+  if (num_sorted == vars_.size()) {
+    return;
+  }
+  const auto middle = vars_.begin() + num_sorted;
+  sort(middle, vars_.end(), less<Variable>{});
+  inplace_merge(vars_.begin(), middle, vars_.end(), less<Variable>{});
+  vars_.erase(unique(vars_.begin(), vars_.end(), std::equal_to<Variable>{}),
+              vars_.end());
+}
 
 Variables intersect(const Variables& vars1, const Variables& vars2) {
-  set<Variable> intersection;
+  vector<Variable> intersection;
   set_intersection(vars1.vars_.begin(), vars1.vars_.end(), vars2.vars_.begin(),
-                   vars2.vars_.end(),
-                   inserter(intersection, intersection.begin()),
+                   vars2.vars_.end(), back_inserter(intersection),
                    less<Variable>{});
   return Variables{std::move(intersection)};
 }
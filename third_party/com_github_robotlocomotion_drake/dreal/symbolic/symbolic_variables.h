@@ -4,8 +4,8 @@
 #include <functional>
 #include <initializer_list>
 #include <ostream>
-#include <set>
 #include <string>
+#include <vector>
 
 #include "dreal/symbolic/symbolic_variable.h"
 
@@ -15,11 +15,19 @@ namespace symbolic {
 
 /** Represents a set of variables.
  *
- * This class is based on std::set<Variable>. The intent is to add things that
- * we need including set-union (Variables::insert, operator+, operator+=),
+ * This class provides set-union (Variables::insert, operator+, operator+=),
  * set-minus (Variables::erase, operator-, operator-=), and subset/superset
  * checking functions (Variables::IsSubsetOf, Variables::IsSupersetOf,
  * Variables::IsStrictSubsetOf, Variables::IsStrictSupersetOf).
+ *
+ * The variables are stored in a vector sorted by their IDs. Compared to
+ * std::set<Variable>, it does not allocate a node per element, and the
+ * set-operations (union, difference, intersection, and subset checks) are
+ * linear merges over contiguous memory. Inserting or erasing a single variable
+ * takes linear time; to insert many variables, use the range or set versions
+ * of insert which sort and merge only once.
+ *
+ * Since the elements have to stay sorted, the iterators are read-only.
  */
 
 class Variables {
@@ -29,11 +37,12 @@ class Variables {
   Variables(Variables&&) = default;
   Variables& operator=(Variables&&) = default;
 
-  typedef typename std::set<Variable>::size_type size_type;
-  typedef typename std::set<Variable>::iterator iterator;
-  typedef typename std::set<Variable>::const_iterator const_iterator;
-  typedef typename std::set<Variable>::reverse_iterator reverse_iterator;
-  typedef typename std::set<Variable>::const_reverse_iterator
+  typedef typename std::vector<Variable>::size_type size_type;
+  typedef typename std::vector<Variable>::const_iterator iterator;
+  typedef typename std::vector<Variable>::const_iterator const_iterator;
+  typedef typename std::vector<Variable>::const_reverse_iterator
+      reverse_iterator;
+  typedef typename std::vector<Variable>::const_reverse_iterator
       const_reverse_iterator;
 
   /** Default constructor. */
@@ -58,9 +67,9 @@ class Variables {
   std::string to_string() const;
 
   /** Returns an iterator to the beginning. */
-  iterator begin() { return vars_.begin(); }
+  iterator begin() { return vars_.cbegin(); }
   /** Returns an iterator to the end. */
-  iterator end() { return vars_.end(); }
+  iterator end() { return vars_.cend(); }
   /** Returns an iterator to the beginning. */
   const_iterator begin() const { return vars_.cbegin(); }
   /** Returns an iterator to the end. */
@@ -70,9 +79,9 @@ class Variables {
   /** Returns a const iterator to the end. */
   const_iterator cend() const { return vars_.cend(); }
   /** Returns a reverse iterator to the beginning. */
-  reverse_iterator rbegin() { return vars_.rbegin(); }
+  reverse_iterator rbegin() { return vars_.crbegin(); }
   /** Returns a reverse iterator to the end. */
-  reverse_iterator rend() { return vars_.rend(); }
+  reverse_iterator rend() { return vars_.crend(); }
   /** Returns a reverse iterator to the beginning. */
   const_reverse_iterator rbegin() const { return vars_.crbegin(); }
   /** Returns a reverse iterator to the end. */
@@ -83,25 +92,26 @@ class Variables {
   const_reverse_iterator crend() const { return vars_.crend(); }
 
   /** Inserts a variable @p var into a set. */
-  void insert(const Variable& var) { vars_.insert(var); }
+  void insert(const Variable& var);
   /** Inserts variables in [@p first, @p last) into a set. */
   template <class InputIt>
   void insert(InputIt first, InputIt last) {
-    vars_.insert(first, last);
+    const size_type num_sorted{vars_.size()};
+    vars_.insert(vars_.end(), first, last);
+    Normalize(num_sorted);
   }
   /** Inserts variables in @p vars into a set. */
-  void insert(const Variables& vars) { vars_.insert(vars.begin(), vars.end()); }
+  void insert(const Variables& vars);
 
   /** Erases @p key from a set. Return number of erased elements (0 or 1). */
-  size_type erase(const Variable& key) { return vars_.erase(key); }
+  size_type erase(const Variable& key);
 
   /** Erases variables in @p vars from a set. Return number of erased
       elements ([0, vars.size()]). */
   size_type erase(const Variables& vars);
 
   /** Finds element with specific key. */
-  iterator find(const Variable& key) { return vars_.find(key); }
-  const_iterator find(const Variable& key) const { return vars_.find(key); }
+  const_iterator find(const Variable& key) const;
 
   /** Return true if @p key is included in the Variables. */
   bool include(const Variable& key) const { return find(key) != end(); }
@@ -124,10 +134,14 @@ class Variables {
   friend Variables intersect(const Variables& vars1, const Variables& vars2);
 
  private:
-  /* Constructs from std::set<Variable>. */
-  explicit Variables(std::set<Variable> vars);
+  /* Constructs from @p vars which is sorted and has no duplicates. */
+  explicit Variables(std::vector<Variable> vars);
+
+  /* Sorts vars_[num_sorted:] and merges it into vars_[0:num_sorted], which is
+   * already sorted. Removes duplicates. */
+  void Normalize(size_type num_sorted);
 
-  std::set<Variable> vars_;
+  std::vector<Variable> vars_;
 };
 
 /** Updates @p var1 with the result of set-union(@p var1, @p var2). */
@@ -0,0 +1,114 @@
+#include "dreal/symbolic/symbolic_arena.h"
+
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "dreal/symbolic/symbolic_expression.h"
+#include "dreal/symbolic/symbolic_formula.h"
+
+namespace dreal {
+namespace drake {
+namespace symbolic {
+namespace {
+
+using std::make_unique;
+using std::thread;
+using std::unique_ptr;
+
+class SymbolicArenaTest : public ::testing::Test {
+ protected:
+  Expression Build(const int n) const {
+    Expression e{0.0};
+    for (int i = 0; i < n; ++i) {
+      e += sin(x_ * i) * pow(y_, i) + exp(z_ / (i + 1));
+    }
+    return e;
+  }
+
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  const Variable z_{"z"};
+};
+
+TEST_F(SymbolicArenaTest, AllocateInArena) {
+  SymbolicArena arena{1024};
+  EXPECT_EQ(SymbolicArena::current(), nullptr);
+  {
+    SymbolicArena::Scope scope{&arena};
+    EXPECT_EQ(SymbolicArena::current(), &arena);
+    const Expression e{Build(50)};
+    EXPECT_GT(arena.num_allocations(), 0U);
+    EXPECT_GT(arena.num_chunks(), 1U);
+  }
+  EXPECT_EQ(SymbolicArena::current(), nullptr);
+
+  // Out of the scope, cells are allocated from the heap.
+  const size_t num_allocations{arena.num_allocations()};
+  const Expression e{Build(50) + x_ * y_ * z_};
+  EXPECT_EQ(arena.num_allocations(), num_allocations);
+}
+
+TEST_F(SymbolicArenaTest, NestedScopes) {
+  SymbolicArena arena1;
+  SymbolicArena arena2;
+  {
+    SymbolicArena::Scope scope1{&arena1};
+    {
+      SymbolicArena::Scope scope2{&arena2};
+      EXPECT_EQ(SymbolicArena::current(), &arena2);
+      {
+        SymbolicArena::Scope scope3{nullptr};
+        EXPECT_EQ(SymbolicArena::current(), nullptr);
+      }
+      EXPECT_EQ(SymbolicArena::current(), &arena2);
+    }
+    EXPECT_EQ(SymbolicArena::current(), &arena1);
+  }
+  EXPECT_EQ(SymbolicArena::current(), nullptr);
+}
+
+TEST_F(SymbolicArenaTest, EscapedCellsOutliveArena) {
+  Expression e;
+  Formula f;
+  {
+    auto arena = make_unique<SymbolicArena>(1024);
+    SymbolicArena::Scope scope{arena.get()};
+    e = Build(20);
+    f = (e > x_) && (y_ == z_);
+    // Build garbage which dies before the arena.
+    for (int i = 0; i < 10; ++i) {
+      Build(i);
+    }
+  }
+  // The arena is destroyed. The escaped cells are still valid.
+  EXPECT_TRUE(e.EqualTo(Build(20)));
+  EXPECT_TRUE(f.EqualTo((Build(20) > x_) && (y_ == z_)));
+  EXPECT_EQ(e.GetVariables(), Variables({x_, y_, z_}));
+
+  // Escaped cells can be shared and released by other threads.
+  thread t{[e]() {
+    const Expression copy{e * 2};
+    EXPECT_EQ(copy.GetVariables().size(), 3U);
+  }};
+  t.join();
+  e = Expression::Zero();
+  f = Formula::True();
+}
+
+TEST_F(SymbolicArenaTest, OtherThreadsUseHeap) {
+  SymbolicArena arena;
+  SymbolicArena::Scope scope{&arena};
+  thread t{[this]() {
+    EXPECT_EQ(SymbolicArena::current(), nullptr);
+    Build(10);
+  }};
+  t.join();
+  EXPECT_EQ(arena.num_allocations(), 0U);
+}
+
+}  // namespace
+}  // namespace symbolic
+}  // namespace drake
+}  // namespace dreal
@@ -1,11 +1,13 @@
 #include <cmath>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include "dreal/symbolic/symbolic_environment.h"
 #include "dreal/symbolic/symbolic_expression.h"
+#include "dreal/symbolic/symbolic_formula.h"
 
 namespace dreal {
 namespace drake {
@@ -14,6 +16,7 @@ namespace {
 
 using std::runtime_error;
 using std::string;
+using std::vector;
 
 // Provides common variables that are used by the following tests.
 class EnvironmentTest : public ::testing::Test {
@@ -125,6 +128,89 @@ TEST_F(EnvironmentTest, LookupOperator) {
   EXPECT_THROW(const_env[var_dummy_], runtime_error);
 }
 
+TEST_F(EnvironmentTest, IndexedEnvironmentSlots) {
+  IndexedEnvironment env{{var_z_, var_x_, var_y_}};
+  EXPECT_EQ(env.size(), 3);
+  EXPECT_FALSE(env.empty());
+  // Slots follow the order of the IDs.
+  EXPECT_EQ(env.slot(var_x_), 0);
+  EXPECT_EQ(env.slot(var_y_), 1);
+  EXPECT_EQ(env.slot(var_z_), 2);
+  EXPECT_EQ(env.slot(var_w_), -1);
+  EXPECT_TRUE(env.has_variable(var_x_));
+  EXPECT_FALSE(env.has_variable(var_w_));
+
+  env[var_y_] = 3.0;
+  env[env.slot(var_z_)] = 4.0;
+  EXPECT_EQ(env[0], 0.0);
+  EXPECT_EQ(env.data()[1], 3.0);
+  EXPECT_EQ(env[var_z_], 4.0);
+  EXPECT_THROW(env[var_w_], runtime_error);
+
+  const IndexedEnvironment& const_env{env};
+  EXPECT_EQ(const_env[var_y_], 3.0);
+  EXPECT_THROW(const_env[var_w_], runtime_error);
+
+  EXPECT_TRUE(IndexedEnvironment{}.empty());
+  EXPECT_THROW((IndexedEnvironment{{var_dummy_, var_x_}}), runtime_error);
+}
+
+TEST_F(EnvironmentTest, IndexedEnvironmentSparseIds) {
+  // Creates many variables between x and y so that their IDs are far apart.
+  const Variable x{"x"};
+  vector<Variable> others;
+  for (int i = 0; i < 1000; ++i) {
+    others.emplace_back("other");
+  }
+  const Variable y{"y"};
+  const IndexedEnvironment env{{x, y}};
+  EXPECT_EQ(env.slot(x), 0);
+  EXPECT_EQ(env.slot(y), 1);
+  EXPECT_EQ(env.slot(others[500]), -1);
+  EXPECT_EQ(env.slot(var_x_), -1);
+}
+
+TEST_F(EnvironmentTest, IndexedEnvironmentUpdate) {
+  IndexedEnvironment env{{var_x_, var_y_}};
+  env.Update(Environment{{var_x_, 1.0}, {var_z_, 2.0}});
+  EXPECT_EQ(env[var_x_], 1.0);
+  EXPECT_EQ(env[var_y_], 0.0);
+  env.Update(Environment{{var_y_, 5.0}});
+  EXPECT_EQ(env[var_x_], 1.0);
+  EXPECT_EQ(env[var_y_], 5.0);
+}
+
+TEST_F(EnvironmentTest, IndexedEnvironmentEvaluate) {
+  const Expression x{var_x_};
+  const Expression y{var_y_};
+  const Expression e{x * sin(y) + pow(x, 2) / (1 + y) +
+                     if_then_else(x > y, x, y)};
+  const Formula f{(e > 2.0) && !(x == y)};
+  IndexedEnvironment env{e.GetVariables()};
+  for (const double v_x : {-1.0, 0.5, 3.0}) {
+    for (const double v_y : {0.5, 3.0}) {
+      env[var_x_] = v_x;
+      env[var_y_] = v_y;
+      const Environment map_env{{var_x_, v_x}, {var_y_, v_y}};
+      EXPECT_EQ(e.Evaluate(env), e.Evaluate(map_env));
+      EXPECT_EQ(f.Evaluate(env), f.Evaluate(map_env));
+    }
+  }
+  // z is not bound.
+  EXPECT_THROW(Expression{var_z_}.Evaluate(env), runtime_error);
+  EXPECT_THROW((x < var_z_).Evaluate(env), runtime_error);
+}
+
+TEST_F(EnvironmentTest, IndexedEnvironmentEvaluateQuantified) {
+  // A quantified formula is evaluated as under an Environment holding the
+  // same values.
+  const Formula f{forall({var_y_}, var_x_ * var_y_ >= 0)};
+  IndexedEnvironment env{f.GetFreeVariables()};
+  env[var_x_] = 1.0;
+  EXPECT_THROW(f.Evaluate(Environment{{var_x_, 1.0}}), runtime_error);
+  EXPECT_THROW(f.Evaluate(env), runtime_error);
+}
+
 }  // namespace
 }  // namespace symbolic
 }  // namespace drake
@@ -0,0 +1,98 @@
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dreal/symbolic/symbolic_expression.h"
+#include "dreal/symbolic/symbolic_formula.h"
+
+namespace dreal {
+namespace drake {
+namespace symbolic {
+namespace {
+
+using std::thread;
+using std::vector;
+
+class SymbolicInternTableTest : public ::testing::Test {
+ protected:
+  // Builds the same expression from scratch on each call.
+  Expression Build(const int n) const {
+    Expression e{0.0};
+    for (int i = 0; i < n; ++i) {
+      e += sin(x_ * i) * pow(y_, i) + exp(z_ / (i + 1));
+    }
+    return e;
+  }
+
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  const Variable z_{"z"};
+};
+
+TEST_F(SymbolicInternTableTest, IndependentlyBuiltExpressions) {
+  const Expression e1{Build(30)};
+  const Expression e2{Build(30)};
+  EXPECT_TRUE(e1.EqualTo(e2));
+  EXPECT_FALSE(e1.EqualTo(Build(29)));
+  EXPECT_FALSE(e1.Less(e2));
+  EXPECT_FALSE(e2.Less(e1));
+  EXPECT_TRUE(((x_ + y_) * z_).EqualTo(z_ * (y_ + x_)));
+  EXPECT_FALSE(((x_ + y_) * z_).EqualTo(z_ * (y_ - x_)));
+}
+
+TEST_F(SymbolicInternTableTest, IndependentlyBuiltFormulas) {
+  const Formula f1{Build(10) > 0 && x_ == y_};
+  const Formula f2{y_ == x_ && 0 < Build(10)};
+  EXPECT_FALSE((x_ == y_).EqualTo(y_ == x_));
+  EXPECT_TRUE(f1.EqualTo(Build(10) > 0 && x_ == y_));
+  EXPECT_FALSE(f1.EqualTo(f2));
+  EXPECT_TRUE((f1 || !f2).EqualTo(f1 || !f2));
+}
+
+// In-place updates of sums, products, conjunctions, and disjunctions must not
+// affect other expressions/formulas sharing the same cells.
+TEST_F(SymbolicInternTableTest, InPlaceUpdate) {
+  const Expression shared{x_ + y_};
+  Expression e{x_ + y_};
+  e += z_;
+  EXPECT_TRUE(shared.EqualTo(x_ + y_));
+  EXPECT_TRUE(e.EqualTo(x_ + y_ + z_));
+
+  Expression p{x_ * y_};
+  p *= z_;
+  EXPECT_TRUE(p.EqualTo(x_ * y_ * z_));
+  EXPECT_TRUE((-(x_ * y_ + 1)).EqualTo(-x_ * y_ - 1));
+
+  const Formula shared_f{x_ > 0 && y_ > 0};
+  Formula f{x_ > 0 && y_ > 0};
+  f = f && z_ > 0;
+  EXPECT_TRUE(shared_f.EqualTo(x_ > 0 && y_ > 0));
+  EXPECT_TRUE(f.EqualTo(x_ > 0 && y_ > 0 && z_ > 0));
+}
+
+TEST_F(SymbolicInternTableTest, MultipleThreads) {
+  const int kNumThreads{8};
+  vector<Expression> results(kNumThreads);
+  vector<thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([this, i, &results]() {
+      for (int j = 0; j < 20; ++j) {
+        // Creates and destroys shared cells concurrently.
+        results[i] = Build(j);
+      }
+    });
+  }
+  for (thread& t : threads) {
+    t.join();
+  }
+  const Expression expected{Build(19)};
+  for (const Expression& e : results) {
+    EXPECT_TRUE(e.EqualTo(expected));
+  }
+}
+
+}  // namespace
+}  // namespace symbolic
+}  // namespace drake
+}  // namespace dreal
@@ -1,3 +1,5 @@
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "dreal/symbolic/symbolic_variables.h"
@@ -55,6 +57,40 @@ TEST_F(VariablesTest, Plus) {
   EXPECT_TRUE(vars1.include(z_));
 }
 
+TEST_F(VariablesTest, InsertKeepsOrder) {
+  // Variables are kept sorted by their IDs (= creation order) regardless of
+  // the order of insertions.
+  Variables vars;
+  vars.insert(z_);
+  vars.insert(x_);
+  vars.insert(v_);
+  vars.insert(x_);
+  EXPECT_EQ(vars.to_string(), "{x, z, v}");
+
+  const std::vector<Variable> more{w_, y_, z_, y_};
+  vars.insert(more.begin(), more.end());
+  EXPECT_EQ(vars.to_string(), "{x, y, z, w, v}");
+  EXPECT_EQ(vars, (Variables{v_, w_, x_, y_, z_}));
+}
+
+TEST_F(VariablesTest, InsertVariables) {
+  Variables vars1{x_, z_};
+  vars1.insert(Variables{});
+  EXPECT_EQ(vars1, (Variables{x_, z_}));
+
+  // Merge.
+  vars1.insert(Variables{y_, z_});
+  EXPECT_EQ(vars1, (Variables{x_, y_, z_}));
+
+  // Append.
+  vars1.insert(Variables{w_, v_});
+  EXPECT_EQ(vars1, (Variables{x_, y_, z_, w_, v_}));
+
+  Variables vars2;
+  vars2.insert(vars1);
+  EXPECT_EQ(vars2, vars1);
+}
+
 TEST_F(VariablesTest, Erase) {
   Variables vars1{x_, y_, z_};
   Variables vars2{y_, z_, w_};